@@ -206,10 +206,14 @@ OBD_BEGIN ()
         //Framemanipulator
 
         //Status Register
-        OBD_BEGIN_INDEX_RAM(0x3000, 0x03, NULL)
-            OBD_SUBINDEX_RAM_VAR(0x3000, 0x00, kObdTypeUInt8, kObdAccConst, tObdUnsigned8, Number_Entries, 0x02)
+        OBD_BEGIN_INDEX_RAM(0x3000, 0x07, NULL)
+            OBD_SUBINDEX_RAM_VAR(0x3000, 0x00, kObdTypeUInt8, kObdAccConst, tObdUnsigned8, Number_Entries, 0x06)
             OBD_SUBINDEX_RAM_USERDEF(0x3000, 0x01, kObdTypeUInt8, kObdAccVPRW, tObdUnsigned8, FM_Operations, 0x00)
             OBD_SUBINDEX_RAM_USERDEF(0x3000, 0x02, kObdTypeUInt8, kObdAccVPR, tObdUnsigned8, FM_Errors, 0x00)
+            OBD_SUBINDEX_RAM_USERDEF(0x3000, 0x03, kObdTypeUInt8, kObdAccVPR, tObdUnsigned8, FM_PacketOccupancyLow, 0x00)
+            OBD_SUBINDEX_RAM_USERDEF(0x3000, 0x04, kObdTypeUInt8, kObdAccVPR, tObdUnsigned8, FM_PacketOccupancyHigh, 0x00)
+            OBD_SUBINDEX_RAM_USERDEF(0x3000, 0x05, kObdTypeUInt8, kObdAccVPRW, tObdUnsigned8, FM_TaskBank, 0x00)
+            OBD_SUBINDEX_RAM_USERDEF(0x3000, 0x06, kObdTypeUInt8, kObdAccVPR, tObdUnsigned8, FM_ActiveTaskBank, 0x00)
         OBD_END_INDEX(0x3000)
 
 
@@ -498,6 +502,375 @@ OBD_BEGIN ()
            OBD_SUBINDEX_RAM_VSTRING(0x3005, 0x00, kObdAccR, fm_version, OBD_MAX_STRING_SIZE, "0.2.0")
         OBD_END_INDEX(0x3005)
 
+        //Reg 6 => Template frames of the inject task
+        OBD_BEGIN_INDEX_RAM(0x3006, 0x81, frameman_configObdAccessCb)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x00, kObdTypeUInt8, kObdAccSRW, tObdUnsigned8, Number_InjectTemplate, 0x80)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x01, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x02, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x03, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x04, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x05, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x06, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x07, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x08, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x09, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x0A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x0B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x0C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x0D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x0E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x0F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x10, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x11, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x12, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x13, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x14, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x15, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x16, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x17, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x18, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x19, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x1A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x1B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x1C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x1D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x1E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x1F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x20, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x21, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x22, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x23, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x24, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x25, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x26, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x27, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x28, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x29, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x2A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x2B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x2C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x2D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x2E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x2F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x30, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x31, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x32, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x33, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x34, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x35, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x36, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x37, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x38, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x39, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x3A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x3B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x3C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x3D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x3E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x3F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x40, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x41, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x42, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x43, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x44, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x45, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x46, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x47, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x48, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x49, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x4A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x4B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x4C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x4D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x4E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x4F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x50, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x51, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x52, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x53, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x54, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x55, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x56, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x57, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x58, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x59, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x5A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x5B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x5C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x5D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x5E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x5F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x60, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x61, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x62, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x63, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x64, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x65, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x66, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x67, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x68, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x69, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x6A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x6B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x6C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x6D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x6E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x6F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x70, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x71, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x72, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x73, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x74, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x75, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x76, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x77, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x78, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x79, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x7A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x7B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x7C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x7D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x7E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x7F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3006, 0x80, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, InjectTemplate, 0x00LL)
+        OBD_END_INDEX(0x3006)
+
+        //Reg 7 => Filter window 1
+        OBD_BEGIN_INDEX_RAM(0x3007, 0x41, frameman_configObdAccessCb)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x00, kObdTypeUInt8, kObdAccSRW, tObdUnsigned8, Number_FilterWindow, 0x40)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x01, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x02, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x03, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x04, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x05, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x06, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x07, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x08, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x09, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x0A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x0B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x0C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x0D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x0E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x0F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x10, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x11, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x12, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x13, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x14, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x15, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x16, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x17, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x18, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x19, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x1A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x1B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x1C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x1D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x1E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x1F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x20, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x21, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x22, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x23, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x24, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x25, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x26, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x27, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x28, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x29, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x2A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x2B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x2C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x2D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x2E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x2F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x30, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x31, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x32, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x33, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x34, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x35, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x36, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x37, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x38, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x39, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x3A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x3B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x3C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x3D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x3E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x3F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3007, 0x40, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+        OBD_END_INDEX(0x3007)
+
+        //Reg 8 => Filter window 2
+        OBD_BEGIN_INDEX_RAM(0x3008, 0x41, frameman_configObdAccessCb)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x00, kObdTypeUInt8, kObdAccSRW, tObdUnsigned8, Number_FilterWindow, 0x40)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x01, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x02, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x03, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x04, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x05, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x06, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x07, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x08, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x09, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x0A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x0B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x0C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x0D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x0E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x0F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x10, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x11, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x12, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x13, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x14, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x15, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x16, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x17, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x18, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x19, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x1A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x1B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x1C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x1D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x1E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x1F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x20, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x21, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x22, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x23, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x24, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x25, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x26, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x27, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x28, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x29, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x2A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x2B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x2C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x2D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x2E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x2F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x30, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x31, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x32, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x33, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x34, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x35, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x36, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x37, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x38, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x39, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x3A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x3B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x3C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x3D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x3E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x3F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x3008, 0x40, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, FilterWindow_Task, 0x00LL)
+        OBD_END_INDEX(0x3008)
+
+        //Reg 9 => Forwarding of all EtherTypes and VLAN tags
+        OBD_BEGIN_INDEX_RAM(0x3009, 0x06, frameman_configObdAccessCb)
+            OBD_SUBINDEX_RAM_VAR(0x3009, 0x00, kObdTypeUInt8, kObdAccConst, tObdUnsigned8, Number_Forwarding, 0x05)
+            OBD_SUBINDEX_RAM_VAR(0x3009, 0x01, kObdTypeUInt8, kObdAccSRW, tObdUnsigned8, Forwarding_Flags, 0x00)
+            OBD_SUBINDEX_RAM_VAR(0x3009, 0x02, kObdTypeUInt16, kObdAccSRW, tObdUnsigned16, Forwarding_EtherType, 0x0000)
+            OBD_SUBINDEX_RAM_VAR(0x3009, 0x03, kObdTypeUInt16, kObdAccSRW, tObdUnsigned16, Forwarding_EtherType, 0x0000)
+            OBD_SUBINDEX_RAM_VAR(0x3009, 0x04, kObdTypeUInt16, kObdAccSRW, tObdUnsigned16, Forwarding_EtherType, 0x0000)
+            OBD_SUBINDEX_RAM_VAR(0x3009, 0x05, kObdTypeUInt16, kObdAccSRW, tObdUnsigned16, Forwarding_EtherType, 0x0000)
+        OBD_END_INDEX(0x3009)
+
+        //Reg A => Image of the task memory, uploaded in one go
+        OBD_BEGIN_INDEX_RAM(0x300A, 0x02, frameman_configObdAccessCb)
+            OBD_SUBINDEX_RAM_VAR(0x300A, 0x00, kObdTypeUInt8, kObdAccConst, tObdUnsigned8, Number_TaskImage, 0x01)
+            OBD_SUBINDEX_RAM_DOMAIN(0x300A, 0x01, kObdAccW, TaskImage)
+        OBD_END_INDEX(0x300A)
+
+        //Reg B => Task chain
+        OBD_BEGIN_INDEX_RAM(0x300B, 0x41, frameman_configObdAccessCb)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x00, kObdTypeUInt8, kObdAccSRW, tObdUnsigned8, Number_TaskChain, 0x40)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x01, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x02, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x03, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x04, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x05, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x06, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x07, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x08, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x09, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x0A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x0B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x0C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x0D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x0E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x0F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x10, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x11, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x12, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x13, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x14, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x15, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x16, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x17, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x18, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x19, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x1A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x1B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x1C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x1D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x1E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x1F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x20, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x21, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x22, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x23, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x24, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x25, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x26, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x27, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x28, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x29, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x2A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x2B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x2C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x2D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x2E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x2F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x30, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x31, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x32, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x33, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x34, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x35, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x36, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x37, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x38, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x39, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x3A, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x3B, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x3C, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x3D, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x3E, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x3F, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+            OBD_SUBINDEX_RAM_VAR(0x300B, 0x40, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, TaskChain_Task, 0x00LL)
+        OBD_END_INDEX(0x300B)
+
+        //Reg C => Start mode and SoC time of the start
+        OBD_BEGIN_INDEX_RAM(0x300C, 0x03, frameman_configObdAccessCb)
+            OBD_SUBINDEX_RAM_VAR(0x300C, 0x00, kObdTypeUInt8, kObdAccConst, tObdUnsigned8, Number_Start, 0x02)
+            OBD_SUBINDEX_RAM_VAR(0x300C, 0x01, kObdTypeUInt8, kObdAccSRW, tObdUnsigned8, Start_Mode, 0x00)
+            OBD_SUBINDEX_RAM_VAR(0x300C, 0x02, kObdTypeUInt64, kObdAccSRW, tObdUnsigned64, Start_Time, 0x00LL)
+        OBD_END_INDEX(0x300C)
+
+        //Reg D => Bits flipped by the BER task
+        OBD_BEGIN_INDEX_RAM(0x300D, 0x02, frameman_configObdAccessCb)
+            OBD_SUBINDEX_RAM_VAR(0x300D, 0x00, kObdTypeUInt8, kObdAccConst, tObdUnsigned8, Number_BitErrors, 0x01)
+            OBD_SUBINDEX_RAM_VAR(0x300D, 0x01, kObdTypeUInt32, kObdAccR, tObdUnsigned32, Bit_Errors, 0x00L)
+        OBD_END_INDEX(0x300D)
+
     OBD_END_PART ()
 
     OBD_BEGIN_PART_DEVICE ()
@@ -118,6 +118,7 @@ architecture rtl of toplevel is
             framemanipulator_0_stream_to_dut_iRXD           : in    std_logic_vector(1 downto 0)  := (others => 'X'); -- iRXD
             framemanipulator_0_stream_to_dut_oTXData        : out   std_logic_vector(1 downto 0);                     -- oTXData
             framemanipulator_0_stream_to_dut_oTXDV          : out   std_logic;                                        -- oTXDV
+            framemanipulator_0_stream_to_dut_oTXER          : out   std_logic;                                        -- oTXER
             framemanipulator_0_led_export                   : out   std_logic_vector(1 downto 0)                      -- export
           );
     end component;
@@ -207,6 +208,7 @@ begin
             framemanipulator_0_stream_to_dut_iRXD           => fm.rxD,
             framemanipulator_0_stream_to_dut_oTXData        => fm.txD,
             framemanipulator_0_stream_to_dut_oTXDV          => fm.txEn,
+            framemanipulator_0_stream_to_dut_oTXER          => open,
             framemanipulator_0_led_export                   => fm.led
         );
 
@@ -57,6 +57,7 @@ set_module_property INSTANTIATE_IN_SYSTEM_MODULE true
 set_module_property EDITABLE false
 set_module_property ANALYZE_HDL false
 set_module_property ICON_PATH "img/br.png"
+set_module_property ELABORATION_CALLBACK elaboration_callback
 # |
 # +-----------------------------------
 
@@ -89,6 +90,7 @@ add_file "../fm/src/lib_Memory/write_logic.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/Address_Manager.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/Byte_to_TXData.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/Control_Register.vhd" {SYNTHESIS SIMULATION}
+add_file "../fm/src/src_components/Cycle_Tracker.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/Delay_FSM.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/Delay_Handler.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/Frame_collector.vhd" {SYNTHESIS SIMULATION}
@@ -96,18 +98,27 @@ add_file "../fm/src/src_components/Frame_Create_FSM.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/Manipulation_Manager.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/Packet_MemCnter.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/Packet_Memory.vhd" {SYNTHESIS SIMULATION}
+add_file "../fm/src/src_components/Packet_SlotAllocator.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/Packet_StartAddrMem.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/PacketControl_FSM.vhd" {SYNTHESIS SIMULATION}
+add_file "../fm/src/src_components/Packet_Handler.vhd" {SYNTHESIS SIMULATION}
+add_file "../fm/src/src_components/Phy_Fault.vhd" {SYNTHESIS SIMULATION}
+add_file "../fm/src/src_components/Bit_Error.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/ReadAddress_FSM.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/RXData_to_Byte.vhd" {SYNTHESIS SIMULATION}
+add_file "../fm/src/src_components/SafetyContextSelection.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/SafetyTaskSelection.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/SoC_Cnter.vhd" {SYNTHESIS SIMULATION}
+add_file "../fm/src/src_components/SocTime_Shift.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/StoreAddress_FSM.vhd" {SYNTHESIS SIMULATION}
-add_file "../fm/src/src_components/Task_Mem_Reset.vhd" {SYNTHESIS SIMULATION}
+add_file "../fm/src/src_components/Task_Mem_Burst.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_components/Task_Memory.vhd" {SYNTHESIS SIMULATION}
+add_file "../fm/src/src_components/Traffic_Shaper.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_Manipulator_top_level/Data_Buffer.vhd" {SYNTHESIS SIMULATION}
+add_file "../fm/src/src_Manipulator_top_level/Ext_Delay_Line.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_Manipulator_top_level/Packet_Buffer.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_Manipulator_top_level/Frame_Creator.vhd" {SYNTHESIS SIMULATION}
+add_file "../fm/src/src_Manipulator_top_level/Frame_Injector.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_Manipulator_top_level/Frame_Receiver.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_Manipulator_top_level/Memory_Interface.vhd" {SYNTHESIS SIMULATION}
 add_file "../fm/src/src_Manipulator_top_level/Process_Unit.vhd" {SYNTHESIS SIMULATION}
@@ -126,8 +137,8 @@ set_parameter_property gBytesOfTheFrameBuffer UNITS Bytes
 set_parameter_property gBytesOfTheFrameBuffer ALLOWED_RANGES 0:2147483647
 set_parameter_property gBytesOfTheFrameBuffer AFFECTS_GENERATION false
 set_parameter_property gBytesOfTheFrameBuffer HDL_PARAMETER true
-add_parameter gTaskBytesPerWord NATURAL 4
-set_parameter_property gTaskBytesPerWord DEFAULT_VALUE 4
+add_parameter gTaskBytesPerWord NATURAL 8
+set_parameter_property gTaskBytesPerWord DEFAULT_VALUE 8
 set_parameter_property gTaskBytesPerWord DISPLAY_NAME "Word width of Avalon slave for transfer of tasks"
 set_parameter_property gTaskBytesPerWord TYPE NATURAL
 set_parameter_property gTaskBytesPerWord ENABLED false
@@ -140,10 +151,20 @@ set_parameter_property gTaskAddr DEFAULT_VALUE 8
 set_parameter_property gTaskAddr DISPLAY_NAME "Address width of Avalon slave for transfer of tasks"
 set_parameter_property gTaskAddr TYPE NATURAL
 set_parameter_property gTaskAddr ENABLED false
+set_parameter_property gTaskAddr DERIVED true
 set_parameter_property gTaskAddr UNITS None
 set_parameter_property gTaskAddr ALLOWED_RANGES 0:2147483647
 set_parameter_property gTaskAddr AFFECTS_GENERATION false
 set_parameter_property gTaskAddr HDL_PARAMETER true
+add_parameter gTaskBurstWidth NATURAL 4
+set_parameter_property gTaskBurstWidth DEFAULT_VALUE 4
+set_parameter_property gTaskBurstWidth DISPLAY_NAME "Width of the burst count of Avalon slave for transfer of tasks"
+set_parameter_property gTaskBurstWidth TYPE NATURAL
+set_parameter_property gTaskBurstWidth ENABLED false
+set_parameter_property gTaskBurstWidth UNITS None
+set_parameter_property gTaskBurstWidth ALLOWED_RANGES 1:11
+set_parameter_property gTaskBurstWidth AFFECTS_GENERATION false
+set_parameter_property gTaskBurstWidth HDL_PARAMETER true
 add_parameter gTaskCount NATURAL 30
 set_parameter_property gTaskCount DEFAULT_VALUE 30
 set_parameter_property gTaskCount DISPLAY_NAME "Number of configurable tasks"
@@ -153,6 +174,15 @@ set_parameter_property gTaskCount UNITS None
 set_parameter_property gTaskCount ALLOWED_RANGES 0:2147483647
 set_parameter_property gTaskCount AFFECTS_GENERATION false
 set_parameter_property gTaskCount HDL_PARAMETER true
+add_parameter gTaskBanks NATURAL 1
+set_parameter_property gTaskBanks DEFAULT_VALUE 1
+set_parameter_property gTaskBanks DISPLAY_NAME "Number of task banks"
+set_parameter_property gTaskBanks DESCRIPTION  "=> Complete task tables, selected by object 0x3000/5 at the next SoC"
+set_parameter_property gTaskBanks TYPE NATURAL
+set_parameter_property gTaskBanks UNITS None
+set_parameter_property gTaskBanks ALLOWED_RANGES {1 2 4 8 16}
+set_parameter_property gTaskBanks AFFECTS_GENERATION false
+set_parameter_property gTaskBanks HDL_PARAMETER true
 add_parameter gControlBytesPerWord NATURAL 1
 set_parameter_property gControlBytesPerWord DEFAULT_VALUE 1
 set_parameter_property gControlBytesPerWord DISPLAY_NAME "Word width of Avalon slave for transfer of operations"
@@ -162,8 +192,8 @@ set_parameter_property gControlBytesPerWord UNITS Bytes
 set_parameter_property gControlBytesPerWord ALLOWED_RANGES 0:2147483647
 set_parameter_property gControlBytesPerWord AFFECTS_GENERATION false
 set_parameter_property gControlBytesPerWord HDL_PARAMETER true
-add_parameter gControlAddr NATURAL 1
-set_parameter_property gControlAddr DEFAULT_VALUE 1
+add_parameter gControlAddr NATURAL 5
+set_parameter_property gControlAddr DEFAULT_VALUE 5
 set_parameter_property gControlAddr DISPLAY_NAME "Address width of Avalon slave for transfer of operations"
 set_parameter_property gControlAddr TYPE NATURAL
 set_parameter_property gControlAddr ENABLED false
@@ -189,6 +219,100 @@ set_parameter_property gNumberOfPackets UNITS None
 set_parameter_property gNumberOfPackets ALLOWED_RANGES 0:2147483647
 set_parameter_property gNumberOfPackets AFFECTS_GENERATION false
 set_parameter_property gNumberOfPackets HDL_PARAMETER true
+add_parameter gSafetyPackets NATURAL 4
+set_parameter_property gSafetyPackets DEFAULT_VALUE 4
+set_parameter_property gSafetyPackets DISPLAY_NAME "Safety packets per frame"
+set_parameter_property gSafetyPackets DESCRIPTION  "=> Number of safety packets, which can be manipulated within one frame. The packet buffer is divided between them"
+set_parameter_property gSafetyPackets TYPE NATURAL
+set_parameter_property gSafetyPackets UNITS None
+set_parameter_property gSafetyPackets ALLOWED_RANGES 1:4
+set_parameter_property gSafetyPackets AFFECTS_GENERATION false
+set_parameter_property gSafetyPackets HDL_PARAMETER true
+add_parameter gSafetyContexts NATURAL 2
+set_parameter_property gSafetyContexts DEFAULT_VALUE 2
+set_parameter_property gSafetyContexts DISPLAY_NAME "Concurrent safety contexts"
+set_parameter_property gSafetyContexts DESCRIPTION  "=> Number of safety tasks with different frame filters, which can run at the same time. The packet buffer is divided between them"
+set_parameter_property gSafetyContexts TYPE NATURAL
+set_parameter_property gSafetyContexts UNITS None
+set_parameter_property gSafetyContexts ALLOWED_RANGES 1:4
+set_parameter_property gSafetyContexts AFFECTS_GENERATION false
+set_parameter_property gSafetyContexts HDL_PARAMETER true
+add_parameter gBytesOfTheInjectBuffer NATURAL 1024
+set_parameter_property gBytesOfTheInjectBuffer DEFAULT_VALUE 1024
+set_parameter_property gBytesOfTheInjectBuffer DISPLAY_NAME "Template memory size"
+set_parameter_property gBytesOfTheInjectBuffer DESCRIPTION  "=> Memory is used to store the template frames of the inject task (object 0x3006)"
+set_parameter_property gBytesOfTheInjectBuffer TYPE NATURAL
+set_parameter_property gBytesOfTheInjectBuffer ENABLED false
+set_parameter_property gBytesOfTheInjectBuffer UNITS Bytes
+set_parameter_property gBytesOfTheInjectBuffer ALLOWED_RANGES 0:2147483647
+set_parameter_property gBytesOfTheInjectBuffer AFFECTS_GENERATION false
+set_parameter_property gBytesOfTheInjectBuffer HDL_PARAMETER true
+add_parameter gInjectBytesPerWord NATURAL 4
+set_parameter_property gInjectBytesPerWord DEFAULT_VALUE 4
+set_parameter_property gInjectBytesPerWord DISPLAY_NAME "Word width of Avalon slave for transfer of template frames"
+set_parameter_property gInjectBytesPerWord TYPE NATURAL
+set_parameter_property gInjectBytesPerWord ENABLED false
+set_parameter_property gInjectBytesPerWord UNITS Bytes
+set_parameter_property gInjectBytesPerWord ALLOWED_RANGES 0:2147483647
+set_parameter_property gInjectBytesPerWord AFFECTS_GENERATION false
+set_parameter_property gInjectBytesPerWord HDL_PARAMETER true
+add_parameter gInjectAddr NATURAL 8
+set_parameter_property gInjectAddr DEFAULT_VALUE 8
+set_parameter_property gInjectAddr DISPLAY_NAME "Address width of Avalon slave for transfer of template frames"
+set_parameter_property gInjectAddr TYPE NATURAL
+set_parameter_property gInjectAddr ENABLED false
+set_parameter_property gInjectAddr UNITS None
+set_parameter_property gInjectAddr ALLOWED_RANGES 0:2147483647
+set_parameter_property gInjectAddr AFFECTS_GENERATION false
+set_parameter_property gInjectAddr HDL_PARAMETER true
+add_parameter gExtDelayLine NATURAL 0
+set_parameter_property gExtDelayLine DEFAULT_VALUE 0
+set_parameter_property gExtDelayLine DISPLAY_NAME "External delay line"
+set_parameter_property gExtDelayLine DESCRIPTION  "=> Frames of the delay type line are delayed in an external memory via the Avalon master m_delay_line"
+set_parameter_property gExtDelayLine TYPE NATURAL
+set_parameter_property gExtDelayLine UNITS None
+set_parameter_property gExtDelayLine ALLOWED_RANGES {"0:Disabled" "1:Enabled"}
+set_parameter_property gExtDelayLine AFFECTS_GENERATION false
+set_parameter_property gExtDelayLine HDL_PARAMETER true
+add_parameter gLineBase NATURAL 0
+set_parameter_property gLineBase DEFAULT_VALUE 0
+set_parameter_property gLineBase DISPLAY_NAME "Base address of the delay line"
+set_parameter_property gLineBase DESCRIPTION  "=> Address of the ring buffer in the external memory like the SDRAM"
+set_parameter_property gLineBase TYPE NATURAL
+set_parameter_property gLineBase UNITS Address
+set_parameter_property gLineBase ALLOWED_RANGES 0:2147483647
+set_parameter_property gLineBase AFFECTS_GENERATION false
+set_parameter_property gLineBase HDL_PARAMETER true
+add_parameter gLineAddr NATURAL 23
+set_parameter_property gLineAddr DEFAULT_VALUE 23
+set_parameter_property gLineAddr DISPLAY_NAME "Address width of the delay line"
+set_parameter_property gLineAddr DESCRIPTION  "=> Size of the ring buffer: 2^width Bytes"
+set_parameter_property gLineAddr TYPE NATURAL
+set_parameter_property gLineAddr UNITS Bits
+set_parameter_property gLineAddr ALLOWED_RANGES 10:30
+set_parameter_property gLineAddr AFFECTS_GENERATION false
+set_parameter_property gLineAddr HDL_PARAMETER true
+# |
+# +-----------------------------------
+
+# +-----------------------------------
+# | elaboration callback
+# |
+proc elaboration_callback {} {
+    # every bank adds a complete task table above the DPRAM selection
+    set bankBits 0
+    while {[expr {1 << $bankBits}] < [get_parameter_value gTaskBanks]} {
+        incr bankBits
+    }
+    set_parameter_value gTaskAddr [expr {8 + $bankBits}]
+    set_module_assignment embeddedsw.CMacro.TASK_BANKS [get_parameter_value gTaskBanks]
+    # tasks are stored in words of 64 bit, independent of the width of the slave
+    set_module_assignment embeddedsw.CMacro.TASK_WORD_SIZE 8
+
+    set_interface_property m_delay_line ENABLED [expr {[get_parameter_value gExtDelayLine] != 0}]
+    set_parameter_property gLineBase ENABLED [expr {[get_parameter_value gExtDelayLine] != 0}]
+    set_parameter_property gLineAddr ENABLED [expr {[get_parameter_value gExtDelayLine] != 0}]
+}
 # |
 # +-----------------------------------
 
@@ -222,6 +346,7 @@ add_interface_port stream_to_dut iRXDV export Input 1
 add_interface_port stream_to_dut iRXD export Input 2
 add_interface_port stream_to_dut oTXData export Output 2
 add_interface_port stream_to_dut oTXDV export Output 1
+add_interface_port stream_to_dut oTXER export Output 1
 # |
 # +-----------------------------------
 
@@ -272,9 +397,9 @@ set_interface_property st_slave_tasks burstcountUnits WORDS
 set_interface_property st_slave_tasks explicitAddressSpan 0
 set_interface_property st_slave_tasks holdTime 0
 set_interface_property st_slave_tasks linewrapBursts false
-set_interface_property st_slave_tasks maximumPendingReadTransactions 0
+set_interface_property st_slave_tasks maximumPendingReadTransactions 1
 set_interface_property st_slave_tasks readLatency 0
-set_interface_property st_slave_tasks readWaitTime 1
+set_interface_property st_slave_tasks readWaitTime 0
 set_interface_property st_slave_tasks setupTime 0
 set_interface_property st_slave_tasks timingUnits Cycles
 set_interface_property st_slave_tasks writeWaitTime 0
@@ -287,6 +412,9 @@ add_interface_port st_slave_tasks iSt_byteenable byteenable Input gtaskbytesperw
 add_interface_port st_slave_tasks iSt_address address Input gtaskaddr
 add_interface_port st_slave_tasks iSt_writedata writedata Input gtaskbytesperword*8
 add_interface_port st_slave_tasks iSt_write write Input 1
+add_interface_port st_slave_tasks iSt_burstcount burstcount Input gtaskburstwidth
+add_interface_port st_slave_tasks oSt_waitrequest waitrequest Output 1
+add_interface_port st_slave_tasks oSt_readdatavalid readdatavalid Output 1
 # |
 # +-----------------------------------
 
@@ -320,3 +448,67 @@ add_interface_port sc_slave_control iSc_write write Input 1
 add_interface_port sc_slave_control iSc_byteenable byteenable Input gcontrolbytesperword
 # |
 # +-----------------------------------
+
+# +-----------------------------------
+# | connection point si_slave_inject
+# |
+add_interface si_slave_inject avalon end
+set_interface_property si_slave_inject addressUnits WORDS
+set_interface_property si_slave_inject associatedClock clock_mem_slave
+set_interface_property si_slave_inject associatedReset reset
+set_interface_property si_slave_inject bitsPerSymbol 8
+set_interface_property si_slave_inject burstOnBurstBoundariesOnly false
+set_interface_property si_slave_inject burstcountUnits WORDS
+set_interface_property si_slave_inject explicitAddressSpan 0
+set_interface_property si_slave_inject holdTime 0
+set_interface_property si_slave_inject linewrapBursts false
+set_interface_property si_slave_inject maximumPendingReadTransactions 0
+set_interface_property si_slave_inject readLatency 0
+set_interface_property si_slave_inject readWaitTime 1
+set_interface_property si_slave_inject setupTime 0
+set_interface_property si_slave_inject timingUnits Cycles
+set_interface_property si_slave_inject writeWaitTime 0
+
+set_interface_property si_slave_inject ENABLED true
+
+add_interface_port si_slave_inject iSi_read read Input 1
+add_interface_port si_slave_inject oSi_readdata readdata Output ginjectbytesperword*8
+add_interface_port si_slave_inject iSi_byteenable byteenable Input ginjectbytesperword
+add_interface_port si_slave_inject iSi_address address Input ginjectaddr
+add_interface_port si_slave_inject iSi_writedata writedata Input ginjectbytesperword*8
+add_interface_port si_slave_inject iSi_write write Input 1
+# |
+# +-----------------------------------
+
+# +-----------------------------------
+# | connection point m_delay_line
+# |
+add_interface m_delay_line avalon start
+set_interface_property m_delay_line addressUnits SYMBOLS
+set_interface_property m_delay_line associatedClock clock_50
+set_interface_property m_delay_line associatedReset reset
+set_interface_property m_delay_line bitsPerSymbol 8
+set_interface_property m_delay_line burstOnBurstBoundariesOnly false
+set_interface_property m_delay_line burstcountUnits WORDS
+set_interface_property m_delay_line doStreamReads false
+set_interface_property m_delay_line doStreamWrites false
+set_interface_property m_delay_line holdTime 0
+set_interface_property m_delay_line linewrapBursts false
+set_interface_property m_delay_line maximumPendingReadTransactions 0
+set_interface_property m_delay_line readLatency 0
+set_interface_property m_delay_line readWaitTime 1
+set_interface_property m_delay_line setupTime 0
+set_interface_property m_delay_line timingUnits Cycles
+set_interface_property m_delay_line writeWaitTime 0
+
+set_interface_property m_delay_line ENABLED true
+
+add_interface_port m_delay_line oM_address address Output 32
+add_interface_port m_delay_line oM_write write Output 1
+add_interface_port m_delay_line oM_writedata writedata Output 32
+add_interface_port m_delay_line oM_read read Output 1
+add_interface_port m_delay_line iM_readdata readdata Input 32
+add_interface_port m_delay_line iM_waitrequest waitrequest Input 1
+add_interface_port m_delay_line iM_readdatavalid readdatavalid Input 1
+# |
+# +-----------------------------------
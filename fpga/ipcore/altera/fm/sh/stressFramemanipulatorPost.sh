@@ -0,0 +1,85 @@
+#!/bin/bash
+# Post script of the line-rate stress test: creates the benchmark report
+# $ stressFramemanipulatorPost.sh [SETTINGS_FILE]
+
+# Needed parameters of the setting file:
+# GEN_FILE_RESULT:  One line per run of tbFramemanipulatorStress.vhd
+# REPORT_FILE:      Generated report
+# STRESS_BURST:     Frames per cycle
+# STRESS_NO_PACKET_OV: Settings, which mustn't set the packet buffer overflow at any run
+
+# Format of the result file:
+# Setting | frame size | IPG | burst | frame buffer | packet buffer | packets | frames in | frames out | status register
+
+# A run passes, when all frames passed the FM and no error flag of the status
+# register is set. The report lists the smallest passing IPG of every task
+# setting, generic configuration and frame size with its frame rate.
+# The script fails, when a setting of STRESS_NO_PACKET_OV overflows the packet
+# buffer. This is independent of the IPG.
+
+#Load settings file
+SETTINGS_FILE=$1
+source $SETTINGS_FILE
+
+#Time of one Byte at 100 MBit/s in ns
+BYTE_TIME=80
+
+#Error flags of the status register (cSt.erDataOv to cSt.erTaskConf)
+ERROR_MASK=0xF0
+
+#Overflow of the packet buffer (cSt.erPacketOv)
+PACKET_OV_MASK=0x40
+
+if ! test -s $GEN_FILE_RESULT
+then
+    echo -e "\n\e[31mERROR: Result file $GEN_FILE_RESULT is empty\e[0m"
+    exit 1
+
+fi
+
+declare -A BEST
+FAILED=0
+
+while read SETTING SIZE IPG BURST BUFFER PACKBUFFER PACKETS IN OUT STATUS
+do
+    KEY="$SETTING $BUFFER $PACKBUFFER $PACKETS $SIZE"
+
+    if [[ " $STRESS_NO_PACKET_OV " == *" $SETTING "* ]] && [ $(( STATUS & PACKET_OV_MASK )) -ne 0 ]; then
+        echo -e "\e[31mERROR: $SETTING overflows the packet buffer of $PACKBUFFER Byte and $PACKETS packets at size $SIZE IPG $IPG\e[0m"
+        FAILED=1
+    fi
+
+    if [ $IN -eq $OUT ] && [ $(( STATUS & ERROR_MASK )) -eq 0 ]; then
+        if [ -z "${BEST[$KEY]}" ] || [ "${BEST[$KEY]}" = "none" ] || [ ${BEST[$KEY]} -gt $IPG ]; then
+            BEST[$KEY]=$IPG
+        fi
+    else
+        printf "Failed: %s frame buffer %d size %d IPG %d: %d of %d frames, status 0x%02X\n" \
+            $SETTING $BUFFER $SIZE $IPG $OUT $IN $STATUS
+        [ -n "${BEST[$KEY]}" ] || BEST[$KEY]=none
+    fi
+done < $GEN_FILE_RESULT
+
+{
+    echo "Line-rate stress test with bursts of $STRESS_BURST frames"
+    echo
+    printf "%-40s %7s %7s %7s %6s %6s %12s\n" "Setting" "FrameBf" "PackBf" "Packets" "Size" "IPG" "Frames/s"
+
+    for KEY in $(printf '%s\n' "${!BEST[@]}" | tr ' ' ':' | sort -t: -k1,1 -k2n -k5n)
+    do
+        read SETTING BUFFER PACKBUFFER PACKETS SIZE <<< "${KEY//:/ }"
+        IPG=${BEST[${KEY//:/ }]}
+
+        if [ "$IPG" = "none" ]; then
+            RATE="-"
+        else
+            RATE=$(( 1000000000 / ((SIZE + 8 + IPG) * BYTE_TIME) ))
+        fi
+
+        printf "%-40s %7d %7d %7d %6d %6s %12s\n" $SETTING $BUFFER $PACKBUFFER $PACKETS $SIZE $IPG $RATE
+    done
+} > $REPORT_FILE
+
+cat $REPORT_FILE
+
+exit $FAILED
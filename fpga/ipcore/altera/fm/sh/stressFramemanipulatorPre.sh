@@ -0,0 +1,25 @@
+#!/bin/bash
+# Pre script of the line-rate stress test: generates the binary stimulation files
+# $ stressFramemanipulatorPre.sh [SETTINGS_FILE]
+
+# Needed parameters of the setting file:
+# STIM_TOOL:        tools/fm-stimbin.sh
+# STIM_DIR:         Directory of the stimulation files
+# STRESS_*:         Sweep of frame size, inter-packet gap, burst and cycles
+# GEN_FILE_RESULT:  Result file, which is cleared
+
+#Load settings file
+SETTINGS_FILE=$1
+source $SETTINGS_FILE
+
+rm -f $GEN_FILE_RESULT
+
+for SIZE in $STRESS_SIZES
+do
+    for IPG in $STRESS_IPGS
+    do
+        $STIM_TOOL stress $STIM_DIR/stress${SIZE}_${IPG}.bin $SIZE $IPG $STRESS_BURST $STRESS_CYCLES || exit 1
+    done
+done
+
+exit 0
@@ -21,17 +21,49 @@
 # Test safetyIncData2Start41Size11PResCycle3:               Safety Incorrect-Data of 2 packets. The packet starts at Byte 41 and are 11 Bytes long. Start at PRes of Cycle 3
 # Test safetyDelay2Start41Size11PResCycle3:                 Safety Delay-task of 2 packets. The packet starts at Byte 41 and are 11 Bytes long. Start at PRes of Cycle 3
 # Test safetyMasq2Start41Size11PResCycle3:                  Safety Masquerade-task of 2 packets. The packet starts at Byte 41 and are 11 Bytes long. Start at PRes of Cycle 3
+# Test safetyDelay3Start54Size4PResCycle2:                  Safety Delay-task of 3 packets, which occupy three slots of the packet memory. The packet starts at Byte 54 and is 4 Bytes long. Start at PRes of Cycle 2
+# Test safetyLoss2Start41Size11Start54Size4PResCycle3:      Safety Loss of 2 packets with two safety packets per frame. Packets start at Byte 41 (11 Bytes) and Byte 54 (4 Bytes). Start at PRes of Cycle 3
+# Test safetyLoss2Start41Size11Ctx2Start54Size4PResCycle3:  Safety Loss of 2 packets with two safety contexts. Packets start at Byte 41 (11 Bytes) and Byte 54 (4 Bytes). Start at PRes of Cycle 3
+# Test ipg80PResCycle2:                                     Stretch the IPG before the PRes of cycle 2 to 80 Byte (6400 ns)
+# Test inject3PResCycle2:                                   Inject 3 copies of an ASnd template with 60 Byte after the PRes of cycle 2
+# Test duplicate2PResCycle2:                                Send the PRes of cycle 2 twice again directly behind the original
+# Test reorder1SocCycle4:                                   Send the SoC of cycle 4 behind the following PRes
+# Test shape25MbitPResCycle2:                               Shape the PRes frames from cycle 2 on to 25 Mbit/s with a bucket of 100 Byte
+# Test dropWin29PResCycle3:                                 Drop of the PRes in cycle 3 and 4 with a filter window on Byte 29, which only matches the PRes of cycle 3
+# Test forwardVlanDropPResCycle2:                           Forward all EtherTypes, parse VLAN tags and drop the tagged PRes of cycle 2 (tbFramemanipulatorForward_stim.txt)
+# Test dropSocCycle2Task4:                                  Drop of the second SoC by task 4 behind a gap of empty tasks
+# Test line20UsPResAllCycles:                               External delay line with a latency of 20 µs from the first PRes on
+# Test lineFull400UsSocAllCycles:                           Overflow of a 1 kByte delay line with a latency of 400 µs and long ASnd frames (tbFramemanipulatorLine_stim.txt)
+# Test bankSwitchDropSocCycle1:                             Switch from the empty bank 0 to bank 1 at the first SoC, which is dropped by the task of bank 1
+# Test chainDropSocCycle3:                                  Task chain: a Trigger-task arms a Drop-task of all SoCs after the second PRes, which drops only the SoC of cycle 3 (once)
+# Test startTriggerDropSocCycle3:                           Start of the test with the PRes of cycle 2, the Drop-task of cycle 1 drops the SoC of cycle 3
+# Test phyPre3SfdDDPResCycle2:                              PHY fault of the PRes in cycle 2 with a preamble of 3 Bytes and the SFD 0xDD
+# Test berBurst8PResAllCycles:                              Bit errors of the PRes in all cycles with a BER of 1.9e-3 and bursts of 8 dibits
+# Test socOffset1000Drift500AllCycles:                      Shift of the NetTime and the RelativeTime of the SoC in all cycles by 1000 ns plus a drift of 500 ns
+# Test dropPResSlot2ASndInvited5:                           Drop of the PRes in multiplexed slot 2 and of the ASnd behind the SoA, which invited node 5
 
 #Constants
 #22th byte of recorded frame is message type (Header+Preamble)
 MESSAGE_TYPE=22
 
+#EtherType or TPID of a VLAN tag in front of the message type
+ETHER_TYPE=20
+
+#Size of a VLAN tag
+VLAN_TAG=4
+
 #First Byte of safety payload: Byte number 5 (+4)
 SAFETY_PAYLOAD=4
 
 #Start of the SoC timestamp
 TIMESTAMP_START=28
 
+#Flags of the SoC with the flag MC in bit 7
+SOC_FLAGS=26
+
+#RequestedServiceTarget of the SoA
+SOA_TARGET=29
+
 # Function load sources:
 function loadTestSources()
 {
@@ -2197,6 +2229,1262 @@ function safetyMasq
 }
 
 
+# Function safetyDelay3Start54Size4PResCycle2:    Safety Delay-task of 3 packets, which occupy three slots of the packet memory. The packet starts at Byte 54 and is 4 Bytes long. Start at PRes of Cycle 2
+function safetyDelay3Start54Size4PResCycle2
+{
+    FRAME_TYPE="PRes"
+    FRAME_CYCLE=2
+    PACK_NR=3
+    PACK_START=54
+    PACK_SIZE=4
+    echo -e "\n\e[36mTest $TEST_NR: Check the allocation and release of the packet slots with delaying of three packets (Start 54, Size 4) beginning with PRes of cycle two\e[0m"
+    safetyDelay
+}
+
+# Function safetyLoss2Start41Size11Start54Size4PResCycle3:   Safety Loss of 2 packets with two safety packets per frame. Packets start at Byte 41 (11 Bytes) and Byte 54 (4 Bytes). Start at PRes of Cycle 3
+function safetyLoss2Start41Size11Start54Size4PResCycle3
+{
+    FRAME_TYPE="PRes"
+    FRAME_CYCLE=3
+    PACK_NR=2
+    PACK_START=41
+    PACK_SIZE=11
+    PACK2_START=54
+    PACK2_SIZE=4
+    echo -e "\n\e[36mTest $TEST_NR: Check safety packet Loss-task of two packets per frame (Start 41, Size 11 and Start 54, Size 4) beginning with PRes of cycle three\e[0m"
+    safetyLossMulti
+}
+
+# Function safetyLoss2Start41Size11Ctx2Start54Size4PResCycle3:   Safety Loss of 2 packets with two safety contexts. Packets start at Byte 41 (11 Bytes) and Byte 54 (4 Bytes). Start at PRes of Cycle 3
+function safetyLoss2Start41Size11Ctx2Start54Size4PResCycle3
+{
+    FRAME_TYPE="PRes"
+    FRAME_CYCLE=3
+    PACK_NR=2
+    PACK_START=41
+    PACK_SIZE=11
+    PACK2_START=54
+    PACK2_SIZE=4
+    echo -e "\n\e[36mTest $TEST_NR: Check two concurrent safety Loss-tasks with different frame filters (Start 41, Size 11 and Start 54, Size 4) beginning with PRes of cycle three\e[0m"
+    safetyLossMulti
+}
+
+# Function safetyLossMulti:
+#Predefined variables: FRAME_TYPE for frame messageType; FRAME_CYCLE for cycle; PACK_NR number of manipulated packets;
+#PACK_START and PACK2_START start Byte of the packets; PACK_SIZE and PACK2_SIZE size of the packets
+function safetyLossMulti
+{
+    #Add Preamble to start (8) (-1 for start at entry 0)
+    PACK_START=$(($PACK_START+8-1))
+    PACK2_START=$(($PACK2_START+8-1))
+
+    #Check if the number of ingoing and outgoing frames is the same:
+    allFramesPass
+
+
+    #Check frame data
+
+    #Testcycle
+    CYCLE=0
+
+    for ((NR=1 ; NR<=$NR_OF_FRAME; NR++))
+    do
+
+        #Load MessageType of stimulated frame and count up cycle at SoC
+        MESSAGE_TYPE_STIM=$(eval "echo \${FRAME"$NR[$MESSAGE_TYPE]})
+
+        case $MESSAGE_TYPE_STIM in
+        01)
+            TYPE_STIM="SoC"
+            CYCLE=$(($CYCLE+1))
+            ;;
+        04)
+            TYPE_STIM="PRes"
+            ;;
+        *)
+            TYPE_STIM="other frame"
+            ;;
+        esac
+
+        #Output detected stimulation frame
+        echo "Stimulated frame $NR is a $TYPE_STIM of test cycle $CYCLE"
+
+        #Load frames as array:
+        FRAME_STIM_A=($(eval "echo \${FRAME"$NR[*]}))
+        FRAME_FM_A=($(eval "echo \${FM_FRAME"$NR[*]}))
+
+        #End of frame without CRC
+        FRAME_END=$((${#FRAME_STIM_A[*]}-4))
+
+        #Number of manipulated packet
+        MAN_PACK_NR=$(($CYCLE-$FRAME_CYCLE+1))
+
+        #Both packets of a manipulated frame are removed
+        if [ $TYPE_STIM == $FRAME_TYPE -a  $CYCLE -ge $FRAME_CYCLE -a $MAN_PACK_NR -le $PACK_NR ]; then
+            echo -e "\e[33mBoth safety packets of this frame should be removed \e[0m"
+
+            for ((BYTE=$PACK_START; BYTE<$PACK_START+$PACK_SIZE; BYTE++))
+            do
+                FRAME_STIM_A[$BYTE]=00
+            done
+
+            for ((BYTE=$PACK2_START; BYTE<$PACK2_START+$PACK2_SIZE; BYTE++))
+            do
+                FRAME_STIM_A[$BYTE]=00
+            done
+
+        fi
+
+        #Compare frames without CRC
+        if [ "${FRAME_STIM_A[*]:0:$FRAME_END}" == "${FRAME_FM_A[*]:0:$FRAME_END}" ]; then
+            echo "Outgoing frame $NR is correct"
+
+        else
+            echo -e "\n\e[31mERROR: Mismatch of outgoing frame $NR\e[0m"
+            exit 1
+
+        fi
+
+    done
+
+    #Check Jitter
+    jitterCheck
+}
+
+# Function ipg80PResCycle2:    Stretch the IPG before the PRes of cycle 2 to 80 Byte (6400 ns)
+function ipg80PResCycle2
+{
+    IPG_M_TYPE="PRes"
+    IPG_CYCLE=2
+    IPG_TIME=6400
+    echo -e "\n\e[36mTest $TEST_NR: Check IPG-task with a gap of 80 Byte before the PRes of cycle two\e[0m"
+    ipgFrame
+}
+
+# Function ipgFrame:
+# Check of the gap before the manipulated frame and of the delay of the other frames via delay of first SoC as reverence
+#Predefined variables: IPG_M_TYPE for messageType; IPG_CYCLE for cycle; IPG_TIME for the configured gap in ns
+function ipgFrame
+{
+    #Check if the number of ingoing and outgoing frames is the same:
+    allFramesPass
+
+    #Check if Frames were distorted:
+    echo "Check the data of the $NR_OF_FRAME frames:"
+
+    for ((NR=1; NR<=$NR_OF_FRAME; NR++))
+    do
+        FRAME_STIM=$(eval "echo \${FRAME"$NR[*]})
+        FRAME_FM=$(eval "echo \${FM_FRAME"$NR[*]})
+
+        if [ "${FRAME_STIM[*]}" != "${FRAME_FM[*]}" ]; then
+            echo -e "\n\e[31mERROR: Mismatch of frame $NR\e[0m"
+            exit 1
+
+        else
+            echo "Frame $NR is the same"
+
+        fi
+
+    done
+
+    #Check the gap of the manipulated frame and the delay of the others:
+    echo "Check the gap of the manipulated frame:"
+
+    #Reference is the delay of the first frame
+    REF_DELAY=${FRAME_DELAY1[*]}
+    echo "The first frame has a delay of $REF_DELAY"
+
+    CYCLE=0
+    for ((NR=1; NR<=$NR_OF_FRAME; NR++))
+    do
+
+        #Load MessageType of stimulated frame and count up cycle at SoC
+        MESSAGE_TYPE_STIM=$(eval "echo \${FRAME"$NR[$MESSAGE_TYPE]})
+
+        case $MESSAGE_TYPE_STIM in
+        01)
+            TYPE_STIM="SoC"
+            CYCLE=$(($CYCLE+1))
+            ;;
+        04)
+            TYPE_STIM="PRes"
+            ;;
+        *)
+            TYPE_STIM="other frame"
+            ;;
+        esac
+
+        #Output detected stimulation frame
+        echo "Stimulated frame $NR is a $TYPE_STIM of test cycle $CYCLE"
+
+        if [ $TYPE_STIM == $IPG_M_TYPE -a $CYCLE == $IPG_CYCLE ]; then
+
+            FRAME_GAP=$(eval "echo \${FRAME_GAP"$NR[*]})
+            echo -e "\e[33mThis is the manipulated frame with a gap of $FRAME_GAP\e[0m"
+
+            #Remove the "ns"
+            SIZE=$((${#FRAME_GAP}-3))
+            FRAME_GAP=${FRAME_GAP:0:$SIZE}
+
+            #The gap may be up to one Byte (80 ns) longer, as it is counted in whole Bytes
+            if (( $FRAME_GAP >= $IPG_TIME && $FRAME_GAP < $IPG_TIME+80 )); then
+                echo -e "\e[33mThe occurred gap of $FRAME_GAP ns is correct\e[0m"
+
+            else
+                echo -e "\n\e[31mERROR: Occurred gap is $FRAME_GAP ns, not $IPG_TIME ns\e[0m"
+                exit 1
+
+            fi
+
+        else
+
+            FRAME_DELAY=$(eval "echo \${FRAME_DELAY"$NR[*]})
+
+            if [ "$FRAME_DELAY" != "$REF_DELAY" ]; then
+                echo -e "\n\e[31mERROR: Frame $NR has a delay of $FRAME_DELAY instead of $REF_DELAY\e[0m"
+                exit 1
+
+            fi
+
+        fi
+
+    done
+
+    echo -e "\e[33mThe other frames kept their delay\e[0m"
+}
+
+# Function inject3PResCycle2:    Inject 3 copies of an ASnd template with 60 Byte after the PRes of cycle 2
+function inject3PResCycle2
+{
+    INJECT_M_TYPE="PRes"
+    INJECT_CYCLE=2
+    INJECT_COUNT=3
+
+    #ASnd of node 17 with 42 Bytes of zero padding
+    INJECT_TEMPLATE="01 11 1E 00 00 04 00 60 65 00 00 11 88 AB 06 FF 11 01"
+    for ((NR=1; NR<=42; NR++))
+    do
+        INJECT_TEMPLATE="$INJECT_TEMPLATE 00"
+    done
+
+    echo -e "\n\e[36mTest $TEST_NR: Check Inject-task with three copies of a template after the PRes of cycle two\e[0m"
+    injectFrame
+}
+
+# Function injectFrame:
+# The copies may be sent between the stimulated frames, which keep their order and data
+#Predefined variables: INJECT_M_TYPE for messageType; INJECT_CYCLE for cycle; INJECT_COUNT for number of copies; INJECT_TEMPLATE for the Bytes of the template
+function injectFrame
+{
+    #Copies get a new preamble
+    FRAME_COPY="55 55 55 55 55 55 55 D5 $INJECT_TEMPLATE"
+
+    #Check the number of outgoing frames
+    if (($NR_OF_FRAME+$INJECT_COUNT != $NR_OF_FM_FRAME)); then
+        echo -e "\n\e[31mERROR: $NR_OF_FM_FRAME frames passed the FM instead of $NR_OF_FRAME frames and $INJECT_COUNT copies\e[0m"
+        exit 1
+
+    fi
+
+    #Testcycle
+    CYCLE=0
+
+    #Copies are allowed after the selected frame
+    INJECT_ACTIVE=0
+    COPIES=0
+
+    for ((NR=1, NR_FM=1; NR_FM<=$NR_OF_FM_FRAME; NR_FM++))
+    do
+
+        FRAME_FM_A=($(eval "echo \${FM_FRAME"$NR_FM[*]}))
+
+        #End of frame without CRC
+        FRAME_END=$((${#FRAME_FM_A[*]}-4))
+
+        FRAME_STIM=$(eval "echo \${FRAME"$NR[*]})
+        FRAME_FM=${FRAME_FM_A[*]}
+
+        if [ $NR -le $NR_OF_FRAME ] && [ "${FRAME_STIM[*]}" == "${FRAME_FM[*]}" ]; then
+
+            #Load MessageType of stimulated frame and count up cycle at SoC
+            MESSAGE_TYPE_STIM=$(eval "echo \${FRAME"$NR[$MESSAGE_TYPE]})
+
+            case $MESSAGE_TYPE_STIM in
+            01)
+                TYPE_STIM="SoC"
+                CYCLE=$(($CYCLE+1))
+                ;;
+            04)
+                TYPE_STIM="PRes"
+                ;;
+            *)
+                TYPE_STIM="other frame"
+                ;;
+            esac
+
+            echo "Outgoing frame $NR_FM is the stimulated $TYPE_STIM $NR of test cycle $CYCLE"
+
+            if [ $TYPE_STIM == $INJECT_M_TYPE -a $CYCLE == $INJECT_CYCLE ]; then
+                echo -e "\e[33mThis frame starts the injection\e[0m"
+                INJECT_ACTIVE=1
+
+            fi
+
+            NR=$(($NR+1))
+
+        elif [ "${FRAME_FM_A[*]:0:$FRAME_END}" == "$FRAME_COPY" ]; then
+
+            if [ $INJECT_ACTIVE == 0 ]; then
+                echo -e "\n\e[31mERROR: Outgoing frame $NR_FM is a copy before the selected frame\e[0m"
+                exit 1
+
+            fi
+
+            COPIES=$(($COPIES+1))
+            echo -e "\e[33mOutgoing frame $NR_FM is copy $COPIES of the template\e[0m"
+
+        else
+            echo -e "\n\e[31mERROR: Mismatch of outgoing frame $NR_FM\e[0m"
+            exit 1
+
+        fi
+
+    done
+
+    if (($COPIES != $INJECT_COUNT)); then
+        echo -e "\n\e[31mERROR: $COPIES copies were injected instead of $INJECT_COUNT\e[0m"
+        exit 1
+
+    fi
+
+    echo -e "\e[33mAll copies were injected and the other frames passed unchanged\e[0m"
+}
+
+# Function duplicate2PResCycle2:    Send the PRes of cycle 2 twice again directly behind the original
+function duplicate2PResCycle2
+{
+    ORDER_M_TYPE="PRes"
+    ORDER_CYCLE=2
+    DUP_COPIES=2
+    REORDER_WINDOW=0
+    echo -e "\n\e[36mTest $TEST_NR: Check Duplicate-task with two copies of the PRes of cycle two\e[0m"
+    frameOrder
+}
+
+# Function reorder1SocCycle4:    Send the SoC of cycle 4 behind the following PRes
+function reorder1SocCycle4
+{
+    ORDER_M_TYPE="SoC"
+    ORDER_CYCLE=4
+    DUP_COPIES=0
+    REORDER_WINDOW=1
+    echo -e "\n\e[36mTest $TEST_NR: Check Reorder-task with the SoC of cycle four behind one following frame\e[0m"
+    frameOrder
+}
+
+# Function frameOrder:
+# Check of the unchanged frames in the order of the Duplicate- or Reorder-task
+#Predefined variables: ORDER_M_TYPE for messageType; ORDER_CYCLE for cycle; DUP_COPIES for the number of copies;
+#REORDER_WINDOW for the number of frames, which pass the held frame
+function frameOrder
+{
+    #Expected order of the stimulated frames
+    ORDER=()
+    HELD=0
+
+    #Testcycle
+    CYCLE=0
+
+    for ((NR=1; NR<=$NR_OF_FRAME; NR++))
+    do
+
+        #Load MessageType of stimulated frame and count up cycle at SoC
+        MESSAGE_TYPE_STIM=$(eval "echo \${FRAME"$NR[$MESSAGE_TYPE]})
+
+        case $MESSAGE_TYPE_STIM in
+        01)
+            TYPE_STIM="SoC"
+            CYCLE=$(($CYCLE+1))
+
+            #Held frame never passes the next SoC
+            if [ $HELD != 0 ]; then
+                ORDER+=($HELD)
+                HELD=0
+            fi
+            ;;
+        04)
+            TYPE_STIM="PRes"
+            ;;
+        *)
+            TYPE_STIM="other frame"
+            ;;
+        esac
+
+        echo "Stimulated frame $NR is a $TYPE_STIM of test cycle $CYCLE"
+
+        if [ $TYPE_STIM == $ORDER_M_TYPE -a $CYCLE == $ORDER_CYCLE ]; then
+
+            if [ $REORDER_WINDOW != 0 ]; then
+                echo -e "\e[33mThis frame is held for $REORDER_WINDOW frames\e[0m"
+                HELD=$NR
+                PASSED=0
+
+            else
+                echo -e "\e[33mThis frame is sent $(($DUP_COPIES+1)) times\e[0m"
+                for ((COPY=0; COPY<=$DUP_COPIES; COPY++))
+                do
+                    ORDER+=($NR)
+                done
+
+            fi
+
+        else
+            ORDER+=($NR)
+
+            if [ $HELD != 0 ]; then
+                PASSED=$(($PASSED+1))
+
+                if [ $PASSED == $REORDER_WINDOW ]; then
+                    ORDER+=($HELD)
+                    HELD=0
+                fi
+            fi
+
+        fi
+
+    done
+
+    #Held frame is sent at the end of the stimulation
+    if [ $HELD != 0 ]; then
+        ORDER+=($HELD)
+    fi
+
+    #Check the number of outgoing frames
+    if ((${#ORDER[*]} != $NR_OF_FM_FRAME)); then
+        echo -e "\n\e[31mERROR: $NR_OF_FM_FRAME frames passed the FM instead of ${#ORDER[*]}\e[0m"
+        exit 1
+
+    fi
+
+    #Compare the outgoing frames with the stimulated frames of the expected order
+    for ((NR_FM=1; NR_FM<=$NR_OF_FM_FRAME; NR_FM++))
+    do
+        NR=${ORDER[$(($NR_FM-1))]}
+
+        FRAME_STIM=$(eval "echo \${FRAME"$NR[*]})
+        FRAME_FM=$(eval "echo \${FM_FRAME"$NR_FM[*]})
+
+        if [ "${FRAME_STIM[*]}" == "${FRAME_FM[*]}" ]; then
+            echo "Outgoing frame $NR_FM is the stimulated frame $NR"
+
+        else
+            echo -e "\n\e[31mERROR: Outgoing frame $NR_FM isn't the stimulated frame $NR\e[0m"
+            exit 1
+
+        fi
+
+    done
+
+    echo -e "\e[33mAll frames were sent in the expected order\e[0m"
+}
+
+# Function shape25MbitPResCycle2:    Shape the PRes frames from cycle 2 on to 25 Mbit/s with a bucket of 100 Byte
+function shape25MbitPResCycle2
+{
+    SHAPE_M_TYPE="PRes"
+    SHAPE_CYCLE=2
+    SHAPE_WAIT_CYCLE=4
+    echo -e "\n\e[36mTest $TEST_NR: Check Shape-task with 25 Mbit/s for the PRes frames beginning with cycle two\e[0m"
+    shapeFrame
+}
+
+# Function shapeFrame:
+# The bucket passes the frames of the cycles before SHAPE_WAIT_CYCLE with the delay of the first frame.
+# The PRes frames need more than the rate, so the delay of the following frames grows from frame to frame.
+#Predefined variables: SHAPE_M_TYPE for messageType; SHAPE_CYCLE for cycle of the task; SHAPE_WAIT_CYCLE for the first cycle with a waiting frame
+function shapeFrame
+{
+    #Check if the number of ingoing and outgoing frames is the same:
+    allFramesPass
+
+    #Check if Frames were distorted:
+    echo "Check the data of the $NR_OF_FRAME frames:"
+
+    for ((NR=1; NR<=$NR_OF_FRAME; NR++))
+    do
+        FRAME_STIM=$(eval "echo \${FRAME"$NR[*]})
+        FRAME_FM=$(eval "echo \${FM_FRAME"$NR[*]})
+
+        if [ "${FRAME_STIM[*]}" != "${FRAME_FM[*]}" ]; then
+            echo -e "\n\e[31mERROR: Mismatch of frame $NR\e[0m"
+            exit 1
+
+        else
+            echo "Frame $NR is the same"
+
+        fi
+
+    done
+
+    #Reference is the delay of the first frame
+    REF_DELAY=${FRAME_DELAY1[*]}
+    SIZE=$((${#REF_DELAY}-3))
+    REF_DELAY=${REF_DELAY:0:$SIZE}
+    echo "The first frame has a delay of $REF_DELAY ns"
+
+    LAST_DELAY=$REF_DELAY
+
+    CYCLE=0
+    for ((NR=1; NR<=$NR_OF_FRAME; NR++))
+    do
+
+        #Load MessageType of stimulated frame and count up cycle at SoC
+        MESSAGE_TYPE_STIM=$(eval "echo \${FRAME"$NR[$MESSAGE_TYPE]})
+
+        case $MESSAGE_TYPE_STIM in
+        01)
+            TYPE_STIM="SoC"
+            CYCLE=$(($CYCLE+1))
+            ;;
+        04)
+            TYPE_STIM="PRes"
+            ;;
+        *)
+            TYPE_STIM="other frame"
+            ;;
+        esac
+
+        FRAME_DELAY=$(eval "echo \${FRAME_DELAY"$NR[*]})
+        echo "Stimulated frame $NR is a $TYPE_STIM of test cycle $CYCLE with a delay of $FRAME_DELAY"
+
+        #Remove the "ns"
+        SIZE=$((${#FRAME_DELAY}-3))
+        FRAME_DELAY=${FRAME_DELAY:0:$SIZE}
+
+        if [ $CYCLE -lt $SHAPE_WAIT_CYCLE ]; then
+
+            #Frames within the bucket
+            if (( $FRAME_DELAY != $REF_DELAY )); then
+                echo -e "\n\e[31mERROR: The frame has to pass without waiting\e[0m"
+                exit 1
+
+            fi
+
+        elif [ $TYPE_STIM == $SHAPE_M_TYPE ]; then
+
+            #Waiting frames
+            if (( $FRAME_DELAY <= $LAST_DELAY )); then
+                echo -e "\n\e[31mERROR: The frame has to wait longer than the last shaped frame\e[0m"
+                exit 1
+
+            fi
+
+            echo -e "\e[33mThe frame waited for the bucket\e[0m"
+            LAST_DELAY=$FRAME_DELAY
+
+        fi
+
+    done
+}
+
+# Function dropWin29PResCycle3:    Drop of the PRes in cycle 3 and 4 with a filter window on Byte 29, which only matches the PRes of cycle 3
+function dropWin29PResCycle3
+{
+    DROP_M_TYPE="PRes"
+    DROP_CYCLE=3
+    echo -e "\n\e[36mTest $TEST_NR: Check filter windows with Drop-tasks of the PRes in cycle three and four, which only match in cycle three\e[0m"
+    dropManipulation
+}
+
+# Function forwardVlanDropPResCycle2:    Forward all EtherTypes, parse VLAN tags and drop the tagged PRes of cycle 2
+function forwardVlanDropPResCycle2
+{
+    DROP_M_TYPE="PRes"
+    DROP_CYCLE=2
+    echo -e "\n\e[36mTest $TEST_NR: Check forwarding of all EtherTypes and VLAN tags with a Drop-task of the tagged PRes of cycle two\e[0m"
+    dropForward
+}
+
+# Function dropForward:
+# Drop manipulation with frames of other EtherTypes and VLAN tags. The tagged SoC is counted as well.
+#Predefined variables: DROP_M_TYPE for type; DROP_CYCLE for cycle
+function dropForward
+{
+    #Check if the one frame is missing:
+    if (($NR_OF_FRAME != $(($NR_OF_FM_FRAME+1)) )); then
+        echo -e "\n\e[31mERROR: $NR_OF_FM_FRAME frames passed the FM instead of $(($NR_OF_FRAME-1))\e[0m"
+        exit 1
+
+    fi
+
+    #Testcycle
+    CYCLE=0
+    for ((NR=1, NR_FM=1 ; NR<=$NR_OF_FRAME; NR++))
+    do
+
+        #Load frame as array
+        FRAME_STIM_A=($(eval "echo \${FRAME"$NR[*]}))
+
+        #Load EtherType and skip the VLAN tag
+        ETHER_TYPE_STIM="${FRAME_STIM_A[*]:$ETHER_TYPE:2}"
+        OFFSET=0
+        TAG=""
+
+        if [ "$ETHER_TYPE_STIM" == "81 00" ]; then
+            OFFSET=$VLAN_TAG
+            TAG=" with VLAN tag"
+            ETHER_TYPE_STIM="${FRAME_STIM_A[*]:$(($ETHER_TYPE+$OFFSET)):2}"
+        fi
+
+        #Load MessageType of stimulated POWERLINK frame and count up cycle at SoC
+        MESSAGE_TYPE_STIM=${FRAME_STIM_A[$(($MESSAGE_TYPE+$OFFSET))]}
+
+        if [ "$ETHER_TYPE_STIM" != "88 AB" ]; then
+            TYPE_STIM="frame of EtherType $ETHER_TYPE_STIM"
+
+        else
+            case $MESSAGE_TYPE_STIM in
+            01)
+                TYPE_STIM="SoC"
+                CYCLE=$(($CYCLE+1))
+                ;;
+            04)
+                TYPE_STIM="PRes"
+                ;;
+            *)
+                TYPE_STIM="other frame"
+                ;;
+            esac
+
+        fi
+
+        echo "Stimulated frame $NR is a $TYPE_STIM$TAG of test cycle $CYCLE"
+
+        if [ "$TYPE_STIM" == $DROP_M_TYPE -a $CYCLE == $DROP_CYCLE ]; then
+            echo -e "\e[33mThis frame should be dropped\e[0m"
+
+        else
+            FRAME_STIM=$(eval "echo \${FRAME"$NR[*]})
+            FRAME_FM=$(eval "echo \${FM_FRAME"$NR_FM[*]})
+
+            if [ "${FRAME_STIM[*]}" == "${FRAME_FM[*]}" ]; then
+                echo "Outgoing frame $NR_FM is the same"
+
+            else
+                echo -e "\n\e[31mERROR: Mismatch of outgoing frame $NR_FM\e[0m"
+                exit 1
+
+            fi
+
+            NR_FM=$(($NR_FM+1))
+
+        fi
+
+    done
+
+    echo -e "\e[33mAll other frames were forwarded unchanged\e[0m"
+}
+
+# Function dropSocCycle2Task4:    Drop of the second SoC by task 4 behind a gap of empty tasks
+function dropSocCycle2Task4
+{
+    DROP_M_TYPE="SoC"
+    DROP_CYCLE=2
+    echo -e "\n\e[36mTest $TEST_NR: Check the valid bits of the tasks with a Drop-task of the second SoC behind three empty tasks\e[0m"
+    dropManipulation
+}
+
+# Function line20UsPResAllCycles:    External delay line with a latency of 20 µs from the first PRes on
+function line20UsPResAllCycles
+{
+    LINE_LATENCY=20000
+    echo -e "\n\e[36mTest $TEST_NR: Check the external delay line with a latency of 20 µs from the first PRes on\e[0m"
+    lineDelay
+}
+
+# Function lineDelay:
+# The frames in front of the first PRes pass the line directly with the reference delay, the PRes and all following
+# frames are delayed by the latency without jitter. The order of the frames is kept and no error flag is set.
+#Predefined variables: LINE_LATENCY for the latency of the line in ns
+function lineDelay
+{
+    #Tolerance of the delay for the access of the line in ns
+    LINE_TOLERANCE=1000
+
+    #Check if the number of ingoing and outgoing frames is the same:
+    allFramesPass
+
+    #Check if Frames were distorted or reordered:
+    echo "Check the data of the $NR_OF_FRAME frames:"
+
+    for ((NR=1; NR<=$NR_OF_FRAME; NR++))
+    do
+        FRAME_STIM=$(eval "echo \${FRAME"$NR[*]})
+        FRAME_FM=$(eval "echo \${FM_FRAME"$NR[*]})
+
+        if [ "${FRAME_STIM[*]}" != "${FRAME_FM[*]}" ]; then
+            echo -e "\n\e[31mERROR: Mismatch of frame $NR\e[0m"
+            exit 1
+
+        else
+            echo "Frame $NR is the same"
+
+        fi
+
+    done
+
+    #Check the delay of the line:
+    echo "Check the delay of the line:"
+
+    LINE_ACTIVE=0
+    LINE_DELAY=
+
+    for ((NR=1; NR<=$NR_OF_FRAME; NR++))
+    do
+        MESSAGE_TYPE_STIM=$(eval "echo \${FRAME"$NR[$MESSAGE_TYPE]})
+        FRAME_DELAY=$(eval "echo \${FRAME_DELAY"$NR[*]})
+
+        #Remove the "ns"
+        SIZE=$((${#FRAME_DELAY}-3))
+        FRAME_DELAY=${FRAME_DELAY:0:$SIZE}
+
+        if [ $MESSAGE_TYPE_STIM == "04" ]; then
+            LINE_ACTIVE=1
+        fi
+
+        if (($LINE_ACTIVE == 0)); then
+            REF_DELAY=$FRAME_DELAY
+            echo "Frame $NR passes the line directly with a delay of $REF_DELAY ns"
+            continue
+
+        fi
+
+        if [ -z "$REF_DELAY" ]; then
+            echo -e "\n\e[31mERROR: No frame in front of the first PRes as reference\e[0m"
+            exit 1
+
+        fi
+
+        DELAY_DIV=$(($FRAME_DELAY-$REF_DELAY))
+        echo "Frame $NR is delayed by $DELAY_DIV ns"
+
+        if (($DELAY_DIV < $LINE_LATENCY || $DELAY_DIV > $LINE_LATENCY+$LINE_TOLERANCE)); then
+            echo -e "\n\e[31mERROR: Delay of $DELAY_DIV ns doesn't match the latency of $LINE_LATENCY ns\e[0m"
+            exit 1
+
+        fi
+
+        if [ "$LINE_DELAY" ] && (($DELAY_DIV != $LINE_DELAY)); then
+            echo -e "\n\e[31mERROR: Jitter at frame $NR\e[0m"
+            exit 1
+
+        fi
+
+        LINE_DELAY=$DELAY_DIV
+
+    done
+
+    if [ -z "$LINE_DELAY" ]; then
+        echo -e "\n\e[31mERROR: No frame entered the line\e[0m"
+        exit 1
+
+    fi
+
+    echo -e "\e[33mThe frames were delayed by $LINE_DELAY ns without jitter\e[0m"
+
+    #Check the error flags of the status register
+    if (($FM_STATUS & 0xF0)); then
+        echo -e "\n\e[31mERROR: Status register $FM_STATUS reports an error\e[0m"
+        exit 1
+
+    fi
+
+    echo -e "\e[33mNo error flag is set\e[0m"
+}
+
+# Function lineFull400UsSocAllCycles:    Overflow of a 1 kByte delay line with a latency of 400 µs and long ASnd frames
+function lineFull400UsSocAllCycles
+{
+    LINE_LATENCY=400000
+    echo -e "\n\e[36mTest $TEST_NR: Check the drop of frames, when the external delay line is full\e[0m"
+    lineOverflow
+}
+
+# Function lineOverflow:
+# Frames are dropped, when the ring buffer and the prefetch fifo of the line are full. The remaining frames
+# leave the line in their order after the latency and erFrameOv is set. Frames of other EtherTypes don't pass the FM.
+#Predefined variables: LINE_LATENCY for the latency of the line in ns
+function lineOverflow
+{
+    NR_OF_DROP=0
+
+    for ((NR=1, NR_FM=1 ; NR<=$NR_OF_FRAME; NR++))
+    do
+        FRAME_STIM_A=($(eval "echo \${FRAME"$NR[*]}))
+
+        if [ "${FRAME_STIM_A[$ETHER_TYPE]}${FRAME_STIM_A[$(($ETHER_TYPE+1))]}" != "88AB" ]; then
+            echo "Frame $NR isn't a POWERLINK frame"
+            continue
+
+        fi
+
+        FRAME_FM_A=($(eval "echo \${FM_FRAME"$NR_FM[*]}))
+
+        if [ "${FRAME_STIM_A[*]}" == "${FRAME_FM_A[*]}" ]; then
+            echo "Frame $NR passed as outgoing frame $NR_FM"
+            NR_FM=$(($NR_FM+1))
+
+        else
+            echo "Frame $NR was dropped"
+            NR_OF_DROP=$(($NR_OF_DROP+1))
+
+        fi
+
+    done
+
+    #All outgoing frames have to match the stimulated frames in their order
+    if (($NR_FM-1 != $NR_OF_FM_FRAME)); then
+        echo -e "\n\e[31mERROR: Outgoing frame $NR_FM is distorted or out of order\e[0m"
+        exit 1
+
+    fi
+
+    if (($NR_OF_FM_FRAME == 0)); then
+        echo -e "\n\e[31mERROR: No frame left the line\e[0m"
+        exit 1
+
+    fi
+
+    if (($NR_OF_DROP == 0)); then
+        echo -e "\n\e[31mERROR: No frame was dropped\e[0m"
+        exit 1
+
+    fi
+
+    echo -e "\e[33m$NR_OF_FM_FRAME frames passed in their order, $NR_OF_DROP frames were dropped\e[0m"
+
+    #The first frame leaves the line after the latency
+    FRAME_DELAY=${FRAME_DELAY1:0:$((${#FRAME_DELAY1}-3))}
+
+    if (($FRAME_DELAY < $LINE_LATENCY)); then
+        echo -e "\n\e[31mERROR: The first frame left the line after $FRAME_DELAY ns instead of $LINE_LATENCY ns\e[0m"
+        exit 1
+
+    fi
+
+    #Check erFrameOv of the status register
+    if ((($FM_STATUS & 0x20) == 0)); then
+        echo -e "\n\e[31mERROR: Status register $FM_STATUS doesn't report the overflow with erFrameOv\e[0m"
+        exit 1
+
+    fi
+
+    echo -e "\e[33mThe overflow is reported with erFrameOv\e[0m"
+}
+
+# Function bankSwitchDropSocCycle1:    Switch from the empty bank 0 to bank 1 at the first SoC, which is dropped by the task of bank 1
+function bankSwitchDropSocCycle1
+{
+    DROP_M_TYPE="SoC"
+    DROP_CYCLE=1
+    echo -e "\n\e[36mTest $TEST_NR: Check the switch to the selected task bank at the SoC with the Drop-task of bank 1\e[0m"
+    dropManipulation
+}
+
+# Function chainDropSocCycle3:    Task chain: a Trigger-task arms a Drop-task of all SoCs after the second PRes, which drops only the SoC of cycle 3 (once)
+function chainDropSocCycle3
+{
+    DROP_M_TYPE="SoC"
+    DROP_CYCLE=3
+    echo -e "\n\e[36mTest $TEST_NR: Check the task chain with a Trigger-task, which arms a Drop-task of the next SoC after two PRes\e[0m"
+    dropManipulation
+}
+
+# Function startTriggerDropSocCycle3:    Start of the test with the PRes of cycle 2, the Drop-task of cycle 1 drops the SoC of cycle 3
+function startTriggerDropSocCycle3
+{
+    DROP_M_TYPE="SoC"
+    DROP_CYCLE=3
+    echo -e "\n\e[36mTest $TEST_NR: Check the start of the test with a Start-task on the PRes of cycle two and a Drop-task of the first SoC\e[0m"
+    dropManipulation
+}
+
+# Function phyPre3SfdDDPResCycle2:    PHY fault of the PRes in cycle 2 with a preamble of 3 Bytes and the SFD 0xDD
+function phyPre3SfdDDPResCycle2
+{
+    PHY_M_TYPE="PRes"
+    PHY_CYCLE=2
+    PHY_PREAMBLE=3
+    PHY_SFD="DD"
+    echo -e "\n\e[36mTest $TEST_NR: Check PHY-task with a short preamble and a wrong SFD of the PRes in cycle two\e[0m"
+    phyFault
+}
+
+# Function phyFault:
+#Predefined variables: PHY_M_TYPE for frame messageType; PHY_CYCLE for cycle; PHY_PREAMBLE for number of preamble Bytes; PHY_SFD for the SFD
+function phyFault
+{
+    #Check if the number of ingoing and outgoing frames is the same:
+    allFramesPass
+
+    #Create preamble of the manipulated frame
+    FRAME_PRE=
+    for ((NR=1; NR<=$PHY_PREAMBLE; NR++))
+    do
+        FRAME_PRE="$FRAME_PRE 55"
+    done
+
+    FRAME_PRE="$FRAME_PRE $PHY_SFD"
+
+    #remove first space
+    FRAME_PRE=${FRAME_PRE:1}
+
+    #Testcycle
+    CYCLE=0
+
+    for ((NR=1 ; NR<=$NR_OF_FRAME; NR++))
+    do
+
+        #Load MessageType of stimulated frame and count up cycle at SoC
+        MESSAGE_TYPE_STIM=$(eval "echo \${FRAME"$NR[$MESSAGE_TYPE]})
+
+        case $MESSAGE_TYPE_STIM in
+        01)
+            TYPE_STIM="SoC"
+            CYCLE=$(($CYCLE+1))
+            ;;
+        04)
+            TYPE_STIM="PRes"
+            ;;
+        *)
+            TYPE_STIM="other frame"
+            ;;
+        esac
+
+        #Output detected stimulated frame
+        echo "Stimulated frame $NR is a $TYPE_STIM of test cycle $CYCLE"
+
+        #Load frames as array:
+        FRAME_STIM_A=($(eval "echo \${FRAME"$NR[*]}))
+        FRAME_FM=$(eval "echo \${FM_FRAME"$NR[*]})
+
+        #Replace the preamble of 8 Bytes of the manipulated frame
+        if [ $TYPE_STIM == $PHY_M_TYPE -a $CYCLE == $PHY_CYCLE ]; then
+            echo -e "\e[33mThis frame should start with $FRAME_PRE\e[0m"
+            FRAME_STIM="$FRAME_PRE ${FRAME_STIM_A[*]:8}"
+
+        else
+            FRAME_STIM="${FRAME_STIM_A[*]}"
+
+        fi
+
+        if [ "$FRAME_STIM" == "$FRAME_FM" ]; then
+            echo "Outgoing frame $NR is correct"
+
+        else
+            echo -e "\n\e[31mERROR: Mismatch of outgoing frame $NR\e[0m"
+            exit 1
+
+        fi
+
+    done
+}
+
+# Function berBurst8PResAllCycles:    Bit errors of the PRes in all cycles with a BER of 1.9e-3 and bursts of 8 dibits
+function berBurst8PResAllCycles
+{
+    BER_M_TYPE="PRes"
+    echo -e "\n\e[36mTest $TEST_NR: Check BER-task of all PRes with a BER of 1.9e-3\e[0m"
+    bitError
+}
+
+# Function bitError:
+# The errors are random, so the PRes of the six cycles have to carry at least one flipped bit in total
+#Predefined variables: BER_M_TYPE for frame messageType
+function bitError
+{
+    #Check if the number of ingoing and outgoing frames is the same:
+    allFramesPass
+
+    #Number of flipped bits
+    FLIPPED=0
+
+    for ((NR=1 ; NR<=$NR_OF_FRAME; NR++))
+    do
+
+        #Load MessageType of stimulated frame
+        MESSAGE_TYPE_STIM=$(eval "echo \${FRAME"$NR[$MESSAGE_TYPE]})
+
+        case $MESSAGE_TYPE_STIM in
+        01)
+            TYPE_STIM="SoC"
+            ;;
+        04)
+            TYPE_STIM="PRes"
+            ;;
+        *)
+            TYPE_STIM="other frame"
+            ;;
+        esac
+
+        #Load frames as array:
+        FRAME_STIM_A=($(eval "echo \${FRAME"$NR[*]}))
+        FRAME_FM_A=($(eval "echo \${FM_FRAME"$NR[*]}))
+
+        if [ $TYPE_STIM == $BER_M_TYPE ]; then
+
+            if ((${#FRAME_STIM_A[*]} != ${#FRAME_FM_A[*]})); then
+                echo -e "\n\e[31mERROR: Size of outgoing frame $NR changed\e[0m"
+                exit 1
+
+            fi
+
+            #Count the flipped bits
+            FRAME_FLIPPED=0
+
+            for ((BYTE=0; BYTE<${#FRAME_STIM_A[*]}; BYTE++))
+            do
+                DIFF=$((0x${FRAME_STIM_A[$BYTE]} ^ 0x${FRAME_FM_A[$BYTE]}))
+
+                while (($DIFF != 0))
+                do
+                    FRAME_FLIPPED=$(($FRAME_FLIPPED+($DIFF & 1)))
+                    DIFF=$(($DIFF >> 1))
+                done
+            done
+
+            echo "Outgoing $TYPE_STIM $NR has $FRAME_FLIPPED flipped bits"
+            FLIPPED=$(($FLIPPED+$FRAME_FLIPPED))
+
+        elif [ "${FRAME_STIM_A[*]}" == "${FRAME_FM_A[*]}" ]; then
+            echo "Outgoing frame $NR is the same"
+
+        else
+            echo -e "\n\e[31mERROR: Mismatch of outgoing frame $NR without bit errors\e[0m"
+            exit 1
+
+        fi
+
+    done
+
+    if (($FLIPPED == 0)); then
+        echo -e "\n\e[31mERROR: No bit was flipped\e[0m"
+        exit 1
+
+    fi
+
+    echo -e "\e[33m$FLIPPED bits were flipped\e[0m"
+}
+
+# Function socOffset1000Drift500AllCycles:    Shift of the NetTime and the RelativeTime of the SoC in all cycles by 1000 ns plus a drift of 500 ns
+function socOffset1000Drift500AllCycles
+{
+    SOC_OFFSET=1000
+    SOC_DRIFT=500
+    echo -e "\n\e[36mTest $TEST_NR: Check SoC-time-task of all SoC with an offset of 1000 ns and a drift of 500 ns\e[0m"
+    socTimeShift
+}
+
+# Function socTimeShift:
+# The n-th SoC is shifted by the offset plus n-1 times the drift, the NetTime in ns and the RelativeTime in us, truncated.
+# NetTime and RelativeTime of the outgoing SoC are compared on their own, the CRC is regenerated and not compared.
+#Predefined variables: SOC_OFFSET for the offset in ns; SOC_DRIFT for the drift per SoC in ns
+function socTimeShift
+{
+    #Check if the number of ingoing and outgoing frames is the same:
+    allFramesPass
+
+    #Number of the current SoC
+    SOC_NR=0
+
+    for ((NR=1 ; NR<=$NR_OF_FRAME; NR++))
+    do
+
+        #Load MessageType of stimulated frame
+        MESSAGE_TYPE_STIM=$(eval "echo \${FRAME"$NR[$MESSAGE_TYPE]})
+
+        #Load frames as array:
+        FRAME_STIM_A=($(eval "echo \${FRAME"$NR[*]}))
+        FRAME_FM_A=($(eval "echo \${FM_FRAME"$NR[*]}))
+
+        if [ $MESSAGE_TYPE_STIM == "01" ]; then
+
+            SOC_NR=$(($SOC_NR+1))
+            SHIFT=$(($SOC_OFFSET+($SOC_NR-1)*$SOC_DRIFT))
+
+            if ((${#FRAME_STIM_A[*]} != ${#FRAME_FM_A[*]})); then
+                echo -e "\n\e[31mERROR: Size of outgoing SoC $NR changed\e[0m"
+                exit 1
+
+            fi
+
+            #Seconds, nanoseconds and RelativeTime of the ingoing and outgoing SoC, little endian
+            SEC=0
+            NS=0
+            REL=0
+            FM_SEC=0
+            FM_NS=0
+            FM_REL=0
+            for ((BYTE=3; BYTE>=0; BYTE--))
+            do
+                SEC=$((($SEC<<8)+0x${FRAME_STIM_A[$(($TIMESTAMP_START+$BYTE))]}))
+                NS=$((($NS<<8)+0x${FRAME_STIM_A[$(($TIMESTAMP_START+4+$BYTE))]}))
+                FM_SEC=$((($FM_SEC<<8)+0x${FRAME_FM_A[$(($TIMESTAMP_START+$BYTE))]}))
+                FM_NS=$((($FM_NS<<8)+0x${FRAME_FM_A[$(($TIMESTAMP_START+4+$BYTE))]}))
+            done
+            for ((BYTE=7; BYTE>=0; BYTE--))
+            do
+                REL=$((($REL<<8)+0x${FRAME_STIM_A[$(($TIMESTAMP_START+8+$BYTE))]}))
+                FM_REL=$((($FM_REL<<8)+0x${FRAME_FM_A[$(($TIMESTAMP_START+8+$BYTE))]}))
+            done
+
+            #NetTime with the carry of the nanoseconds
+            NS=$(($NS+$SHIFT))
+            if (($NS >= 1000000000)); then
+                NS=$(($NS-1000000000))
+                SEC=$(($SEC+1))
+            fi
+
+            if (($FM_SEC != $SEC || $FM_NS != $NS)); then
+                echo -e "\n\e[31mERROR: NetTime of outgoing SoC $NR is $FM_SEC s $FM_NS ns instead of $SEC s $NS ns\e[0m"
+                exit 1
+
+            fi
+
+            #RelativeTime with the same shift in us
+            REL=$(($REL+$SHIFT/1000))
+
+            if (($FM_REL != $REL)); then
+                echo -e "\n\e[31mERROR: RelativeTime of outgoing SoC $NR is $FM_REL us instead of $REL us\e[0m"
+                exit 1
+
+            fi
+
+            #Rest of the SoC without both times and the CRC
+            TIME_END=$(($TIMESTAMP_START+16))
+            REST_SIZE=$((${#FRAME_STIM_A[*]}-4-$TIME_END))
+
+            if [ "${FRAME_STIM_A[*]:0:$TIMESTAMP_START} ${FRAME_STIM_A[*]:$TIME_END:$REST_SIZE}" != \
+                 "${FRAME_FM_A[*]:0:$TIMESTAMP_START} ${FRAME_FM_A[*]:$TIME_END:$REST_SIZE}" ]; then
+                echo -e "\n\e[31mERROR: Outgoing SoC $NR changed outside of its NetTime and RelativeTime\e[0m"
+                exit 1
+
+            fi
+
+            echo "Outgoing SoC $NR is shifted by $SHIFT ns: NetTime $FM_SEC s $FM_NS ns, RelativeTime $FM_REL us"
+
+        elif [ "${FRAME_STIM_A[*]}" == "${FRAME_FM_A[*]}" ]; then
+            echo "Outgoing frame $NR is the same"
+
+        else
+            echo -e "\n\e[31mERROR: Mismatch of outgoing frame $NR without a SoC\e[0m"
+            exit 1
+
+        fi
+
+    done
+}
+
+# Function dropPResSlot2ASndInvited5:    Drop of the PRes in multiplexed slot 2 and of the ASnd behind the SoA, which invited node 5
+function dropPResSlot2ASndInvited5
+{
+    PHASE_SLOT=2
+    PHASE_INVITED=5
+    echo -e "\n\e[36mTest $TEST_NR: Check Drop-task of the PRes in multiplexed slot 2 and of the ASnd of the asynchronous phase of node 5\e[0m"
+    dropCyclePhase
+}
+
+# Function dropCyclePhase:
+# Follows the cycle of the stimulated frames like the Cycle_Tracker: the multiplexed slot restarts at 1 with the toggle of MC,
+# the invitation of the SoA applies to the frames behind it
+#Predefined variables: PHASE_SLOT for the slot of the dropped PRes; PHASE_INVITED for the invited node of the dropped ASnd
+function dropCyclePhase
+{
+    MC=
+    SLOT=0
+    INVITED=0
+    NR_OF_DROP=0
+
+    for ((NR=1, NR_FM=1 ; NR<=$NR_OF_FRAME; NR++))
+    do
+
+        #Load MessageType of stimulated frame
+        MESSAGE_TYPE_STIM=$(eval "echo \${FRAME"$NR[$MESSAGE_TYPE]})
+
+        #Load frames as array:
+        FRAME_STIM_A=($(eval "echo \${FRAME"$NR[*]}))
+
+        DROP=0
+
+        case $MESSAGE_TYPE_STIM in
+        01)
+            TYPE_STIM="SoC"
+            SOC_MC=$((0x${FRAME_STIM_A[$SOC_FLAGS]} >> 7))
+
+            if [ "$MC" ] && (($SOC_MC != $MC)); then
+                SLOT=1
+            elif (($SLOT != 0)); then
+                SLOT=$(($SLOT+1))
+            fi
+
+            MC=$SOC_MC
+            INVITED=0
+            ;;
+        04)
+            TYPE_STIM="PRes"
+            (($SLOT == $PHASE_SLOT)) && DROP=1
+            ;;
+        05)
+            TYPE_STIM="SoA"
+            INVITED=$((0x${FRAME_STIM_A[$SOA_TARGET]}))
+            ;;
+        06)
+            TYPE_STIM="ASnd"
+            (($INVITED == $PHASE_INVITED)) && DROP=1
+            ;;
+        *)
+            TYPE_STIM="other frame"
+            ;;
+        esac
+
+        if (($DROP == 1)); then
+            echo "$TYPE_STIM $NR of slot $SLOT and invited node $INVITED was dropped"
+            NR_OF_DROP=$(($NR_OF_DROP+1))
+            continue
+
+        fi
+
+        FRAME_FM_A=($(eval "echo \${FM_FRAME"$NR_FM[*]}))
+
+        if [ "${FRAME_STIM_A[*]}" == "${FRAME_FM_A[*]}" ]; then
+            echo "Outgoing $TYPE_STIM $NR is the same"
+
+        else
+            echo -e "\n\e[31mERROR: Mismatch of outgoing $TYPE_STIM $NR of slot $SLOT and invited node $INVITED\e[0m"
+            exit 1
+
+        fi
+
+        NR_FM=$(($NR_FM+1))
+
+    done
+
+    if (($NR_OF_DROP == 0)); then
+        echo -e "\n\e[31mERROR: The stimulated frames don't contain a frame of the slot or invitation\e[0m"
+        exit 1
+
+    fi
+
+    if (($NR_OF_FM_FRAME != $NR_OF_FRAME-$NR_OF_DROP)); then
+        echo -e "\n\e[31mERROR: $NR_OF_FM_FRAME frames passed instead of $(($NR_OF_FRAME-$NR_OF_DROP))\e[0m"
+        exit 1
+
+    fi
+
+    echo -e "\e[33mMissing of $NR_OF_DROP frames confirmed\e[0m"
+}
+
 #Load settings file
 SETTINGS_FILE=$1
 source $SETTINGS_FILE
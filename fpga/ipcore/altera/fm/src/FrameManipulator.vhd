@@ -59,13 +59,23 @@ use libcommon.global.all;
 --! This is the entity is the top-module of the Framemanipulator
 entity FrameManipulator is
     generic(gBytesOfTheFrameBuffer  : natural := 1600;  --! Frame buffer size
-            gTaskBytesPerWord       : natural := 4;     --! Word width of Avalon slave for transfer of tasks
+            gTaskBytesPerWord       : natural := 8;     --! Word width of Avalon slave for transfer of tasks (4, 8 or 16)
             gTaskAddr               : natural := 8;     --! Address width of Avalon slave for transfer of tasks
+            gTaskBurstWidth         : natural := 4;     --! Width of the burst count of the Avalon slave for transfer of tasks
             gTaskCount              : natural := 32;    --! Number of configurable tasks
+            gTaskBanks              : natural := 1;     --! Number of banks of complete task tables (1, 2, 4, 8 or 16), gTaskAddr grows by their address bits
             gControlBytesPerWord    : natural := 1;     --! Word width of Avalon slave for transfer of operations
-            gControlAddr            : natural := 1;     --! Address width of Avalon slave for transfer of operations
+            gControlAddr            : natural := 5;     --! Address width of Avalon slave for transfer of operations
             gBytesOfThePackBuffer   : natural := 16000; --! Packet buffer size
-            gNumberOfPackets        : natural := 500    --! Maximal number of safety packets
+            gNumberOfPackets        : natural := 500;   --! Maximal number of safety packets
+            gSafetyPackets          : natural := 4;     --! Number of safety packets per frame
+            gSafetyContexts         : natural := 2;     --! Number of concurrent safety contexts
+            gBytesOfTheInjectBuffer : natural := 1024;  --! Template memory size of the inject task
+            gInjectBytesPerWord     : natural := 4;     --! Word width of Avalon slave for transfer of template frames
+            gInjectAddr             : natural := 8;     --! Address width of Avalon slave for transfer of template frames
+            gExtDelayLine           : natural := 0;     --! External delay line for the delay type "line" (0 or 1)
+            gLineBase               : natural := 0;     --! Base address of the delay line in the external memory
+            gLineAddr               : natural := 23     --! Address width of the delay line in Byte
             );
     port(
         iClk50          : in std_logic;                     --! clock
@@ -81,6 +91,9 @@ entity FrameManipulator is
         iSt_read        : in std_logic;                                                         --! Task avalon slave read enable
         oSt_readdata    : out std_logic_vector(gTaskBytesPerWord*cByteLength-1 downto 0);       --! Task avalon slave read data
         iSt_byteenable  : in std_logic_vector(gTaskBytesPerWord-1 downto 0);                    --! Task avalon slave byte enable
+        iSt_burstcount  : in std_logic_vector(gTaskBurstWidth-1 downto 0) := (0 => '1', others => '0');  --! Task avalon slave burst count
+        oSt_waitrequest : out std_logic;                                                        --! Task avalon slave wait request
+        oSt_readdatavalid : out std_logic;                                                      --! Task avalon slave read data valid
 
         --Avalon Slave Contol Memory
         iSc_address     : in std_logic_vector(gControlAddr-1 downto 0);                         --! FM-control avalon slave address
@@ -90,8 +103,26 @@ entity FrameManipulator is
         oSc_readdata    : out std_logic_vector(gControlBytesPerWord*cByteLength-1 downto 0);    --! FM-control avalon slave read data
         iSc_byteenable  : in std_logic_vector(gControlBytesPerWord-1 downto 0);                 --! FM-control avalon slave byte enable
 
+        --Avalon Slave Template Memory
+        iSi_address     : in std_logic_vector(gInjectAddr-1 downto 0);                          --! Template avalon slave address
+        iSi_writedata   : in std_logic_vector(gInjectBytesPerWord*cByteLength-1 downto 0);      --! Template avalon slave data write
+        iSi_write       : in std_logic;                                                         --! Template avalon slave write enable
+        iSi_read        : in std_logic;                                                         --! Template avalon slave read enable
+        oSi_readdata    : out std_logic_vector(gInjectBytesPerWord*cByteLength-1 downto 0);     --! Template avalon slave read data
+        iSi_byteenable  : in std_logic_vector(gInjectBytesPerWord-1 downto 0);                  --! Template avalon slave byte enable
+
+        --Avalon Master Delay Line
+        oM_address      : out std_logic_vector(31 downto 0);                                    --! Delay line avalon master address
+        oM_write        : out std_logic;                                                        --! Delay line avalon master write enable
+        oM_writedata    : out std_logic_vector(31 downto 0);                                    --! Delay line avalon master data write
+        oM_read         : out std_logic;                                                        --! Delay line avalon master read enable
+        iM_readdata     : in std_logic_vector(31 downto 0) := (others => '0');                  --! Delay line avalon master read data
+        iM_waitrequest  : in std_logic := '0';                                                  --! Delay line avalon master wait request
+        iM_readdatavalid : in std_logic := '0';                                                 --! Delay line avalon master read data valid
+
         oTXData         : out std_logic_vector(1 downto 0); --! RMII data out
         oTXDV           : out std_logic;                    --! RMII data valid
+        oTXER           : out std_logic;                    --! TX error for PHYs with TX_ER
 
         oLED            : out std_logic_vector(1 downto 0)  --! LED out
      );
@@ -110,7 +141,7 @@ architecture two_seg_arch of FrameManipulator is
     constant cSlaveTaskWordWidth    : natural := gTaskBytesPerWord*cByteLength;                 --! Word width of the avalon bus of the task transfer
     constant cSlaveTaskAddr         : natural := gTaskAddr;                                     --! Address width of the avalon slave for the task transfer
 
-    constant cTaskWordWidth         : natural := cSlaveTaskWordWidth*2;                         --! doubled memory width for the internal process
+    constant cTaskWordWidth         : natural := 8*cByteLength;                                 --! memory width of the internal process
 
     constant cTaskAddrWidth         : natural := LogDualis(gTaskCount);                         --! Address width of the task memory
 
@@ -121,18 +152,32 @@ architecture two_seg_arch of FrameManipulator is
     constant cPacketAddrWidth       : natural := LogDualis(gBytesOfThePackBuffer);              --! Address width of the packet buffer
     constant cAddrMemoryWidth       : natural := LogDualis(gNumberOfPackets);                   --! Address width of the packet address-Fifo
 
+    constant cInjectAddrWidth       : natural := LogDualis(gBytesOfTheInjectBuffer);            --! Address width of the template memory
+
 
     --signals memory interface
     signal error_addrBuffOv     : std_logic;                                        --! Error: Address buffer overflow
     signal error_frameBuffOv    : std_logic;                                        --! Error: Frame buffer overflow
+    signal error_lineOv         : std_logic;                                        --! Error: Delay line overflow
+    signal error_frameOv        : std_logic;                                        --! Error: Overflow of the frame buffer or the delay line
     signal error_packetBuffOv   : std_logic;                                        --! Error: Packet buffer overflow
     signal error_taskConf       : std_logic;                                        --! Error: Wrong configuration
+    signal packetOccupancy      : std_logic_vector(cAddrMemoryWidth downto 0);      --! Number of used slots of the packet buffer
+    signal packetOccupancy_ctrl : std_logic_vector(2*gControlBytesPerWord*cByteLength-1 downto 0); --! Occupancy for the control register
+    signal bitErrors            : std_logic_vector(4*cByteLength-1 downto 0);                       --! Number of bits flipped by the BER task
+    signal bitErrors_ctrl       : std_logic_vector(4*gControlBytesPerWord*cByteLength-1 downto 0);  --! Bit errors for the control register
 
     signal rdTaskAddr           : std_logic_vector(cTaskAddrWidth-1 downto 0);      --! Read address of task memory
+    signal taskBank             : std_logic_vector(cByteLength-1 downto 0);         --! Bank of the read tasks
+    signal bankSelect           : std_logic_vector(cByteLength-1 downto 0);         --! Selected bank of the control register
 
     signal taskSettingData      : std_logic_vector(2*cTaskWordWidth-1 downto 0);    --! Paramters of the task
+    signal taskValid            : std_logic;                                        --! Task has a setting other than zero since the last clear
+    signal taskRemain           : std_logic;                                        --! Task or one of the following tasks is valid
     signal taskCompFrame        : std_logic_vector(cTaskWordWidth-1 downto 0);      --! Frame data of the task
     signal taskCompMask         : std_logic_vector(cTaskWordWidth-1 downto 0);      --! Frame mask of the task
+    signal taskWindowData       : std_logic_vector(cParam.noOfFilterWindows*cTaskWordWidth-1 downto 0); --! Filter windows of the task
+    signal taskChainData        : std_logic_vector(cTaskWordWidth-1 downto 0);      --! Chain of the task
 
     --writing data buffer
     signal wrBuffAddr           : std_logic_vector(cDataBuffAddrWidth-1 downto 0);  --! Write address of frame buffer
@@ -150,20 +195,37 @@ architecture two_seg_arch of FrameManipulator is
     signal dataOutStartAddr     : std_logic_vector(cDataBuffAddrWidth-1 downto 0);  --! Read start address of frame buffer
     signal dataOutEndAddr       : std_logic_vector(cDataBuffAddrWidth-1 downto 0);  --! Read ed address of frame buffer
 
+    --injected frames
+    signal injectRdAddr         : std_logic_vector(cInjectAddrWidth-1 downto 0);    --! Read address of template memory
+    signal injectRdEn           : std_logic;                                        --! Read enable of template memory
+    signal injectData           : std_logic_vector(cByteLength-1 downto 0);         --! Read data of template memory
+    signal taskInjectEn         : std_logic;                                        --! task: inject template frames
+    signal frameReady           : std_logic;                                        --! stored frame is ready to be created
+
     --Incoming frames
     signal startFrameProc       : std_logic;    --! Start processing the current frame
     signal frameEnded           : std_logic;    --! Incomming frame ended
     signal frameSync            : std_logic;    --! New frame started => Synchronous reset of modules
+    signal frameTagged          : std_logic;    --! Incomming frame has a VLAN tag
+    signal frameBypass          : std_logic;    --! Incomming frame is forwarded without tasks
+
+    --Forwarding
+    signal forwardCfg           : std_logic_vector(cByteLength-1 downto 0);                         --! Forwarding flags
+    signal etherTypeCfg         : std_logic_vector(cEth.noCfgEtherType*cEth.sizeEtherType-1 downto 0);  --! Table of EtherTypes
 
     --Test control
     signal startTest            : std_logic;    --! Start series of test
     signal stopTest             : std_logic;    --! Stop series of test
     signal clearMem             : std_logic;    --! Clear Memory
     signal testActive           : std_logic;    --! Series of test is active
+    signal startMode            : std_logic_vector(cByteLength-1 downto 0);         --! Start mode of the test
+    signal startTime            : std_logic_vector(cEth.sizeSocTime-1 downto 0);    --! SoC time of the start
 
     --Outgoing frames
     signal nextFrame            : std_logic;    --! New frame can be put out
     signal startNewFrame        : std_logic;    --! data for a new frame is available
+    signal storedNextFrame      : std_logic;    --! New stored frame can be put out
+    signal storedNewFrame       : std_logic;    --! data for a new stored frame is available
     signal frameIsSoc           : std_logic;    --! current frame is a SoC
 
     --Manipulations
@@ -171,6 +233,18 @@ architecture two_seg_arch of FrameManipulator is
     signal taskManiEn           : std_logic;                                        --! Enable frame header manipulation
     signal taskCutEn            : std_logic;                                        --! Enable frame truncation
     signal distCrcEn            : std_logic;                                        --! Enable CRC distortion
+    signal frameIpg             : std_logic_vector(cCreateTime.ipgWidth-1 downto 0); --! Inter packet gap before the new frame
+    signal storedDistCrcEn      : std_logic;                                        --! Enable CRC distortion of the stored frame
+    signal storedFrameIpg       : std_logic_vector(cCreateTime.ipgWidth-1 downto 0); --! Inter packet gap before the stored frame
+    signal phyFault             : std_logic_vector(cSettingSize.phy-1 downto 0);    --! PHY faults of the new frame
+    signal storedPhyFault       : std_logic_vector(cSettingSize.phy-1 downto 0);    --! PHY faults of the stored frame
+    signal socTimeEn            : std_logic;                                        --! Shifted time of the SoC is ready
+    signal socTime              : std_logic_vector(2*cEth.sizeSocTime-1 downto 0);  --! Shifted NetTime and RelativeTime of the SoC
+    signal frameStartAddr       : std_logic_vector(cDataBuffAddrWidth-1 downto 0);  --! Start address of the new frame
+    signal frameEndAddr         : std_logic_vector(cDataBuffAddrWidth-1 downto 0);  --! End address of the new frame
+    signal frameData            : std_logic_vector(cByteLength-1 downto 0);         --! Data of the new frame
+    signal taskLineEn           : std_logic;                                        --! Delay frames in the external delay line
+    signal lineLatency          : std_logic_vector(cSettingSize.Delay-1 downto 0);  --! Latency of the external delay line
 
 
     --! Reducing ManiSetting of cut-manipulation via alias
@@ -179,21 +253,27 @@ architecture two_seg_arch of FrameManipulator is
 
 
     --Safety
-    signal taskSafetyEn         : std_logic;                                        --! task: safety packet manipulation
-    signal safetyFrame          : std_logic;                                        --! Current Frame is a selected safety frame
+    signal taskSafetyEn         : std_logic_vector(gSafetyContexts-1 downto 0);     --! task: safety packet manipulation of each context
+    signal safetyFrame          : std_logic_vector(gSafetyContexts-1 downto 0);     --! Current Frame is a selected safety frame of each context
     signal packetExchangeEn     : std_logic;                                        --! Start of the exchange of the safety packet
     signal packetStart          : std_logic_vector(cByteLength-1 downto 0);         --! Start of safety packet
     signal packetSize           : std_logic_vector(cByteLength-1 downto 0);         --! Size of safety packet
     signal packetData           : std_logic_vector(cByteLength-1 downto 0);         --! Data of the safety packet
-    signal safetyActive         : std_logic;                                        --! safety manipulations are active
+    signal safetyActive         : std_logic_vector(gSafetyContexts-1 downto 0);     --! safety manipulations of each context are active
     signal exchangeData         : std_logic;                                        --! exchange packet data
     signal packetExtension      : std_logic;                                        --! Exchange will be extended for several tacts
-    signal safetySetting        : std_logic_vector(cSettingSize.Safety-1 downto 0); --! Setting of the current or last safety task
+    signal frameExchangeEn      : std_logic;                                        --! Start of the exchange within the new frame
+    signal frameExtension       : std_logic;                                        --! Exchange within the new frame will be extended
+    signal safetySetting        : std_logic_vector(gSafetyContexts*cSettingSize.Safety-1 downto 0); --! Setting of the current or last safety task of each context
     signal resetPaketBuff       : std_logic;                                        --! Resets the packet FIFO and removes the packet lag
 
     --Output
     signal txData               : std_logic_vector(1 downto 0); --! RMII TX-data
     signal txDv                 : std_logic;                    --! RMII TX-data-valid
+    signal txEr                 : std_logic;                    --! TX error of the PHY task
+    signal lineTxData           : std_logic_vector(1 downto 0); --! RMII TX-data behind the delay line
+    signal lineTxDv             : std_logic;                    --! RMII TX-data-valid behind the delay line
+    signal lineTxEr             : std_logic;                    --! TX error behind the delay line
 
 
 begin
@@ -204,17 +284,26 @@ begin
     --! st_...    avalon slave for the different tasks
     --! sc_...    avalon slave for the control registers
     --! FM Error collection   => iError_Addr_Buff_OV, iError_Frame_Buff_OV
-    --! output of test status => oStartTest, oStopTest
-    --! reading tasks         => iRdTaskAddr
-    --! output tasks          => oTaskSettingData, oTaskCompFrame, oTaskCompMask
+    --! output of test status => oStartTest, oStopTest, oStartMode, oStartTime
+    --! reading tasks         => iRdTaskAddr, iTaskBank
+    --! bank of the tasks     => oBankSelect
+    --! output tasks          => oTaskSettingData, oTaskCompFrame, oTaskCompMask, oTaskWindowData,
+    --!                          oTaskChainData, oTaskValid, oTaskRemain
+    --! si_...    avalon slave for the template frames
+    --! reading templates     => iInjectRdAddr, oInjectData
     M_Interface : entity work.Memory_Interface
     generic map(
                 gSlaveTaskWordWidth     => cSlaveTaskWordWidth,
                 gSlaveTaskAddrWidth     => cSlaveTaskAddr,
+                gSlaveTaskBurstWidth    => gTaskBurstWidth,
                 gTaskWordWidth          => cTaskWordWidth,
                 gTaskAddrWidth          => cTaskAddrWidth,
+                gTaskBanks              => gTaskBanks,
                 gSlaveControlWordWidth  => gControlBytesPerWord*cByteLength,
-                gSlaveControlAddrWidth  => gControlAddr
+                gSlaveControlAddrWidth  => gControlAddr,
+                gSlaveInjectWordWidth   => gInjectBytesPerWord*cByteLength,
+                gSlaveInjectAddrWidth   => gInjectAddr,
+                gInjectAddrWidth        => cInjectAddrWidth
                 )
     port map(
             iClk                    => iClk50,
@@ -227,6 +316,9 @@ begin
             iSt_read                => iSt_read,
             oSt_readdata            => oSt_readdata,
             iSt_byteenable          => iSt_byteenable,
+            iSt_burstcount          => iSt_burstcount,
+            oSt_waitrequest         => oSt_waitrequest,
+            oSt_readdatavalid       => oSt_readdatavalid,
 
             iSc_address             => iSc_address,
             iSc_writedata           => iSc_writedata,
@@ -235,20 +327,43 @@ begin
             oSc_readdata            => oSc_readdata,
             iSc_byteenable          => iSc_byteenable,
 
+            iSi_address             => iSi_address,
+            iSi_writedata           => iSi_writedata,
+            iSi_write               => iSi_write,
+            iSi_read                => iSi_read,
+            oSi_readdata            => oSi_readdata,
+            iSi_byteenable          => iSi_byteenable,
+
             iError_addrBuffOv       => error_addrBuffOv,
-            iError_frameBuffOv      => error_frameBuffOv,
+            iError_frameBuffOv      => error_frameOv,
             iError_packetBuffOv     => error_packetBuffOv,
             iError_taskConf         => error_taskConf,
+            iPacketOccupancy        => packetOccupancy_ctrl,
             oStartTest              => startTest,
             oStopTest               => stopTest,
             oClearMem               => clearMem,
             oResetPaketBuff         => resetPaketBuff,
             iTestActive             => testActive,
+            oForwardCfg             => forwardCfg,
+            oEtherTypeCfg           => etherTypeCfg,
+            oBankSelect             => bankSelect,
+            oStartMode              => startMode,
+            oStartTime              => startTime,
+            iBitErrors              => bitErrors_ctrl,
 
             iRdTaskAddr             => rdTaskAddr,
+            iTaskBank               => taskBank,
             oTaskSettingData        => taskSettingData,
+            oTaskValid              => taskValid,
+            oTaskRemain             => taskRemain,
             oTaskCompFrame          => taskCompFrame,
-            oTaskCompMask           => taskCompMask
+            oTaskCompMask           => taskCompMask,
+            oTaskWindowData         => taskWindowData,
+            oTaskChainData          => taskChainData,
+
+            iInjectRdAddr           => injectRdAddr,
+            iInjectRdEn             => injectRdEn,
+            oInjectData             => injectData
             );
 
 
@@ -268,6 +383,8 @@ begin
             iReset              => iReset,
             iRXDV               => iRXDV,
             iRXD                => iRXD,
+            iForwardCfg         => forwardCfg,
+            iEtherTypeCfg       => etherTypeCfg,
             iDataStartAddr      => dataInStartAddr,
             iTaskCutEn          => taskCutEn,
             iTaskCutData        => maniSetting_cut,
@@ -277,6 +394,8 @@ begin
             oWrBuffEn           => wrBuffEn,
             oDataEndAddr        => dataInEndAddr,
             oStartFrameProcess  => startFrameProc,
+            oFrameTagged        => frameTagged,
+            oFrameBypass        => frameBypass,
             oFrameEnded         => frameEnded,
             oFrameSync          => frameSync
             );
@@ -307,13 +426,16 @@ begin
             iTaskManiEn             => taskManiEn,
             iManiSetting            => maniSetting,
             iDataStartAddr          => dataInStartAddr,
+            iFrameTagged            => frameTagged,
+            iSocTimeEn              => socTimeEn,
+            iSocTime                => socTime,
             oError_frameBuffOv      => error_frameBuffOv
             );
 
 
 
     --! @brief component for processing the frame
-    --! handles the whole series of test      =>  iStartTest, iStopTest
+    --! handles the whole series of test      =>  iStartTest, iStopTest, iStartMode, iStartTime
     --! compares the frame with the tasks-mem =>  iData, iTaskSettingData,
     --!                                           iTaskCompFrame, iTaskCompMask
     --! manages the space of the data memory  =>  oDataInStartAddr, iDataInEndAddr,
@@ -324,9 +446,12 @@ begin
                 gTaskAddrWidth      =>  cTaskAddrWidth,
                 gManiSettingWidth   =>  cManiSettingWidth,
                 gSafetySetting      =>  cSettingSize.Safety,
+                gSafetyPackets      =>  gSafetyPackets,
+                gSafetyContexts     =>  gSafetyContexts,
                 gCycleCntWidth      =>  cCycleCntWidth,
                 gSize_Mani_Time     =>  cSettingSize.Delay,
-                gNoOfDelFrames      =>  cParam.NoDelFrames)
+                gNoOfDelFrames      =>  cParam.NoDelFrames,
+                gExtDelayLine       =>  gExtDelayLine)
     port map(
             iClk                => iClk50,
             iReset              => iReset,
@@ -334,20 +459,31 @@ begin
             iStartFrameProcess  => startFrameProc,
             iFrameEnded         => frameEnded,
             iFrameSync          => frameSync,
-            iNextFrame          => nextFrame,
+            iFrameTagged        => frameTagged,
+            iFrameBypass        => frameBypass,
+            iNextFrame          => storedNextFrame,
             iStartTest          => startTest,
             iStopTest           => stopTest,
+            iStartMode          => startMode,
+            iStartTime          => startTime,
             iClearMem           => clearMem,
             iSafetyActive       => safetyActive,
             oTestActive         => testActive,
-            oStartNewFrame      => startNewFrame,
+            oStartNewFrame      => storedNewFrame,
+            oFrameReady         => frameReady,
             oError_taskConf     => error_taskConf,
 
             iData               => dataToBuff,
             iTaskSettingData    => taskSettingData,
+            iTaskValid          => taskValid,
+            iTaskRemain         => taskRemain,
             iTaskCompFrame      => taskCompFrame,
             iTaskCompMask       => taskCompMask,
+            iTaskWindowData     => taskWindowData,
+            iTaskChainData      => taskChainData,
             oRdTaskAddr         => rdTaskAddr,
+            iBankSelect         => bankSelect,
+            oTaskBank           => taskBank,
 
             oDataInStartAddr    => dataInStartAddr,
             iDataInEndAddr      => dataInEndAddr,
@@ -357,12 +493,70 @@ begin
 
             oTaskManiEn         => taskManiEn,
             oTaskCutEn          => taskCutEn,
-            oDistCrcEn          => distCrcEn,
+            oTaskInjectEn       => taskInjectEn,
+            oDistCrcEn          => storedDistCrcEn,
+            oFrameIpg           => storedFrameIpg,
+            oPhyFault           => storedPhyFault,
+            oSocTimeEn          => socTimeEn,
+            oSocTime            => socTime,
             oTaskSafetyEn       => taskSafetyEn,
             oSafetyFrame        => safetyFrame,
             oFrameIsSoc         => frameIsSoc,
             oManiSetting        => maniSetting,
-            oSafetySetting      => safetySetting
+            oSafetySetting      => safetySetting,
+            oTaskLineEn         => taskLineEn,
+            oLineLatency        => lineLatency
+            );
+
+
+
+    --! @brief component for injecting template frames
+    --! stores the inject task                =>  iTaskInjectEn, iManiSetting
+    --! uses the Frame-Creator, when no stored frame is ready =>  iNextFrame, iFrameReady
+    --! reads the template frames             =>  oInjectRdAddr, iInjectData
+    F_Injector : entity work.Frame_Injector
+    generic map(gDataBuffAddrWidth  => cDataBuffAddrWidth,
+                gInjectAddrWidth    => cInjectAddrWidth,
+                gTaskWordWidth      => cTaskWordWidth,
+                gManiSettingWidth   => cManiSettingWidth)
+    port map(
+            iClk                => iClk50,
+            iReset              => iReset,
+
+            iTestActive         => testActive,
+            iStopTest           => stopTest,
+            iFrameIsSoc         => frameIsSoc,
+            iTaskInjectEn       => taskInjectEn,
+            iManiSetting        => maniSetting,
+
+            iStartNewFrame      => storedNewFrame,
+            iFrameReady         => frameReady,
+            oNextFrame          => storedNextFrame,
+            iDistCrcEn          => storedDistCrcEn,
+            iFrameIpg           => storedFrameIpg,
+            iPhyFault           => storedPhyFault,
+            iDataStartAddr      => dataOutStartAddr,
+            iDataEndAddr        => dataOutEndAddr,
+            iBuffData           => dataFromBuff,
+            iPacketExchangeEn   => packetExchangeEn,
+            iPacketExtension    => packetExtension,
+
+            oStartNewFrame      => startNewFrame,
+            iNextFrame          => nextFrame,
+            oDistCrcEn          => distCrcEn,
+            oFrameIpg           => frameIpg,
+            oPhyFault           => phyFault,
+            oDataStartAddr      => frameStartAddr,
+            oDataEndAddr        => frameEndAddr,
+            iRdBuffAddr         => rdBuffAddr,
+            iRdBuffEn           => rdBuffEn,
+            oData               => frameData,
+            oPacketExchangeEn   => frameExchangeEn,
+            oPacketExtension    => frameExtension,
+
+            oInjectRdAddr       => injectRdAddr,
+            oInjectRdEn         => injectRdEn,
+            iInjectData         => injectData
             );
 
 
@@ -375,33 +569,92 @@ begin
     port map (
             iClk                => iClk50,
             iReset              => iReset,
+            iTestActive         => testActive,
 
             iStartNewFrame      => startNewFrame,
             oNextFrame          => nextFrame,
             iDistCrcEn          => distCrcEn,
+            iFrameIpg           => frameIpg,
+            iPhyFault           => phyFault,
+            oBitErrors          => bitErrors,
 
-            iDataEndAddr        => dataOutEndAddr,
-            iDataStartAddr      => dataOutStartAddr,
-            iData               => dataFromBuff,
+            iDataEndAddr        => frameEndAddr,
+            iDataStartAddr      => frameStartAddr,
+            iData               => frameData,
             oRdBuffEn           => rdBuffEn,
             oRdBuffAddr         => rdBuffAddr,
 
-            iPacketExchangeEn   => packetExchangeEn,
+            iPacketExchangeEn   => frameExchangeEn,
             iPacketStart        => packetStart,
             iPacketSize         => packetSize,
             iPacketData         => packetData,
-            iPacketExtension    => packetExtension,
+            iPacketExtension    => frameExtension,
             oExchangeData       => exchangeData,
 
             oTXData             => txData,
-            oTXDV               => txDv
+            oTXDV               => txDv,
+            oTxEr               => txEr
             );
 
 
+    --! @brief component for delaying the created frames in an external memory
+    --! delays the frames of the delay type "line" =>  iTaskLineEn, iLatency
+    --! stores the frames via the avalon master    =>  oM_*, iM_*
+    genDelayLine :
+    if gExtDelayLine/=0 generate
+        E_Line : entity work.Ext_Delay_Line
+        generic map(gLineBase           => gLineBase,
+                    gLineAddr           => gLineAddr,
+                    gLatencyWidth       => cSettingSize.Delay)
+        port map(
+                iClk                => iClk50,
+                iReset              => iReset,
+
+                iTestActive         => testActive,
+                iTestStop           => stopTest,
+                iTaskLineEn         => taskLineEn,
+                iLatency            => lineLatency,
+                oError_lineOv       => error_lineOv,
+
+                iTxData             => txData,
+                iTxDV               => txDv,
+                iTxEr               => txEr,
+                oTxData             => lineTxData,
+                oTxDV               => lineTxDv,
+                oTxEr               => lineTxEr,
+
+                oM_address          => oM_address,
+                oM_write            => oM_write,
+                oM_writedata        => oM_writedata,
+                oM_read             => oM_read,
+                iM_readdata         => iM_readdata,
+                iM_waitrequest      => iM_waitrequest,
+                iM_readdatavalid    => iM_readdatavalid
+                );
+    end generate genDelayLine;
+
+    genNoDelayLine :
+    if gExtDelayLine=0 generate
+        lineTxData      <= txData;
+        lineTxDv        <= txDv;
+        lineTxEr        <= txEr;
+        error_lineOv    <= '0';
+
+        oM_address      <= (others=>'0');
+        oM_write        <= '0';
+        oM_writedata    <= (others=>'0');
+        oM_read         <= '0';
+    end generate genNoDelayLine;
+
+    error_frameOv   <= error_frameBuffOv or error_lineOv;
+
+
     --! @brief component for safety packet manipulations
     --! stores and exchanges safety packets
     P_Buff : entity work.Packet_Buffer
     generic map(gSafetySetting      => cSettingSize.Safety,
+                gSafetyPackets      => gSafetyPackets,
+                gSafetyContexts     => gSafetyContexts,
                 gPacketAddrWidth    => cPacketAddrWidth,
                 gAddrMemoryWidth    => cAddrMemoryWidth)
     port map(
@@ -412,6 +665,7 @@ begin
             iStopTest               => stopTest,
             oSafetyActive           => safetyActive,
             oError_packetBuffOv     => error_packetBuffOv,
+            oPacketOccupancy        => packetOccupancy,
 
             iTaskSafetyEn           => taskSafetyEn,
             iExchangeData           => exchangeData,
@@ -430,6 +684,13 @@ begin
 
 
 
+    --Occupancy of the packet buffer to the control register
+    packetOccupancy_ctrl    <= std_logic_vector(resize(unsigned(packetOccupancy), packetOccupancy_ctrl'length));
+
+    --Bit errors of the BER task to the control register
+    bitErrors_ctrl          <= std_logic_vector(resize(unsigned(bitErrors), bitErrors_ctrl'length));
+
+
     --! @brief register to decrease timing problems of the PHY
     --! better alternative: 100MHz clock with synchronization on the falling edge
     --! - Storing with asynchronous reset
@@ -439,10 +700,12 @@ begin
         if iReset='1' then
             oTXData <= "00";
             oTXDV   <= '0';
+            oTXER   <= '0';
 
         elsif rising_edge(iClk50) then
-            oTXData <= txData;
-            oTXDV   <= txDv;
+            oTXData <= lineTxData;
+            oTXDV   <= lineTxDv;
+            oTXER   <= lineTxEr;
 
         end if;
     end process;
@@ -101,6 +101,94 @@ package framemanipulatorPkg is
                                 erTaskConf  => 7
                                 );
 
+    --! Definition forwarding register 0x3009/1
+    type tForward is record
+        passAll     : natural;  --! Forward frames of all EtherTypes, unknown ones without manipulation
+        vlan        : natural;  --! Parse VLAN tags and move the frame filters behind the tag
+    end record;
+
+    --! Set predefined value for forwarding flags
+    constant cFwd : tForward :=(
+                                passAll     => 0,
+                                vlan        => 1
+                                );
+
+    --! Definition of the flags of the task chain 0x300B, first Byte
+    type tChain is record
+        standby     : natural;  --! Task is disarmed at the start of the test, until another task arms it
+        once        : natural;  --! Task disarms itself after the number of hits
+        stop        : natural;  --! Series of test stops after the number of hits
+    end record;
+
+    --! Set predefined value for the flags of the task chain
+    constant cChain : tChain :=(
+                                standby     => 0,
+                                once        => 1,
+                                stop        => 2
+                                );
+
+    --! Definition of the phases of the POWERLINK cycle, fifth Byte of the task chain 0x300B
+    type tCyclePhase is record
+        isochronous : natural;  --! Frame from the SoC to the SoA
+        async       : natural;  --! Frame from the SoA to the next SoC
+    end record;
+
+    --! Set predefined value for the flags of the cycle phase
+    constant cCyclePhase : tCyclePhase :=(
+                                isochronous => 0,
+                                async       => 1
+                                );
+
+    --! Definition of the start modes 0x300C/1
+    type tStartMode is record
+        edge        : std_logic_vector(cByteLength-1 downto 0); --! Start at the rising edge of the start operation
+        trigger     : std_logic_vector(cByteLength-1 downto 0); --! Start with the first frame of a start task
+        netTime     : std_logic_vector(cByteLength-1 downto 0); --! Start with the first SoC at or behind the NetTime 0x300C/2
+        relTime     : std_logic_vector(cByteLength-1 downto 0); --! Start with the first SoC at or behind the RelativeTime 0x300C/2
+    end record;
+
+    --! Set predefined value for the start modes
+    constant cStartMode : tStartMode :=(
+                                edge        => X"00",
+                                trigger     => X"01",
+                                netTime     => X"02",
+                                relTime     => X"03"
+                                );
+
+    --! Definition of the fault flags of the PHY task, first Byte of the setting
+    type tPhyFault is record
+        preamble    : natural;  --! Preamble is shortened to the number of Bytes of the setting
+        sfd         : natural;  --! SFD is replaced by the Byte of the setting
+        dribble     : natural;  --! Dribble dibits are appended behind the CRC
+        abort       : natural;  --! Frame is aborted at the position without CRC
+        txErr       : natural;  --! TX error is set for one Byte at the position
+        ber         : natural;  --! Random bit errors of the BER task, set instead of the PHY setting
+    end record;
+
+    --! Set predefined value for the PHY fault flags
+    constant cPhyFault : tPhyFault :=(
+                                preamble    => 0,
+                                sfd         => 1,
+                                dribble     => 2,
+                                abort       => 3,
+                                txErr       => 4,
+                                ber         => 5
+                                );
+
+    --! Definition of the flags of the SoC time task, first Byte of the setting
+    type tTimeShift is record
+        net         : natural;  --! NetTime is shifted in ns
+        rel         : natural;  --! RelativeTime is shifted in us
+        walk        : natural;  --! Random walk of the step of setting 2 in each selected SoC
+    end record;
+
+    --! Set predefined value for the flags of the SoC time task
+    constant cTimeShift : tTimeShift :=(
+                                net         => 0,
+                                rel         => 1,
+                                walk        => 2
+                                );
+
     ---------------------------------------------------------------------------
     -- Manipulation Tasks
     ---------------------------------------------------------------------------
@@ -112,6 +200,16 @@ package framemanipulatorPkg is
         mani        : std_logic_vector(cByteLength-1 downto 0); --! Manipulate frame data
         crc         : std_logic_vector(cByteLength-1 downto 0); --! Distort the CRC
         cut         : std_logic_vector(cByteLength-1 downto 0); --! Truncate frame
+        ipg         : std_logic_vector(cByteLength-1 downto 0); --! Set the inter packet gap before the frame
+        inject      : std_logic_vector(cByteLength-1 downto 0); --! Inject template frames behind the frame
+        duplicate   : std_logic_vector(cByteLength-1 downto 0); --! Send copies of the frame
+        reorder     : std_logic_vector(cByteLength-1 downto 0); --! Send the frame behind the following frames
+        shape       : std_logic_vector(cByteLength-1 downto 0); --! Limit the rate of the following frames
+        trigger     : std_logic_vector(cByteLength-1 downto 0); --! Count the frame for the task chain without manipulating it
+        start       : std_logic_vector(cByteLength-1 downto 0); --! Start the armed test with the frame
+        phy         : std_logic_vector(cByteLength-1 downto 0); --! Inject faults of the PHY level into the frame
+        ber         : std_logic_vector(cByteLength-1 downto 0); --! Flip random bits of the frame
+        socTime     : std_logic_vector(cByteLength-1 downto 0); --! Shift the NetTime and RelativeTime of the SoC
         --! Safety ones
         repetition  : std_logic_vector(cByteLength-1 downto 0); --! Repeat safety packets
         paLoss      : std_logic_vector(cByteLength-1 downto 0); --! Delete safety packets
@@ -129,6 +227,16 @@ package framemanipulatorPkg is
                                 mani        => X"04",
                                 crc         => X"08",
                                 cut         => X"10",
+                                ipg         => X"20",
+                                inject      => X"40",
+                                duplicate   => X"03",
+                                reorder     => X"05",
+                                shape       => X"06",
+                                trigger     => X"07",
+                                start       => X"09",
+                                phy         => X"0A",
+                                ber         => X"0B",
+                                socTime     => X"0C",
                                 repetition  => X"81",
                                 paLoss      => X"82",
                                 insertion   => X"83",
@@ -147,13 +255,15 @@ package framemanipulatorPkg is
         pass    : std_logic_vector(cByteLength-1 downto 0); --! Pass all frames
         delete  : std_logic_vector(cByteLength-1 downto 0); --! Delete all
         passSoC : std_logic_vector(cByteLength-1 downto 0); --! Pass only SoCs
+        line    : std_logic_vector(cByteLength-1 downto 0); --! Pass all frames, delay them in the external delay line
     end record;
 
     --! Set predefined value for operation flags
     constant cDelayType : tDelayType :=(
                                 pass    => X"01",
                                 delete  => X"02",
-                                passSoC => X"04"
+                                passSoC => X"04",
+                                line    => X"08"
                                 );
 
 
@@ -162,14 +272,22 @@ package framemanipulatorPkg is
     ---------------------------------------------------------------------------
     --! Definition of task setting size
     type tSettingSize is record
-        delay   : natural;  --! Size of needed setting for delay task
-        safety  : natural;  --! Size of needed setting for safety task
+        delay           : natural;  --! Size of needed setting for delay task
+        safety          : natural;  --! Size of needed setting for safety task
+        safetyPacket    : natural;  --! Size of the setting of one safety packet
+        safetyDescr     : natural;  --! Size of the descriptor of a further safety packet
+        phy             : natural;  --! Size of the setting of the PHY task
+        socTime         : natural;  --! Size of the setting of the SoC time task
     end record;
 
     --! Set predefined value for setting size
     constant cSettingSize   : tSettingSize :=(
-                                delay   => 5*cByteLength,   --! 5 Byte Delay setting
-                                safety  => 6*cByteLength    --! 6 Byte Safety setting
+                                delay           => 5*cByteLength,   --! 5 Byte Delay setting
+                                safety          => 15*cByteLength,  --! 15 Byte Safety setting with descriptors of further packets
+                                safetyPacket    => 6*cByteLength,   --! 6 Byte setting of the first packet
+                                safetyDescr     => 3*cByteLength,   --! 3 Byte for task, start and size of a further packet
+                                phy             => 6*cByteLength,   --! 6 Byte PHY setting
+                                socTime         => 14*cByteLength   --! 6 Byte of setting 1 and 8 Byte of setting 2
                                 );
 
 
@@ -183,6 +301,14 @@ package framemanipulatorPkg is
         sizeManiHeaderOffset    : natural;  --! Size of the offsets for manipulation task
         sizeManiHeaderData      : natural;  --! Size of the data for manipulation task
         safetyPackSelCntWidth   : natural;  --! Width of counter to select packet: 11 bit to change the whole frame
+        maxSafetyPackets        : natural;  --! Maximal number of safety packets per frame
+        noOfInjectInc           : natural;  --! Number of incremented Bytes of injected frames
+        sizeInjectSetting       : natural;  --! Size of start, size and number of injected frames
+        sizeShapeRate           : natural;  --! Size of the rate of the shaper in Byte per clock cycle
+        sizeShapeBurst          : natural;  --! Size of the burst of the shaper in Byte
+        noOfFilterWindows       : natural;  --! Number of additional filter windows per task
+        sizeFilterOffset        : natural;  --! Size of the offset of a filter window
+        sizeFilterWindow        : natural;  --! Size of data and mask of a filter window
     end record;
 
     --! Set predefined value for FM parameters
@@ -191,7 +317,15 @@ package framemanipulatorPkg is
                                 noOfHeadMani            => 8,           --! 8 Manipulated Bytes per manipulation task
                                 sizeManiHeaderOffset    => 6,           --! 6 bit per offset
                                 sizeManiHeaderData      => cByteLength, --! 1 Byte
-                                safetyPackSelCntWidth   => 11           --! 11 bit to change the whole frame
+                                safetyPackSelCntWidth   => 11,          --! 11 bit to change the whole frame
+                                maxSafetyPackets        => 4,           --! First packet and three descriptors within the safety setting
+                                noOfInjectInc           => 2,           --! Two offsets with increments within the inject setting
+                                sizeInjectSetting       => 16,          --! 2 Byte for start, size and number of injected frames
+                                sizeShapeRate           => 24,          --! 3 Byte fraction: 1 Byte per clock cycle = 400 Mbit/s
+                                sizeShapeBurst          => 16,          --! 2 Byte
+                                noOfFilterWindows       => 2,           --! Objects 0x3007 and 0x3008
+                                sizeFilterOffset        => 16,          --! 2 Byte for the first Byte of the window
+                                sizeFilterWindow        => 24           --! 3 Byte data and 3 Byte mask
                                 );
 
 
@@ -203,11 +337,23 @@ package framemanipulatorPkg is
         filterEtherType     : std_logic_vector(8*cByteLength-1 downto 0);   --! Frame Ethertypes which are allowed to pass the FM
         startFrameFilter    : natural;                                      --! First Byte of the frame to identify it via object 0x3003
         endFrameFilter      : natural;                                      --! Last Byte of the frame to identify it via object 0x3003
+        endWindowFilter     : natural;                                      --! Last Byte of the frame within the filter windows
+        noCfgEtherType      : natural;                                      --! Number of EtherTypes of the table 0x3009
         sizeEtherType       : natural;                                      --! Size of EtherType
         startEtherType      : natural;                                      --! Start Byte of EtherType
         endEtherType        : natural;                                      --! Start Byte of EtherType
         startMessageType    : natural;                                      --! Position of POWERLINK MessageType
+        startNetTime        : natural;                                      --! First Byte of the NetTime of the SoC
+        startRelativeTime   : natural;                                      --! First Byte of the RelativeTime of the SoC
+        sizeSocTime         : natural;                                      --! Size of the NetTime and the RelativeTime
         messageTypeSoC      : std_logic_vector(cByteLength-1 downto 0);     --! MessageType for SoCs
+        messageTypeSoA      : std_logic_vector(cByteLength-1 downto 0);     --! MessageType for SoAs
+        startSocFlags       : natural;                                      --! Byte of the SoC flags with the MC flag
+        socFlagMc           : natural;                                      --! Bit of the flag Multiplexed Cycle Completed
+        startSoaService     : natural;                                      --! Byte of the RequestedServiceID of the SoA
+        startSoaTarget      : natural;                                      --! Byte of the RequestedServiceTarget of the SoA
+        vlanTpid            : std_logic_vector(2*cByteLength-1 downto 0);   --! EtherType of a VLAN tag
+        sizeVlanTag         : natural;                                      --! Size of the VLAN tag in Byte
     end record;
 
     --! Set predefined value for setting size
@@ -215,11 +361,23 @@ package framemanipulatorPkg is
                                 filterEtherType     => X"88AB_0800_0806_3E3F",   --! POWERLINK V2, IP, ARP and POWERLINK V1 frames are valid
                                 startFrameFilter    => 15,                  --! Filter starts with Messagetype
                                 endFrameFilter      => 22,                  --! StartFrameFilter+8Byte-1
+                                endWindowFilter     => 52,                  --! 48 Bytes and the VLAN tag, before the end of the shortest frame
+                                noCfgEtherType      => 4,                   --! EtherTypes 0x3009/2-5
                                 sizeEtherType       => 2*cByteLength,       --! 2 Bytes
                                 startEtherType      => 13,                  --! Starts at Byte 13
                                 endEtherType        => 14,                  --! End at Byte 14
                                 startMessageType    => 15,                  --! At Byte 15
-                                messageTypeSoC      => X"01"
+                                startNetTime        => 21,                  --! Seconds and nanoseconds, little endian
+                                startRelativeTime   => 29,                  --! Microseconds, little endian
+                                sizeSocTime         => 8*cByteLength,       --! 8 Bytes
+                                messageTypeSoC      => X"01",
+                                messageTypeSoA      => X"05",
+                                startSocFlags       => 19,                  --! Flags 1 of the SoC
+                                socFlagMc           => 7,                   --! MC toggles with the first multiplexed cycle
+                                startSoaService     => 21,                  --! Behind the flags of the SoA
+                                startSoaTarget      => 22,                  --! Invited node, last Byte of the frame filter
+                                vlanTpid            => X"8100",             --! IEEE 802.1Q
+                                sizeVlanTag         => 4                    --! TPID and TCI
                                 );
 
 
@@ -232,7 +390,10 @@ package framemanipulatorPkg is
         preamble    : natural;  --! Clock cycles to create the Preamble
         preReadTime : natural;  --! Clock cycles to compensate the delay of the read operation
         crcTime     : natural;  --! Clock cycles to create the CRC
-        ipgTime     : natural;  --! Clock cycles to keep the Inter packet gap of 960 ns
+        ipgWidth    : natural;  --! Width of the inter packet gap in Byte
+        ipgSize     : natural;  --! Standard inter packet gap of 960 ns in Byte
+        ipgCntWidth : natural;  --! Width of the gap counter in clock cycles
+        ipgCntOffset: natural;  --! Clock cycles of the gap, which aren't counted by the gap counter
     end record;
 
     --! Set predefined value for timing parameters for frame creation
@@ -241,13 +402,29 @@ package framemanipulatorPkg is
                                 preamble    => 31,  --! 8Byte => 8Byte*8Bit/2Width => 32
                                 preReadTime => 5,   --! Forerun of the reading logic of 5 cycles
                                 crcTime     => 15,  --! 4Byte => 4Byte*8Bit/2Width => 16
-                                ipgTime     => 44   --! Whole delay of 960ns => here 880ns + process time
+                                ipgWidth    => 16,  --! Gap of up to 65535 Byte (5.2 ms)
+                                ipgSize     => 12,  --! 12Byte => 12Byte*8Bit/2Width => 48 cycles
+                                ipgCntWidth => 18,  --! ipgWidth + 2 bit for the cycles of one Byte
+                                ipgCntOffset=> 2    --! Cycle of the next state and output delay of the CRC => 960 ns like the fixed IPG
                                 );
 
+
+    ---------------------------------------------------------------------------
+    -- Functions
+    ---------------------------------------------------------------------------
+    --! Returns true, when the task is one of the safety tasks
+    function isSafetyTask(task : std_logic_vector(cByteLength-1 downto 0)) return boolean;
+
 end framemanipulatorPkg;
 
 package body framemanipulatorPkg is
 
-
+    function isSafetyTask(task : std_logic_vector(cByteLength-1 downto 0)) return boolean is
+    begin
+        return  task = cTask.repetition or task = cTask.paLoss  or
+                task = cTask.insertion  or task = cTask.incSeq  or
+                task = cTask.incData    or task = cTask.paDelay or
+                task = cTask.masquerade;
+    end function;
 
 end framemanipulatorPkg;
\ No newline at end of file
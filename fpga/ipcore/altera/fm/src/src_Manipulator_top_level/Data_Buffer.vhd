@@ -78,7 +78,10 @@ entity Data_Buffer is
 
         iManiSetting            : in std_logic_vector(gManiSettingWidth-1 downto 0);    --! header manipulation setting
         iTaskManiEn             : in std_logic;                                         --! header manipulation enable
-        iDataStartAddr          : in std_logic_vector(gDataAddrWidth-1 downto 0)        --! start byte of manipulated header
+        iDataStartAddr          : in std_logic_vector(gDataAddrWidth-1 downto 0);       --! start byte of manipulated header
+        iFrameTagged            : in std_logic;                                         --! frame has a VLAN tag
+        iSocTimeEn              : in std_logic;                                         --! shifted time of the SoC is ready
+        iSocTime                : in std_logic_vector(2*cEth.sizeSocTime-1 downto 0)    --! shifted NetTime and RelativeTime of the SoC
     );
 end Data_Buffer;
 
@@ -92,11 +95,19 @@ end Data_Buffer;
 --! - The header manipulation setting is stored at the edge of the task enable signal. The
 --!   manipulation of up to 8 different bytes are done on port B, while there is no read
 --!   access.
+--! - The shifted time of the SoC time task is stored with its address and written Byte by Byte
+--!   on port B, while neither the frame is read nor the header is manipulated.
 architecture two_seg_arch of Data_Buffer is
 
     --! size selection of the selection counter
     constant cCntWidth  : natural:=LogDualis(gNoOfHeadMani+1);
 
+    --! Bytes of the shifted NetTime and RelativeTime
+    constant cTimeBytes     : natural:=2*cEth.sizeSocTime/gDataWidth;
+
+    --! size of the counter of the time Bytes
+    constant cTimeCntWidth  : natural:=LogDualis(cTimeBytes+1);
+
 
     --! Typedef for registers
     type tReg is record
@@ -104,6 +115,9 @@ architecture two_seg_arch of Data_Buffer is
         dataStartAddr   : std_logic_vector(gDataAddrWidth-1 downto 0);                      --! Start Byte of manipulated frame header
         maniOffset      : std_logic_vector(gManiSettingWidth-gTaskWordWidth-1 downto 0);    --! Offsets of header manipulation
         maniWords       : std_logic_vector(gTaskWordWidth-1 downto 0);                      --! New header data
+        timeAddr        : std_logic_vector(gDataAddrWidth-1 downto 0);                      --! Address of the next time Byte
+        timeData        : std_logic_vector(2*cEth.sizeSocTime-1 downto 0);                  --! Remaining time Bytes, next Byte at the bottom
+        timeCnt         : std_logic_vector(cTimeCntWidth-1 downto 0);                       --! Number of written time Bytes
     end record;
 
 
@@ -112,7 +126,10 @@ architecture two_seg_arch of Data_Buffer is
                                 taskManiEn      => '0',
                                 dataStartAddr   => (others=>'0'),
                                 maniOffset      => (others=>'0'),
-                                maniWords       => (others=>'0')
+                                maniWords       => (others=>'0'),
+                                timeAddr        => (others=>'0'),
+                                timeData        => (others=>'0'),
+                                timeCnt         => std_logic_vector(to_unsigned(cTimeBytes, cTimeCntWidth))
                                 );
 
     signal reg          : tReg; --! Registers
@@ -132,6 +149,9 @@ architecture two_seg_arch of Data_Buffer is
     --Usage of Port B--------------------
     signal wrEnB    : std_logic;                                    --! Write enable for header manipulation at port B
     signal addressB : std_logic_vector(gDataAddrWidth-1 downto 0);  --! Address for header manipulation at port B
+    signal dataB    : std_logic_vector(gDataWidth-1 downto 0);      --! Written data at port B
+    signal wrManiB  : std_logic;                                    --! Write of the header manipulation at port B
+    signal wrTimeB  : std_logic;                                    --! Write of the shifted SoC time at port B
 
 
 
@@ -161,7 +181,7 @@ begin
             iRden_a     => '0',
             oQ_a        => open,
             iAddress_b  => addressB,
-            iData_b     => selManiWords,
+            iData_b     => dataB,
             iWren_b     => wrEnB,
             iRden_b     => iRdEn,
             oQ_b        => oData
@@ -188,8 +208,11 @@ begin
     --! @brief Next register value
     --! - Storing of iTaskManiEn for edge detection
     --! - Storing of manipulation setting at edge
+    --! - Storing of the shifted SoC time with the address of the NetTime in the frame
+    --! - Next time Byte after each write
     nextComb :
-    process(reg, iTaskManiEn, taskManiEn_posEdge, iDataStartAddr, iManiSetting)
+    process(reg, iTaskManiEn, taskManiEn_posEdge, iDataStartAddr, iManiSetting, iSocTimeEn, iSocTime,
+            iFrameTagged, wrTimeB)
     begin
         reg_next    <= reg;
 
@@ -202,6 +225,23 @@ begin
 
         end if;
 
+        if iSocTimeEn='1' then
+            reg_next.timeData   <= iSocTime;
+            reg_next.timeCnt    <= (others=>'0');
+
+            if iFrameTagged='1' then
+                reg_next.timeAddr   <= std_logic_vector(unsigned(iDataStartAddr)+cEth.startNetTime+cEth.sizeVlanTag);
+            else
+                reg_next.timeAddr   <= std_logic_vector(unsigned(iDataStartAddr)+cEth.startNetTime);
+            end if;
+
+        elsif wrTimeB='1' then
+            reg_next.timeData   <= std_logic_vector(shift_right(unsigned(reg.timeData), gDataWidth));
+            reg_next.timeAddr   <= std_logic_vector(unsigned(reg.timeAddr)+1);
+            reg_next.timeCnt    <= std_logic_vector(unsigned(reg.timeCnt)+1);
+
+        end if;
+
     end process;
 
 
@@ -261,11 +301,19 @@ begin
 
 
     --Usage of Port B------------------------------------------------------------------------------
-    wrEnB       <= '1' when cntEn='1' and selManiOffset/=(selManiOffset'range =>'0') else '0';
+    wrManiB     <= '1' when cntEn='1' and selManiOffset/=(selManiOffset'range =>'0') else '0';
         --Write Enabled when Manipulation is active(CntEn) and a Manipulation exists(Offset not 00..0)
 
-    addressB    <= std_logic_vector(unsigned(reg.dataStartAddr)+unsigned(selManiOffset)) when wrEnB='1' else iRdAddress;
-        --selection between write-manipulation- and read-address
+    wrTimeB     <= '1' when iRdEn='0' and cntEn='0' and unsigned(reg.timeCnt)<cTimeBytes else '0';
+        --Time is written, when the buffer isn't read and the header manipulation has finished
+
+    wrEnB       <= wrManiB or wrTimeB;
+
+    addressB    <= std_logic_vector(unsigned(reg.dataStartAddr)+unsigned(selManiOffset)) when wrManiB='1' else
+                    reg.timeAddr when wrTimeB='1' else iRdAddress;
+        --selection between write-manipulation-, time- and read-address
+
+    dataB       <= reg.timeData(gDataWidth-1 downto 0) when wrTimeB='1' else selManiWords;
 
 
     --Error flag is set, when an overflow occurs
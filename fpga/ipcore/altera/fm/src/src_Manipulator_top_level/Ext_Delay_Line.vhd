@@ -0,0 +1,682 @@
+-------------------------------------------------------------------------------
+--! @file Ext_Delay_Line.vhd
+--! @brief Delays the outgoing frames in an external memory
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+--! Use work library
+library work;
+--! use fm library
+use work.framemanipulatorPkg.all;
+
+--! Common library
+library libcommon;
+--! Use common library global package
+use libcommon.global.all;
+
+
+
+--! This is the entity of the top-module for delaying frames in an external memory
+entity Ext_Delay_Line is
+    generic(gLineBase           : natural := 0;             --! Base address of the delay line in the external memory
+            gLineAddr           : natural := 23;            --! Address width of the delay line in Byte
+            gPrefetchAddrWidth  : natural := 9;             --! Address width of the prefetch fifo of 32 bit words
+            gLatencyWidth       : natural := 5*cByteLength  --! Width of the latency setting
+            );
+    port(
+        iClk                : in std_logic;     --! clk
+        iReset              : in std_logic;     --! reset
+        --control signals
+        iTestActive         : in std_logic;                                     --! Series of test is active
+        iTestStop           : in std_logic;                                     --! Test abort
+        iTaskLineEn         : in std_logic;                                     --! task: delay the frames in the line
+        iLatency            : in std_logic_vector(gLatencyWidth-1 downto 0);    --! latency of the line in 10ns
+        oError_lineOv       : out std_logic;                                    --! Error: overflow of the delay line
+        --Frame stream of the Frame_Creator
+        iTxData             : in std_logic_vector(1 downto 0);  --! frame-data of the Frame_Creator
+        iTxDV               : in std_logic;                     --! frame-data-valid of the Frame_Creator
+        iTxEr               : in std_logic;                     --! TX error of the Frame_Creator
+        oTxData             : out std_logic_vector(1 downto 0); --! delayed frame-output-data
+        oTxDV               : out std_logic;                    --! delayed frame-output-data-valid
+        oTxEr               : out std_logic;                    --! TX error of the directly passed frames
+        --Avalon master of the external memory
+        oM_address          : out std_logic_vector(31 downto 0);    --! Delay line avalon master address
+        oM_write            : out std_logic;                        --! Delay line avalon master write enable
+        oM_writedata        : out std_logic_vector(31 downto 0);    --! Delay line avalon master data write
+        oM_read             : out std_logic;                        --! Delay line avalon master read enable
+        iM_readdata         : in std_logic_vector(31 downto 0);     --! Delay line avalon master read data
+        iM_waitrequest      : in std_logic;                         --! Delay line avalon master wait request
+        iM_readdatavalid    : in std_logic                          --! Delay line avalon master read data valid
+    );
+end Ext_Delay_Line;
+
+
+
+--! @brief Ext_Delay_Line architecture
+--! @details Delays the outgoing frames of the Frame_Creator in an external memory like the SDRAM
+--! - The latency is stored, when the delay task of the type "line" is enabled. It applies to
+--!   all frames, which start afterwards, until the series of test has finished.
+--! - The dibits of these frames are collected to 32 bit words and written to a ring buffer
+--!   via the Avalon master. Every frame starts with two header words: the point of time,
+--!   when it has to leave the line, and its number of dibits.
+--! - Complete frames are read back into the prefetch fifo. A frame is sent, when its point
+--!   of time has passed and all of its words are prefetched. Latencies below the duration
+--!   of the frame are extended thereby. The gap before the frame is stored with its number
+--!   of dibits up to the standard IPG, so the delayed frames keep at least their gaps.
+--! - Frames pass directly, when the latency is 0 and the line is empty. Otherwise they enter
+--!   the line to keep the order of the frames. Only the directly passed frames keep the TX
+--!   error of the PHY task, the line stores the dibits without it.
+--! - A frame is dropped with oError_lineOv, when the ring buffer is full. After an abort of
+--!   the test, the remaining frames are sent without waiting for their point of time.
+architecture two_seg_arch of Ext_Delay_Line is
+
+    --constants
+    constant cTimeWidth     : natural:=32;                      --! Width of the timeline in 20ns
+    constant cWordAddrWidth : natural:=gLineAddr-2;             --! Address width of the ring buffer in 32 bit words
+    constant cCntWidth      : natural:=16;                      --! Width of the number of dibits of a frame
+    constant cCapAddrWidth  : natural:=6;                       --! Address width of the capture fifo
+    constant cPrefetchSize  : natural:=2**gPrefetchAddrWidth;   --! Number of words of the prefetch fifo
+    constant cMaxGap        : natural:=4*cCreateTime.ipgSize;   --! Limit of the stored gap before a frame in cycles
+    constant cGapWidth      : natural:=LogDualis(cMaxGap+1);    --! Width of the gap
+
+    --entries of the capture fifo
+    constant cEntryStart    : std_logic_vector(1 downto 0):="01";   --! Start of a frame with its point of time
+    constant cEntryData     : std_logic_vector(1 downto 0):="10";   --! Word of frame-data
+    constant cEntryEnd      : std_logic_vector(1 downto 0):="11";   --! End of a frame with its number of dibits
+
+
+    --! Typedef for the writer of the ring buffer
+    type tWrState is (sWrPop, sWrEval, sWrWait);
+
+    --! Typedef for the Avalon master
+    type tMasterState is (sMIdle, sMWrite, sMRead);
+
+    --! Typedef for the output of the delayed frames
+    type tOutState is (sOutDue, sOutCnt, sOutWait, sOutSend);
+
+
+    --! Typedef for registers
+    type tReg is record
+        time        : unsigned(cTimeWidth-1 downto 0);              --! Timeline in 20ns
+        latency     : unsigned(cTimeWidth-1 downto 0);              --! Latency of the line in 20ns
+        flush       : std_logic;                                    --! Remaining frames are sent without latency
+        frames      : unsigned(cCntWidth-1 downto 0);               --! Number of frames in the line
+        error       : std_logic;                                    --! Overflow of the line
+        --capture of the incoming frames
+        txDv        : std_logic;                                    --! Register for edge detection of iTxDV
+        capture     : std_logic;                                    --! Current frame enters the line
+        capValid    : std_logic;                                    --! Start of the current frame was stored
+        capIdx      : unsigned(3 downto 0);                         --! Dibit within the current word
+        capCnt      : unsigned(cCntWidth-1 downto 0);               --! Number of dibits of the current frame
+        capWord     : std_logic_vector(31 downto 0);                --! Collected dibits
+        capGap      : unsigned(cGapWidth-1 downto 0);               --! Idle cycles of the incoming stream
+        capFrameGap : unsigned(cGapWidth-1 downto 0);               --! Gap before the current frame
+        pushEnd     : std_logic;                                    --! End of frame is stored after the last word
+        --writer of the ring buffer
+        wrState     : tWrState;                                     --! State of the writer
+        entry       : std_logic_vector(33 downto 0);                --! Entry of the capture fifo
+        drop        : std_logic;                                    --! Current frame is dropped
+        frameOpen   : std_logic;                                    --! Header of the current frame was written
+        commit      : std_logic;                                    --! Frame is complete after the current write
+        wrReq       : std_logic;                                    --! Write request to the master
+        wrAddr      : unsigned(cWordAddrWidth-1 downto 0);          --! Address of the write request
+        wrData      : std_logic_vector(31 downto 0);                --! Data of the write request
+        wrPtr       : unsigned(cWordAddrWidth-1 downto 0);          --! Next free word of the ring buffer
+        hdrPtr      : unsigned(cWordAddrWidth-1 downto 0);          --! Header of the current frame
+        commitPtr   : unsigned(cWordAddrWidth-1 downto 0);          --! End of the complete frames
+        rdPtr       : unsigned(cWordAddrWidth-1 downto 0);          --! Next prefetched word
+        --Avalon master
+        mState      : tMasterState;                                 --! State of the master
+        mAddr       : unsigned(cWordAddrWidth-1 downto 0);          --! Address of the current transfer
+        mData       : std_logic_vector(31 downto 0);                --! Write data of the current transfer
+        pfUsed      : unsigned(gPrefetchAddrWidth downto 0);        --! Words in the prefetch fifo and pending reads
+        pfWords     : unsigned(gPrefetchAddrWidth downto 0);        --! Words in the prefetch fifo
+        pfPop       : std_logic;                                    --! Prefetch fifo was read in the last cycle
+        --output of the delayed frames
+        outState    : tOutState;                                    --! State of the output
+        due         : unsigned(cTimeWidth-1 downto 0);              --! Point of time of the next frame
+        outCnt      : unsigned(cCntWidth-1 downto 0);               --! Remaining dibits of the frame
+        outIdx      : unsigned(3 downto 0);                         --! Dibit within the current word
+        outWord     : std_logic_vector(31 downto 0);                --! Current word of the frame
+        outGap      : unsigned(cGapWidth-1 downto 0);               --! Gap before the frame
+        idle        : unsigned(cGapWidth-1 downto 0);               --! Idle cycles after the last frame
+    end record;
+
+    --! Init for registers
+    constant cRegInit   : tReg :=(
+                                time        => (others=>'0'),
+                                latency     => (others=>'0'),
+                                flush       => '0',
+                                frames      => (others=>'0'),
+                                error       => '0',
+                                txDv        => '0',
+                                capture     => '0',
+                                capValid    => '0',
+                                capIdx      => (others=>'0'),
+                                capCnt      => (others=>'0'),
+                                capWord     => (others=>'0'),
+                                capGap      => to_unsigned(cMaxGap, cGapWidth),
+                                capFrameGap => (others=>'0'),
+                                pushEnd     => '0',
+                                wrState     => sWrPop,
+                                entry       => (others=>'0'),
+                                drop        => '0',
+                                frameOpen   => '0',
+                                commit      => '0',
+                                wrReq       => '0',
+                                wrAddr      => (others=>'0'),
+                                wrData      => (others=>'0'),
+                                wrPtr       => (others=>'0'),
+                                hdrPtr      => (others=>'0'),
+                                commitPtr   => (others=>'0'),
+                                rdPtr       => (others=>'0'),
+                                mState      => sMIdle,
+                                mAddr       => (others=>'0'),
+                                mData       => (others=>'0'),
+                                pfUsed      => (others=>'0'),
+                                pfWords     => (others=>'0'),
+                                pfPop       => '0',
+                                outState    => sOutDue,
+                                due         => (others=>'0'),
+                                outCnt      => (others=>'0'),
+                                outIdx      => (others=>'0'),
+                                outWord     => (others=>'0'),
+                                outGap      => (others=>'0'),
+                                idle        => to_unsigned(cMaxGap, cGapWidth)
+                                );
+
+    signal reg          : tReg; --! Registers
+    signal reg_next     : tReg; --! Next value of registers
+
+    signal latencySetting   : unsigned(cTimeWidth-1 downto 0);  --! Latency of the task in 20ns
+    signal startFrame       : std_logic;    --! First dibit of a frame of the Frame_Creator
+    signal useLine          : std_logic;    --! New frame enters the line
+    signal captureFrame     : std_logic;    --! Current frame enters the line
+
+    --capture fifo
+    signal capWr        : std_logic;                        --! Write capture fifo
+    signal capRd        : std_logic;                        --! Read capture fifo
+    signal capWrData    : std_logic_vector(33 downto 0);    --! Entry to the capture fifo
+    signal capRdData    : std_logic_vector(33 downto 0);    --! Entry of the capture fifo
+    signal capFull      : std_logic;                        --! Capture fifo is full
+    signal capEmpty     : std_logic;                        --! Capture fifo is empty
+
+    --prefetch fifo
+    signal pfRd         : std_logic;                        --! Read prefetch fifo
+    signal pfRdData     : std_logic_vector(31 downto 0);    --! Word of the prefetch fifo
+    signal pfEmpty      : std_logic;                        --! Prefetch fifo is empty
+
+    --output
+    signal lineData     : std_logic_vector(1 downto 0);     --! Dibit of the delayed frame
+    signal lineDv       : std_logic;                        --! Delayed frame is sent
+
+begin
+
+    --! @brief Registers
+    --! - Storing with asynchronous reset
+    registers :
+    process(iClk, iReset)
+    begin
+        if iReset='1' then
+            reg <= cRegInit;
+
+        elsif rising_edge(iClk) then
+            reg <= reg_next;
+
+        end if;
+    end process;
+
+
+    --latency in 20ns, limited to the half timeline for the comparison with the point of time
+    latencySetting  <= (cTimeWidth-1 => '0', others => '1')
+                        when unsigned(iLatency(gLatencyWidth-1 downto cTimeWidth))/=0 else
+                       resize(unsigned(iLatency(cTimeWidth-1 downto 1)), cTimeWidth);
+
+    startFrame      <= '1' when iTxDV='1' and reg.txDv='0' else '0';
+
+    --frames enter the line, as long as there are delayed frames left
+    useLine         <= '1' when reg.latency/=0 or reg.frames/=0 else '0';
+
+    captureFrame    <= useLine when startFrame='1' else reg.capture;
+
+
+    --! @brief Next register value logic
+    --! - Storing of the latency and capture of the frames into the capture fifo
+    --! - Writing of the ring buffer and prefetching of the complete frames
+    --! - Output of the delayed frames at their point of time
+    nextComb :
+    process(reg, iTestActive, iTestStop, iTaskLineEn, latencySetting, iTxData, iTxDV, startFrame,
+            useLine, captureFrame, capFull, capEmpty, capRdData, pfEmpty, pfRdData, iM_waitrequest,
+            iM_readdatavalid)
+        variable vValid     : std_logic;                                --! Start of the frame was stored
+        variable vIdx       : unsigned(3 downto 0);                     --! Dibit within the word
+        variable vCnt       : unsigned(cCntWidth-1 downto 0);           --! Number of dibits of the frame
+        variable vWord      : std_logic_vector(31 downto 0);            --! Collected dibits
+        variable vError     : std_logic;                                --! Overflow of the line
+        variable vFrames    : unsigned(cCntWidth-1 downto 0);           --! Number of frames in the line
+        variable vPfUsed    : unsigned(gPrefetchAddrWidth downto 0);    --! Used words of the prefetch fifo
+        variable vPfWords   : unsigned(gPrefetchAddrWidth downto 0);    --! Words in the prefetch fifo
+        variable vPfRd      : std_logic;                                --! Read prefetch fifo
+        variable vHeadValid : std_logic;                                --! First word of the prefetch fifo is valid
+        variable vHdrPtr    : unsigned(cWordAddrWidth-1 downto 0);      --! Header of the new frame
+    begin
+        reg_next    <= reg;
+
+        capWr       <= '0';
+        capWrData   <= (others=>'0');
+        capRd       <= '0';
+
+        vError      := '0';
+        vFrames     := reg.frames;
+        vPfUsed     := reg.pfUsed;
+        vPfWords    := reg.pfWords;
+        vPfRd       := '0';
+
+        reg_next.time   <= reg.time+1;
+
+
+        --latency of the task until the end of the series of test
+        if iTestStop='1' then
+            reg_next.latency    <= (others=>'0');
+            reg_next.flush      <= '1';
+
+        elsif iTestActive='0' then
+            reg_next.latency    <= (others=>'0');
+
+        elsif iTaskLineEn='1' then
+            reg_next.latency    <= latencySetting;
+
+        end if;
+
+        if reg.flush='1' and reg.frames=0 and iTestStop='0' then
+            reg_next.flush      <= '0';
+        end if;
+
+
+        --capture of the frames----------------------------------------------------------
+        reg_next.txDv   <= iTxDV;
+
+        if iTxDV='1' then
+            reg_next.capGap <= (others=>'0');
+        elsif reg.capGap/=cMaxGap then
+            reg_next.capGap <= reg.capGap+1;
+        end if;
+
+        vValid  := reg.capValid;
+        vIdx    := reg.capIdx;
+        vCnt    := reg.capCnt;
+        vWord   := reg.capWord;
+
+        --start of frame with its point of time
+        if startFrame='1' then
+            reg_next.capture    <= useLine;
+            reg_next.capFrameGap <= reg.capGap;
+            vValid  := '0';
+            vIdx    := (others=>'0');
+            vCnt    := (others=>'0');
+
+            if useLine='1' then
+                if capFull='0' then
+                    capWr       <= '1';
+                    capWrData   <= cEntryStart & std_logic_vector(reg.time+reg.latency);
+                    vValid      := '1';
+                    vFrames     := vFrames+1;
+
+                else
+                    vError      := '1';
+
+                end if;
+            end if;
+        end if;
+
+        if iTxDV='1' and captureFrame='1' and vValid='1' then
+            --collect dibit
+            for i in 0 to 15 loop
+                if vIdx=i then
+                    vWord(2*i+1 downto 2*i) := iTxData;
+                end if;
+            end loop;
+
+            vCnt    := vCnt+1;
+
+            if vIdx=15 then
+                if capFull='0' then
+                    capWr       <= '1';
+                    capWrData   <= cEntryData & vWord;
+                else
+                    vError      := '1';
+                end if;
+            end if;
+
+            vIdx    := vIdx+1;
+
+        elsif iTxDV='0' and reg.txDv='1' and reg.capture='1' and reg.capValid='1' then
+            --end of frame: last word and number of dibits
+            if capFull='1' then
+                vError  := '1';
+
+            elsif vIdx/=0 then
+                capWr       <= '1';
+                capWrData   <= cEntryData & vWord;
+                reg_next.pushEnd    <= '1';
+
+            else
+                capWr       <= '1';
+                capWrData   <= cEntryEnd & std_logic_vector(resize(reg.capFrameGap, 16)) & std_logic_vector(vCnt);
+
+            end if;
+
+        elsif reg.pushEnd='1' then
+            reg_next.pushEnd    <= '0';
+
+            if capFull='0' then
+                capWr       <= '1';
+                capWrData   <= cEntryEnd & std_logic_vector(resize(reg.capFrameGap, 16)) & std_logic_vector(vCnt);
+            else
+                vError      := '1';
+            end if;
+
+        end if;
+
+        reg_next.capValid   <= vValid;
+        reg_next.capIdx     <= vIdx;
+        reg_next.capCnt     <= vCnt;
+        reg_next.capWord    <= vWord;
+
+
+        --writer of the ring buffer------------------------------------------------------
+        case reg.wrState is
+            when sWrPop =>
+                if capEmpty='0' then
+                    capRd               <= '1';
+                    reg_next.entry      <= capRdData;
+                    reg_next.wrState    <= sWrEval;
+                end if;
+
+            when sWrEval =>
+                reg_next.wrState    <= sWrPop;
+
+                if reg.entry(33 downto 32)=cEntryStart then
+                    --header with point of time, number of dibits follows
+                    vHdrPtr := reg.wrPtr;
+
+                    if reg.frameOpen='1' then   --end of the last frame was lost
+                        vHdrPtr := reg.hdrPtr;
+                        vError  := '1';
+                        vFrames := vFrames-1;
+                    end if;
+
+                    reg_next.hdrPtr <= vHdrPtr;
+                    reg_next.wrPtr  <= vHdrPtr;
+
+                    if vHdrPtr+1=reg.rdPtr or vHdrPtr+2=reg.rdPtr then
+                        reg_next.drop       <= '1';
+                        reg_next.frameOpen  <= '0';
+                        vError              := '1';
+                        vFrames             := vFrames-1;
+
+                    else
+                        reg_next.drop       <= '0';
+                        reg_next.frameOpen  <= '1';
+                        reg_next.wrReq      <= '1';
+                        reg_next.wrAddr     <= vHdrPtr;
+                        reg_next.wrData     <= reg.entry(31 downto 0);
+                        reg_next.wrPtr      <= vHdrPtr+2;
+                        reg_next.wrState    <= sWrWait;
+
+                    end if;
+
+                elsif reg.entry(33 downto 32)=cEntryData and reg.drop='0' then
+                    --frame-data
+                    if reg.wrPtr+1=reg.rdPtr then
+                        reg_next.drop       <= '1';
+                        reg_next.frameOpen  <= '0';
+                        reg_next.wrPtr      <= reg.hdrPtr;  --remove frame
+                        vError              := '1';
+                        vFrames             := vFrames-1;
+
+                    else
+                        reg_next.wrReq      <= '1';
+                        reg_next.wrAddr     <= reg.wrPtr;
+                        reg_next.wrData     <= reg.entry(31 downto 0);
+                        reg_next.wrPtr      <= reg.wrPtr+1;
+                        reg_next.wrState    <= sWrWait;
+
+                    end if;
+
+                elsif reg.entry(33 downto 32)=cEntryEnd and reg.drop='0' then
+                    --number of dibits completes the frame
+                    reg_next.wrReq      <= '1';
+                    reg_next.wrAddr     <= reg.hdrPtr+1;
+                    reg_next.wrData     <= reg.entry(31 downto 0);
+                    reg_next.commit     <= '1';
+                    reg_next.wrState    <= sWrWait;
+
+                end if;
+
+            when sWrWait =>
+                if reg.mState=sMWrite and iM_waitrequest='0' then
+                    reg_next.wrState    <= sWrPop;
+
+                    if reg.commit='1' then
+                        reg_next.commit     <= '0';
+                        reg_next.frameOpen  <= '0';
+                        reg_next.commitPtr  <= reg.wrPtr;
+                    end if;
+                end if;
+
+        end case;
+
+
+        --Avalon master: writes before prefetching-----------------------------------------
+        case reg.mState is
+            when sMIdle =>
+                if reg.wrReq='1' then
+                    reg_next.wrReq  <= '0';
+                    reg_next.mAddr  <= reg.wrAddr;
+                    reg_next.mData  <= reg.wrData;
+                    reg_next.mState <= sMWrite;
+
+                elsif reg.rdPtr/=reg.commitPtr and reg.pfUsed<cPrefetchSize-1 then
+                    reg_next.mAddr  <= reg.rdPtr;
+                    reg_next.mState <= sMRead;
+                    vPfUsed         := vPfUsed+1;
+
+                end if;
+
+            when sMWrite =>
+                if iM_waitrequest='0' then
+                    reg_next.mState <= sMIdle;
+                end if;
+
+            when sMRead =>
+                if iM_waitrequest='0' then
+                    reg_next.rdPtr  <= reg.rdPtr+1;
+                    reg_next.mState <= sMIdle;
+                end if;
+
+        end case;
+
+        if iM_readdatavalid='1' then
+            vPfWords    := vPfWords+1;
+        end if;
+
+
+        --output of the delayed frames-----------------------------------------------------
+        --the word of the prefetch fifo follows one cycle after reading
+        vHeadValid  := not pfEmpty and not reg.pfPop;
+
+        if reg.idle/=cMaxGap then
+            reg_next.idle   <= reg.idle+1;
+        end if;
+
+        case reg.outState is
+            when sOutDue =>
+                if vHeadValid='1' then
+                    vPfRd               := '1';
+                    reg_next.due        <= unsigned(pfRdData);
+                    reg_next.outState   <= sOutCnt;
+                end if;
+
+            when sOutCnt =>
+                if vHeadValid='1' then
+                    vPfRd               := '1';
+                    reg_next.outCnt     <= unsigned(pfRdData(cCntWidth-1 downto 0));
+                    reg_next.outGap     <= unsigned(pfRdData(cCntWidth+cGapWidth-1 downto cCntWidth));
+                    reg_next.outState   <= sOutWait;
+                end if;
+
+            when sOutWait =>
+                if reg.outCnt=0 then
+                    reg_next.outState   <= sOutDue;
+                    vFrames             := vFrames-1;
+
+                elsif reg.idle+1>=reg.outGap and vHeadValid='1' and (signed(reg.time-reg.due)>=0 or reg.flush='1') and
+                      resize(reg.pfWords, cCntWidth)>=shift_right(reg.outCnt+15, 4) then
+                    vPfRd               := '1';
+                    reg_next.outWord    <= pfRdData;
+                    reg_next.outIdx     <= (others=>'0');
+                    reg_next.outState   <= sOutSend;
+
+                end if;
+
+            when sOutSend =>
+                reg_next.outCnt     <= reg.outCnt-1;
+                reg_next.outIdx     <= reg.outIdx+1;
+
+                if reg.outCnt=1 then
+                    reg_next.outState   <= sOutDue;
+                    reg_next.idle       <= (others=>'0');
+                    vFrames             := vFrames-1;
+
+                elsif reg.outIdx=15 then
+                    vPfRd               := '1';
+                    reg_next.outWord    <= pfRdData;
+
+                end if;
+
+        end case;
+
+        if vPfRd='1' then
+            vPfUsed     := vPfUsed-1;
+            vPfWords    := vPfWords-1;
+        end if;
+
+        pfRd                <= vPfRd;
+        reg_next.pfPop      <= vPfRd;
+        reg_next.pfUsed     <= vPfUsed;
+        reg_next.pfWords    <= vPfWords;
+        reg_next.frames     <= vFrames;
+        reg_next.error      <= vError;
+
+    end process;
+
+
+    --! @brief Fifo of the captured frames
+    CapFifo : entity work.FiFo_top
+    generic map(
+                gDataWidth  => capWrData'length,
+                gAddrWidth  => cCapAddrWidth
+                )
+    port map(
+            iClk    => iClk,
+            iReset  => iReset,
+            iRd     => capRd,
+            iWr     => capWr,
+            iWrData => capWrData,
+            oFull   => capFull,
+            oEmpty  => capEmpty,
+            oRdData => capRdData
+            );
+
+
+    --! @brief Prefetch fifo of the complete frames
+    PrefetchFifo : entity work.FiFo_top
+    generic map(
+                gDataWidth  => iM_readdata'length,
+                gAddrWidth  => gPrefetchAddrWidth
+                )
+    port map(
+            iClk    => iClk,
+            iReset  => iReset,
+            iRd     => pfRd,
+            iWr     => iM_readdatavalid,
+            iWrData => iM_readdata,
+            oFull   => open,
+            oEmpty  => pfEmpty,
+            oRdData => pfRdData
+            );
+
+
+    --Avalon master
+    oM_address      <= std_logic_vector(to_unsigned(gLineBase, 32)+shift_left(resize(reg.mAddr, 32), 2));
+    oM_write        <= '1' when reg.mState=sMWrite else '0';
+    oM_writedata    <= reg.mData;
+    oM_read         <= '1' when reg.mState=sMRead else '0';
+
+    oError_lineOv   <= reg.error;
+
+
+    --! @brief Selection of the current dibit
+    dibitMux :
+    process(reg)
+    begin
+        lineData    <= (others=>'0');
+
+        for i in 0 to 15 loop
+            if reg.outIdx=i then
+                lineData    <= reg.outWord(2*i+1 downto 2*i);
+            end if;
+        end loop;
+    end process;
+
+    lineDv      <= '1' when reg.outState=sOutSend else '0';
+
+    --delayed frames or directly passed frames
+    oTxDV       <= lineDv or (iTxDV and not captureFrame);
+    oTxData     <= lineData when lineDv='1' else
+                   iTxData  when captureFrame='0' else
+                   (others=>'0');
+    oTxEr       <= iTxEr when lineDv='0' and captureFrame='0' else '0';
+
+
+end two_seg_arch;
@@ -45,6 +45,8 @@ use ieee.numeric_std.all;
 
 --! Use work library
 library work;
+--! use fm library
+use work.framemanipulatorPkg.all;
 
 --! Common library
 library libcommon;
@@ -61,10 +63,14 @@ entity Frame_Creator is
     port(
         iClk                : in std_logic;         --! clk
         iReset              : in std_logic;         --! reset
+        iTestActive         : in std_logic;         --! Series of test is active
 
         iStartNewFrame      : in std_logic;         --! data for a new frame is available
         oNextFrame          : out std_logic;        --! frame-creator is ready for new data
         iDistCrcEn          : in std_logic;         --! task: distortion of frame-CRC
+        iFrameIpg           : in std_logic_vector(cCreateTime.ipgWidth-1 downto 0);  --! Inter packet gap before the new frame in Byte
+        iPhyFault           : in std_logic_vector(cSettingSize.phy-1 downto 0);     --! Setting of the PHY faults of the new frame
+        oBitErrors          : out std_logic_vector(4*cByteLength-1 downto 0);       --! Number of bits flipped by the BER task
         --Read data buffer
         iDataStartAddr      : in std_logic_vector(gDataBuffAddrWidth-1 downto 0);   --! Position of the first frame-byte
         iDataEndAddr        : in std_logic_vector(gDataBuffAddrWidth-1 downto 0);   --! Position of the last
@@ -80,7 +86,8 @@ entity Frame_Creator is
         oExchangeData       : out std_logic;                                --! Exchanging safety data
         --Output
         oTxData             : out std_logic_vector(1 downto 0); --! frame-output-data
-        oTxDV               : out std_logic                     --! frame-output-data-valid
+        oTxDV               : out std_logic;                    --! frame-output-data-valid
+        oTxEr               : out std_logic                     --! frame-output-TX-error
     );
 end Frame_Creator;
 
@@ -91,8 +98,13 @@ end Frame_Creator;
 --! - Creates a new frame, when iStartNewFrame is set. It generates a new Preamble and a
 --!   valid or manipulated CRC. The frame-data are collected from iDataStartAddr to
 --!   iDataEndAddr.
---! - Once a frame was sent out, it activates oNextFrame to receive the next one. Thereby,
---!   the IPG (Inter Packet Gap) is considered by a small delay.
+--! - Once a frame was sent out, it activates oNextFrame to receive the next one. The new
+--!   frame starts after its IPG (Inter Packet Gap) iFrameIpg, which is 960 ns for frames
+--!   without an IPG manipulation.
+--! - The PHY task shortens the preamble, replaces the SFD, aborts the frame, sets the TX
+--!   error or appends dribble dibits in the module Phy_Fault at the output.
+--! - The BER task flips random bits of the whole stream including the CRC in the module
+--!   Bit_Error behind Phy_Fault.
 architecture two_seg_arch of Frame_Creator is
 
     signal preambleActive   : std_logic;    --! Preamble will be generated
@@ -113,6 +125,11 @@ architecture two_seg_arch of Frame_Creator is
     signal txdCrc           : std_logic_vector(1 downto 0);             --! Stream of calculated CRC
 
     signal temp_txdMux      : std_logic_vector(cByteLength-1 downto 0); --! Finished stream (temp)
+    signal txData           : std_logic_vector(1 downto 0);             --! Stream of the new frame
+    signal txDv             : std_logic;                                --! Data valid of the new frame
+    signal nextFrame        : std_logic;                                --! FSM is ready for the next frame
+    signal phyTxData        : std_logic_vector(1 downto 0);             --! Stream with PHY faults
+    signal phyTxDv          : std_logic;                                --! Data valid with PHY faults
 
 begin
 
@@ -132,6 +149,7 @@ begin
         iClk                => iClk,
         iReset              => iReset,
         iFrameStart         => iStartNewFrame,
+        iFrameIpg           => iFrameIpg,
         iReadBuffDone       => readdone,
         iPacketExchangeEn   => iPacketExchangeEn,
         iPacketStart        => iPacketStart,
@@ -142,10 +160,12 @@ begin
         oReadBuffActive     => readBuffActive,
         oCrcActive          => crcActive,
         oSelectTX           => txdSelection,
-        oNextFrame          => oNextFrame,
-        oTXDV               => oTXDV
+        oNextFrame          => nextFrame,
+        oTXDV               => txDv
         );
 
+    oNextFrame      <= nextFrame;
+
     oExchangeData   <= ExchangeData;
 
     --! @brief preamble generator
@@ -224,7 +244,48 @@ begin
     port map(
             iData   => temp_txdMux,
             iSel    => txdSelection,
-            oWord   => oTxData
+            oWord   => txData
+            );
+
+
+    --! @brief PHY faults
+    --! - stores the setting with the start of the frame
+    --! - manipulates the preamble, SFD, end of frame and TX error of the stream
+    Phy : entity work.Phy_Fault
+    generic map(gSettingWidth   => cSettingSize.phy)
+    port map(
+            iClk            => iClk,
+            iReset          => iReset,
+            iStartNewFrame  => iStartNewFrame,
+            iNextFrame      => nextFrame,
+            iPhySetting     => iPhyFault,
+            iTxData         => txData,
+            iTxDV           => txDv,
+            oTxData         => phyTxData,
+            oTxDV           => phyTxDv,
+            oTxEr           => oTxEr
+            );
+
+    oTxDV   <= phyTxDv;
+
+
+    --! @brief Bit errors
+    --! - stores the setting with the start of the frame
+    --! - flips random bits of the frames of the BER task and counts them
+    BER : entity work.Bit_Error
+    generic map(gSettingWidth   => cSettingSize.phy,
+                gCntWidth       => oBitErrors'length)
+    port map(
+            iClk            => iClk,
+            iReset          => iReset,
+            iTestActive     => iTestActive,
+            iStartNewFrame  => iStartNewFrame,
+            iNextFrame      => nextFrame,
+            iPhySetting     => iPhyFault,
+            oBitErrors      => oBitErrors,
+            iTxData         => phyTxData,
+            iTxDV           => phyTxDv,
+            oTxData         => oTxData
             );
 
 
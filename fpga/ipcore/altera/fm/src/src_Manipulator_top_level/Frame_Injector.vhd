@@ -0,0 +1,371 @@
+-------------------------------------------------------------------------------
+--! @file Frame_Injector.vhd
+--! @brief Injects template frames, when the Frame-Creator is idle
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+--! Use standard ieee library
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+--! Use work library
+library work;
+--! use fm library
+use work.framemanipulatorPkg.all;
+
+--! Common library
+library libcommon;
+--! Use common library global package
+use libcommon.global.all;
+
+
+--! This is the entity of the injector of template frames
+entity Frame_Injector is
+    generic(gDataBuffAddrWidth  : natural := 11;                --! Address width of frame buffer
+            gInjectAddrWidth    : natural := 10;                --! Address width of the template memory
+            gTaskWordWidth      : natural := 8*cByteLength;     --! Width of task setting
+            gManiSettingWidth   : natural := 14*cByteLength     --! Width of whole setting
+            );
+    port(
+        iClk                : in std_logic;     --! clk
+        iReset              : in std_logic;     --! reset
+        --control signals
+        iTestActive         : in std_logic;     --! Series of test is active
+        iStopTest           : in std_logic;     --! Abort of the series of test
+        iFrameIsSoc         : in std_logic;     --! Current frame is a SoC
+        iTaskInjectEn       : in std_logic;     --! task: inject template frames
+        iManiSetting        : in std_logic_vector(gManiSettingWidth-1 downto 0);    --! Setting of the inject task
+        --Process-Unit
+        iStartNewFrame      : in std_logic;                                         --! data of a stored frame is available
+        iFrameReady         : in std_logic;                                         --! a stored frame is ready to be created
+        oNextFrame          : out std_logic;                                        --! Frame-Creator is ready for a stored frame
+        iDistCrcEn          : in std_logic;                                         --! CRC distortion of the stored frame
+        iFrameIpg           : in std_logic_vector(cCreateTime.ipgWidth-1 downto 0); --! IPG before the stored frame
+        iPhyFault           : in std_logic_vector(cSettingSize.phy-1 downto 0);     --! PHY faults of the stored frame
+        iDataStartAddr      : in std_logic_vector(gDataBuffAddrWidth-1 downto 0);   --! Start address of the stored frame
+        iDataEndAddr        : in std_logic_vector(gDataBuffAddrWidth-1 downto 0);   --! End address of the stored frame
+        iBuffData           : in std_logic_vector(cByteLength-1 downto 0);          --! Data of the stored frame
+        iPacketExchangeEn   : in std_logic;                                         --! Start of the exchange of the safety packet
+        iPacketExtension    : in std_logic;                                         --! Exchange will be extended for several tacts
+        --Frame-Creator
+        oStartNewFrame      : out std_logic;                                        --! data for a new frame is available
+        iNextFrame          : in std_logic;                                         --! Frame-Creator is ready for new data
+        oDistCrcEn          : out std_logic;                                        --! CRC distortion of the new frame
+        oFrameIpg           : out std_logic_vector(cCreateTime.ipgWidth-1 downto 0);--! IPG before the new frame
+        oPhyFault           : out std_logic_vector(cSettingSize.phy-1 downto 0);    --! PHY faults of the new frame
+        oDataStartAddr      : out std_logic_vector(gDataBuffAddrWidth-1 downto 0);  --! Start address of the new frame
+        oDataEndAddr        : out std_logic_vector(gDataBuffAddrWidth-1 downto 0);  --! End address of the new frame
+        iRdBuffAddr         : in std_logic_vector(gDataBuffAddrWidth-1 downto 0);   --! Read address of the Frame-Creator
+        iRdBuffEn           : in std_logic;                                         --! Read enable of the Frame-Creator
+        oData               : out std_logic_vector(cByteLength-1 downto 0);         --! Data of the new frame
+        oPacketExchangeEn   : out std_logic;                                        --! Start of the exchange of the safety packet
+        oPacketExtension    : out std_logic;                                        --! Exchange will be extended for several tacts
+        --Template memory
+        oInjectRdAddr       : out std_logic_vector(gInjectAddrWidth-1 downto 0);    --! Read address of the template memory
+        oInjectRdEn         : out std_logic;                                        --! Read enable of the template memory
+        iInjectData         : in std_logic_vector(cByteLength-1 downto 0)           --! Data of the template memory
+    );
+end Frame_Injector;
+
+
+--! @brief Frame_Injector architecture
+--! @details Injects copies of a template frame into the idle slots of the Frame-Creator
+--! - The inject task is stored at the edge of its enable signal. The triggering frame
+--!   passes unchanged.
+--! - A new copy is started, when the Frame-Creator is ready and there is no stored frame
+--!   waiting. Stored frames are always preferred, the Process-Unit is blocked only while a
+--!   copy is created.
+--! - The copies are sent with the IPG of the setting until the number of copies was sent,
+--!   the window of SoCs has passed or the test was stopped. A setting of 0 disables the
+--!   respective limit.
+--! - Up to two Bytes of each copy are incremented by a fixed step. The template memory has
+--!   a latency of one cycle, the additional output register matches the latency of the
+--!   frame buffer.
+architecture two_seg_arch of Frame_Injector is
+
+    --! Typedef for states
+    type tMcState is
+        (
+        sIdle,      --! Frame-Creator is used by the Process-Unit
+        sStart,     --! Start a new copy
+        sActive     --! Copy is created
+        );
+
+    --! Typedef for registers
+    type tReg is record
+        state           : tMcState;                                             --! State of the injection
+        taskInjectEn    : std_logic;                                            --! Register for edge detection of iTaskInjectEn
+        frameIsSoc      : std_logic;                                            --! Register for edge detection of iFrameIsSoc
+        injectActive    : std_logic;                                            --! Copies are pending
+        start           : std_logic_vector(cParam.sizeInjectSetting-1 downto 0);--! Start of the template in Byte
+        size            : std_logic_vector(cParam.sizeInjectSetting-1 downto 0);--! Size of the template without CRC
+        count           : std_logic_vector(cParam.sizeInjectSetting-1 downto 0);--! Remaining copies
+        gap             : std_logic_vector(cCreateTime.ipgWidth-1 downto 0);    --! IPG before each copy
+        window          : std_logic_vector(cByteLength-1 downto 0);             --! Remaining SoCs
+        countEn         : std_logic;                                            --! Number of copies is limited
+        windowEn        : std_logic;                                            --! Number of SoCs is limited
+        incOffset       : std_logic_vector(cParam.noOfInjectInc*cByteLength-1 downto 0);   --! Offsets of the incremented Bytes
+        incStep         : std_logic_vector(cParam.noOfInjectInc*cByteLength-1 downto 0);   --! Steps of the incremented Bytes
+        incValue        : std_logic_vector(cParam.noOfInjectInc*cByteLength-1 downto 0);   --! Increments of the current copy
+        rdAddr          : std_logic_vector(gDataBuffAddrWidth-1 downto 0);      --! Delayed read address
+        data            : std_logic_vector(cByteLength-1 downto 0);             --! Output register of the template data
+    end record;
+
+
+    --! Init for registers
+    constant cRegInit   : tReg :=(
+                                state           => sIdle,
+                                taskInjectEn    => '0',
+                                frameIsSoc      => '0',
+                                injectActive    => '0',
+                                start           => (others=>'0'),
+                                size            => (others=>'0'),
+                                count           => (others=>'0'),
+                                gap             => (others=>'0'),
+                                window          => (others=>'0'),
+                                countEn         => '0',
+                                windowEn        => '0',
+                                incOffset       => (others=>'0'),
+                                incStep         => (others=>'0'),
+                                incValue        => (others=>'0'),
+                                rdAddr          => (others=>'0'),
+                                data            => (others=>'0')
+                                );
+
+    signal reg          : tReg; --! Registers
+    signal reg_next     : tReg; --! Next value of registers
+
+    signal taskInjectEn_posEdge : std_logic;    --! positive edge of iTaskInjectEn
+    signal frameIsSoc_posEdge   : std_logic;    --! positive edge of iFrameIsSoc
+    signal injectSel            : std_logic;    --! Frame-Creator is used for a copy
+    signal copyDone             : std_logic;    --! Copy was sent
+
+
+    --! Start of the template in the task setting
+    alias iManiSetting_start    : std_logic_vector(cParam.sizeInjectSetting-1 downto 0)
+                                    is iManiSetting(gTaskWordWidth+3*cParam.sizeInjectSetting-1 downto gTaskWordWidth+2*cParam.sizeInjectSetting);
+
+    --! Size of the template in the task setting
+    alias iManiSetting_size     : std_logic_vector(cParam.sizeInjectSetting-1 downto 0)
+                                    is iManiSetting(gTaskWordWidth+2*cParam.sizeInjectSetting-1 downto gTaskWordWidth+cParam.sizeInjectSetting);
+
+    --! Number of copies in the task setting
+    alias iManiSetting_count    : std_logic_vector(cParam.sizeInjectSetting-1 downto 0)
+                                    is iManiSetting(gTaskWordWidth+cParam.sizeInjectSetting-1 downto gTaskWordWidth);
+
+    --! IPG of the copies in the task setting
+    alias iManiSetting_gap      : std_logic_vector(cCreateTime.ipgWidth-1 downto 0)
+                                    is iManiSetting(gTaskWordWidth-1 downto gTaskWordWidth-cCreateTime.ipgWidth);
+
+    --! Window of SoCs in the task setting
+    alias iManiSetting_window   : std_logic_vector(cByteLength-1 downto 0)
+                                    is iManiSetting(gTaskWordWidth-cCreateTime.ipgWidth-1 downto gTaskWordWidth-cCreateTime.ipgWidth-cByteLength);
+
+    --! Offsets and steps of the incremented Bytes in the task setting
+    alias iManiSetting_inc      : std_logic_vector(2*cParam.noOfInjectInc*cByteLength-1 downto 0)
+                                    is iManiSetting(gTaskWordWidth-cCreateTime.ipgWidth-cByteLength-1 downto gTaskWordWidth-cCreateTime.ipgWidth-cByteLength-2*cParam.noOfInjectInc*cByteLength);
+
+begin
+
+    --! @brief Registers
+    --! - Storing with asynchronous reset
+    registers :
+    process(iClk, iReset)
+    begin
+        if iReset='1' then
+            reg <= cRegInit;
+
+        elsif rising_edge(iClk) then
+            reg <= reg_next;
+
+        end if;
+    end process;
+
+
+    taskInjectEn_posEdge    <= '1' when reg.taskInjectEn='0' and iTaskInjectEn='1' else '0';
+    frameIsSoc_posEdge      <= '1' when reg.frameIsSoc='0' and iFrameIsSoc='1' else '0';
+
+    --copy was sent, when the Frame-Creator is ready again
+    copyDone    <= '1' when reg.state=sActive and iNextFrame='1' else '0';
+
+
+    --! @brief Next register value logic
+    --! - Storing of the setting at the edge of the task enable
+    --! - Counting of the copies and SoCs
+    --! - Selection of the Frame-Creator
+    --! - Increment of the Bytes of the template
+    nextComb :
+    process(reg, iTaskInjectEn, iFrameIsSoc, taskInjectEn_posEdge, frameIsSoc_posEdge, copyDone,
+            iManiSetting, iTestActive, iStopTest, iNextFrame, iFrameReady, iStartNewFrame,
+            iRdBuffAddr, iInjectData)
+    begin
+        reg_next    <= reg;
+
+        reg_next.taskInjectEn   <= iTaskInjectEn;
+        reg_next.frameIsSoc     <= iFrameIsSoc;
+
+        --store setting of a new task
+        if taskInjectEn_posEdge='1' then
+            reg_next.injectActive   <= '1';
+            reg_next.start          <= iManiSetting_start;
+            reg_next.size           <= iManiSetting_size;
+            reg_next.count          <= iManiSetting_count;
+            reg_next.gap            <= iManiSetting_gap;
+            reg_next.window         <= iManiSetting_window;
+            reg_next.incValue       <= (others=>'0');
+
+            if unsigned(iManiSetting_count)/=0 then
+                reg_next.countEn    <= '1';
+            else
+                reg_next.countEn    <= '0';
+            end if;
+
+            if unsigned(iManiSetting_window)/=0 then
+                reg_next.windowEn   <= '1';
+            else
+                reg_next.windowEn   <= '0';
+            end if;
+
+            for i in cParam.noOfInjectInc-1 downto 0 loop
+                reg_next.incOffset((i+1)*cByteLength-1 downto i*cByteLength)
+                    <= iManiSetting_inc((2*i+2)*cByteLength-1 downto (2*i+1)*cByteLength);
+                reg_next.incStep((i+1)*cByteLength-1 downto i*cByteLength)
+                    <= iManiSetting_inc((2*i+1)*cByteLength-1 downto 2*i*cByteLength);
+            end loop;
+
+        else
+            --sent copy
+            if copyDone='1' then
+                for i in cParam.noOfInjectInc-1 downto 0 loop
+                    reg_next.incValue((i+1)*cByteLength-1 downto i*cByteLength)
+                        <= std_logic_vector(unsigned(reg.incValue((i+1)*cByteLength-1 downto i*cByteLength))
+                                            +unsigned(reg.incStep((i+1)*cByteLength-1 downto i*cByteLength)));
+                end loop;
+
+                if reg.countEn='1' then
+                    reg_next.count  <= std_logic_vector(unsigned(reg.count)-1);
+
+                    if unsigned(reg.count)=1 then
+                        reg_next.injectActive   <= '0';     --all copies were sent
+                    end if;
+
+                end if;
+
+            end if;
+
+            --passed SoC
+            if frameIsSoc_posEdge='1' and reg.windowEn='1' then
+                reg_next.window <= std_logic_vector(unsigned(reg.window)-1);
+
+                if unsigned(reg.window)=1 then
+                    reg_next.injectActive   <= '0';         --window has passed
+                end if;
+
+            end if;
+
+        end if;
+
+        --end of the series of test
+        if iTestActive='0' or iStopTest='1' then
+            reg_next.injectActive   <= '0';
+        end if;
+
+
+        --selection of the Frame-Creator
+        case reg.state is
+            when sIdle =>
+                if reg.injectActive='1' and iNextFrame='1' and iFrameReady='0' and iStartNewFrame='0' then
+                    reg_next.state  <= sStart;      --Frame-Creator isn't needed for a stored frame
+                end if;
+
+            when sStart =>
+                reg_next.state  <= sActive;         --Frame-Creator has started the copy
+
+            when sActive =>
+                if iNextFrame='1' then
+                    reg_next.state  <= sIdle;       --copy was sent
+                end if;
+
+        end case;
+
+
+        --template data with incremented Bytes
+        reg_next.rdAddr <= iRdBuffAddr;
+        reg_next.data   <= iInjectData;
+
+        for i in cParam.noOfInjectInc-1 downto 0 loop
+            if unsigned(reg.incOffset((i+1)*cByteLength-1 downto i*cByteLength))/=0 and
+                unsigned(reg.rdAddr)=unsigned(reg.incOffset((i+1)*cByteLength-1 downto i*cByteLength))-1 then
+                reg_next.data   <= std_logic_vector(unsigned(iInjectData)
+                                                    +unsigned(reg.incValue((i+1)*cByteLength-1 downto i*cByteLength)));
+            end if;
+        end loop;
+
+    end process;
+
+
+    injectSel   <= '0' when reg.state=sIdle else '1';
+
+
+    --Process-Unit is blocked during a copy
+    oNextFrame          <= iNextFrame when injectSel='0' else '0';
+
+    --Frame-Creator
+    oStartNewFrame      <= '1' when reg.state=sStart else iStartNewFrame;
+    oDistCrcEn          <= iDistCrcEn when injectSel='0' else '0';
+    oFrameIpg           <= iFrameIpg when injectSel='0' else
+                            reg.gap when unsigned(reg.gap)/=0 else
+                            std_logic_vector(to_unsigned(cCreateTime.ipgSize, oFrameIpg'length));
+    oPhyFault           <= iPhyFault when injectSel='0' else (others=>'0');
+
+    --template starts at address 0, end address includes 4 Bytes for the CRC
+    oDataStartAddr      <= iDataStartAddr when injectSel='0' else (others=>'0');
+    oDataEndAddr        <= iDataEndAddr when injectSel='0' else
+                            std_logic_vector(resize(unsigned(reg.size)+4, oDataEndAddr'length));
+    oData               <= iBuffData when injectSel='0' else reg.data;
+    oPacketExchangeEn   <= iPacketExchangeEn when injectSel='0' else '0';
+    oPacketExtension    <= iPacketExtension when injectSel='0' else '0';
+
+    --Template memory
+    oInjectRdAddr       <= std_logic_vector(resize(unsigned(reg.start), oInjectRdAddr'length)
+                                            +resize(unsigned(iRdBuffAddr), oInjectRdAddr'length));
+    oInjectRdEn         <= iRdBuffEn and injectSel;
+
+
+end two_seg_arch;
@@ -66,6 +66,9 @@ entity Frame_Receiver is
         iReset              : in std_logic;                                     --! reset
         iRXDV               : in std_logic;                                     --! frame data valid
         iRXD                : in std_logic_vector(1 downto 0);                  --! frame data (2bit)
+        --forwarding configuration
+        iForwardCfg         : in std_logic_vector(cByteLength-1 downto 0);      --! forwarding flags of cFwd
+        iEtherTypeCfg       : in std_logic_vector(cEth.noCfgEtherType*cEth.sizeEtherType-1 downto 0);   --! configured EtherTypes
         --write data
         oData               : out std_logic_vector(cByteLength-1 downto 0);     --! frame data (1byte)
         oWrBuffAddr         : out std_logic_vector(gBuffAddrWidth-1 downto 0);  --! write address
@@ -77,6 +80,8 @@ entity Frame_Receiver is
         iTaskCutData        : in std_logic_vector(gBuffAddrWidth-1 downto 0);   --! cut task setting
         --start process-unit
         oStartFrameProcess  : out std_logic;                                    --! valid frame received
+        oFrameTagged        : out std_logic;                                    --! frame has a VLAN tag
+        oFrameBypass        : out std_logic;                                    --! frame with unknown EtherType is forwarded without tasks
         oFrameEnded         : out std_logic;                                    --! frame ended
         oFrameSync          : out std_logic                                     --! synchronization signal
     );
@@ -86,7 +91,12 @@ end Frame_Receiver;
 --! @brief Frame_Receiver architecture
 --! @details Receives the incoming frame and stores it on the data-buffer
 --! - Only frames with a valid preamble and one of the Ethertypes of gEtherTypeFilter
---!   activates the start signal "oStartFrame" for the next process units.
+--!   or of the configured table iEtherTypeCfg activates the start signal "oStartFrame"
+--!   for the next process units.
+--! - With the flag passAll, frames of other Ethertypes are started as well, but marked
+--!   with oFrameBypass to be forwarded without manipulation.
+--! - With the flag vlan, the Ethertype of tagged frames is taken behind the VLAN tag
+--!   and the frame is marked with oFrameTagged.
 --! - It starts to write the data to the memory, starting with the address iDataStartAddr.
 --!   This position is sent by the process unit and overwrites invalid or dropped frames to
 --!   save some memory.
@@ -109,13 +119,23 @@ architecture two_seg_arch of Frame_Receiver is
     signal etherType            : std_logic_vector(cEth.SizeEtherType-1 downto 0);  --! Ethertype of current frame
     signal preambleOk           : std_logic:='0';                                   --! Preamble of frame is valid
     signal collectorFinished    : std_logic;                                        --! Ethertype is read from frame
+    signal vlanEtherType        : std_logic_vector(cEth.SizeEtherType-1 downto 0);  --! Ethertype behind the VLAN tag
+    signal vlanCollFinished     : std_logic;                                        --! Ethertype behind the VLAN tag is read
+    signal frameTagged          : std_logic;                                        --! Frame has a VLAN tag
+    signal frameEtherType       : std_logic_vector(cEth.SizeEtherType-1 downto 0);  --! Ethertype of the payload
+    signal typeFinished         : std_logic;                                        --! Ethertype of the payload is read
+    signal knownEtherType       : std_logic;                                        --! Ethertype is one of the filter or the table
 
     signal frameEnd             : std_logic;                                        --! Reached end of incoming frame
 
     signal matchFilter          : std_logic_vector(cNumbFilter-1 downto 0);         --! Filter(x) does match
+    signal matchCfg             : std_logic_vector(cEth.noCfgEtherType-1 downto 0); --! Configured Ethertype(x) does match
 
     signal startFrameProcess_reg    : std_logic;    --! Register of oStartFrameProcess to reduce path delay
     signal startFrameProcess_next   : std_logic;    --! Next value of register
+    signal frameTagged_reg          : std_logic;    --! Register of oFrameTagged
+    signal frameBypass_reg          : std_logic;    --! Register of oFrameBypass
+    signal frameBypass_next         : std_logic;    --! Next value of register
 
 
 begin
@@ -166,15 +186,51 @@ begin
             );
 
 
+    --! @brief Ethertype collector behind the VLAN tag
+    VlanEtherType_Collector : entity work.Frame_collector
+    generic map(
+                gFrom   => cEth.StartEtherType+cEth.sizeVlanTag,
+                gTo     => cEth.EndEtherType+cEth.sizeVlanTag
+                )
+    port map(
+            iClk                => iClk,
+            iReset              => iReset,
+            iData               => data,
+            iSync               => sync,
+            oFrameData          => vlanEtherType,
+            oCollectorFinished  => vlanCollFinished
+            );
+
+
+    --frame is tagged, when the first Ethertype is the TPID and tags are parsed
+    frameTagged     <= '1' when collectorFinished='1' and etherType=cEth.vlanTpid
+                                and iForwardCfg(cFwd.vlan)='1' else '0';
+
+    frameEtherType  <= vlanEtherType    when frameTagged='1' else etherType;
+    typeFinished    <= vlanCollFinished when frameTagged='1' else collectorFinished;
+
+
     --! Check of the Ethertype with the predefined values
     EthertypeMatch :
     for i in MatchFilter'range generate
 
-        matchFilter(i)  <=  '1' when etherType = cEtherTypeFilter(cEth.sizeEtherType*(i+1)-1 downto cEth.sizeEtherType*i) else '0';
+        matchFilter(i)  <=  '1' when frameEtherType = cEtherTypeFilter(cEth.sizeEtherType*(i+1)-1 downto cEth.sizeEtherType*i) else '0';
 
     end generate EthertypeMatch;
 
 
+    --! Check of the Ethertype with the configured table, unused entries are zero
+    EthertypeCfgMatch :
+    for i in matchCfg'range generate
+
+        matchCfg(i)     <=  '1' when frameEtherType = iEtherTypeCfg(cEth.sizeEtherType*(i+1)-1 downto cEth.sizeEtherType*i)
+                                    and frameEtherType /= (frameEtherType'range=>'0') else '0';
+
+    end generate EthertypeCfgMatch;
+
+    knownEtherType  <= reduceOr(matchFilter) or reduceOr(matchCfg);
+
+
 
     --write logic is enabled and stores data utill the frame has ended
     enWL    <= not frameEnd;
@@ -216,7 +272,13 @@ begin
 
 
     --  frame process can start, when the collection has finished with Preamble and one of the valid Ethertypes
-    startFrameProcess_next  <= '1' when collectorFinished='1' and preambleOk='1' and reduceOr(matchFilter)='1' else '0';
+    --  or with any Ethertype, when all frames are forwarded
+    startFrameProcess_next  <= '1' when typeFinished='1' and preambleOk='1'
+                                    and (knownEtherType='1' or iForwardCfg(cFwd.passAll)='1') else '0';
+
+    --  frames of unknown Ethertypes bypass the tasks
+    frameBypass_next        <= '1' when typeFinished='1' and preambleOk='1'
+                                    and knownEtherType='0' and iForwardCfg(cFwd.passAll)='1' else '0';
 
 
     --! @brief Registers
@@ -226,14 +288,20 @@ begin
     begin
         if iReset='1' then
             startFrameProcess_reg   <= '0';
+            frameTagged_reg         <= '0';
+            frameBypass_reg         <= '0';
 
         elsif rising_edge(iClk) then
             startFrameProcess_reg   <= startFrameProcess_next;
+            frameTagged_reg         <= frameTagged;
+            frameBypass_reg         <= frameBypass_next;
 
         end if;
     end process;
 
     oStartFrameProcess  <= startFrameProcess_reg;
+    oFrameTagged        <= frameTagged_reg;
+    oFrameBypass        <= frameBypass_reg;
 
 
     --signal output
@@ -46,6 +46,8 @@ use ieee.numeric_std.all;
 
 --! Use work library
 library work;
+--! use fm library
+use work.framemanipulatorPkg.all;
 
 --! Common library
 library libcommon;
@@ -56,12 +58,17 @@ use libcommon.global.all;
 --! This is the entity of the top-module with the interface between FM and PL-Slace
 entity Memory_Interface is
     generic(
-            gSlaveTaskWordWidth     : natural := 4*cByteLength; --! Word width of avalon bus for the transfer of tasks
+            gSlaveTaskWordWidth     : natural := 8*cByteLength; --! Word width of avalon bus for the transfer of tasks
             gSlaveTaskAddrWidth     : natural := 8;             --! Address width of avalon bus for the transfer of tasks
+            gSlaveTaskBurstWidth    : natural := 4;             --! Width of the burst count of the task slave
             gTaskWordWidth          : natural := 8*cByteLength; --! Word width of the tasks
             gTaskAddrWidth          : natural := 5;             --! Address width of the tasks
+            gTaskBanks              : natural := 1;             --! Number of banks of complete task tables
             gSlaveControlWordWidth  : natural := cByteLength;   --! Word width of avalon bus for FM control
-            gSlaveControlAddrWidth  : natural := 1              --! Address width of avalon bus for FM control
+            gSlaveControlAddrWidth  : natural := 5;             --! Address width of avalon bus for FM control
+            gSlaveInjectWordWidth   : natural := 4*cByteLength; --! Word width of avalon bus for the transfer of template frames
+            gSlaveInjectAddrWidth   : natural := 8;             --! Address width of avalon bus for the transfer of template frames
+            gInjectAddrWidth        : natural := 10             --! Address width of the template memory
             );
     port(
         iClk                    : in std_logic;                                             --! clk
@@ -74,6 +81,9 @@ entity Memory_Interface is
         iSt_read                 : in std_logic;                                                       --! Task avalon slave read enable
         oSt_readdata             : out std_logic_vector(gSlaveTaskWordWidth-1 downto 0);               --! Task avalon slave read data
         iSt_byteenable           : in std_logic_vector((gSlaveTaskWordWidth/cByteLength)-1 downto 0);  --! Task avalon slave byte enable
+        iSt_burstcount           : in std_logic_vector(gSlaveTaskBurstWidth-1 downto 0);               --! Task avalon slave burst count
+        oSt_waitrequest          : out std_logic;                                                      --! Task avalon slave wait request
+        oSt_readdatavalid        : out std_logic;                                                      --! Task avalon slave read data valid
         --Avalon Slave Contol Memory
         iSc_address              : in std_logic_vector(gSlaveControlAddrWidth-1 downto 0);             --! FM-control avalon slave address
         iSc_writedata            : in std_logic_vector(gSlaveControlWordWidth-1 downto 0);             --! FM-control avalon slave data write
@@ -81,21 +91,44 @@ entity Memory_Interface is
         iSc_read                 : in std_logic;                                                       --! FM-control avalon slave read enable
         oSc_readdata             : out std_logic_vector(gSlaveControlWordWidth-1 downto 0);            --! FM-control avalon slave read data
         iSc_byteenable           : in std_logic_vector(gSlaveControlWordWidth/cByteLength-1 downto 0); --! FM-control avalon slave byte enable
+        --Avalon Slave Template Memory
+        iSi_address              : in std_logic_vector(gSlaveInjectAddrWidth-1 downto 0);              --! Template avalon slave address
+        iSi_writedata            : in std_logic_vector(gSlaveInjectWordWidth-1 downto 0);              --! Template avalon slave data write
+        iSi_write                : in std_logic;                                                       --! Template avalon slave write enable
+        iSi_read                 : in std_logic;                                                       --! Template avalon slave read enable
+        oSi_readdata             : out std_logic_vector(gSlaveInjectWordWidth-1 downto 0);             --! Template avalon slave read data
+        iSi_byteenable           : in std_logic_vector(gSlaveInjectWordWidth/cByteLength-1 downto 0);  --! Template avalon slave byte enable
         --status signals
         iError_addrBuffOv       : in std_logic;                                             --!Error: Overflow address-buffer
         iError_frameBuffOv      : in std_logic;                                             --!Error: Overflow data-buffer
         iError_packetBuffOv     : in std_logic;                                             --!Error: Overflow packet-buffer
         iError_taskConf         : in std_logic;                                             --!Error: Wrong task configuration
+        iPacketOccupancy        : in std_logic_vector(2*gSlaveControlWordWidth-1 downto 0); --!Number of used slots of the packet buffer
         oStartTest              : out std_logic;                                            --!start a new series of test
         oStopTest               : out std_logic;                                            --!aborts the current test
         oClearMem               : out std_logic;                                            --!clear all tasks
         oResetPaketBuff         : out std_logic;                                            --!Resets the packet FIFO and removes the packet lag
         iTestActive             : in std_logic;                                             --!Series of test is active
+        oForwardCfg             : out std_logic_vector(cByteLength-1 downto 0);             --!Forwarding flags
+        oEtherTypeCfg           : out std_logic_vector(cEth.noCfgEtherType*cEth.sizeEtherType-1 downto 0);  --!Table of EtherTypes
+        oBankSelect             : out std_logic_vector(cByteLength-1 downto 0);             --!Selected bank of the tasks
+        oStartMode              : out std_logic_vector(cByteLength-1 downto 0);             --!Start mode of the test
+        oStartTime              : out std_logic_vector(cEth.sizeSocTime-1 downto 0);        --!SoC time of the start
+        iBitErrors              : in std_logic_vector(4*gSlaveControlWordWidth-1 downto 0); --!Number of bits flipped by the BER task
         --task signals
         iRdTaskAddr             : in std_logic_vector(gTaskAddrWidth-1 downto 0);           --!task selection
+        iTaskBank               : in std_logic_vector(cByteLength-1 downto 0);              --!bank of the task selection
         oTaskSettingData        : out std_logic_vector(2*gTaskWordWidth-1 downto 0);        --!settings of the task
+        oTaskValid              : out std_logic;                                            --!task has a setting other than zero since the last clear
+        oTaskRemain             : out std_logic;                                            --!task or one of the following tasks is valid
         oTaskCompFrame          : out std_logic_vector(gTaskWordWidth-1 downto 0);          --!header-data of the manipulated frame
-        oTaskCompMask           : out std_logic_vector(gTaskWordWidth-1 downto 0)           --!mask-data of the manipulated frame
+        oTaskCompMask           : out std_logic_vector(gTaskWordWidth-1 downto 0);          --!mask-data of the manipulated frame
+        oTaskWindowData         : out std_logic_vector(cParam.noOfFilterWindows*gTaskWordWidth-1 downto 0);  --!filter windows of the task
+        oTaskChainData          : out std_logic_vector(gTaskWordWidth-1 downto 0);          --!chain of the task
+        --template signals
+        iInjectRdAddr           : in std_logic_vector(gInjectAddrWidth-1 downto 0);         --!read address of the template memory
+        iInjectRdEn             : in std_logic;                                             --!read enable of the template memory
+        oInjectData             : out std_logic_vector(cByteLength-1 downto 0)              --!data of the template frame
     );
 end Memory_Interface;
 
@@ -103,13 +136,17 @@ end Memory_Interface;
 
 --! @brief Memory_Interface architecture
 --! @details Toplevel of Interface between FM and PL-Slace
---! - Transfer of the FM configuration via Avalon bus
+--! - Transfer of the FM configuration via Avalon bus, also with bursts of a DMA
+--! - Several banks of complete task tables, the bank in use is selected via the control register
 --! - Transfer of the control and status register via Avalon bus
+--! - Transfer of the template frames for the inject task via Avalon bus
 architecture two_seg_arch of Memory_Interface is
 
-    signal clearMem : std_logic;                                    --! Start clearing the task memory
-    signal clTask   : std_logic;                                    --! Clear task
-    signal taskAddr : std_logic_vector(gTaskAddrWidth-1 downto 0);  --! Task address
+    signal clearMem : std_logic;                                    --! Clear the task memory
+
+    signal slaveTaskAddr    : std_logic_vector(gSlaveTaskAddrWidth-1 downto 0); --! Task slave address of the current word
+    signal slaveTaskWrEn    : std_logic;                                        --! Task slave write of the current word
+    signal slaveTaskRdEn    : std_logic;                                        --! Task slave read of the current word
 
 
 begin
@@ -119,6 +156,9 @@ begin
     --! @brief Control register
     --! - Transfer of operations from PL-Slave to FM
     --! - Transfer of status- and error-flags to PL-Slave
+    --! - Transfer of the forwarding flags and the EtherType table to FM
+    --! - Transfer of the start mode and the start time to FM
+    --! - Transfer of the number of bit errors to PL-Slave
     C_Reg : entity work.Control_Register
     generic map(
                 gWordWidth      => gSlaveControlWordWidth,
@@ -139,6 +179,19 @@ begin
             iError_frameBuffOv      => iError_frameBuffOv,
             iError_packetBuffOv     => iError_packetBuffOv,
             iError_taskConf         => iError_taskConf,
+            --Monitoring
+            iPacketOccupancy        => iPacketOccupancy,
+            --Forwarding
+            oForwardCfg             => oForwardCfg,
+            oEtherTypeCfg           => oEtherTypeCfg,
+            --Task banks
+            oBankSelect             => oBankSelect,
+            iActiveBank             => iTaskBank,
+            --Start of the test
+            oStartMode              => oStartMode,
+            oStartTime              => oStartTime,
+            --Bit errors
+            iBitErrors              => iBitErrors,
             --avalon bus (s_clk-domain)
             iSt_addr                => iSc_address,
             iSt_writeData           => iSc_writedata,
@@ -153,50 +206,96 @@ begin
 
 
     ------------------------------------------------------------------------------------------
-    --! @brief Clear up task memory
-    --! - Deletes all tasks
-    T_Mem_Res : entity work.Task_Mem_Reset
-    generic map(gAddrWidth  => gTaskAddrWidth)
+    --! @brief Burst transfers of the task slave
+    --! - Addresses of the following words of a burst
+    --! - Read data valid one cycle after the address
+    T_Burst : entity work.Task_Mem_Burst
+    generic map(
+                gAddrWidth  => gSlaveTaskAddrWidth,
+                gBurstWidth => gSlaveTaskBurstWidth
+                )
     port map(
-            iClk            => iClk,
+            iClk            => iS_clk,
             iReset          => iReset,
-            iRdAddress      => iRdTaskAddr,
-            iClearMem       => clearMem,
-            oTaskMemAddr    => taskAddr,
-            oEnClear        => clTask
+            iAddress        => iSt_address,
+            iBurstcount     => iSt_burstcount,
+            iWrite          => iSt_write,
+            iRead           => iSt_read,
+            oWaitrequest    => oSt_waitrequest,
+            oReadDataValid  => oSt_readdatavalid,
+            oMemAddr        => slaveTaskAddr,
+            oMemWrEn        => slaveTaskWrEn,
+            oMemRdEn        => slaveTaskRdEn
             );
 
 
     ------------------------------------------------------------------------------------------
     --! @brief Task memory
-    --! - Port A: PL-Slave: one memory with 32bit word-width and the avalon bus clock domain
+    --! - Port A: PL-Slave: one memory with the word-width of the slave and the avalon bus clock domain
     --! - Port B: FM:   three memories with 64bit word-width and 50MHz ethernet clock domain
-    --! - Task selection with iTaskAddr
-    --! - Clear task with iClTaskMem
-    --! - Task data: oSettingData, oCompFrame and oCompMask
+    --! - Task selection with iTaskAddr within the bank iTaskBank
+    --! - Clear all tasks with iClearMem via the valid bits of the tasks
+    --! - Task data: oSettingData, oCompFrame, oCompMask, oWindowData and oChainData
     T_Memory : entity work.Task_Memory
     generic map(
                 gSlaveWordWidth => gSlaveTaskWordWidth,
                 gWordWidth      => gTaskWordWidth,
                 gSlaveAddrWidth => gSlaveTaskAddrWidth,
-                gAddresswidth   => gTaskAddrWidth
+                gAddresswidth   => gTaskAddrWidth,
+                gNoOfBanks      => gTaskBanks
                 )
     port map (
             iClk            => iClk,
             iS_clk          => iS_clk,
             --avalon bus (s_clk domain)
-            iSc_addr        => iSt_address,
+            iSc_addr        => slaveTaskAddr,
             iSc_writeData   => iSt_writedata,
-            iSc_wrEn        => iSt_write,
-            iSc_rdEn        => iSt_read,
+            iSc_wrEn        => slaveTaskWrEn,
+            iSc_rdEn        => slaveTaskRdEn,
             oSc_ReadData    => oSt_readdata,
             iSc_byteEn      => iSt_byteenable,
             --memory signals
-            iClTaskMem      => clTask,
-            iTaskAddr       => taskAddr,
+            iClearMem       => clearMem,
+            iTaskAddr       => iRdTaskAddr,
+            iBank           => iTaskBank,
+            oTaskValid      => oTaskValid,
+            oTaskRemain     => oTaskRemain,
             oSettingData    => oTaskSettingData,
             oCompFrame      => oTaskCompFrame,
-            oCompMask       => oTaskCompMask
+            oCompMask       => oTaskCompMask,
+            oWindowData     => oTaskWindowData,
+            oChainData      => oTaskChainData
+            );
+
+
+    ------------------------------------------------------------------------------------------
+    --! @brief Template memory
+    --! - Port A: PL-Slave: 32bit word-width and the avalon bus clock domain
+    --! - Port B: FM: Byte-wise reading of the injected frames with the 50MHz ethernet clock domain
+    I_Memory : entity work.DpramAdjustable
+    generic map(
+                gAddresswidthA  => gSlaveInjectAddrWidth,
+                gAddresswidthB  => gInjectAddrWidth,
+                gWordWidthA     => gSlaveInjectWordWidth,
+                gWordWidthB     => cByteLength
+                )
+    port map(
+            iClock_a    => iS_clk,
+            iClock_b    => iClk,
+            --port A PL-Slave
+            iAddress_a  => iSi_address,
+            iByteena_a  => iSi_byteenable,
+            iData_a     => iSi_writedata,
+            iWren_a     => iSi_write,
+            iRden_a     => iSi_read,
+            oQ_a        => oSi_readdata,
+            --port B FM
+            iAddress_b  => iInjectRdAddr,
+            iByteena_b  => (others=>'1'),
+            iData_b     => (others=>'0'),
+            iWren_b     => '0',
+            iRden_b     => iInjectRdEn,
+            oQ_b        => oInjectData
             );
 
 
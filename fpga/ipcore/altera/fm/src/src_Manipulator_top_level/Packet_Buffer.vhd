@@ -34,7 +34,6 @@
 --    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 --    POSSIBILITY OF SUCH DAMAGE.
 --
--------------------------------------------------------------------------------
 
 --! Use standard ieee library
 library ieee;
@@ -45,6 +44,8 @@ use ieee.numeric_std.all;
 
 --! Use work library
 library work;
+--! use fm library
+use work.framemanipulatorPkg.all;
 
 --! Common library
 library libcommon;
@@ -56,7 +57,9 @@ use libcommon.global.all;
 --! This is the entity of the top-module for exchanging and manipulating safety packets.
 entity Packet_Buffer is
     generic(
-            gSafetySetting      : natural :=5*cByteLength;  --!Size of safety setting
+            gSafetySetting      : natural :=15*cByteLength; --!Size of safety setting
+            gSafetyPackets      : natural := 4;             --!Number of safety packets per frame
+            gSafetyContexts     : natural := 2;             --!Number of concurrent safety contexts
             gPacketAddrWidth    : natural := 14;            --!enough for 500 Packets with the size of 28 Bytes
             gAddrMemoryWidth    : natural := 9              --!Width of address memory, should store at least 500 addresses
             );
@@ -66,14 +69,15 @@ entity Packet_Buffer is
         -- Operation signals
         iResetPaketBuff         : in std_logic;     --!Resets the packet FIFO and removes the packet lag
         iStopTest               : in std_logic;     --!abort of a series of test
-        oSafetyActive           : out std_logic;    --!safety manipulations are active
+        oSafetyActive           : out std_logic_vector(gSafetyContexts-1 downto 0); --!safety manipulations of each context are active
         oError_packetBuffOv     : out std_logic;    --!Error: Overflow packet-buffer
+        oPacketOccupancy        : out std_logic_vector(gAddrMemoryWidth downto 0);  --!Number of used packet slots
         -- Manipulation signals
-        iTaskSafetyEn           : in std_logic;                                     --!task: safety packet manipulation
-        iExchangeData           : in std_logic;                                     --!exchange packet data
-        iSafetyFrame            : in std_logic;                                     --!current frame matches to the current or last safety task
-        iFrameIsSoc             : in std_logic;                                     --!current frame is a SoC
-        iManiSetting            : in std_logic_vector(gSafetySetting-1 downto 0);   --!settings of the manipulations
+        iTaskSafetyEn           : in std_logic_vector(gSafetyContexts-1 downto 0);                  --!task: safety packet manipulation of each context
+        iExchangeData           : in std_logic;                                                     --!exchange packet data
+        iSafetyFrame            : in std_logic_vector(gSafetyContexts-1 downto 0);                  --!current frame matches to the current or last safety task of each context
+        iFrameIsSoc             : in std_logic;                                                     --!current frame is a SoC
+        iManiSetting            : in std_logic_vector(gSafetyContexts*gSafetySetting-1 downto 0);   --!settings of the manipulations of each context
         oPacketExchangeEn       : out std_logic;                                    --!Start of the exchange of the safety packet
         oPacketExtension        : out std_logic;                                    --!Exchange will be extended for several tacts
         oPacketStart            : out std_logic_vector(cByteLength-1 downto 0);     --!Start of safety packet
@@ -87,341 +91,368 @@ end Packet_Buffer;
 
 --! @brief Packet_Buffer architecture
 --! @details This is the top-module for exchanging and manipulating safety packets.
+--! - Every safety context has its own setting, frame filter and handlers
+--! - Every safety packet of the frame is handled by its own Packet_Handler
+--! - The packet memory is shared by the handlers of all contexts. Every handler with a
+--!   configured packet gets an equal region, a single packet uses the whole memory
+--! - The regions are renewed at a SoC, when no handler delays packets or is active
+--! - The exchange windows are passed to the Frame_Creator in the order of their position
 architecture two_seg_arch of Packet_Buffer is
 
     -- Definitions
-    --!First byte of the safety Payload (+4 = Byte Number 5). If Payload doesn't exist, it's the first subframe CRC
-    constant cFirstPayloadByte  : natural := 4;
+    --!Number of packet handlers of all contexts
+    constant cHandlers          : natural := gSafetyContexts*gSafetyPackets;
+
+    --!Size of the packet memory in Byte
+    constant cMemorySize        : natural := 2**gPacketAddrWidth;
+
+
+    --! Typedef for the settings of the packets
+    type tPacketSetting is array (cHandlers-1 downto 0) of std_logic_vector(cSettingSize.safetyPacket-1 downto 0);
+
+    --! Typedef for Byte values of the packets
+    type tPacketByte is array (cHandlers-1 downto 0) of std_logic_vector(cByteLength-1 downto 0);
+
+    --! Typedef for the occupancy of the packets
+    type tPacketOccupancy is array (cHandlers-1 downto 0) of std_logic_vector(gAddrMemoryWidth downto 0);
+
+    --! Typedef for addresses of the packet memory
+    type tPacketAddr is array (cHandlers-1 downto 0) of std_logic_vector(gPacketAddrWidth-1 downto 0);
+
+    --! Typedef for the sizes of the memory regions
+    type tRegionSize is array (cHandlers-1 downto 0) of std_logic_vector(gPacketAddrWidth downto 0);
+
+
+    -- Packet signals
+    signal packetSetting        : tPacketSetting;                                   --!Setting of each packet
+    signal packetExchangeEn     : std_logic_vector(cHandlers-1 downto 0);           --!Exchange of each packet
+    signal packetExtension      : std_logic_vector(cHandlers-1 downto 0);           --!Extension of each packet
+    signal packetExchangeData   : std_logic_vector(cHandlers-1 downto 0);           --!Exchange data of the selected packet
+    signal packetSafetyActive   : std_logic_vector(cHandlers-1 downto 0);           --!Manipulation of each packet is active
+    signal packetBuffOv         : std_logic_vector(cHandlers-1 downto 0);           --!Overflow of each memory partition
+    signal packetStart          : tPacketByte;                                      --!Start of each packet
+    signal packetSize           : tPacketByte;                                      --!Size of each packet
+    signal packetData           : tPacketByte;                                      --!Data of each packet
+    signal packetOccupancy      : tPacketOccupancy;                                 --!Used slots of each packet
+    signal packetLag            : std_logic_vector(cHandlers-1 downto 0);           --!Packets of each handler are delayed
+    signal packetMemWrEn        : std_logic_vector(cHandlers-1 downto 0);           --!Each handler stores data
+    signal packetMemWrAddr      : tPacketAddr;                                      --!Write address of each handler within its region
+    signal packetMemRdAddr      : tPacketAddr;                                      --!Read address of each handler within its region
+
+    -- Memory regions
+    signal frameIsSoc_reg       : std_logic;                                        --!Register for edge detection of iFrameIsSoc
+    signal handlerUsed          : std_logic_vector(cHandlers-1 downto 0);           --!Handler has a configured packet
+    signal regionUsed_reg       : std_logic_vector(cHandlers-1 downto 0);           --!Handlers with a memory region
+    signal regionUsed_next      : std_logic_vector(cHandlers-1 downto 0);           --!Next value of regionUsed_reg
+    signal regionInit           : std_logic;                                        --!Regions are renewed
+    signal regionBase           : tPacketAddr;                                      --!Start address of the region of each handler
+    signal regionSize           : tRegionSize;                                      --!Size of the region of each handler
+    signal regionOv             : std_logic;                                        --!Handler without region stores data
+
+    -- Packet memory
+    signal memWrEn              : std_logic;                                        --!Write enable of the packet memory
+    signal memWrAddr            : std_logic_vector(gPacketAddrWidth-1 downto 0);    --!Write address of the packet memory
+    signal memRdAddr            : std_logic_vector(gPacketAddrWidth-1 downto 0);    --!Read address of the packet memory
+    signal memRdData            : std_logic_vector(cByteLength-1 downto 0);         --!Read data of the packet memory
+
+    -- Packet selection
+    signal packetSel            : natural range 0 to cHandlers-1;       --!Packet of the current exchange
+    signal packetSel_next       : natural range 0 to cHandlers-1;       --!Next value of packetSel
 
+begin
 
-    --!Start of the SoC Timestamp at Byte 21
-    constant cSocTimeStart      : std_logic_vector(cByteLength-1 downto 0)
-                                    := std_logic_vector(to_unsigned(21,cByteLength));
 
+    -- Packet handlers ----------------------------------------------------------------------
 
+    --! @brief Safety contexts
+    --! - Every context has its own setting, safety frame and handlers
+    genContext :
+    for c in 0 to gSafetyContexts-1 generate
 
-    -- Selecting safety parameters
-    --! Byte 1: Start position of safety packet
-    alias iManiSetting_TaskSafety      : std_logic_vector(cByteLength-1 downto 0)
-                                        is iManiSetting(iManiSetting'left downto iManiSetting'left-cByteLength+1);
+        --! Setting of this context
+        alias iManiSetting_Context  : std_logic_vector(gSafetySetting-1 downto 0)
+                                    is iManiSetting((c+1)*gSafetySetting-1 downto c*gSafetySetting);
 
-    --! Byte 2: Start position of safety packet
-    alias iManiSetting_PacketStart      : std_logic_vector(cByteLength-1 downto 0)
-                                        is iManiSetting(iManiSetting'left-cByteLength downto iManiSetting'left-2*cByteLength+1);
+        --! Byte 4-6: Number of manipulated packets and start of SN2 packet, which are used by all packets
+        alias iManiSetting_Shared   : std_logic_vector(3*cByteLength-1 downto 0)
+                                    is iManiSetting_Context(gSafetySetting-3*cByteLength-1 downto gSafetySetting-6*cByteLength);
 
-    --! Byte 3: Size of safety packet
-    alias iManiSetting_PacketSize       : std_logic_vector(cByteLength-1 downto 0)
-                                        is iManiSetting(iManiSetting'left-2*cByteLength downto iManiSetting'left-3*cByteLength+1);
+    begin
 
-    --! Byte 4+5: Number of manipulated Packets
-    alias iManiSetting_NoOfPackets      : std_logic_vector(2*cByteLength-1 downto 0)
-                                        is iManiSetting(iManiSetting'left-3*cByteLength downto iManiSetting'left-5*cByteLength+1);
+        --! @brief Settings of the safety packets
+        --! - Packet 1 uses Byte 1-6 of the safety setting
+        --! - Every further packet uses its descriptor with task, start and size of 3 Bytes
+        --! - The number of packets and the SN2 start are used by all packets
+        genSetting :
+        for i in 0 to gSafetyPackets-1 generate
 
-    --! Byte 6: Start position of SL2 packet
-    alias iManiSetting_Packet2Start     : std_logic_vector(cByteLength-1 downto 0)
-                                        is iManiSetting(iManiSetting'left-5*cByteLength downto iManiSetting'left-6*cByteLength+1);
+            genFirstPacket :
+            if i = 0 generate
+                packetSetting(c*gSafetyPackets+i)   <= iManiSetting_Context(gSafetySetting-1 downto gSafetySetting-cSettingSize.safetyPacket);
 
+            end generate;
 
-    --! Typedef for registers
-    type tReg is record
-        socReg          : std_logic;                                    --!Register for edge detection of iFrameIsSoc
-        taskSafety      : std_logic_vector(cByteLength-1 downto 0);     --!Current safety task
-        packetStart     : std_logic_vector(cByteLength-1 downto 0);     --!Start position of safety packet
-        packetSize      : std_logic_vector(cByteLength-1 downto 0);     --!Size of safety packet
-        noOfPackets     : std_logic_vector(2*cByteLength-1 downto 0);   --!Number of manipulated Packets
-        packet2Start    : std_logic_vector(cByteLength-1 downto 0);     --!Start position of SL2 packet
-    end record;
+            genFurtherPacket :
+            if i > 0 generate
+                packetSetting(c*gSafetyPackets+i)   <= iManiSetting_Context(gSafetySetting-cSettingSize.safetyPacket-(i-1)*cSettingSize.safetyDescr-1
+                                                                        downto gSafetySetting-cSettingSize.safetyPacket-i*cSettingSize.safetyDescr)
+                                                        & iManiSetting_Shared;
 
+            end generate;
 
-    --! Init for registers
-    constant cRegInit   : tReg :=(
-                                socReg          => '0',
-                                taskSafety      => (others=>'0'),
-                                packetStart     => (others=>'0'),
-                                packetSize      => (others=>'0'),
-                                noOfPackets     => (others=>'0'),
-                                packet2Start    => (others=>'0')
-                                );
+            --packet is configured, when its task is set
+            handlerUsed(c*gSafetyPackets+i) <= '1' when packetSetting(c*gSafetyPackets+i)(cSettingSize.safetyPacket-1 downto cSettingSize.safetyPacket-cByteLength)
+                                                        /= (cByteLength-1 downto 0 => '0') else '0';
 
-    signal reg          : tReg; --! Registers
-    signal reg_next     : tReg; --! Next value of registers
+        end generate;
 
-    -- Flags
-    signal dutNoPaGap       : std_logic;    --!there is no gap after DUT packet
-    signal snNoPaGap        : std_logic;    --!there is no gap after the SN packet
-    signal sn2Pre           : std_logic;    --!SN2 packet arrives bevore DUT packet
-    signal newTask          : std_logic;    --!task has changed
-    signal lagReached       : std_logic;    --!reached required number of delayed packets
 
-    signal numDelPackets    : std_logic_vector(gAddrMemoryWidth-1 downto 0);    --!Number of delayed packets
+        --! @brief Handler of the safety packets
+        --! - Each packet is handled with its own FSM, frame counter and memory region
+        --! - Only the selected packet receives the exchange of the Frame_Creator
+        genHandler :
+        for i in c*gSafetyPackets to (c+1)*gSafetyPackets-1 generate
 
+            packetExchangeData(i)   <= iExchangeData when packetSel = i else '0';
 
-    -- signals for counting the safety frames
-    signal frameCntEnd      : std_logic;                                --!all packets were manipulated
-    signal frameCntClear    : std_logic;                                --!reset of cnter, when no task is active
-    signal frameCntEn       : std_logic;                                --!cnter enabled, when safety frame is incoming
-    signal frameCnt         : std_logic_vector(reg.NoOfPackets'range);  --!number of incomming frames
+            Handler : entity work.Packet_Handler
+            generic map(gSafetySetting      => cSettingSize.safetyPacket,
+                        gPacketAddrWidth    => gPacketAddrWidth,
+                        gAddrMemoryWidth    => gAddrMemoryWidth)
+            port map(
+                    iClk                    => iClk,
+                    iReset                  => iReset,
 
-    -- temporary signals
-    signal packetData_temp  : std_logic_vector(oPacketData'range);      --! Temporary signal of oPacketData
+                    iResetPaketBuff         => iResetPaketBuff,
+                    iStopTest               => iStopTest,
+                    iRegionInit             => regionInit,
+                    iRegionSize             => regionSize(i),
+                    oSafetyActive           => packetSafetyActive(i),
+                    oPacketLag              => packetLag(i),
+                    oError_packetBuffOv     => packetBuffOv(i),
+                    oPacketOccupancy        => packetOccupancy(i),
 
-    -- Data signals
-    signal storeData            : std_logic;                                --! Store data stream
-    signal readData             : std_logic;                                --! Send data from packet memory
-    signal memoryData           : std_logic_vector(cByteLength-1 downto 0); --! Data from packet memory
-    signal clonePacketEx        : std_logic;                                --! Clone incoming safety packet
-    signal zeroPacketEx         : std_logic;                                --! Remove incomng safety packet
-    signal twistPacketEx        : std_logic;                                --! Put out safety packets in reverse order
+                    iTaskSafetyEn           => iTaskSafetyEn(c),
+                    iExchangeData           => packetExchangeData(i),
+                    iSafetyFrame            => iSafetyFrame(c),
+                    iFrameIsSoc             => iFrameIsSoc,
+                    iManiSetting            => packetSetting(i),
+                    oPacketExchangeEn       => packetExchangeEn(i),
+                    oPacketExtension        => packetExtension(i),
+                    oPacketStart            => packetStart(i),
+                    oPacketSize             => packetSize(i),
 
-    -- Packet manipulation Flags
-    signal packetStartSoc       : std_logic;    --! Manipulation starts at SoC Timestamp
-    signal packetStartPayload   : std_logic;    --! Manipulation starts at safety packet payload
-    signal packetStartSN2       : std_logic;    --! Manipulation starts at packet of the second SN
+                    iFrameData              => iFrameData,
+                    oPacketData             => packetData(i),
 
-begin
+                    oMemWrEn                => packetMemWrEn(i),
+                    oMemWrAddr              => packetMemWrAddr(i),
+                    oMemRdAddr              => packetMemRdAddr(i),
+                    iMemRdData              => memRdData
+                    );
 
+        end generate;
 
-    -----------------------------------------------------------------------------------------
 
-    --Registers
+        --context is active, when one of its packets is active
+        oSafetyActive(c)    <= '1' when packetSafetyActive((c+1)*gSafetyPackets-1 downto c*gSafetyPackets)
+                                        /= (gSafetyPackets-1 downto 0 => '0') else '0';
 
-    --! @brief Registers
-    --! - Storing with asynchronous reset
-    registers :
-    process(iClk, iReset)
-    begin
-        if iReset='1' then
-            reg <= cRegInit;
+    end generate;
 
-        elsif rising_edge(iClk) then
-            reg <= reg_next;
 
-        end if;
-    end process;
+    oError_packetBuffOv <= '1' when packetBuffOv        /= (packetBuffOv'range => '0') or regionOv = '1' else '0';
 
 
-    --! @brief Reg_next logic for registers
-    --! - Storing safety parameters at incoming SoC
-    --! - Detect the changing of the safety task
-    comb_reg :
-    process (reg, iFrameIsSoC, iManiSetting)
+    --! @brief Occupancy of the packet memory
+    --! - Sum of the used slots of all handlers
+    --! - Saturates at the maximum of oPacketOccupancy
+    combOccupancy :
+    process(packetOccupancy)
+        variable vOccupancy : unsigned(oPacketOccupancy'length+LogDualis(cHandlers) downto 0);
     begin
+        vOccupancy  := (others => '0');
 
-        NewTask     <= '0';
+        for i in 0 to cHandlers-1 loop
+            vOccupancy  := vOccupancy + resize(unsigned(packetOccupancy(i)), vOccupancy'length);
 
-        reg_next            <= reg;
-        reg_next.socReg     <= iFrameIsSoc;
+        end loop;
 
-        --if safty task starts (positive edge of iFrameIsSoc)
-        if (reg.socReg   = '0' and iFrameIsSoc   = '1') then
-            --store Settings:
-            reg_next.taskSafety     <= iManiSetting_TaskSafety;
-            reg_next.packetStart    <= iManiSetting_PacketStart;
-            reg_next.packetSize     <= iManiSetting_PacketSize;
-            reg_next.noOfPackets    <= iManiSetting_NoOfPackets;
-            reg_next.packet2Start   <= iManiSetting_Packet2Start;
+        if vOccupancy >= 2**oPacketOccupancy'length then
+            oPacketOccupancy    <= (others => '1');
 
-            --update task, when changed
-            if  reg.taskSafety /= iManiSetting_TaskSafety then
-                NewTask <= '1';
-
-            end if;
+        else
+            oPacketOccupancy    <= std_logic_vector(vOccupancy(oPacketOccupancy'range));
 
         end if;
 
     end process;
 
-    --!there is no gap after the DUT packet
-    dutNoPaGap  <= '1' when (unsigned(reg.packetStart) =
-                            unsigned(reg.packet2Start)  +   unsigned(reg.packetSize))
-                        else '0';
+    -----------------------------------------------------------------------------------------
 
-    --!there is no gap after the SN packet
-    snNoPaGap   <= '1' when (unsigned(reg.packet2Start) =
-                            unsigned(reg.packetStart)   +   unsigned(reg.packetSize))
-                        else '0';
 
-    --!SN2 packet arrives bevore DUT packet
-    sn2Pre      <= '1' when unsigned(reg.packetStart)   >   unsigned(reg.packet2Start)
-                        else '0';
 
-    --!There should be at least as many packets delayed
-    lagReached  <= '1' when unsigned(numDelPackets)     >=  unsigned(reg.noOfPackets)
-                        else '0';
+    -- Memory regions -----------------------------------------------------------------------
 
+    --! @brief Renewal of the memory regions
+    --! - At the positive edge of iFrameIsSoc, when the handlers take their settings
+    --! - Only while no handler delays packets or is active, their stored packets would be lost
+    --! - The handlers restart their slots with the new region
+    combRegion :
+    process(iFrameIsSoc, frameIsSoc_reg, handlerUsed, regionUsed_reg, packetLag, packetSafetyActive)
+    begin
+        regionUsed_next <= regionUsed_reg;
+        regionInit      <= '0';
 
-    --! @brief Control of the safety packet manipulation
-    --! - Handles the different tasks
-    --! - Controls data stream and storage of data
-    Control : entity work.PacketControl_FSM
-    port map(
-            iClk                => iClk,
-            iReset              => iReset,
-            iSafetyTask         => reg.taskSafety,
-            iTaskSafetyEn       => iTaskSafetyEn,
-            iStopTest           => iStopTest,
-            iResetPaketBuff     => iResetPaketBuff,
-            oPacketExchangeEn   => oPacketExchangeEn,
-            oPacketExtension    => oPacketExtension,
-            oSafetyActive       => oSafetyActive,
-
-            iNewTask            => newTask,
-            iDutNoPaGap         => dutNoPaGap,
-            iSnNoPaGap          => snNoPaGap,
-            iSn2Pre             => sn2Pre,
-            iExchangeData       => iExchangeData,
-            iLagReached         => lagReached,
-
-            iSafetyFrame        => iSafetyFrame,
-            iFrameIsSoc         => iFrameIsSoc,
-
-            iCntEnd             => frameCntEnd,
-            oCntEn              => frameCntEn,
-            oCntClear           => frameCntClear,
-
-            oStore              => storeData,
-            oRead               => readData,
-            oClonePacketEx      => clonePacketEx,
-            oZeroPacketEx       => zeroPacketEx,
-            oTwistPacketEx      => twistPacketEx,
-
-            oPacketStartSoc     => packetStartSoc,
-            oPacketStartPayload => packetStartPayload,
-            oPacketStartSN2     => packetStartSN2
-            );
+        if  iFrameIsSoc = '1' and frameIsSoc_reg = '0'              and
+            packetLag           = (packetLag'range => '0')          and
+            packetSafetyActive  = (packetSafetyActive'range => '0') and
+            handlerUsed        /= regionUsed_reg                    then
 
+            regionUsed_next <= handlerUsed;
+            regionInit      <= '1';
 
-    -----------------------------------------------------------------------------------------
-
+        end if;
 
+    end process;
 
-    -- Manipulation Logic -------------------------------------------------------------------
 
-    --! @brief Change of packet start and size
-    --! - Changing payload at Incorrect-Data task
-    --! - Collects data from SoC at Masquerade task
-    --! - Collects safety packet from other SN at Insertion task
-    combManiEn :
-    process(reg, packetStartPayload, packetStartSoc, packetStartSN2)
+    --! @brief Size and start of the memory regions
+    --! - The memory is divided equally between the used handlers
+    --! - The regions follow each other in the order of the handlers
+    --! - Unused handlers have an empty region
+    combRegionSize :
+    process(regionUsed_reg)
+        variable vCnt   : natural range 0 to cHandlers;
+        variable vSize  : unsigned(gPacketAddrWidth downto 0);
+        variable vBase  : unsigned(gPacketAddrWidth downto 0);
     begin
+        vCnt    := 0;
 
-        oPacketStart        <= reg.packetStart;
-        oPacketSize         <= reg.packetSize;
+        for i in 0 to cHandlers-1 loop
+            if regionUsed_reg(i) = '1' then
+                vCnt    := vCnt + 1;
 
+            end if;
+        end loop;
 
-        if packetStartPayload = '1' then    --manipulation of packet payload
 
-            oPacketStart    <= std_logic_vector(cFirstPayloadByte +
-                                            unsigned(reg.packetStart));     --manipulation of the payload
-            oPacketSize     <= (0=>'1',others=>'0');                        --with the first byte
+        vSize   := (others => '0');
 
-        end if;
+        for n in 1 to cHandlers loop
+            if vCnt = n then
+                vSize   := to_unsigned(cMemorySize/n, vSize'length);
 
+            end if;
+        end loop;
 
-        if packetStartSoc='1' then          --collecting of SoC time
-            oPacketStart        <= cSocTimeStart;
 
-        end if;
+        vBase   := (others => '0');
 
+        for i in 0 to cHandlers-1 loop
+            regionBase(i)   <= std_logic_vector(vBase(gPacketAddrWidth-1 downto 0));
+            regionSize(i)   <= (others => '0');
 
-        if packetStartSN2='1' then          --collecting data of SN2
-            oPacketStart        <= reg.packet2Start;
+            if regionUsed_reg(i) = '1' then
+                regionSize(i)   <= std_logic_vector(vSize);
+                vBase           := vBase + vSize;
 
-        end if;
-    end process;
+            end if;
+        end loop;
 
+    end process;
 
     -----------------------------------------------------------------------------------------
 
 
-    --Counting the safety frames-------------------------------------------------------------
 
-    --! @brief Safety frame counter
-    --! - Counts every safety frame, when active
-    --! - Reset at inactive manipulation
-    frameCnter : entity work.FixCnter
+    -- Packet memory ------------------------------------------------------------------------
+
+    --!Only the selected handler accesses the memory, handlers without region don't store data
+    memWrEn     <= packetMemWrEn(packetSel) when unsigned(regionSize(packetSel)) /= 0 else '0';
+
+    --!Error, when a handler without region stores data
+    regionOv    <= packetMemWrEn(packetSel) when unsigned(regionSize(packetSel)) = 0 else '0';
+
+    --!Addresses of the handler are relative to its region
+    memWrAddr   <= std_logic_vector(unsigned(regionBase(packetSel)) + unsigned(packetMemWrAddr(packetSel)));
+    memRdAddr   <= std_logic_vector(unsigned(regionBase(packetSel)) + unsigned(packetMemRdAddr(packetSel)));
+
+
+    --! @brief Packet memory
+    --! - RAM with the packet data of all handlers
+    PacketRAM : entity work.FiFo_File
     generic map(
-                gCntWidth   => reg.NoOfPackets'length,
-                gStartValue => (reg.NoOfPackets'range => '0'),
-                gInitValue  => (reg.NoOfPackets'range => '0'),
-                gEndValue   => (reg.NoOfPackets'range => '1')
+                gAddrWidth  => gPacketAddrWidth,
+                gDataWidth  => cByteLength
                 )
     port map(
             iClk    => iClk,
-            iReset  => iReset,
-            iClear  => frameCntClear,
-            iEn     => frameCntEn,
-            oQ      => frameCnt,
-            oOv     => open
+            iWrEn   => memWrEn,
+            iWrAddr => memWrAddr,
+            iWrData => iFrameData,
+            iRdAddr => memRdAddr,
+            oRdData => memRdData
             );
 
-
-    --oOv can't be used. NoOfPackets can change anytime
-    frameCntEnd <= '1' when unsigned(frameCnt)>=unsigned(reg.noOfPackets) else '0';
-
     -----------------------------------------------------------------------------------------
 
 
-    --Packet data----------------------------------------------------------------------------
 
-    --! @brief Control of data stream
-    --! - Manipulate stream at Insertion task
-    --! - Pass data stream, when it will only be stored into the memory
-    --! - Exchange stream with memory data, when needed
-    comb_data:
-    process(iFrameData, storeData, readData, memoryData, PacketStartPayload)
+    -- Packet selection ---------------------------------------------------------------------
+
+    --! @brief Registers
+    --! - Storing with asynchronous reset
+    registers :
+    process(iClk, iReset)
     begin
-        packetData_temp     <= (others=>'0');       --Also output at manipulation Loss
+        if iReset='1' then
+            packetSel       <= 0;
+            frameIsSoc_reg  <= '0';
+            regionUsed_reg  <= (others => '0');
 
-        if packetStartPayload='1' then
-            packetData_temp <= not iFrameData;      --Incorrect Data with toggeling the first payload byte
+        elsif rising_edge(iClk) then
+            packetSel       <= packetSel_next;
+            frameIsSoc_reg  <= iFrameIsSoc;
+            regionUsed_reg  <= regionUsed_next;
 
         end if;
+    end process;
 
 
-        if (storeData='1' and readData='0') then    --Pass frame data at data collection
-            packetData_temp <= iFrameData;
+    --! @brief Selection of the next exchanged packet
+    --! - Selection stays during the exchange and its extension
+    --! - Otherwise the enabled packet with the lowest start position is selected
+    --! - A packet, which finished its exchanges for this frame, disables its exchange
+    combSel :
+    process(packetSel, iExchangeData, packetExtension, packetExchangeEn, packetStart)
+        variable vStart : unsigned(cByteLength downto 0);
+    begin
+        packetSel_next  <= packetSel;
 
-        end if;
+        if iExchangeData = '0' and packetExtension(packetSel) = '0' then
+            vStart  := (others => '1');
 
+            for i in 0 to cHandlers-1 loop
+                if packetExchangeEn(i) = '1' and unsigned('0' & packetStart(i)) < vStart then
+                    vStart          := unsigned('0' & packetStart(i));
+                    packetSel_next  <= i;
 
-        if readData='1' then
-            packetData_temp <= memoryData;
+                end if;
+            end loop;
 
         end if;
 
     end process;
 
-    oPacketData <= packetData_temp;
-
 
-    --! @brief Packet Memory
-    --! - Stores safety packets
-    --! - Output of safety packets in correct or reverse order
-    --! - Delete packets at Loss or Delay task
-    --! - Error output at overflow of the packet buffer
-    PacketRAM : entity work.Packet_Memory
-    generic map(gPacketAddrWidth    => gPacketAddrWidth,
-                gAddrMemoryWidth    => gAddrMemoryWidth)
-    port map(
-            iClk                    => iClk,
-            iReset                  => iReset,
-            iSafetyFrame            => iSafetyFrame,
-            iTaskSafety             => reg.TaskSafety,
-            iResetPaketBuff         => iResetPaketBuff,
-            oNumDelPackets          => numDelPackets,
-            oError_packetBuffOv     => oError_packetBuffOv,
-
-            iClonePacketEx          => clonePacketEx,
-            iZeroPacketEx           => zeroPacketEx,
-            iTwistPacketEx          => twistPacketEx,
-
-            iWrEn                   => storeData,
-            iRdEn                   => readData,
-            iData                   => iFrameData,
-            oData                   => memoryData
-            );
+    oPacketExchangeEn   <= packetExchangeEn(packetSel);
+    oPacketExtension    <= packetExtension(packetSel);
+    oPacketStart        <= packetStart(packetSel);
+    oPacketSize         <= packetSize(packetSel);
+    oPacketData         <= packetData(packetSel);
 
+    -----------------------------------------------------------------------------------------
 
 
-end two_seg_arch;
\ No newline at end of file
+end two_seg_arch;
@@ -61,9 +61,12 @@ entity Process_Unit is
             gTaskAddrWidth      : natural := 5;                 --! Address width of the task memory
             gManiSettingWidth   : natural := 14*cByteLength;    --! Width of the total task setting
             gSafetySetting      : natural := 5*cByteLength;     --! 5 Byte safety setting
+            gSafetyPackets      : natural := 4;                 --! Number of safety packets per frame
+            gSafetyContexts     : natural := 2;                 --! Number of concurrent safety contexts
             gCycleCntWidth      : natural := cByteLength;       --! Width of the counter for the current cycle
             gSize_Mani_Time     : natural := 5*cByteLength;     --! Width of setting from delay-manipulation
-            gNoOfDelFrames      : natural := 255                --! Maximal number of delayed frames
+            gNoOfDelFrames      : natural := 255;               --! Maximal number of delayed frames
+            gExtDelayLine       : natural := 0                  --! Delay type "line" uses the external delay line
             );
     port(
         iClk                : in std_logic;     --! clk
@@ -72,21 +75,32 @@ entity Process_Unit is
         iStartFrameProcess  : in std_logic;     --! valid frame received
         iFrameEnded         : in std_logic;     --! frame has reached its end
         iFrameSync          : in std_logic;     --! synchronization of the frame-data-stream
+        iFrameTagged        : in std_logic;     --! frame has a VLAN tag
+        iFrameBypass        : in std_logic;     --! frame is forwarded without tasks
         iStartTest          : in std_logic;     --! start of a series of test
         iStopTest           : in std_logic;     --! abort of a series of test
+        iStartMode          : in std_logic_vector(cByteLength-1 downto 0);          --! start mode of the test
+        iStartTime          : in std_logic_vector(cEth.sizeSocTime-1 downto 0);     --! SoC time of the start
         iClearMem           : in std_logic;     --! clear all tasks
         iNextFrame          : in std_logic;     --! a new frame could be created
-        iSafetyActive       : in std_logic;     --! safety manipulations are active
+        iSafetyActive       : in std_logic_vector(gSafetyContexts-1 downto 0);  --! safety manipulations of each context are active
         oTestActive         : out std_logic;    --! Series of Test is active => Flag for PRes
         oStartNewFrame      : out std_logic;    --! data of a new frame is available
+        oFrameReady         : out std_logic;    --! a stored frame is ready to be created
         oError_taskConf     : out std_logic;    --! Error: Wrong task configuration
 
         --compare Tasks from memory with the frame
         iData               : in std_logic_vector(cByteLength-1 downto 0);          --! frame-data-stream
         iTaskSettingData    : in std_logic_vector(gTaskWordWidth*2-1 downto 0);     --! task settings
+        iTaskValid          : in std_logic;                                         --! task has a setting other than zero since the last clear
+        iTaskRemain         : in std_logic;                                         --! task or one of the following tasks is valid
         iTaskCompFrame      : in std_logic_vector(gTaskWordWidth-1 downto 0);       --! frame-selection-data
         iTaskCompMask       : in std_logic_vector(gTaskWordWidth-1 downto 0);       --! frame-selection-mask
+        iTaskWindowData     : in std_logic_vector(cParam.noOfFilterWindows*gTaskWordWidth-1 downto 0);  --! filter windows
+        iTaskChainData      : in std_logic_vector(gTaskWordWidth-1 downto 0);       --! chain of the task
         oRdTaskAddr         : out std_logic_vector(gTaskAddrWidth-1 downto 0);      --! task selection
+        iBankSelect         : in std_logic_vector(cByteLength-1 downto 0);          --! selected bank of the tasks
+        oTaskBank           : out std_logic_vector(cByteLength-1 downto 0);         --! bank of the task selection
 
         --Start/End address of the frame-data
         oDataInStartAddr    : out std_logic_vector(gDataBuffAddrWidth-1 downto 0);  --! position of the first written byte of the next frame
@@ -98,12 +112,19 @@ entity Process_Unit is
         --Manipulations in other components
         oTaskManiEn         : out std_logic;                                        --! task: header manipulation
         oTaskCutEn          : out std_logic;                                        --! task: cut frame
+        oTaskInjectEn       : out std_logic;                                        --! task: inject template frames
         oDistCrcEn          : out std_logic;
-        oTaskSafetyEn       : out std_logic;                                        --! task: safety packet manipulation
-        oSafetyFrame        : out std_logic;                                        --! current frame matches to the current or last safety task
-        oFrameIsSoc         : out std_logic;                                        --! current frame is a SoC
-        oManiSetting        : out std_logic_vector(gManiSettingWidth-1 downto 0);   --! settings of the manipulations
-        oSafetySetting      : out std_logic_vector(gSafetySetting-1 downto 0)       --! Setting of the current or last safety task
+        oFrameIpg           : out std_logic_vector(cCreateTime.ipgWidth-1 downto 0);            --! inter packet gap before the created frame
+        oPhyFault           : out std_logic_vector(cSettingSize.phy-1 downto 0);                --! PHY faults of the created frame
+        oSocTimeEn          : out std_logic;                                                    --! shifted time of the SoC is ready
+        oSocTime            : out std_logic_vector(2*cEth.sizeSocTime-1 downto 0);              --! shifted NetTime and RelativeTime of the SoC
+        oTaskSafetyEn       : out std_logic_vector(gSafetyContexts-1 downto 0);                 --! task: safety packet manipulation of each context
+        oSafetyFrame        : out std_logic_vector(gSafetyContexts-1 downto 0);                 --! current frame matches to the current or last safety task of each context
+        oFrameIsSoc         : out std_logic;                                                    --! current frame is a SoC
+        oManiSetting        : out std_logic_vector(gManiSettingWidth-1 downto 0);               --! settings of the manipulations
+        oSafetySetting      : out std_logic_vector(gSafetyContexts*gSafetySetting-1 downto 0);  --! Setting of the current or last safety task of each context
+        oTaskLineEn         : out std_logic;                                                    --! task: delay frames in the external delay line
+        oLineLatency        : out std_logic_vector(gSize_Mani_Time-1 downto 0)                  --! latency of the external delay line in 10ns
      );
 end Process_Unit;
 
@@ -114,9 +135,12 @@ end Process_Unit;
 --!   Manipulation_Manager.
 --! - The addresses of the frame-data are allocated by the Address_Manager
 --!   The delay-task is also done there
+--! - The delay type "line" is passed on to the external delay line instead, when it exists
+--! - The shifted time of the SoC time task is calculated by the SocTime_Shift
 architecture two_seg_arch of Process_Unit is
 
     constant cDelayDataWidth    : natural :=gSize_Mani_Time+8;  --! Width of setting from delay-manipulation TODO exchange with existing generic
+    constant cBerFlags          : std_logic_vector(cByteLength-1 downto 0):=std_logic_vector(to_unsigned(2**cPhyFault.ber, cByteLength));  --! Flags of the BER task in the PHY setting
 
 
     signal startFrameStorage    : std_logic;    --! Store current frame
@@ -124,9 +148,22 @@ architecture two_seg_arch of Process_Unit is
     signal frameIsSoC           : std_logic;    --! Current frame is a SoC
 
     signal taskDelayEn          : std_logic;    --! Delay task is active
+    signal taskLineEn           : std_logic;    --! Delay task of the external delay line is active
+    signal taskStoreDelayEn     : std_logic;    --! Delay task of the frame buffer is active
     signal taskCrcEn            : std_logic;    --! CRC manipulation is active
+    signal taskIpgEn            : std_logic;    --! IPG manipulation is active
+    signal taskDuplicateEn      : std_logic;    --! Frame duplication is active
+    signal taskReorderEn        : std_logic;    --! Frame reordering is active
+    signal taskShapeEn          : std_logic;    --! Traffic shaping is active
+    signal taskPhyEn            : std_logic;    --! PHY faults are active
+    signal taskBerEn            : std_logic;    --! Bit errors are active
+    signal taskPhyFaultEn       : std_logic;    --! PHY faults or bit errors are active
+    signal phySetting           : std_logic_vector(cSettingSize.phy-1 downto 0);    --! Setting of the PHY faults or bit errors
+    signal taskSocTimeEn        : std_logic;    --! SoC time shift is active
+    signal socTime              : std_logic_vector(2*cEth.sizeSocTime-1 downto 0);  --! NetTime and RelativeTime of the current frame
 
     signal maniActive           : std_logic;    --! Series of test is active
+    signal safetyActive         : std_logic;    --! Safety manipulations of any context are active
 
     signal maniSetting          : std_logic_vector(gManiSettingWidth-1 downto 0);   --! Task setting
 
@@ -134,21 +171,55 @@ architecture two_seg_arch of Process_Unit is
     alias aManiSetting_Delay     : std_logic_vector(cDelayDataWidth-1 downto 0)
                                     is maniSetting(cDelayDataWidth+gTaskWordWidth-1 downto gTaskWordWidth);
 
+    --! Needed setting for IPG task
+    alias aManiSetting_Ipg       : std_logic_vector(cCreateTime.ipgWidth-1 downto 0)
+                                    is maniSetting(cCreateTime.ipgWidth+gTaskWordWidth-1 downto gTaskWordWidth);
+
+    --! Needed setting for duplication task: number of copies in front of the gap
+    alias aManiSetting_Copies    : std_logic_vector(cByteLength-1 downto 0)
+                                    is maniSetting(cByteLength+cCreateTime.ipgWidth+gTaskWordWidth-1 downto cCreateTime.ipgWidth+gTaskWordWidth);
+
+    --! Needed setting for reorder task: number of overtaking frames
+    alias aManiSetting_Reorder   : std_logic_vector(cByteLength-1 downto 0)
+                                    is maniSetting(cByteLength+gTaskWordWidth-1 downto gTaskWordWidth);
+
+    --! Needed setting for shape task: rate, burst, limit of waiting frames and window
+    alias aManiSetting_Shape     : std_logic_vector(7*cByteLength-1 downto 0)
+                                    is maniSetting(6*cByteLength+gTaskWordWidth-1 downto gTaskWordWidth-cByteLength);
+
+    --! Needed setting for PHY task: flags, preamble, SFD, dribble dibits and position
+    alias aManiSetting_Phy       : std_logic_vector(cSettingSize.phy-1 downto 0)
+                                    is maniSetting(cSettingSize.phy+gTaskWordWidth-1 downto gTaskWordWidth);
+
+    --! Needed setting for BER task: rate and burst length
+    alias aManiSetting_Ber       : std_logic_vector(cSettingSize.phy-cByteLength-1 downto 0)
+                                    is maniSetting(cSettingSize.phy+gTaskWordWidth-1 downto gTaskWordWidth+cByteLength);
+
+    --! Needed setting for SoC time task: flags, offset, drift and step of the random walk
+    alias aManiSetting_SocTime   : std_logic_vector(cSettingSize.socTime-1 downto 0)
+                                    is maniSetting(cSettingSize.socTime-1 downto 0);
+
 begin
 
 
 
     --! @brief manipulation selector
-    --! - starts a test of series after receiving the iStartTest signal.
+    --! - starts a test of series after receiving the iStartTest signal,
+    --!   a start frame or the SoC of the start time.
     --! - compares the ethernet-header-data with the task settings, filter and mask
     --! - process the drop-frame manipulation task
     --! - enables the active manipulation
+    --! - switches the bank of the tasks behind the SoC
     M_Manager : entity work.Manipulation_Manager
     generic map(gFrom               => cEth.StartFrameFilter,
                 gTo                 => cEth.EndFrameFilter,
+                gWindowTo           => cEth.endWindowFilter,
+                gFilterWindows      => cParam.noOfFilterWindows,
                 gWordWidth          => gTaskWordWidth,
                 gManiSettingWidth   => gManiSettingWidth,
                 gSafetySetting      => gSafetySetting,
+                gSafetyPackets      => gSafetyPackets,
+                gSafetyContexts     => gSafetyContexts,
                 gCycleCntWidth      => gCycleCntWidth,
                 gBuffAddrWidth      => gTaskAddrWidth)
     port map(
@@ -157,26 +228,45 @@ begin
             --control signals
             iStartFrameProcess  => iStartFrameProcess,
             iFrameSync          => iFrameSync,
+            iFrameTagged        => iFrameTagged,
+            iFrameBypass        => iFrameBypass,
             iStartTest          => iStartTest,
             oStartFrameStorage  => StartFrameStorage,
             iStopTest           => iStopTest,
+            iStartMode          => iStartMode,
+            iStartTime          => iStartTime,
             iClearMem           => iClearMem,
             iSafetyActive       => iSafetyActive,
+            iBankSelect         => iBankSelect,
             oTestSync           => testSync,
             oManiActive         => maniActive,
             oFrameIsSoc         => frameIsSoC,
             oError_taskConf     => oError_taskConf,
             --data signals
             oTaskSelection      => oRdTaskAddr,
+            oTaskBank           => oTaskBank,
             iData               => iData,
             iTaskSettingData    => iTaskSettingData,
+            iTaskValid          => iTaskValid,
+            iTaskRemain         => iTaskRemain,
             iTaskCompFrame      => iTaskCompFrame,
             iTaskCompMask       => iTaskCompMask,
+            iTaskWindowData     => iTaskWindowData,
+            iTaskChainData      => iTaskChainData,
             --manipulations
             oTaskDelayEn        => taskDelayEn,
             oTaskManiEn         => oTaskManiEn,
             oTaskCrcEn          => taskCrcEn,
             oTaskCutEn          => oTaskCutEn,
+            oTaskIpgEn          => taskIpgEn,
+            oTaskInjectEn       => oTaskInjectEn,
+            oTaskDuplicateEn    => taskDuplicateEn,
+            oTaskReorderEn      => taskReorderEn,
+            oTaskShapeEn        => taskShapeEn,
+            oTaskPhyEn          => taskPhyEn,
+            oTaskBerEn          => taskBerEn,
+            oTaskSocTimeEn      => taskSocTimeEn,
+            oSocTime            => socTime,
             oTaskSafetyEn       => oTaskSafetyEn,
             oSafetyFrame        => oSafetyFrame,
             oManiSetting        => maniSetting,
@@ -184,7 +274,8 @@ begin
             );
 
     --Output of active Bit
-    oTestActive <= maniActive or iSafetyActive;
+    safetyActive    <= '1' when iSafetyActive /= (iSafetyActive'range => '0') else '0';
+    oTestActive     <= maniActive or safetyActive;
     oFrameIsSoc <= frameIsSoc;
 
 
@@ -194,7 +285,10 @@ begin
     --! - It also allocates a new start address to the Frame-Receiver with oDataInStartAddr.
     --! - The signal oDataInStartAddr remains after receiving an invalid or dropped frames. Thus,
     --!   these frames are overwritten with the data following frame.
-    --! - The delay task is also done in this component.
+    --! - The delay task is also done in this component. The IPG is stored with the frame.
+    --! - Duplicated and reordered frames reuse the stored addresses of the frame.
+    --! - Shaped frames are held back by the token bucket of the Traffic_Shaper.
+    --! - The setting of the PHY or the BER task is stored with the frame.
     --! - Addresses for new frames can be ordered from the Frame-Creator with iNextFrame
     A_Manager : entity work.Address_Manager
     generic map(gAddrDataWidth  => gDataBuffAddrWidth,
@@ -209,13 +303,27 @@ begin
             iFrameIsSoC         => frameIsSoC,
             iTestSync           => testSync,
             iTestStop           => iStopTest,
+            iTestActive         => maniActive,
             iNextFrame          => iNextFrame,
             oStartNewFrame      => oStartNewFrame,
+            oFrameReady         => oFrameReady,
             --manipulations
             iDelaySetting       => aManiSetting_Delay,
-            iTaskDelayEn        => taskDelayEn,
+            iTaskDelayEn        => taskStoreDelayEn,
             iTaskCrcEn          => taskCrcEn,
             oDistCrcEn          => oDistCrcEn,
+            iIpgSetting         => aManiSetting_Ipg,
+            iTaskIpgEn          => taskIpgEn,
+            oFrameIpg           => oFrameIpg,
+            iCopySetting        => aManiSetting_Copies,
+            iTaskDuplicateEn    => taskDuplicateEn,
+            iReorderSetting     => aManiSetting_Reorder,
+            iTaskReorderEn      => taskReorderEn,
+            iShapeSetting       => aManiSetting_Shape,
+            iTaskShapeEn        => taskShapeEn,
+            iPhySetting         => phySetting,
+            iTaskPhyEn          => taskPhyFaultEn,
+            oPhyFault           => oPhyFault,
             --memory management
             iDataInEndAddr      => iDataInEndAddr,
             oDataInStartAddr    => oDataInStartAddr,
@@ -225,6 +333,42 @@ begin
             );
 
 
+    --BER task is passed on as PHY setting with its own flag
+    phySetting          <= aManiSetting_Phy when taskPhyEn='1' else cBerFlags & aManiSetting_Ber;
+
+    taskPhyFaultEn      <= taskPhyEn or taskBerEn;
+
+
+    --! @brief Time of the SoC time task
+    --! - Shifts the NetTime and RelativeTime of the selected SoCs by offset, drift and random walk
+    --! - The shifted time is written into the frame buffer by the Data_Buffer
+    S_Time : entity work.SocTime_Shift
+    generic map(gSettingWidth   => cSettingSize.socTime)
+    port map(
+            iClk            => iClk,
+            iReset          => iReset,
+            --control signals
+            iTestSync       => testSync,
+            iTaskSocTimeEn  => taskSocTimeEn,
+            iFrameIsSoc     => frameIsSoC,
+            iTimeSetting    => aManiSetting_SocTime,
+            --time of the SoC
+            iSocTime        => socTime,
+            oSocTimeEn      => oSocTimeEn,
+            oSocTime        => oSocTime
+            );
+
+
+    --delay type "line" is done by the external delay line, if it exists
+    taskLineEn          <= taskDelayEn when gExtDelayLine/=0 and
+                            aManiSetting_Delay(cDelayDataWidth-1 downto cDelayDataWidth-cByteLength)=cDelayType.line
+                            else '0';
+
+    taskStoreDelayEn    <= taskDelayEn and not taskLineEn;
+
+    oTaskLineEn     <= taskLineEn;
+    oLineLatency    <= aManiSetting_Delay(gSize_Mani_Time-1 downto 0);
+
     oManiSetting    <= maniSetting;
 
 end two_seg_arch;
\ No newline at end of file
@@ -46,6 +46,8 @@ use ieee.numeric_std.all;
 
 --! Use work library
 library work;
+--! use fm library
+use work.framemanipulatorPkg.all;
 
 --! Common library
 library libcommon;
@@ -70,13 +72,27 @@ entity Address_Manager is
         iFrameIsSoC         : in std_logic;     --! current frame is a SoC
         iTestSync           : in std_logic;     --! sync: Test started
         iTestStop           : in std_logic;     --! Test abort
+        iTestActive         : in std_logic;     --! Series of test is active
         iNextFrame          : in std_logic;     --! frame_creator is ready for new data
         oStartNewFrame      : out std_logic;    --! new frame data is vaild
+        oFrameReady         : out std_logic;    --! a stored frame is ready to be created
         --manipulations
         iDelaySetting       : in std_logic_vector(gDelayDataWidth-1 downto 0);  --! setting for delaying frames
         iTaskDelayEn        : in std_logic;                                     --! task: delay frames
         iTaskCrcEn          : in std_logic;                                     --! task: distort crc ready to be stored
         oDistCrcEn          : out std_logic;                                    --! task: new frame receives a distorted crc
+        iIpgSetting         : in std_logic_vector(cCreateTime.ipgWidth-1 downto 0);     --! setting of the IPG before the frame in Byte
+        iTaskIpgEn          : in std_logic;                                             --! task: set the IPG before the frame
+        oFrameIpg           : out std_logic_vector(cCreateTime.ipgWidth-1 downto 0);    --! IPG before the new frame in Byte
+        iCopySetting        : in std_logic_vector(cByteLength-1 downto 0);              --! setting of the number of copies
+        iTaskDuplicateEn    : in std_logic;                                             --! task: send copies of the frame
+        iReorderSetting     : in std_logic_vector(cByteLength-1 downto 0);              --! setting of the number of overtaking frames
+        iTaskReorderEn      : in std_logic;                                             --! task: send frame behind the following frames
+        iShapeSetting       : in std_logic_vector(7*cByteLength-1 downto 0);            --! setting of the traffic shaper
+        iTaskShapeEn        : in std_logic;                                             --! task: limit the rate of the following frames
+        iPhySetting         : in std_logic_vector(cSettingSize.phy-1 downto 0);         --! setting of the PHY faults
+        iTaskPhyEn          : in std_logic;                                             --! task: inject faults of the PHY level
+        oPhyFault           : out std_logic_vector(cSettingSize.phy-1 downto 0);        --! PHY faults of the new frame
         --memory management
         iDataInEndAddr      : in std_logic_vector(gAddrDataWidth-1 downto 0);   --! end position of current frame
         oDataInStartAddr    : out std_logic_vector(gAddrDataWidth-1 downto 0);  --! start position of next incoming frame
@@ -95,7 +111,14 @@ end Address_Manager;
 --!   stored with it. Once it is loaded, the Address_Manager waits until it has passed this
 --!   point of time.
 --! - The loaded addresses are then stored and passed on to the Frame_Creator with the CRC-
---!   distortion flag (which is stored with the end-address).
+--!   distortion flag (which is stored with the end-address) and the IPG of the frame (which
+--!   is stored with the start-address). Frames without IPG-task keep the standard IPG.
+--! - The setting of the PHY task is stored with the start-address as well, as the
+--!   Frame_Creator needs it from the preamble on. Other frames receive a setting of zero.
+--! - Copies of a duplicated frame and a held back frame of the reorder task are written to
+--!   the fifo with the stored addresses of the frame.
+--! - Frames of the shape task are marked at the start-address. They are only loaded, when
+--!   the token bucket of the Traffic_Shaper allows it.
 architecture two_seg_arch of Address_Manager is
 
     --constants
@@ -103,18 +126,29 @@ architecture two_seg_arch of Address_Manager is
 
     --Fifo address and word width
     constant cBuffAddrWidth : natural:=LogDualis((2**gAddrDataWidth)/60*2); --! Fifo address width. Every frame uses two entries of the fifo --TODO framesize => package
-    constant cBuffWordWidth : natural:=gAddrDataWidth+cSize_Time;           --! Fifo word width
+    constant cBuffWordWidth : natural:=gAddrDataWidth+cSize_Time+cCreateTime.ipgWidth+cSettingSize.phy+1; --! Fifo word width
 
 
     signal startAddrStorage :std_logic; --! start address storage of the current frame
+    signal storeFrame       :std_logic; --! start address storage of the current frame without dropped frames
+    signal shapeFrame       :std_logic; --! current frame is limited by the shaper
 
     signal delayTime        : std_logic_vector(cSize_Time-1 downto 0);      --! delay timestamp for the incoming frame
+    signal frameIpg         : std_logic_vector(cCreateTime.ipgWidth-1 downto 0);    --! IPG of the incoming frame
+    signal phyFault         : std_logic_vector(cSettingSize.phy-1 downto 0);        --! PHY faults of the incoming frame
+    signal copies           : std_logic_vector(cByteLength-1 downto 0);             --! Number of copies of the incoming frame
+    signal reorder          : std_logic_vector(cByteLength-1 downto 0);             --! Number of frames overtaking the incoming frame
 
     --received fifo data
     signal addrOutData      : std_logic_vector(gAddrDataWidth-1 downto 0);  --! address for new frame
     signal frameTimestamp   : std_logic_vector(cSize_Time-1 downto 0);      --! frame timestamp
     signal currentTime      : std_logic_vector(cSize_Time-1 downto 0);      --! current time
     signal delFrameLoaded   : std_logic;                                    --! a delayed frame was loaded
+    signal frameShape       : std_logic;                                    --! loaded frame is limited by the shaper
+    signal shapeConform     : std_logic;                                    --! token bucket allows a shaped frame
+    signal shapeReady       : std_logic;                                    --! loaded frame isn't held by the shaper
+    signal rdStartAddr      : std_logic;                                    --! start address is read from the fifo
+    signal rdEndAddr        : std_logic;                                    --! end address is read from the fifo
 
     --Fifo signals
     signal fifoWr           : std_logic;    --! write data
@@ -154,12 +188,54 @@ begin
             oDelayTime          => delayTime
             );
 
+    --IPG of the task or the standard one
+    frameIpg    <= iIpgSetting when iTaskIpgEn='1' else
+                    std_logic_vector(to_unsigned(cCreateTime.ipgSize,frameIpg'length));
+
+    --PHY faults of the task or none
+    phyFault    <= iPhySetting when iTaskPhyEn='1' else (others=>'0');
+
+    --number of copies and overtaking frames, when the tasks are active
+    copies      <= iCopySetting when iTaskDuplicateEn='1' else (others=>'0');
+    reorder     <= iReorderSetting when iTaskReorderEn='1' else (others=>'0');
+
+    --! @brief traffic shaper
+    --! - drops frames at the limit of waiting frames
+    --! - holds shaped frames back, until the token bucket allows them
+    Shaper : entity work.Traffic_Shaper
+    generic map(
+            gAddrDataWidth  => gAddrDataWidth,
+            gSettingWidth   => 7*cByteLength
+            )
+    port map(
+            iClk                => iClk,
+            iReset              => iReset,
+            iTestActive         => iTestActive,
+            iTestSync           => iTestSync,
+            iTestStop           => iTestStop,
+            iFrameIsSoC         => iFrameIsSoC,
+            iTaskShapeEn        => iTaskShapeEn,
+            iShapeSetting       => iShapeSetting,
+            iStartStorage       => storeFrame,
+            oStartStorage       => storeFrame,
+            oShapeFrame         => shapeFrame,
+            iFrameShape         => frameShape,
+            iRdStart            => rdStartAddr,
+            iRdEnd              => rdEndAddr,
+            iRdAddr             => addrOutData,
+            oConform            => shapeConform
+            );
+
     --! @brief address storer
-    --! - stores start and end address with delay timestamp and crc distortion flag
+    --! - stores start and end address with delay timestamp, IPG and crc distortion flag
+    --! - writes the addresses again for copies and held back frames
     Addr_in : entity work.StoreAddress_FSM
     generic map(
             gAddrDataWidth  => gAddrDataWidth,
             gSize_Time      => cSize_Time,
+            gIpgWidth       => cCreateTime.ipgWidth,
+            gPhyWidth       => cSettingSize.phy,
+            gCntWidth       => cByteLength,
             gFiFoBitWidth   => cBuffWordWidth
             )
     port map(
@@ -168,6 +244,13 @@ begin
             iStartStorage       => startAddrStorage,
             iFrameEnd           => iFrameEnd,
             iCRCManEn           => iTaskCrcEn,
+            iFrameIpg           => frameIpg,
+            iPhyFault           => phyFault,
+            iFrameIsSoC         => iFrameIsSoC,
+            iCopies             => copies,
+            iCopyIpg            => iIpgSetting,
+            iReorder            => reorder,
+            iShapeEn            => shapeFrame,
             iDataInEndAddr      => iDataInEndAddr,
             iDelayTime          => delayTime,
             oDataInStartAddr    => oDataInStartAddr,
@@ -210,9 +293,22 @@ begin
     --DATA-SPLIT OFF--------------------------------------------------------------------------
 
     --first bits => Timestamp                           iNextFrame='1' appears only at reading the start address
-    frameTimestamp  <= rdFifoData(rdFifoData'left downto gAddrDataWidth) when iNextFrame='1'
+    frameTimestamp  <= rdFifoData(cSize_Time+gAddrDataWidth-1 downto gAddrDataWidth) when iNextFrame='1'
                         and iTestStop='0' else (others=>'0');
 
+    --IPG                                               stored with the start address as well
+    oFrameIpg       <= rdFifoData(cCreateTime.ipgWidth+cSize_Time+gAddrDataWidth-1 downto cSize_Time+gAddrDataWidth);
+
+    --PHY faults                                        stored with the start address as well
+    oPhyFault       <= rdFifoData(rdFifoData'left-1 downto rdFifoData'left-cSettingSize.phy);
+
+    --Shaper flag                                       first bit of the start address
+    frameShape      <= rdFifoData(rdFifoData'left) when iNextFrame='1' and iTestStop='0' else '0';
+
+    --read start and end address
+    rdStartAddr     <= fifoRd and iNextFrame;
+    rdEndAddr       <= fifoRd and not iNextFrame;
+
     --CRC flag                                          iNextFrame='0' appears only at reading the end address
     oDistCrcEn      <= rdFifoData(gAddrDataWidth)  when iNextFrame='0' else '0';
 
@@ -225,11 +321,17 @@ begin
 
     --DELAYING FRAME--------------------------------------------------------------------------
 
-    --Timestamp isn't zero => a delayed frame was loaded => pull counter +1
-    delFrameLoaded  <= '1' when frameTimestamp/=(frameTimestamp'range=>'0') else '0';
+    --Timestamp of the read start address isn't zero => a delayed frame was loaded => pull counter +1
+    --(the Frame-Creator may also be blocked by injected frames, while a delayed frame is waiting)
+    delFrameLoaded  <= '1' when fifoRd='1' and frameTimestamp/=(frameTimestamp'range=>'0') else '0';
+
+    --shaped frames wait for the tokens of the shaper
+    shapeReady      <= shapeConform or not frameShape;
+
+    --data is ready, when data is available, timestamp has been reached and the shaper allows it
+    fifoDataReady   <= not fifoEmpty when frameTimestamp<=currentTime and shapeReady='1' else '0';
 
-    --data is ready, when data is available and timestamp has been reached
-    fifoDataReady   <= not fifoEmpty when frameTimestamp<=currentTime else '0';
+    oFrameReady     <= fifoDataReady;
     ------------------------------------------------------------------------------------------
 
 
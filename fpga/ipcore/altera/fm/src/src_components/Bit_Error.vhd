@@ -0,0 +1,238 @@
+-------------------------------------------------------------------------------
+--! @file Bit_Error.vhd
+--! @brief Injects random bit errors into the stream of the new frame
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+--! Use work library
+library work;
+--! use fm library
+use work.framemanipulatorPkg.all;
+
+--! Common library
+library libcommon;
+--! Use common library global package
+use libcommon.global.all;
+
+
+--! This is the entity of the module, which flips random bits of the new frame
+entity Bit_Error is
+    generic(
+            gSettingWidth   : natural:=6*cByteLength;   --! Width of the PHY setting
+            gCntWidth       : natural:=4*cByteLength    --! Width of the counter of the flipped bits
+            );
+    port(
+        iClk                : in std_logic;     --! clk
+        iReset              : in std_logic;     --! reset
+        --control signals
+        iTestActive         : in std_logic;                                     --! Series of test is active
+        iStartNewFrame      : in std_logic;                                     --! data for a new frame is available
+        iNextFrame          : in std_logic;                                     --! frame-creator is ready for new data
+        iPhySetting         : in std_logic_vector(gSettingWidth-1 downto 0);    --! setting of the PHY or BER task of the new frame
+        oBitErrors          : out std_logic_vector(gCntWidth-1 downto 0);       --! Number of flipped bits since the start of the test
+        --frame stream
+        iTxData             : in std_logic_vector(1 downto 0);  --! stream of the new frame
+        iTxDV               : in std_logic;                     --! data valid of the new frame
+        oTxData             : out std_logic_vector(1 downto 0)  --! stream with bit errors
+     );
+end Bit_Error;
+
+
+--! @brief Bit_Error architecture
+--! @details Injects random bit errors into the stream of the Frame_Creator
+--! - The setting is stored with the start of each frame like in Phy_Fault. Only frames
+--!   with the flag cPhyFault.ber of the BER task receive bit errors.
+--! - A 64 bit LFSR is advanced by 64 steps per clock, so each dibit compares a fresh random
+--!   value of 40 bit with the rate of the setting. Each hit flips one random bit of the
+--!   dibit, which results in a bit error rate of rate/2^41.
+--! - A hit starts a burst of the number of dibits of the setting. Each dibit of the burst
+--!   flips one random bit with a probability of 1/2. The burst ends with the frame.
+--! - All dibits with data valid are affected from the preamble to the CRC, so the
+--!   receiver sees the errors like on the cable.
+--! - The LFSR is seeded and the counter of the flipped bits is cleared at the start of the
+--!   test, so a scenario repeats the same pattern of errors.
+architecture two_seg_arch of Bit_Error is
+
+    --constants
+    constant cLfsrWidth     : natural:=64;                                          --! Width of the LFSR
+    constant cLfsrSeed      : std_logic_vector(cLfsrWidth-1 downto 0):=X"B5AD4ECEDA1CE2A9";  --! Start value of the LFSR
+    constant cRandWidth     : natural:=5*cByteLength;                               --! Width of the compared random value
+    constant cRateWidth     : natural:=4*cByteLength;                               --! Width of the rate of the setting
+
+    --! Typedef for registers
+    type tReg is record
+        setting     : std_logic_vector(gSettingWidth-1 downto 0);   --! Setting of the current frame
+        testActive  : std_logic;                                    --! Register for edge detection of iTestActive
+        lfsr        : std_logic_vector(cLfsrWidth-1 downto 0);      --! Random number generator
+        burst       : unsigned(cByteLength-1 downto 0);             --! Remaining dibits of the burst
+        flips       : unsigned(gCntWidth-1 downto 0);               --! Flipped bits since the start of the test
+    end record;
+
+    --! Init for registers
+    constant cRegInit   : tReg :=(
+                                setting     => (others=>'0'),
+                                testActive  => '0',
+                                lfsr        => cLfsrSeed,
+                                burst       => (others=>'0'),
+                                flips       => (others=>'0')
+                                );
+
+    signal reg          : tReg; --! Registers
+    signal reg_next     : tReg; --! Next value of registers
+
+    signal berActive        : std_logic;                        --! Dibit of a frame of the BER task
+    signal errorHit         : std_logic;                        --! Random value is below the rate
+    signal burstFlip        : std_logic;                        --! Dibit of the burst is flipped
+    signal flip             : std_logic;                        --! Dibit is flipped
+    signal flipMask         : std_logic_vector(1 downto 0);     --! Flipped bit of the dibit
+
+
+    --! Fault flags of cPhyFault in the setting
+    alias setting_flags     : std_logic_vector(cByteLength-1 downto 0)
+                                is reg.setting(gSettingWidth-1 downto gSettingWidth-cByteLength);
+
+    --! Rate of the bit errors in the setting
+    alias setting_rate      : std_logic_vector(cRateWidth-1 downto 0)
+                                is reg.setting(cRateWidth+cByteLength-1 downto cByteLength);
+
+    --! Length of the burst in dibits in the setting
+    alias setting_burst     : std_logic_vector(cByteLength-1 downto 0)
+                                is reg.setting(cByteLength-1 downto 0);
+
+    --! Random value of the hit
+    alias rand_value        : std_logic_vector(cRandWidth-1 downto 0)
+                                is reg.lfsr(cRandWidth-1 downto 0);
+
+    --! Random selection of the flipped bit
+    alias rand_bit          : std_logic is reg.lfsr(cRandWidth);
+
+    --! Random flip of a dibit of the burst
+    alias rand_burst        : std_logic is reg.lfsr(cRandWidth+1);
+
+
+    --! @brief Leap of the LFSR
+    --! - Fibonacci LFSR with the taps 64, 63, 61 and 60
+    --! - Advances the LFSR by its whole width, so all bits are new
+    function lfsrLeap(lfsr : std_logic_vector(cLfsrWidth-1 downto 0)) return std_logic_vector is
+        variable vLfsr  : std_logic_vector(cLfsrWidth-1 downto 0);
+    begin
+        vLfsr   := lfsr;
+        for i in 0 to cLfsrWidth-1 loop
+            vLfsr   := vLfsr(cLfsrWidth-2 downto 0) & (vLfsr(63) xor vLfsr(62) xor vLfsr(60) xor vLfsr(59));
+        end loop;
+        return vLfsr;
+    end function;
+
+begin
+
+    --! @brief Registers
+    --! - Storing with asynchronous reset
+    registers :
+    process(iClk, iReset)
+    begin
+        if iReset='1' then
+            reg <= cRegInit;
+
+        elsif rising_edge(iClk) then
+            reg <= reg_next;
+
+        end if;
+    end process;
+
+
+    berActive   <= '1' when setting_flags(cPhyFault.ber)='1' and iTxDV='1' else '0';
+
+    errorHit    <= '1' when berActive='1' and unsigned(rand_value)<resize(unsigned(setting_rate), cRandWidth)
+                    else '0';
+
+    burstFlip   <= '1' when berActive='1' and reg.burst/=0 and rand_burst='1' else '0';
+
+    flip        <= errorHit or burstFlip;
+
+    flipMask    <= "01" when rand_bit='0' else "10";
+
+
+    --! @brief Next register value logic
+    --! - Storing of the setting with the start of the frame
+    --! - Seed and clear of the counter with the start of the test
+    --! - Counting of the burst and the flipped bits
+    combNext :
+    process(reg, iTestActive, iStartNewFrame, iNextFrame, iPhySetting, iTxDV, errorHit, flip, setting_burst)
+    begin
+        reg_next    <= reg;
+
+        reg_next.testActive <= iTestActive;
+        reg_next.lfsr       <= lfsrLeap(reg.lfsr);
+
+        if iStartNewFrame='1' and iNextFrame='1' then
+            reg_next.setting    <= iPhySetting;
+        end if;
+
+        if iTxDV='0' then
+            reg_next.burst  <= (others=>'0');
+
+        elsif errorHit='1' then
+            reg_next.burst  <= unsigned(setting_burst);
+
+        elsif reg.burst/=0 then
+            reg_next.burst  <= reg.burst-1;
+
+        end if;
+
+        if iTestActive='1' and reg.testActive='0' then
+            reg_next.lfsr   <= cLfsrSeed;
+            reg_next.flips  <= (others=>'0');
+
+        elsif flip='1' then
+            reg_next.flips  <= reg.flips+1;
+
+        end if;
+    end process;
+
+
+    --Output stream
+    oTxData     <= iTxData xor flipMask when flip='1' else iTxData;
+
+    oBitErrors  <= std_logic_vector(reg.flips);
+
+
+end two_seg_arch;
@@ -59,7 +59,7 @@ use libcommon.global.all;
 entity Control_Register is
     generic(
             gWordWidth      : natural :=cByteLength;    --! Word width of avalon bus for FM control
-            gAddresswidth   : natural :=1               --! Address width of avalon bus for FM control
+            gAddresswidth   : natural :=5               --! Address width of avalon bus for FM control
             );
     port(
         iClk                    : in std_logic;                                     --! clk
@@ -76,6 +76,19 @@ entity Control_Register is
         iError_frameBuffOv      : in std_logic;                                     --! Error: Data-buffer overflow
         iError_packetBuffOv     : in std_logic;                                     --! Error: Overflow packet-buffer
         iError_taskConf         : in std_logic;                                     --! Error: Wrong task configuration
+        --Monitoring
+        iPacketOccupancy        : in std_logic_vector(2*gWordWidth-1 downto 0);     --! Number of used slots of the packet buffer
+        --Forwarding
+        oForwardCfg             : out std_logic_vector(gWordWidth-1 downto 0);      --! Forwarding flags of cFwd
+        oEtherTypeCfg           : out std_logic_vector(cEth.noCfgEtherType*cEth.sizeEtherType-1 downto 0);  --! Table of EtherTypes
+        --Task banks
+        oBankSelect             : out std_logic_vector(gWordWidth-1 downto 0);      --! Selected bank of the tasks
+        iActiveBank             : in std_logic_vector(gWordWidth-1 downto 0);       --! Bank of the tasks in use
+        --Start of the test
+        oStartMode              : out std_logic_vector(gWordWidth-1 downto 0);      --! Start mode of cStartMode
+        oStartTime              : out std_logic_vector(cEth.sizeSocTime-1 downto 0);    --! SoC time of the start
+        --Bit errors
+        iBitErrors              : in std_logic_vector(4*gWordWidth-1 downto 0);     --! Number of bits flipped by the BER task
         --avalon bus (s_clk-domain)
         iSt_addr                : in std_logic_vector(gAddresswidth-1 downto 0);              --! FM-control avalon slave address
         iSt_wrEn                : in std_logic;                                               --! FM-control avalon slave write enable
@@ -91,10 +104,45 @@ end Control_Register;
 --! @details Control register
 --! - Transfer of operations from PL-Slave to FM
 --! - Transfer of status- and error-flags to PL-Slave
+--! - Transfer of the packet-buffer occupancy to PL-Slave
+--! - Transfer of the forwarding flags and the EtherType table from PL-Slave to FM.
+--!   Port B reads the operation and the forwarding registers one after another.
+--! - Transfer of the selected task bank from PL-Slave to FM and of the active bank back
+--! - Transfer of the start mode and the start time from PL-Slave to FM
+--! - Transfer of the number of bit errors to PL-Slave. The counter is stored, when port B
+--!   reaches its first Byte, and written instead of the read of its Bytes.
 architecture two_seg_arch of Control_Register is
 
+    --! Address of the operation register
+    constant cAddrOperation     : natural := 0;
+    --! Address of the status register
+    constant cAddrStatus        : natural := 1;
+    --! Address of the lower word of the packet-buffer occupancy
+    constant cAddrOccupancy     : natural := 2;
+    --! Address of the forwarding flags
+    constant cAddrForward       : natural := 4;
+    --! Address of the selected task bank
+    constant cAddrBank          : natural := 5;
+    --! Address of the high Byte of the first EtherType of the table
+    constant cAddrEtherType     : natural := 6;
+    --! Address of the active task bank
+    constant cAddrActiveBank    : natural := 14;
+    --! Address of the start mode
+    constant cAddrStartMode     : natural := 15;
+    --! Address of the lowest Byte of the start time
+    constant cAddrStartTime     : natural := 16;
+    --! Address of the lowest Byte of the number of bit errors
+    constant cAddrBitErrors     : natural := 24;
+    --! Number of Bytes of the EtherType table
+    constant cEtherTypeBytes    : natural := cEth.noCfgEtherType*cEth.sizeEtherType/gWordWidth;
+    --! Number of Bytes of the start time
+    constant cStartTimeBytes    : natural := cEth.sizeSocTime/gWordWidth;
+    --! Number of Bytes of the bit errors
+    constant cBitErrorBytes     : natural := 4;
+
     --data variables
     signal dataB_out    : std_logic_vector(gWordWidth-1 downto 0);              --! Output Operations from Avalon bus
+    signal dataB_in     : std_logic_vector(gWordWidth-1 downto 0);              --! Input status or occupancy to Avalon bus
     signal wren_b       : std_logic;                                            --! Write status endable
     signal rden_b       : std_logic;                                            --! Read operations enable
     signal addr_b       : std_logic_vector(gAddresswidth-1 downto 0);           --! Interface address
@@ -107,6 +155,38 @@ architecture two_seg_arch of Control_Register is
     signal statusByte_reg   : std_logic_vector(gWordWidth-1 downto 0):=(others=>'0');       --! Status register
     signal statusByte_next  : std_logic_vector(gWordWidth-1 downto 0):=(others=>'0');       --! Next status
 
+    --occupancy register
+    signal occupancy_reg    : std_logic_vector(2*gWordWidth-1 downto 0):=(others=>'0');     --! Last written occupancy
+    signal occupancy_next   : std_logic_vector(2*gWordWidth-1 downto 0):=(others=>'0');     --! Next written occupancy
+
+    --forwarding registers
+    signal forward_reg      : std_logic_vector(gWordWidth-1 downto 0):=(others=>'0');                   --! Forwarding flags
+    signal forward_next     : std_logic_vector(gWordWidth-1 downto 0):=(others=>'0');                   --! Next forwarding flags
+    signal etherType_reg    : std_logic_vector(cEtherTypeBytes*gWordWidth-1 downto 0):=(others=>'0');   --! EtherType table
+    signal etherType_next   : std_logic_vector(cEtherTypeBytes*gWordWidth-1 downto 0):=(others=>'0');   --! Next EtherType table
+
+    --task bank registers
+    signal bank_reg         : std_logic_vector(gWordWidth-1 downto 0):=(others=>'0');   --! Selected task bank
+    signal bank_next        : std_logic_vector(gWordWidth-1 downto 0):=(others=>'0');   --! Next selected task bank
+    signal activeBank_reg   : std_logic_vector(gWordWidth-1 downto 0):=(others=>'0');   --! Last written active bank
+    signal activeBank_next  : std_logic_vector(gWordWidth-1 downto 0):=(others=>'0');   --! Next written active bank
+
+    --start registers
+    signal startMode_reg    : std_logic_vector(gWordWidth-1 downto 0):=(others=>'0');               --! Start mode
+    signal startMode_next   : std_logic_vector(gWordWidth-1 downto 0):=(others=>'0');               --! Next start mode
+    signal startTime_reg    : std_logic_vector(cStartTimeBytes*gWordWidth-1 downto 0):=(others=>'0');   --! Start time
+    signal startTime_next   : std_logic_vector(cStartTimeBytes*gWordWidth-1 downto 0):=(others=>'0');   --! Next start time
+
+    --bit error register
+    signal bitErrors_reg    : std_logic_vector(cBitErrorBytes*gWordWidth-1 downto 0):=(others=>'0');    --! Stored number of bit errors
+    signal bitErrors_next   : std_logic_vector(cBitErrorBytes*gWordWidth-1 downto 0):=(others=>'0');    --! Next stored number
+
+    --cyclic read of port B
+    signal rdAddr_reg       : std_logic_vector(gAddresswidth-1 downto 0):=(others=>'0');    --! Address of the next read
+    signal rdAddr_next      : std_logic_vector(gAddresswidth-1 downto 0):=(others=>'0');    --! Next read address
+    signal lastAddr_reg     : std_logic_vector(gAddresswidth-1 downto 0):=(others=>'0');    --! Address of the data at port B
+    signal lastRdEn_reg     : std_logic:='0';                                               --! Data at port B was read
+
 
     signal writeStatus : std_logic;    --! writes status, when changes occurres
     signal clearErrors  : std_logic;    --! Opertaion: Clear all errors
@@ -123,10 +203,32 @@ begin
         if iReset='1' then
             statusByte_reg      <= (others=>'0');
             operationByte_reg   <= (others=>'0');
+            occupancy_reg       <= (others=>'0');
+            forward_reg         <= (others=>'0');
+            etherType_reg       <= (others=>'0');
+            bank_reg            <= (others=>'0');
+            activeBank_reg      <= (others=>'0');
+            startMode_reg       <= (others=>'0');
+            startTime_reg       <= (others=>'0');
+            bitErrors_reg       <= (others=>'0');
+            rdAddr_reg          <= (others=>'0');
+            lastAddr_reg        <= (others=>'0');
+            lastRdEn_reg        <= '0';
 
         elsif rising_edge(iClk) then
             statusByte_reg      <= statusByte_next;
             operationByte_reg   <= operationByte_next;
+            occupancy_reg       <= occupancy_next;
+            forward_reg         <= forward_next;
+            etherType_reg       <= etherType_next;
+            bank_reg            <= bank_next;
+            activeBank_reg      <= activeBank_next;
+            startMode_reg       <= startMode_next;
+            startTime_reg       <= startTime_next;
+            bitErrors_reg       <= bitErrors_next;
+            rdAddr_reg          <= rdAddr_next;
+            lastAddr_reg        <= addr_b;
+            lastRdEn_reg        <= rden_b;
 
         end if;
     end process;
@@ -153,15 +255,82 @@ begin
     --writes new status, when changes occure
     writeStatus<='0' when statusByte_next=statusByte_reg else '1';
 
-    wren_b<='1' when writeStatus='1' else '0'; --enable write at changes
-    rden_b<='1' when writeStatus='0' else '0'; --disable read at changes
+    --! @brief Access of port B
+    --! - Addr 1: Write status, when changes occure
+    --! - Addr 2 and 3: Write packet-buffer occupancy, when changes occure
+    --! - Addr 14: Write active task bank, when changes occure
+    --! - Otherwise read all addresses one after another for the operations, the forwarding and the start registers
+    --! - Addr 24 to 27: Write the number of bit errors in turn of the read, stored at Addr 24
+    combPortB :
+    process(writeStatus, statusByte_next, occupancy_reg, iPacketOccupancy, activeBank_reg, iActiveBank, rdAddr_reg,
+            bitErrors_reg, iBitErrors)
+    begin
+        wren_b          <= '0';
+        rden_b          <= '1';
+        addr_b          <= rdAddr_reg;
+        dataB_in        <= statusByte_next;
+
+        occupancy_next  <= occupancy_reg;
+        activeBank_next <= activeBank_reg;
+        bitErrors_next  <= bitErrors_reg;
+        rdAddr_next     <= std_logic_vector(unsigned(rdAddr_reg)+1);
+
+        if writeStatus = '1' then   --status has priority
+            wren_b      <= '1';
+            rden_b      <= '0';
+            addr_b      <= std_logic_vector(to_unsigned(cAddrStatus, addr_b'length));
+            rdAddr_next <= rdAddr_reg;
+
+        elsif iPacketOccupancy(gWordWidth-1 downto 0) /= occupancy_reg(gWordWidth-1 downto 0) then  --lower word
+            wren_b      <= '1';
+            rden_b      <= '0';
+            addr_b      <= std_logic_vector(to_unsigned(cAddrOccupancy, addr_b'length));
+            dataB_in    <= iPacketOccupancy(gWordWidth-1 downto 0);
+            rdAddr_next <= rdAddr_reg;
+
+            occupancy_next(gWordWidth-1 downto 0)   <= iPacketOccupancy(gWordWidth-1 downto 0);
+
+        elsif iPacketOccupancy(2*gWordWidth-1 downto gWordWidth) /= occupancy_reg(2*gWordWidth-1 downto gWordWidth) then  --upper word
+            wren_b      <= '1';
+            rden_b      <= '0';
+            addr_b      <= std_logic_vector(to_unsigned(cAddrOccupancy+1, addr_b'length));
+            dataB_in    <= iPacketOccupancy(2*gWordWidth-1 downto gWordWidth);
+            rdAddr_next <= rdAddr_reg;
+
+            occupancy_next(2*gWordWidth-1 downto gWordWidth)    <= iPacketOccupancy(2*gWordWidth-1 downto gWordWidth);
+
+        elsif iActiveBank /= activeBank_reg then
+            wren_b      <= '1';
+            rden_b      <= '0';
+            addr_b      <= std_logic_vector(to_unsigned(cAddrActiveBank, addr_b'length));
+            dataB_in    <= iActiveBank;
+            rdAddr_next <= rdAddr_reg;
+
+            activeBank_next <= iActiveBank;
+
+        elsif unsigned(rdAddr_reg)>=cAddrBitErrors and unsigned(rdAddr_reg)<cAddrBitErrors+cBitErrorBytes then
+            wren_b      <= '1';
+            rden_b      <= '0';
+
+            if to_integer(unsigned(rdAddr_reg))=cAddrBitErrors then     --store all Bytes at once
+                dataB_in        <= iBitErrors(gWordWidth-1 downto 0);
+                bitErrors_next  <= iBitErrors;
+            end if;
+
+            for i in 1 to cBitErrorBytes-1 loop
+                if to_integer(unsigned(rdAddr_reg))=cAddrBitErrors+i then
+                    dataB_in    <= bitErrors_reg((i+1)*gWordWidth-1 downto i*gWordWidth);
+                end if;
+            end loop;
+
+        end if;
+    end process;
 
-    addr_b(0)<='1' when writeStatus='1' else '0';  --Addr 1 = Write Errors, else Read Addr 0 = Operations
 
     --Memory----------------------------------------------------------
 
     --! @brief Control memory
-    --! - Storing of operations and status/error flags
+    --! - Storing of operations, status/error flags and packet-buffer occupancy
     ControlMem : entity work.DpramAdjustable
     generic map(
                 gAddresswidthA  => gAddresswidth,
@@ -180,7 +349,7 @@ begin
             oQ_a         => oSt_ReadData,
             --Port B: FM
             iAddress_b   => addr_b,
-            iData_b      => statusByte_next,
+            iData_b      => dataB_in,
             iWren_b      => wren_b,
             iRden_b      => rden_b,
             iByteena_b   => (others=>'1'),
@@ -189,8 +358,57 @@ begin
 
 
     --Operation Output------------------------------------------------
-    --update register, when data is read
-    operationByte_next  <= dataB_out(operationByte_next'range) when rden_b='1' else operationByte_reg;
+
+    --! @brief Update of the registers with the read data of the last address
+    --! - EtherTypes of the table with the high Byte first
+    --! - Start time with the low Byte first like in the SoC
+    combRead :
+    process(lastRdEn_reg, lastAddr_reg, dataB_out, operationByte_reg, forward_reg, etherType_reg, bank_reg,
+            startMode_reg, startTime_reg)
+    begin
+        operationByte_next  <= operationByte_reg;
+        forward_next        <= forward_reg;
+        etherType_next      <= etherType_reg;
+        bank_next           <= bank_reg;
+        startMode_next      <= startMode_reg;
+        startTime_next      <= startTime_reg;
+
+        if lastRdEn_reg='1' then
+            if to_integer(unsigned(lastAddr_reg))=cAddrOperation then
+                operationByte_next  <= dataB_out(operationByte_next'range);
+
+            elsif to_integer(unsigned(lastAddr_reg))=cAddrForward then
+                forward_next        <= dataB_out;
+
+            elsif to_integer(unsigned(lastAddr_reg))=cAddrBank then
+                bank_next           <= dataB_out;
+
+            elsif to_integer(unsigned(lastAddr_reg))=cAddrStartMode then
+                startMode_next      <= dataB_out;
+
+            end if;
+
+            for i in 0 to cEtherTypeBytes-1 loop
+                if to_integer(unsigned(lastAddr_reg))=cAddrEtherType+i then
+                    etherType_next((i/2)*cEth.sizeEtherType+(2-i mod 2)*gWordWidth-1 downto
+                                    (i/2)*cEth.sizeEtherType+(1-i mod 2)*gWordWidth)  <= dataB_out;
+                end if;
+            end loop;
+
+            for i in 0 to cStartTimeBytes-1 loop
+                if to_integer(unsigned(lastAddr_reg))=cAddrStartTime+i then
+                    startTime_next((i+1)*gWordWidth-1 downto i*gWordWidth)  <= dataB_out;
+                end if;
+            end loop;
+        end if;
+    end process;
+
+    oForwardCfg     <= forward_reg;
+    oEtherTypeCfg   <= etherType_reg;
+    oBankSelect     <= bank_reg;
+    oStartMode      <= startMode_reg;
+    oStartTime      <= startTime_reg;
+
 
     oStartTest  <='1' when operationByte_reg(cOp.Start)='1'   and operationByte_reg(cOp.Stop)='0'
                                                             and operationByte_reg(cOp.ClearMem)='0'
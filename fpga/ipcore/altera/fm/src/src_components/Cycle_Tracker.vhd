@@ -0,0 +1,232 @@
+-------------------------------------------------------------------------------
+--! @file Cycle_Tracker.vhd
+--! @brief Tracks the phase and the multiplexed slot of the POWERLINK cycle
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+--! Use work library
+library work;
+--! use fm library
+use work.framemanipulatorPkg.all;
+
+--! Common library
+library libcommon;
+--! Use common library global package
+use libcommon.global.all;
+
+
+--! This is the entity of the module, which follows the structure of the POWERLINK cycle
+entity Cycle_Tracker is
+    port(
+        iClk            : in std_logic;                                 --! clk
+        iReset          : in std_logic;                                 --! reset
+        --frame data
+        iFrameSync      : in std_logic;                                 --! sync for new incoming frame
+        iFrameBypass    : in std_logic;                                 --! frame with unknown EtherType
+        iCollFinished   : in std_logic;                                 --! header of the frame was received
+        iMessageType    : in std_logic_vector(cByteLength-1 downto 0);  --! MessageType of the frame
+        iSocMc          : in std_logic;                                 --! flag MC of a SoC
+        iSoaService     : in std_logic_vector(cByteLength-1 downto 0);  --! RequestedServiceID of a SoA
+        iWindowFinished : in std_logic;                                 --! Bytes of the filter windows were received
+        iSoaTarget      : in std_logic_vector(cByteLength-1 downto 0);  --! RequestedServiceTarget of a SoA
+        --cycle structure of the current frame
+        oPhase          : out std_logic_vector(cByteLength-1 downto 0); --! flag of cCyclePhase, zero before the first SoC or SoA
+        oMuxSlot        : out std_logic_vector(cByteLength-1 downto 0); --! multiplexed slot, zero before the first toggle of MC
+        oInvitedNode    : out std_logic_vector(cByteLength-1 downto 0); --! node invited by the SoA of the asynchronous phase
+        oInvitedService : out std_logic_vector(cByteLength-1 downto 0)  --! service requested by the SoA of the asynchronous phase
+    );
+end Cycle_Tracker;
+
+
+--! @brief Cycle_Tracker architecture
+--! @details Follows the cycle SoC -> PReq/PRes -> SoA -> ASnd of the received frames
+--! - The SoC starts the isochronous phase, the SoA the asynchronous one.
+--! - The multiplexed slot restarts at 1 with the SoC, whose flag MC toggled, and counts the
+--!   following SoCs up to 255.
+--! - The invited node and service of the SoA are taken over with the next frame, so they only
+--!   apply to the frames behind the SoA.
+--! - The values of a SoC or SoA are put out with its header, before they are stored.
+architecture two_seg_arch of Cycle_Tracker is
+
+    --! Typedef for registers
+    type tReg is record
+        frameDone       : std_logic;                                    --! SoC or SoA of the current frame was taken over
+        phase           : std_logic_vector(cByteLength-1 downto 0);     --! Phase of the cycle
+        mc              : std_logic;                                    --! Flag MC of the last SoC
+        mcValid         : std_logic;                                    --! A SoC was received
+        muxSlot         : std_logic_vector(cByteLength-1 downto 0);     --! Multiplexed slot of the current cycle
+        invitedNode     : std_logic_vector(cByteLength-1 downto 0);     --! Node invited by the last SoA
+        invitedService  : std_logic_vector(cByteLength-1 downto 0);     --! Service requested by the last SoA
+        soaPending      : std_logic;                                    --! Invitation of the current SoA waits for the next frame
+        soaNode         : std_logic_vector(cByteLength-1 downto 0);     --! Node invited by the current SoA
+        soaService      : std_logic_vector(cByteLength-1 downto 0);     --! Service requested by the current SoA
+    end record;
+
+    --! Init for registers
+    constant cRegInit   : tReg :=(
+                                frameDone       => '0',
+                                phase           => (others=>'0'),
+                                mc              => '0',
+                                mcValid         => '0',
+                                muxSlot         => (others=>'0'),
+                                invitedNode     => (others=>'0'),
+                                invitedService  => (others=>'0'),
+                                soaPending      => '0',
+                                soaNode         => (others=>'0'),
+                                soaService      => (others=>'0')
+                                );
+
+    signal reg          : tReg; --! Registers
+    signal reg_next     : tReg; --! Next value of registers
+
+    signal frameIsSoc   : std_logic;                                    --! Header of a SoC, which wasn't taken over
+    signal frameIsSoa   : std_logic;                                    --! Header of a SoA, which wasn't taken over
+    signal socMuxSlot   : std_logic_vector(cByteLength-1 downto 0);     --! Multiplexed slot of the current SoC
+
+begin
+
+    --! @brief Registers
+    --! - Storing with asynchronous reset
+    registers :
+    process(iClk, iReset)
+    begin
+        if iReset='1' then
+            reg <= cRegInit;
+
+        elsif rising_edge(iClk) then
+            reg <= reg_next;
+
+        end if;
+    end process;
+
+
+    frameIsSoc  <= '1' when iCollFinished='1' and iFrameBypass='0' and reg.frameDone='0'
+                        and iMessageType=cEth.messageTypeSoC else '0';
+
+    frameIsSoa  <= '1' when iCollFinished='1' and iFrameBypass='0' and reg.frameDone='0'
+                        and iMessageType=cEth.messageTypeSoA else '0';
+
+
+    --first slot at the toggle of MC, unknown slot until then
+    socMuxSlot  <= std_logic_vector(to_unsigned(1, cByteLength)) when reg.mcValid='1' and iSocMc/=reg.mc else
+                    reg.muxSlot when reg.muxSlot=(reg.muxSlot'range=>'0') or reg.muxSlot=(reg.muxSlot'range=>'1') else
+                    std_logic_vector(unsigned(reg.muxSlot)+1);
+
+
+    --! @brief Next register value logic
+    --! - Take over the SoC or SoA once per frame with its header
+    --! - Store the invitation of the SoA with the Bytes of the filter windows, use it from the next frame on
+    combNext :
+    process(reg, iFrameSync, iCollFinished, frameIsSoc, frameIsSoa, socMuxSlot, iSocMc, iWindowFinished,
+            iMessageType, iFrameBypass, iSoaService, iSoaTarget)
+    begin
+        reg_next    <= reg;
+
+        if iFrameSync='1' then
+            reg_next.frameDone  <= '0';
+
+            if reg.soaPending='1' then
+                reg_next.invitedNode    <= reg.soaNode;
+                reg_next.invitedService <= reg.soaService;
+                reg_next.soaPending     <= '0';
+
+            end if;
+
+        elsif iCollFinished='1' then
+            reg_next.frameDone  <= '1';
+
+        end if;
+
+        if frameIsSoc='1' then
+            reg_next.phase          <= (others=>'0');
+            reg_next.phase(cCyclePhase.isochronous) <= '1';
+            reg_next.mc             <= iSocMc;
+            reg_next.mcValid        <= '1';
+            reg_next.muxSlot        <= socMuxSlot;
+            reg_next.invitedNode    <= (others=>'0');
+            reg_next.invitedService <= (others=>'0');
+
+        elsif frameIsSoa='1' then
+            reg_next.phase          <= (others=>'0');
+            reg_next.phase(cCyclePhase.async)       <= '1';
+            reg_next.invitedNode    <= (others=>'0');
+            reg_next.invitedService <= (others=>'0');
+
+        end if;
+
+        if iWindowFinished='1' and iFrameSync='0' and iFrameBypass='0' and iMessageType=cEth.messageTypeSoA then
+            reg_next.soaPending <= '1';
+            reg_next.soaNode    <= iSoaTarget;
+            reg_next.soaService <= iSoaService;
+
+        end if;
+
+    end process;
+
+
+    --! @brief Output of the current frame
+    --! - A SoC or SoA is put out before it is stored
+    combOut :
+    process(reg, frameIsSoc, frameIsSoa, socMuxSlot)
+    begin
+        oPhase          <= reg.phase;
+        oMuxSlot        <= reg.muxSlot;
+        oInvitedNode    <= reg.invitedNode;
+        oInvitedService <= reg.invitedService;
+
+        if frameIsSoc='1' then
+            oPhase                          <= (others=>'0');
+            oPhase(cCyclePhase.isochronous) <= '1';
+            oMuxSlot                        <= socMuxSlot;
+            oInvitedNode                    <= (others=>'0');
+            oInvitedService                 <= (others=>'0');
+
+        elsif frameIsSoa='1' then
+            oPhase                          <= (others=>'0');
+            oPhase(cCyclePhase.async)       <= '1';
+            oInvitedNode                    <= (others=>'0');
+            oInvitedService                 <= (others=>'0');
+
+        end if;
+    end process;
+
+end two_seg_arch;
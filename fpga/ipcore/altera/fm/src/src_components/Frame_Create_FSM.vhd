@@ -65,6 +65,7 @@ entity Frame_Create_FSM is
         iReset              : in std_logic;                     --! reset
 
         iFrameStart         : in std_logic;                     --! start of a new frame
+        iFrameIpg           : in std_logic_vector(cCreateTime.ipgWidth-1 downto 0); --! inter packet gap before the new frame in Byte
         iReadBuffDone       : in std_logic;                     --! buffer reading has reched the last position
 
         iPacketExchangeEn   : in std_logic;                                 --! Start of the exchange of the safety packet
@@ -97,7 +98,7 @@ architecture Behave of Frame_Create_FSM is
             sRead,          --! loads and converts frame payload
             sSafetyRead,    --! Activate safety packet exchange
             sCrc,           --! starts CRC_calculator
-            sWait_IPG       --! waits a few cycles to keep the Inter Packet Gap of 960ns
+            sWait_IPG       --! waits until the Inter Packet Gap before the new frame has passed
             );
 
     signal state_reg    : tMcState; --! Current state
@@ -110,6 +111,15 @@ architecture Behave of Frame_Create_FSM is
     signal pCnt         : std_logic_vector(gSafetyPackSelCntWidth-1 downto 0);  --! Byte counter for packet exchange
     signal pCntPre      : std_logic;                                            --! Prescaler for packet counter
 
+    --inter packet gap
+    signal clearIpgCnt  : std_logic;                                            --! Clear of gap counter
+    signal ipgCntEn     : std_logic;                                            --! Gap counter hasn't reached its limit
+    signal ipgCnt       : std_logic_vector(cCreateTime.ipgCntWidth-1 downto 0); --! Clock cycles since the end of the last frame
+    signal ipgReached   : std_logic;                                            --! Gap of iFrameIpg has passed
+    signal reg_ipgReached   : std_logic;                                        --! Gap of the stored IPG has passed
+    signal next_ipg     : std_logic_vector(cCreateTime.ipgWidth-1 downto 0);    --! Next inter packet gap
+    signal reg_ipg      : std_logic_vector(cCreateTime.ipgWidth-1 downto 0);    --! Inter packet gap of the new frame
+
 begin
 
     --! @brief counter for timings
@@ -130,6 +140,36 @@ begin
             );
 
 
+    --! @brief counter for the inter packet gap
+    --! - counts the clock cycles after the last frame and stops at its limit
+    --! - starts at its limit to send the first frame without delay
+    IPG_Cnter : entity work.FixCnter
+    generic map(
+                gCntWidth   => cCreateTime.ipgCntWidth,
+                gStartValue => (cCreateTime.ipgCntWidth-1 downto 0 => '0'),
+                gInitValue  => (cCreateTime.ipgCntWidth-1 downto 0 => '1'),
+                gEndValue   => (cCreateTime.ipgCntWidth-1 downto 0 => '1')
+                )
+    port map(
+            iClk    => iClk,
+            iReset  => iReset,
+            iClear  => clearIpgCnt,
+            iEn     => ipgCntEn,
+            oQ      => ipgCnt,
+            oOv     => open
+            );
+
+    ipgCntEn    <= '0' when ipgCnt=(ipgCnt'range=>'1') else '1';
+
+    --gap has passed, when the counted and the uncounted cycles reach it => Byte*4 cycles of the IPG
+    --the standard IPG starts the preamble in the 48th cycle after the CRC like the fixed wait of 44 cycles
+    ipgReached      <= '1' when ('0' & unsigned(ipgCnt))+cCreateTime.ipgCntOffset>=unsigned(iFrameIpg & "00")  else '0';
+    reg_ipgReached  <= '1' when ('0' & unsigned(ipgCnt))+cCreateTime.ipgCntOffset>=unsigned(reg_ipg & "00")    else '0';
+
+    --IPG of the new frame is stored at its start
+    next_ipg    <= iFrameIpg when state_reg=sIdle and iFrameStart='1' else reg_ipg;
+
+
     --! @brief prescaler for safety counter
     --! - starts with Ov to eliminate register delay
     Packet_Prescaler : entity work.FixCnter
@@ -176,23 +216,29 @@ begin
     process(iClk, iReset)
     begin
         if iReset='1' then
-            state_reg <= sIdle;
+            state_reg   <= sIdle;
+            reg_ipg     <= (others=>'0');
 
         elsif rising_edge(iClk) then
-            state_reg <= state_next;
+            state_reg   <= state_next;
+            reg_ipg     <= next_ipg;
 
         end if;
     end process;
 
 
     --! @brief next-state logic
-    process(state_reg, iFrameStart, iReadBuffDone,cnt,pCnt,iPacketExchangeEn,iPacketStart,iPacketSize)
+    process(state_reg, iFrameStart, iReadBuffDone,cnt,pCnt,iPacketExchangeEn,iPacketStart,iPacketSize,
+            ipgReached,reg_ipgReached)
     begin
         case state_reg is
 
             when sIdle =>
-                if iFrameStart='1' then
-                    state_next  <= sPreamble;   --start of preamble after start
+                if iFrameStart='1' and ipgReached='1' then
+                    state_next  <= sPreamble;   --start of preamble after start, when the IPG has passed
+
+                elsif iFrameStart='1' then
+                    state_next  <= sWait_IPG;   --wait for the IPG of the new frame
 
                 else
                     state_next  <= sIdle;
@@ -246,7 +292,7 @@ begin
 
             when sCrc =>
                 if cnt=std_logic_vector(to_unsigned(cCreateTime.crcTime,cnt'length)) then
-                    state_next  <= sWait_IPG;   --goto waiting after CRC has finished
+                    state_next  <= sIdle;       --ready for the next frame after CRC has finished
 
                 else
                     state_next  <= sCrc;
@@ -254,8 +300,8 @@ begin
                 end if;
 
             when sWait_IPG =>
-                if cnt=std_logic_vector(to_unsigned(cCreateTime.crcTime+cCreateTime.ipgTime,cnt'length)) then
-                    state_next  <= sIdle;   --goto idle after waiting for the IPG
+                if reg_ipgReached='1' then
+                    state_next  <= sPreamble;   --start of preamble after waiting for the IPG
 
                 else
                     state_next  <= sWait_IPG;
@@ -278,10 +324,12 @@ begin
 
         clearCnt    <= '0';
         clearPCnt   <= '1';             --always inactive
+        clearIpgCnt <= '1';             --active between frames
 
         case state_reg is
             when sIdle=>                --IDLE:
                 clearCnt        <= '1'; --deaktivates Cnter
+                clearIpgCnt     <= '0'; --Gap Cnter is active
                 oNextFrame      <= '1'; --FSM is ready for new data
 
             when sPreamble=>            --PREAMBLE
@@ -304,8 +352,9 @@ begin
             when sCrc=>                 --CRC (is Meely to compensate one cycle of delay)
                 null;
 
-            when sWait_IPG=>            --WAIT_IPG (doesn't need output)
-                null;
+            when sWait_IPG=>            --WAIT_IPG
+                clearCnt        <= '1'; --deaktivates Cnter
+                clearIpgCnt     <= '0'; --Gap Cnter is active
 
         end case;
 
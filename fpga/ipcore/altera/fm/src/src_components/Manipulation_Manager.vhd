@@ -59,9 +59,13 @@ entity Manipulation_Manager is
     generic(
             gFrom               : natural := 15;                --! Start byte for checking the frame header
             gTo                 : natural := 22;                --! Last byte for checking the frame header
+            gWindowTo           : natural := 52;                --! Last byte for checking the filter windows
+            gFilterWindows      : natural := 2;                 --! Number of filter windows per task
             gWordWidth          : natural := 8*cByteLength;     --! Width of the task objects
             gManiSettingWidth   : natural := 14*cByteLength;    --! Width of the total setting
             gSafetySetting      : natural := 5*cByteLength;     --! Width of the used setting for safety manipulations
+            gSafetyPackets      : natural := 4;                 --! Number of safety packets per frame
+            gSafetyContexts     : natural := 2;                 --! Number of concurrent safety contexts
             gCycleCntWidth      : natural := 8;                 --! Width of the counter for the current cycle
             gBuffAddrWidth      : natural := 5                  --! Address width of the task memory
         );
@@ -71,10 +75,15 @@ entity Manipulation_Manager is
         --control signals
         iStartFrameProcess  : in std_logic;     --! Valid Frame received for processing
         iFrameSync          : in std_logic;     --! sync for collecting header-data
+        iFrameTagged        : in std_logic;     --! frame has a VLAN tag => header behind the tag
+        iFrameBypass        : in std_logic;     --! frame with unknown EtherType is forwarded without tasks
         iStartTest          : in std_logic;     --! start series of test
         iStopTest           : in std_logic;     --! stop test
+        iStartMode          : in std_logic_vector(cByteLength-1 downto 0);          --! start mode of cStartMode
+        iStartTime          : in std_logic_vector(cEth.sizeSocTime-1 downto 0);     --! SoC time of the start
         iClearMem           : in std_logic;     --! clear all tasks
-        iSafetyActive       : in std_logic;     --! safety manipulations are active
+        iSafetyActive       : in std_logic_vector(gSafetyContexts-1 downto 0);  --! safety manipulations of each context are active
+        iBankSelect         : in std_logic_vector(cByteLength-1 downto 0);      --! selected bank of the tasks
         oStartFrameStorage  : out std_logic;    --! valid frame was compared and can be stored
         oTestSync           : out std_logic;    --! sync of a new test
         oManiActive         : out std_logic;    --! series of test is currently running
@@ -83,18 +92,32 @@ entity Manipulation_Manager is
         --data signals
         iData               : in std_logic_vector(cByteLength-1 downto 0);          --! frame-stream
         iTaskSettingData    : in std_logic_vector(2*gWordWidth-1 downto 0);         --! settings for the tasks
+        iTaskValid          : in std_logic;                                         --! task has a setting other than zero since the last clear
+        iTaskRemain         : in std_logic;                                         --! task or one of the following tasks is valid
         iTaskCompFrame      : in std_logic_vector(gWordWidth-1 downto 0);           --! frame-header-data for the tasks
         iTaskCompMask       : in std_logic_vector(gWordWidth-1 downto 0);           --! frame-mask for the tasks
+        iTaskWindowData     : in std_logic_vector(gFilterWindows*gWordWidth-1 downto 0);    --! filter windows for the tasks
+        iTaskChainData      : in std_logic_vector(gWordWidth-1 downto 0);           --! chain of the tasks
         oTaskSelection      : out std_logic_vector(gBuffAddrWidth-1 downto 0);      --! Task selection
+        oTaskBank           : out std_logic_vector(cByteLength-1 downto 0);         --! Bank of the task selection
         --manipulations
         oTaskDelayEn        : out std_logic;                                        --! task: delay frame
         oTaskManiEn         : out std_logic;                                        --! task: manipulate header
         oTaskCrcEn          : out std_logic;                                        --! task: distort crc
         oTaskCutEn          : out std_logic;                                        --! task: truncate frame
-        oTaskSafetyEn       : out std_logic;                                        --! task: safety packet manipulation
-        oSafetyFrame        : out std_logic;                                        --! current frame matches to the current or last safety task
-        oManiSetting        : out std_logic_vector(gManiSettingWidth-1 downto 0);   --! manipulation setting
-        oSafetySetting      : out std_logic_vector(gSafetySetting-1 downto 0)       --! Setting of the current or last safety task
+        oTaskIpgEn          : out std_logic;                                        --! task: set inter packet gap
+        oTaskInjectEn       : out std_logic;                                        --! task: inject template frames
+        oTaskDuplicateEn    : out std_logic;                                        --! task: send copies of the frame
+        oTaskReorderEn      : out std_logic;                                        --! task: send frame behind the following frames
+        oTaskShapeEn        : out std_logic;                                        --! task: limit the rate of the following frames
+        oTaskPhyEn          : out std_logic;                                        --! task: inject faults of the PHY level
+        oTaskBerEn          : out std_logic;                                        --! task: flip random bits of the frame
+        oTaskSocTimeEn      : out std_logic;                                        --! task: shift the time of the SoC
+        oSocTime            : out std_logic_vector(2*cEth.sizeSocTime-1 downto 0);  --! NetTime and RelativeTime of the current frame in the order of the frame
+        oTaskSafetyEn       : out std_logic_vector(gSafetyContexts-1 downto 0);                 --! task: safety packet manipulation of each context
+        oSafetyFrame        : out std_logic_vector(gSafetyContexts-1 downto 0);                 --! current frame matches to the current or last safety task of each context
+        oManiSetting        : out std_logic_vector(gManiSettingWidth-1 downto 0);               --! manipulation setting
+        oSafetySetting      : out std_logic_vector(gSafetyContexts*gSafetySetting-1 downto 0)   --! Setting of the current or last safety task of each context
      );
 end Manipulation_Manager;
 
@@ -105,14 +128,47 @@ end Manipulation_Manager;
 --! manipulations to the other components
 --! - It starts counting the following POWERLINK-cycles by detecting the SoCs.
 --!   It is reading the tasks and selecting the fitting one.
+--! - Additional filter windows of each task are compared in parallel to the frame header.
+--!   Their Bytes up to gWindowTo are collected while the frame passes. The task reading
+--!   only waits for them, when the header and cycle of the task fit.
+--! - The header, the SoC detection and the filter windows behind the EtherType are moved
+--!   behind the VLAN tag of tagged frames. Frames of the bypass aren't compared at all.
+--! - Tasks without their valid bit are skipped, the comparison ends behind the last valid task.
+--! - The selected bank of the tasks is taken over, when a SoC is detected at its MessageType. This
+--!   is before the comparison of the tasks, so the SoC and all frames of its POWERLINK cycle are
+--!   compared with the same bank.
+--! - The task chains count the selected frames of each task. After the number of hits of its chain,
+--!   a task arms or disarms other tasks or itself or stops the series of test. Disarmed tasks are
+--!   skipped like invalid ones, the task Trigger only counts the frame without a manipulation.
+--! - The start modes with a trigger arm the test at the positive edge of iStartTest. An armed test
+--!   starts with the first frame, which fits to a start task regardless of its cycle, or with the
+--!   first SoC at or behind the start time. Start tasks are skipped during the test.
+--! - The NetTime and RelativeTime of the collected Bytes are passed on to the SoC time task.
+--! - The Cycle_Tracker follows the phases and the multiplexed slots of the POWERLINK cycle.
+--!   Bytes 5-8 of the task chain select the frames of a phase, a slot or an invitation of the SoA.
 architecture two_seg_arch of Manipulation_Manager is
 
+    constant cNoOfTasks     : natural := 2**gBuffAddrWidth;     --! Number of tasks
+
+    --! Typedef for the hit counters of the tasks
+    type tHitCnt is array (cNoOfTasks-1 downto 0) of std_logic_vector(cByteLength-1 downto 0);
+
     --! Typedef for registers
     type tReg is record
         startTest       : std_logic;                                                --! Register for edge detection of iStartTest
+        startArmed      : std_logic;                                                --! Test waits for its start trigger
         testActive      : std_logic;                                                --! Test is active
         maniSetting     : std_logic_vector(2*gWordWidth-gCycleCntWidth-1 downto 0); --!settings for the task
+        taskSafetyEn    : std_logic_vector(gSafetyContexts-1 downto 0);             --!safety task of each context fits
         cycleLastTask   : std_logic_vector(gCycleCntWidth-1 downto 0);              --! cycle number of the last task
+        frameIsSoc      : std_logic;                                                --! Register for edge detection of the SoC
+        taskBank        : std_logic_vector(cByteLength-1 downto 0);                 --! bank of the tasks in use
+        taskAddr        : std_logic_vector(gBuffAddrWidth-1 downto 0);              --! address of the task data, one cycle behind the read address
+        taskHit         : std_logic;                                                --! task of hitAddr was already counted for the current frame
+        hitAddr         : std_logic_vector(gBuffAddrWidth-1 downto 0);              --! address of the last counted task
+        hitCnt          : tHitCnt;                                                  --! selected frames of each task
+        chainArmed      : std_logic_vector(cNoOfTasks-1 downto 0);                  --! task was armed by a chain
+        chainDisarmed   : std_logic_vector(cNoOfTasks-1 downto 0);                  --! task was disarmed by a chain
     end record;
 
 
@@ -120,9 +176,19 @@ architecture two_seg_arch of Manipulation_Manager is
     --! - Manipulator should run for at least one PL cycle
     constant cRegInit   : tReg :=(
                                 startTest       => '0',
+                                startArmed      => '0',
                                 testActive      => '0',
                                 maniSetting     => (others => '0'),
-                                cycleLastTask   => (0=>'1', others => '0')
+                                taskSafetyEn    => (others => '0'),
+                                cycleLastTask   => (0=>'1', others => '0'),
+                                frameIsSoc      => '0',
+                                taskBank        => (others => '0'),
+                                taskAddr        => (others => '0'),
+                                taskHit         => '0',
+                                hitAddr         => (others => '0'),
+                                hitCnt          => (others => (others => '0')),
+                                chainArmed      => (others => '0'),
+                                chainDisarmed   => (others => '0')
                                 );
 
     signal reg          : tReg; --! Registers
@@ -130,12 +196,33 @@ architecture two_seg_arch of Manipulation_Manager is
 
 
     --Test signals
-    signal testSync : std_logic;  --!reset for new test at positive edge of iStartTest
+    signal testSync     : std_logic;    --!reset for new test at positive edge of iStartTest or at the start trigger
+    signal startEdge    : std_logic;    --! positive edge of iStartTest
+    signal startTrigger : std_logic;    --! start mode waits for a trigger
+    signal startSearch  : std_logic;    --! armed test searches for a frame of a start task
+    signal startTask    : std_logic;    --! current task is a valid start task
+    signal startFrame   : std_logic;    --! frame fits to a start task of the armed test
+    signal startSoc     : std_logic;    --! SoC reached the start time of the armed test
+    signal socTime      : std_logic_vector(cEth.sizeSocTime-1 downto 0);   --! NetTime or RelativeTime of the current frame
+    signal socFields    : std_logic_vector(2*cEth.sizeSocTime-1 downto 0); --! NetTime and RelativeTime of the current frame
 
     --collector signals
     signal collFinished         : std_logic;                                    --! collector received the header data
     signal headerData           : std_logic_vector(gWordWidth-1 downto 0);      --! received header data
+    signal collFinishedEth      : std_logic;                                    --! collector received the header of an untagged frame
+    signal headerDataEth        : std_logic_vector(gWordWidth-1 downto 0);      --! header data of an untagged frame
+    signal collFinishedVlan     : std_logic;                                    --! collector received the header of a tagged frame
+    signal headerDataVlan       : std_logic_vector(gWordWidth-1 downto 0);      --! header data of a tagged frame
     signal frameIsSoc           : std_logic;                                    --! Current frame is a SoC
+    signal windowCollFinished   : std_logic;                                    --! collector received the Bytes of the filter windows
+    signal windowData           : std_logic_vector(gWindowTo*cByteLength-1 downto 0);   --! received Bytes of the filter windows
+    signal soaTarget            : std_logic_vector(cByteLength-1 downto 0);     --! RequestedServiceTarget of a SoA
+
+    --cycle structure
+    signal cyclePhase           : std_logic_vector(cByteLength-1 downto 0);     --! phase of the current frame
+    signal muxSlot              : std_logic_vector(cByteLength-1 downto 0);     --! multiplexed slot of the current frame
+    signal invitedNode          : std_logic_vector(cByteLength-1 downto 0);     --! node invited by the SoA of the current frame
+    signal invitedService       : std_logic_vector(cByteLength-1 downto 0);     --! service requested by the SoA of the current frame
 
     --memory signals
     signal readEn               : std_logic;                                    --! read task-buffer
@@ -145,14 +232,21 @@ architecture two_seg_arch of Manipulation_Manager is
     signal currentCycle         : std_logic_vector(gCycleCntWidth-1 downto 0);  --! current PL Cycle of the Ssries of test
 
     --task variables
-    signal taskEmpty            : std_logic;                                    --! current task consists of zeroes => reached end of task
+    signal taskEmpty            : std_logic;                                    --! no valid task from the current one on => reached end of tasks
+    signal taskMem              : std_logic_vector(cByteLength-1 downto 0);     --! task of the current entry, zero when invalid
     signal headerConformance    : std_logic;                                    --! frame header fits with the frame of the task
+    signal cycleConformance     : std_logic;                                    --! current cycle fits with the cycle of the task
+    signal phaseConformance     : std_logic;                                    --! phase, slot and invitation fit with the task
+    signal windowUsed           : std_logic_vector(gFilterWindows-1 downto 0);  --! filter window of the task is used
+    signal windowConformance    : std_logic_vector(gFilterWindows-1 downto 0);  --! frame fits with the filter window of the task
+    signal windowWait           : std_logic;                                    --! task reading waits for the Bytes of the filter windows
     signal selectedTask         : std_logic;                                    --! conformance with header an POWRLINK-cycle
+    signal taskArmed            : std_logic;                                    --! task isn't disarmed by its chain or another one
+    signal taskHitNew           : std_logic;                                    --! first selection of the task within the frame
     signal compFinished         : std_logic;                                    --! all tasks were compared
 
     --manipulation tasks:
     signal taskDropEn           : std_logic;                                    --! drop frame
-    signal safetyTask           : std_logic_vector(cByteLength-1 downto 0);     --! safety task of the test
 
 
     --! Manipulation setting of whole setting:
@@ -171,14 +265,65 @@ architecture two_seg_arch of Manipulation_Manager is
     alias iTaskSettingData_task         : std_logic_vector(cByteLength-1 downto 0)
                                             is iTaskSettingData(reg.maniSetting'left downto reg.maniSetting'left-cByteLength+1);
 
+    --! Flags of the task chain
+    alias iTaskChainData_flags          : std_logic_vector(cByteLength-1 downto 0)
+                                            is iTaskChainData(gWordWidth-1 downto gWordWidth-cByteLength);
+
+    --! Number of hits, after which the chain is executed
+    alias iTaskChainData_hits           : std_logic_vector(cByteLength-1 downto 0)
+                                            is iTaskChainData(gWordWidth-cByteLength-1 downto gWordWidth-2*cByteLength);
+
+    --! Number of the task (1-n), which is armed by the chain
+    alias iTaskChainData_arm            : std_logic_vector(cByteLength-1 downto 0)
+                                            is iTaskChainData(gWordWidth-2*cByteLength-1 downto gWordWidth-3*cByteLength);
+
+    --! Number of the task (1-n), which is disarmed by the chain
+    alias iTaskChainData_disarm         : std_logic_vector(cByteLength-1 downto 0)
+                                            is iTaskChainData(gWordWidth-3*cByteLength-1 downto gWordWidth-4*cByteLength);
+
+    --! Flags of cCyclePhase, in which the task selects its frames
+    alias iTaskChainData_phase          : std_logic_vector(cByteLength-1 downto 0)
+                                            is iTaskChainData(gWordWidth-4*cByteLength-1 downto gWordWidth-5*cByteLength);
+
+    --! Multiplexed slot, in which the task selects its frames
+    alias iTaskChainData_slot           : std_logic_vector(cByteLength-1 downto 0)
+                                            is iTaskChainData(gWordWidth-5*cByteLength-1 downto gWordWidth-6*cByteLength);
+
+    --! Node, which was invited by the SoA in front of the frame
+    alias iTaskChainData_node           : std_logic_vector(cByteLength-1 downto 0)
+                                            is iTaskChainData(gWordWidth-6*cByteLength-1 downto gWordWidth-7*cByteLength);
+
+    --! Service, which was requested by the SoA in front of the frame
+    alias iTaskChainData_service        : std_logic_vector(cByteLength-1 downto 0)
+                                            is iTaskChainData(gWordWidth-7*cByteLength-1 downto 0);
+
+    --! MessageType of the header
+    alias headerData_messageType        : std_logic_vector(cByteLength-1 downto 0)
+                                            is headerData((gTo-cEth.startMessageType+1)*cByteLength-1 downto (gTo-cEth.startMessageType)*cByteLength);
+
+    --! Flags of a SoC in the header
+    alias headerData_socFlags           : std_logic_vector(cByteLength-1 downto 0)
+                                            is headerData((gTo-cEth.startSocFlags+1)*cByteLength-1 downto (gTo-cEth.startSocFlags)*cByteLength);
+
+    --! RequestedServiceID of a SoA in the header
+    alias headerData_soaService         : std_logic_vector(cByteLength-1 downto 0)
+                                            is headerData((gTo-cEth.startSoaService+1)*cByteLength-1 downto (gTo-cEth.startSoaService)*cByteLength);
+
     --! Setting of the selected manipulation:
     alias maniSetting_task              : std_logic_vector(cByteLength-1 downto 0)
                                             is reg.ManiSetting(reg.maniSetting'left downto reg.maniSetting'left-cByteLength+1);
 
 
     -- safety tasks:
-    signal nextSafetyFrame     : std_logic_vector(gWordWidth-1 downto 0);   --! data of next safety frame
-    signal nextSafetyMask      : std_logic_vector(gWordWidth-1 downto 0);   --! mask of next safety frame
+    --! Typedef for the frame filters of the safety contexts
+    type tSafetyFilter is array (gSafetyContexts-1 downto 0) of std_logic_vector(gWordWidth-1 downto 0);
+
+    signal nextSafetyFrame      : tSafetyFilter;                                    --! data of next safety frame of each context
+    signal nextSafetyMask       : tSafetyFilter;                                    --! mask of next safety frame of each context
+    signal safetyActive         : std_logic;                                        --! safety manipulations of any context are active
+    signal contextSel           : std_logic_vector(gSafetyContexts-1 downto 0);     --! safety context of the current task
+    signal error_contextOv      : std_logic;                                        --! more frame filters than safety contexts
+    signal error_taskConf       : std_logic_vector(gSafetyContexts-1 downto 0);     --! wrong task configuration of each context
 
 begin
 
@@ -204,9 +349,20 @@ begin
     --!   Reset at end of cycle counter, last task or an abort
     --! - Set ManiSetting when the matching task of the current frame was found.
     --!   Reset when new frame arrives
+    --! - Set the safety enable of the context of a matching safety task.
+    --!   Reset when new frame arrives
     --! - storing the last cycle of all tasks
+    --! - Take over the selected bank at the detection of a SoC, before its tasks are compared
+    --! - Count the first selection of a task per frame. Execute its chain, when the counter reaches
+    --!   the number of hits. Reset the counters and chains at test start
+    --! - Arm the test at the positive edge of the start signal, when the start mode waits for a trigger.
+    --!   Disarm at test start or an abort
     nextComb :
-    process(reg, iStartTest, TestSync, iStopTest, currentCycle, selectedTask, iFrameSync)
+    process(reg, iStartTest, TestSync, iStopTest, currentCycle, selectedTask, iFrameSync, contextSel, iTaskValid,
+            frameIsSoc, iBankSelect, taskSelection, taskHitNew, iTaskSettingData, iTaskChainData,
+            startEdge, startTrigger)
+        variable vTask      : natural;                      --! task of the current data
+        variable vHits      : unsigned(cByteLength downto 0);   --! hits of the task with the current frame
     begin
         reg_next    <= reg;
 
@@ -238,8 +394,19 @@ begin
 
         end if;
 
+        --test waits for its start trigger
+        if startEdge='1' and startTrigger='1' then
+            reg_next.startArmed <= '1';
+
+        end if;
+
+        if testSync='1' or iStopTest='1' then
+            reg_next.startArmed <= '0';
+
+        end if;
+
         --Set Mani setting at start of Frame
-        if (selectedTask='1') then          --task fits => store setting
+        if (selectedTask='1' and iTaskSettingData_task/=cTask.trigger) then --task fits => store setting
             reg_next.maniSetting    <= iTaskSettingData_maniSetting;
 
         elsif (iFrameSync='1') then         --reset => delete setting
@@ -247,6 +414,15 @@ begin
 
         end if;
 
+        --Set safety enable of the context
+        if (selectedTask='1') then          --task fits => enable its context
+            reg_next.taskSafetyEn   <= reg.taskSafetyEn or contextSel;
+
+        elsif (iFrameSync='1') then         --reset => disable contexts
+            reg_next.taskSafetyEn   <= cRegInit.taskSafetyEn;
+
+        end if;
+
 
         --Reset, when test inactive
         if reg.TestActive = '0' then
@@ -254,17 +430,92 @@ begin
 
         end if;
 
-        --store the last task cycle
-        if unsigned(iTaskSettingData_Cycle) > unsigned(reg.CycleLastTask) then
+        --store the last task cycle, start tasks have none
+        if iTaskValid='1' and iTaskSettingData_task/=cTask.start
+            and unsigned(iTaskSettingData_Cycle) > unsigned(reg.CycleLastTask) then
             reg_next.CycleLastTask  <= iTaskSettingData_Cycle;
 
         end if;
 
+
+        --bank switch at the detection of the SoC, the header of the tasks follows behind the MessageType
+        reg_next.frameIsSoc <= frameIsSoc;
+
+        if frameIsSoc='1' and reg.frameIsSoc='0' then
+            reg_next.taskBank   <= iBankSelect;
+
+        end if;
+
+
+        --task chains
+        vTask   := to_integer(unsigned(reg.taskAddr));
+        vHits   := resize(unsigned(reg.hitCnt(vTask)), vHits'length)+1;
+
+        reg_next.taskAddr   <= taskSelection;
+
+        if iFrameSync='1' then              --new frame => count the tasks again
+            reg_next.taskHit    <= '0';
+
+        end if;
+
+        if taskHitNew='1' then
+            reg_next.taskHit    <= '1';
+            reg_next.hitAddr    <= reg.taskAddr;
+
+            if reg.hitCnt(vTask)/=(cByteLength-1 downto 0 => '1') then   --counter saturates
+                reg_next.hitCnt(vTask)  <= std_logic_vector(vHits(cByteLength-1 downto 0));
+
+            end if;
+
+            if vHits=unsigned(iTaskChainData_hits) then     --number of hits reached => execute chain
+
+                if unsigned(iTaskChainData_arm)/=0 and unsigned(iTaskChainData_arm)<=cNoOfTasks then
+                    reg_next.chainArmed(to_integer(unsigned(iTaskChainData_arm))-1)     <= '1';
+                    reg_next.chainDisarmed(to_integer(unsigned(iTaskChainData_arm))-1)  <= '0';
+
+                end if;
+
+                if unsigned(iTaskChainData_disarm)/=0 and unsigned(iTaskChainData_disarm)<=cNoOfTasks then
+                    reg_next.chainDisarmed(to_integer(unsigned(iTaskChainData_disarm))-1)   <= '1';
+
+                end if;
+
+                if iTaskChainData_flags(cChain.once)='1' then
+                    reg_next.chainDisarmed(vTask)   <= '1';
+
+                end if;
+
+                if iTaskChainData_flags(cChain.stop)='1' then
+                    reg_next.testActive <= '0';
+
+                end if;
+
+            end if;
+
+        end if;
+
+        if testSync='1' then                --new test => restart counters and chains
+            reg_next.taskHit        <= cRegInit.taskHit;
+            reg_next.hitCnt         <= cRegInit.hitCnt;
+            reg_next.chainArmed     <= cRegInit.chainArmed;
+            reg_next.chainDisarmed  <= cRegInit.chainDisarmed;
+
+        end if;
+
     end process;
 
+    oTaskBank   <= reg.taskBank;
+
+
+    --Positive edge of start signal
+    startEdge   <= '1' when (iStartTest = '1' and reg.startTest = '0')  else '0';
 
-    --Test reset after positive edge of start signal
-    testSync    <= '1' when (iStartTest = '1' and reg.startTest = '0')  else '0';
+    --Start modes, which arm the test at the edge
+    startTrigger<= '1' when iStartMode=cStartMode.trigger or iStartMode=cStartMode.netTime
+                            or iStartMode=cStartMode.relTime else '0';
+
+    --Test reset after positive edge of start signal or at the trigger of the armed test
+    testSync    <= '1' when (startEdge='1' and startTrigger='0') or startFrame='1' or startSoc='1' else '0';
     oTestSync   <= testSync;
 
 
@@ -276,6 +527,8 @@ begin
             iReset      => iReset,
             iTestSync   => testSync,
             iFrameSync  => iFrameSync,
+            iFrameTagged=> iFrameTagged,
+            iFrameBypass=> iFrameBypass,
             iEn         => reg.TestActive,
             iData       => iData,
             oFrameIsSoc => frameIsSoc,
@@ -283,6 +536,85 @@ begin
             );
 
 
+    --! @brief SoC time of the start mode
+    --! - The NetTime is compared with its seconds above the nanoseconds, the RelativeTime as it is.
+    --!   Both are little endian like the start time
+    --! - The time is moved behind the VLAN tag of tagged frames
+    combSocTime :
+    process(windowData, iFrameTagged, iStartMode)
+        constant cBytes     : natural := cEth.sizeSocTime/cByteLength;  --! Bytes of the time
+        variable vStart     : natural;                                  --! First Byte of the time
+        variable vPos       : natural;
+        variable vByte      : std_logic_vector(cByteLength-1 downto 0);
+    begin
+        socTime <= (others=>'0');
+
+        if iStartMode=cStartMode.netTime then
+            vStart  := cEth.startNetTime;
+        else
+            vStart  := cEth.startRelativeTime;
+        end if;
+
+        if iFrameTagged='1' then
+            vStart  := vStart+cEth.sizeVlanTag;
+        end if;
+
+        for b in 0 to cBytes-1 loop
+            vPos    := vStart+b;
+            vByte   := (others=>'0');
+
+            for k in cEth.startNetTime to cEth.startRelativeTime+cEth.sizeVlanTag+cBytes-1 loop
+                if vPos=k then  --Byte k is stored at the top of the collector
+                    vByte   := windowData((gWindowTo-k+1)*cByteLength-1 downto (gWindowTo-k)*cByteLength);
+                end if;
+            end loop;
+
+            if iStartMode=cStartMode.netTime then   --seconds in the upper, nanoseconds in the lower half
+                socTime((((b+cBytes/2) mod cBytes)+1)*cByteLength-1 downto ((b+cBytes/2) mod cBytes)*cByteLength)
+                        <= vByte;
+            else
+                socTime((b+1)*cByteLength-1 downto b*cByteLength)   <= vByte;
+            end if;
+        end loop;
+
+    end process;
+
+
+    --! @brief NetTime and RelativeTime of the SoC time task
+    --! - Both fields with the first Byte of the frame at the bottom, moved behind the VLAN tag
+    combSocFields :
+    process(windowData, iFrameTagged)
+        constant cBytes     : natural := 2*cEth.sizeSocTime/cByteLength;    --! Bytes of both fields
+        variable vPos       : natural;
+    begin
+        socFields   <= (others=>'0');
+
+        for b in 0 to cBytes-1 loop
+            vPos    := cEth.startNetTime+b;
+
+            if iFrameTagged='1' then
+                vPos    := vPos+cEth.sizeVlanTag;
+            end if;
+
+            for k in cEth.startNetTime to cEth.startNetTime+cEth.sizeVlanTag+cBytes-1 loop
+                if vPos=k then  --Byte k is stored at the top of the collector
+                    socFields((b+1)*cByteLength-1 downto b*cByteLength)
+                            <= windowData((gWindowTo-k+1)*cByteLength-1 downto (gWindowTo-k)*cByteLength);
+                end if;
+            end loop;
+        end loop;
+
+    end process;
+
+    oSocTime    <= socFields;
+
+
+    --SoC of the armed test has reached the start time
+    startSoc    <= '1' when reg.startArmed='1' and (iStartMode=cStartMode.netTime or iStartMode=cStartMode.relTime)
+                        and frameIsSoc='1' and windowCollFinished='1'
+                        and unsigned(socTime)>=unsigned(iStartTime) else '0';
+
+
     --output of SoC information, when comparison of the manipulation tasks has finished
     -- => it can be used for storing setting information
     oFrameIsSoc <= frameIsSoc when compFinished='1' else '0';
@@ -304,13 +636,79 @@ begin
             iReset              => iReset,
             iData               => iData,
             iSync               => iFrameSync,
-            oFrameData          => headerData,
-            oCollectorFinished  => collFinished
+            oFrameData          => headerDataEth,
+            oCollectorFinished  => collFinishedEth
+            );
+
+
+    --! @brief Header data collector of tagged frames
+    FCV : entity work.Frame_collector
+    generic map(
+                gFrom   => gFrom+cEth.sizeVlanTag,
+                gTo     => gTo+cEth.sizeVlanTag
+                )
+    port map(
+            iClk                => iClk,
+            iReset              => iReset,
+            iData               => iData,
+            iSync               => iFrameSync,
+            oFrameData          => headerDataVlan,
+            oCollectorFinished  => collFinishedVlan
+            );
+
+
+    --header behind the VLAN tag, the tag is detected before the header of untagged frames is complete
+    headerData      <= headerDataVlan   when iFrameTagged='1' else headerDataEth;
+    collFinished    <= collFinishedVlan when iFrameTagged='1' else collFinishedEth;
+
+
+    --! @brief Collector of the Bytes of the filter windows
+    WC : entity work.Frame_collector
+    generic map(
+                gFrom   => 1,
+                gTo     => gWindowTo
+                )
+    port map(
+            iClk                => iClk,
+            iReset              => iReset,
+            iData               => iData,
+            iSync               => iFrameSync,
+            oFrameData          => windowData,
+            oCollectorFinished  => windowCollFinished
+            );
+
+
+    --RequestedServiceTarget of a SoA behind the header, moved behind the VLAN tag
+    soaTarget   <= windowData((gWindowTo-cEth.startSoaTarget-cEth.sizeVlanTag+1)*cByteLength-1
+                                downto (gWindowTo-cEth.startSoaTarget-cEth.sizeVlanTag)*cByteLength) when iFrameTagged='1' else
+                    windowData((gWindowTo-cEth.startSoaTarget+1)*cByteLength-1 downto (gWindowTo-cEth.startSoaTarget)*cByteLength);
+
+
+    --! @brief Phases and multiplexed slots of the POWERLINK cycle
+    --! - SoC -> PReq/PRes is the isochronous, SoA -> ASnd the asynchronous phase
+    --! - The multiplexed slot restarts with the toggle of the flag MC of the SoC
+    --! - The invitation of the SoA applies to the frames behind it
+    CycleTracker : entity work.Cycle_Tracker
+    port map(
+            iClk            => iClk,
+            iReset          => iReset,
+            iFrameSync      => iFrameSync,
+            iFrameBypass    => iFrameBypass,
+            iCollFinished   => collFinished,
+            iMessageType    => headerData_messageType,
+            iSocMc          => headerData_socFlags(cEth.socFlagMc),
+            iSoaService     => headerData_soaService,
+            iWindowFinished => windowCollFinished,
+            iSoaTarget      => soaTarget,
+            oPhase          => cyclePhase,
+            oMuxSlot        => muxSlot,
+            oInvitedNode    => invitedNode,
+            oInvitedService => invitedService
             );
 
 
     --enable task-reading, when header-data are ready and the manager is still comparing the tasks
-    ReadEn  <= '1' when (collFinished='1' and compFinished='0') else '0';
+    ReadEn  <= '1' when (collFinished='1' and compFinished='0' and windowWait='0') else '0';
 
 
     --! @brief logic for reading the task-data
@@ -329,14 +727,15 @@ begin
             );
 
 
-    --Comparing has finished, when the last entry or an gap was reached
-    compFinished<= '1' when (to_integer(unsigned(taskSelection))+1=2**gBuffAddrWidth)
-                                or TaskEmpty='1' else '0';
+    --Comparing has finished, when the last entry or the end of the valid tasks was reached or the frame bypasses the tasks
+    compFinished<= '1' when (((to_integer(unsigned(taskSelection))+1=2**gBuffAddrWidth)
+                                or TaskEmpty='1') and windowWait='0') or iFrameBypass='1' else '0';
+
+    --no valid task follows => end of tasks
+    taskEmpty<= not iTaskRemain;
 
-    --current task is empty => gap
-    taskEmpty<= '1' when iTaskSettingData=(iTaskSettingData'range=>'0')
-                            and iTaskCompFrame=(iTaskCompFrame'range=>'0')
-                            and iTaskCompMask=(iTaskCompMask'range=>'0') else '0';
+    --invalid entries keep the data before the last clear => hidden from the safety tasks, like disarmed tasks
+    taskMem <= iTaskSettingData_Task when iTaskValid='1' and taskArmed='1' else (others=>'0');
     ---------------------------------------------------------------------------------------------
 
 
@@ -348,9 +747,125 @@ begin
                                     and iTaskCompMask)=(headerData'range=>'0') else '0';
 
 
-    --Task Cycle=current cycle => Frame fits with selected task
-    selectedTask<= '1' when (headerConformance='1' and collFinished='1' and reg.testActive='1'
-                        and (currentCycle=iTaskSettingData_Cycle or iTaskSettingData_Cycle=X"FF") ) else '0';
+    --Task Cycle=current cycle
+    cycleConformance <= '1' when (currentCycle=iTaskSettingData_Cycle or iTaskSettingData_Cycle=X"FF") else '0';
+
+
+    --Phase, multiplexed slot and invitation of the SoA fit with the chain of the task, zero values aren't compared
+    phaseConformance <= '1' when (iTaskChainData_phase=(cByteLength-1 downto 0 => '0')
+                                    or (iTaskChainData_phase and cyclePhase)/=(cByteLength-1 downto 0 => '0'))
+                            and (iTaskChainData_slot=(cByteLength-1 downto 0 => '0') or iTaskChainData_slot=muxSlot)
+                            and (iTaskChainData_node=(cByteLength-1 downto 0 => '0') or iTaskChainData_node=invitedNode)
+                            and (iTaskChainData_service=(cByteLength-1 downto 0 => '0')
+                                    or iTaskChainData_service=invitedService) else '0';
+
+
+    --! @brief Filter windows
+    --! - Window word: offset of the first Byte, data and mask of three Bytes
+    --! - An unused window has a mask of zero
+    --! - The offset counts without VLAN tag, Bytes behind the EtherType are moved behind the tag
+    genWindow :
+    for i in 0 to gFilterWindows-1 generate
+
+        --! window word of this filter window
+        alias winWord   : std_logic_vector(gWordWidth-1 downto 0)
+                            is iTaskWindowData((i+1)*gWordWidth-1 downto i*gWordWidth);
+
+        --! first Byte of the window
+        alias winOffset : std_logic_vector(cParam.sizeFilterOffset-1 downto 0)
+                            is winWord(gWordWidth-1 downto gWordWidth-cParam.sizeFilterOffset);
+
+        --! data of the window
+        alias winData   : std_logic_vector(cParam.sizeFilterWindow-1 downto 0)
+                            is winWord(2*cParam.sizeFilterWindow-1 downto cParam.sizeFilterWindow);
+
+        --! mask of the window
+        alias winMask   : std_logic_vector(cParam.sizeFilterWindow-1 downto 0)
+                            is winWord(cParam.sizeFilterWindow-1 downto 0);
+
+    begin
+
+        windowUsed(i)   <= '1' when winMask/=(winMask'range=>'0') else '0';
+
+        --! @brief Comparison of the window
+        --! - selects the Bytes of the window from the collected Bytes
+        combWindow :
+        process(winOffset, winData, winMask, windowData, iFrameTagged)
+            constant cBytes     : natural := cParam.sizeFilterWindow/cByteLength;   --! Bytes of a window
+            variable vFrame     : std_logic_vector(cParam.sizeFilterWindow-1 downto 0);
+            variable vValid     : boolean;
+            variable vByteValid : boolean;
+            variable vPos       : natural;
+        begin
+            vFrame  := (others=>'0');
+            vValid  := true;
+
+            for b in 0 to cBytes-1 loop
+                vPos        := to_integer(unsigned(winOffset))+b;
+                vByteValid  := false;
+
+                if iFrameTagged='1' and vPos>=cEth.startEtherType then
+                    vPos    := vPos+cEth.sizeVlanTag;
+                end if;
+
+                for k in 1 to gWindowTo loop
+                    if vPos=k then  --Byte k is stored at the top of the collector
+                        vFrame((cBytes-b)*cByteLength-1 downto (cBytes-b-1)*cByteLength)
+                                    := windowData((gWindowTo-k+1)*cByteLength-1 downto (gWindowTo-k)*cByteLength);
+                        vByteValid  := true;
+                    end if;
+                end loop;
+
+                vValid  := vValid and vByteValid;
+            end loop;
+
+            if winMask=(winMask'range=>'0') or
+                (vValid and ((vFrame xor winData) and winMask)=(winMask'range=>'0')) then
+                windowConformance(i)    <= '1';
+            else
+                windowConformance(i)    <= '0';
+            end if;
+
+        end process;
+
+    end generate genWindow;
+
+
+    --Header and cycle fit, but the Bytes of the filter windows haven't been received yet
+    --The armed test waits for the windows of the start tasks regardless of the cycle
+    windowWait  <= '1' when windowUsed/=(windowUsed'range=>'0') and windowCollFinished='0'
+                        and headerConformance='1' and phaseConformance='1' and collFinished='1' and iTaskValid='1'
+                        and ((cycleConformance='1' and reg.testActive='1' and taskArmed='1')
+                            or (startTask='1' and startSearch='1')) else '0';
+
+
+    --Task Cycle=current cycle and all windows fit => Frame fits with selected task
+    selectedTask<= '1' when (headerConformance='1' and phaseConformance='1' and collFinished='1' and reg.testActive='1'
+                        and cycleConformance='1' and windowWait='0' and iFrameBypass='0' and iTaskValid='1'
+                        and taskArmed='1' and startTask='0' and windowConformance=(windowConformance'range=>'1') ) else '0';
+
+
+    --Valid start task, which is only used by the armed test
+    startTask   <= '1' when iTaskValid='1' and iTaskSettingData_task=cTask.start else '0';
+
+    --Armed test waits for a frame of a start task
+    startSearch <= '1' when reg.startArmed='1' and iStartMode=cStartMode.trigger else '0';
+
+    --Header and all windows fit with a start task => start of the armed test
+    startFrame  <= '1' when (headerConformance='1' and phaseConformance='1' and collFinished='1'
+                        and startSearch='1' and startTask='1'
+                        and windowWait='0' and iFrameBypass='0'
+                        and windowConformance=(windowConformance'range=>'1') ) else '0';
+
+
+    --Task isn't disarmed and a standby task was armed by a chain
+    taskArmed   <= '1' when reg.chainDisarmed(to_integer(unsigned(reg.taskAddr)))='0'
+                        and (iTaskChainData_flags(cChain.standby)='0'
+                            or reg.chainArmed(to_integer(unsigned(reg.taskAddr)))='1') else '0';
+
+
+    --Count a task only once, while the reading stays at the last task
+    taskHitNew  <= '1' when selectedTask='1' and not (reg.taskHit='1' and reg.hitAddr=reg.taskAddr) else '0';
 
 
     ---------------------------------------------------------------------------------------------
@@ -360,13 +875,20 @@ begin
     --DATA HANDLING (select the right manipulation, output)----------------------------------
 
     --Second Byte: Definnition of the kind of manipulation with the second Byte
-    taskDropEn<=    '1' when maniSetting_task = cTask.drop      else '0';
-    oTaskDelayEn<=  '1' when maniSetting_task = cTask.delay     else '0';
-    oTaskCrcEn<=    '1' when maniSetting_task = cTask.crc       else '0';
-    oTaskManiEn<=   '1' when maniSetting_task = cTask.mani      else '0';
-    oTaskCutEn<=    '1' when maniSetting_task = cTask.cut       else '0';
-    oTaskSafetyEn<= '1' when (maniSetting_task = safetyTask and safetyTask /= (safetyTask'range=>'0'))
-                        else '0';
+    taskDropEn<=      '1' when maniSetting_task = cTask.drop        else '0';
+    oTaskDelayEn<=    '1' when maniSetting_task = cTask.delay       else '0';
+    oTaskCrcEn<=      '1' when maniSetting_task = cTask.crc         else '0';
+    oTaskManiEn<=     '1' when maniSetting_task = cTask.mani        else '0';
+    oTaskCutEn<=      '1' when maniSetting_task = cTask.cut         else '0';
+    oTaskIpgEn<=      '1' when maniSetting_task = cTask.ipg         else '0';
+    oTaskInjectEn<=   '1' when maniSetting_task = cTask.inject      else '0';
+    oTaskDuplicateEn<='1' when maniSetting_task = cTask.duplicate   else '0';
+    oTaskReorderEn<=  '1' when maniSetting_task = cTask.reorder     else '0';
+    oTaskShapeEn<=    '1' when maniSetting_task = cTask.shape       else '0';
+    oTaskPhyEn<=      '1' when maniSetting_task = cTask.phy         else '0';
+    oTaskBerEn<=      '1' when maniSetting_task = cTask.ber         else '0';
+    oTaskSocTimeEn<=  '1' when maniSetting_task = cTask.socTime     else '0';
+    oTaskSafetyEn<= reg.taskSafetyEn;
 
     --output
     oManiSetting    <= reg.maniSetting(oManiSetting'left downto 0);
@@ -383,37 +905,83 @@ begin
     -- SAFETY TASK DETECTION --------------------------------------------------------------------
 
 
-    --! @brief Check of safety task
-    SafetyTaskCheck : entity work.SafetyTaskSelection
+    --safety manipulations of any context are active
+    safetyActive    <= '1' when iSafetyActive /= (iSafetyActive'range => '0') else '0';
+
+
+    --! @brief Assignment of the safety tasks to the contexts via their frame filter
+    SafetyContextCheck : entity work.SafetyContextSelection
     generic map(
                 gWordWidth      => gWordWidth,
-                gSafetySetting  => gSafetySetting
+                gSafetyContexts => gSafetyContexts
                 )
     port map(
             iClk                => iClk,
             iReset              => iReset,
             iClearMem           => iClearMem,
             iTestActive         => reg.TestActive,
-            iSafetyActive       => iSafetyActive,
+            iSafetyActive       => safetyActive,
             iReadEn             => readEn,
-            iCycleNr            => currentCycle,
-            iTaskMem            => iTaskSettingData_Task,
-            iCycleMem           => iTaskSettingData_Cycle,
-            iSettingMem         => iTaskSettingData_Safety,
+            iTaskMem            => taskMem,
             iFrameMem           => iTaskCompFrame,
             iMaskMem            => iTaskCompMask,
-            oError_taskConf     => oError_taskConf,
-            oNextSafetySetting  => oSafetySetting,
-            oNextSafetyFrame    => nextSafetyFrame,
-            oNextSafetyMask     => nextSafetyMask,
-            oSafetyTask         => safetyTask);
-
-    --current frame matches to the current or last safety task
-    oSafetyFrame    <= '1' when ((headerData xor nextSafetyFrame) and nextSafetyMask)
-                                =(headerData'range=>'0')
-                            and compFinished = '1'                              --when comparison has finished ...
-                            and nextSafetyMask/=(nextSafetyMask'range=>'0')     --... and frame mask is valid
-                            else '0';
+            oError_taskConf     => error_contextOv,
+            oContextSel         => contextSel
+            );
+
+
+    --! @brief Safety contexts
+    --! - Every context selects its next safety task independently
+    --! - Safety tasks of other contexts are hidden, other tasks are visible to all contexts
+    genContext :
+    for i in 0 to gSafetyContexts-1 generate
+
+        signal contextTaskMem   : std_logic_vector(cByteLength-1 downto 0); --! task from memory for this context
+
+    begin
+
+        contextTaskMem  <= taskMem when contextSel(i) = '1' or not isSafetyTask(taskMem)
+                            else (others => '0');
+
+
+        --! @brief Check of safety task
+        SafetyTaskCheck : entity work.SafetyTaskSelection
+        generic map(
+                    gWordWidth      => gWordWidth,
+                    gSafetySetting  => gSafetySetting,
+                    gSafetyPackets  => gSafetyPackets
+                    )
+        port map(
+                iClk                => iClk,
+                iReset              => iReset,
+                iClearMem           => iClearMem,
+                iTestActive         => reg.TestActive,
+                iSafetyActive       => iSafetyActive(i),
+                iReadEn             => readEn,
+                iCycleNr            => currentCycle,
+                iTaskMem            => contextTaskMem,
+                iCycleMem           => iTaskSettingData_Cycle,
+                iSettingMem         => iTaskSettingData_Safety,
+                iFrameMem           => iTaskCompFrame,
+                iMaskMem            => iTaskCompMask,
+                oError_taskConf     => error_taskConf(i),
+                oNextSafetySetting  => oSafetySetting((i+1)*gSafetySetting-1 downto i*gSafetySetting),
+                oNextSafetyFrame    => nextSafetyFrame(i),
+                oNextSafetyMask     => nextSafetyMask(i),
+                oSafetyTask         => open);
+
+        --current frame matches to the current or last safety task of this context
+        oSafetyFrame(i) <= '1' when ((headerData xor nextSafetyFrame(i)) and nextSafetyMask(i))
+                                    =(headerData'range=>'0')
+                                and compFinished = '1' and iFrameBypass = '0'           --when comparison has finished ...
+                                and nextSafetyMask(i)/=(nextSafetyMask(i)'range=>'0')   --... and frame mask is valid
+                                else '0';
+
+    end generate;
+
+
+    oError_taskConf <= '1' when error_taskConf /= (error_taskConf'range => '0') or error_contextOv = '1'
+                        else '0';
 
 
 end two_seg_arch;
\ No newline at end of file
@@ -67,7 +67,12 @@ entity Packet_Memory is
         iSafetyFrame            : in std_logic;                                         --! current frame matches to the current or last safety task
         iTaskSafety             : in std_logic_vector(cByteLength-1 downto 0);          --! current safety task
         iResetPaketBuff         : in std_logic;                                         --! Resets the packet FIFO and removes the packet lag
+        iRegionInit             : in std_logic;                                         --! Memory region has changed, restart with slot zero
+        iRegionSize             : in std_logic_vector(gPacketAddrWidth downto 0);       --! Size of the memory region in Byte
+        iPacketSize             : in std_logic_vector(cByteLength-1 downto 0);          --! Size of the safety packet
+        oPacketLag              : out std_logic;                                        --! Packets are delayed
         oNumDelPackets          : out std_logic_vector(gAddrMemoryWidth-1 downto 0);    --! Number of delayed packets
+        oPacketOccupancy        : out std_logic_vector(gAddrMemoryWidth downto 0);      --! Number of used packet slots
         oError_packetBuffOv     : out std_logic;                                        --! Error: Overflow packet-buffer
 
         iClonePacketEx          : in std_logic;                                 --! exchange current packet with clone
@@ -77,7 +82,11 @@ entity Packet_Memory is
         iWrEn                   : in std_logic;                                 --! Write data enable
         iRdEn                   : in std_logic;                                 --! Read data enable
         iData                   : in std_logic_vector(cByteLength-1 downto 0);  --! Data stream from packet
-        oData                   : out std_logic_vector(cByteLength-1 downto 0)  --! New data stream
+        oData                   : out std_logic_vector(cByteLength-1 downto 0); --! New data stream
+
+        oMemWrAddr              : out std_logic_vector(gPacketAddrWidth-1 downto 0);    --! Write address within the memory region
+        oMemRdAddr              : out std_logic_vector(gPacketAddrWidth-1 downto 0);    --! Read address within the memory region
+        iMemRdData              : in std_logic_vector(cByteLength-1 downto 0)           --! Read data of the packet memory
         );
 end Packet_Memory;
 
@@ -87,6 +96,9 @@ end Packet_Memory;
 --! - Stores safety packets
 --! - Output of safety packets in correct or reverse order
 --! - Delete packets at Loss or Delay task
+--! - Packets are stored in fixed-size slots of a free list
+--! - The packet RAM is shared with the other handlers. The addresses are relative
+--!   to the memory region of this packet with the size of iRegionSize
 --! - Error output at overflow of the packet buffer
 architecture two_seg_arch of Packet_Memory is
 
@@ -97,6 +109,8 @@ architecture two_seg_arch of Packet_Memory is
         safetyFrame_posEdge_reg : std_logic;                                        --!delayed edge
         packetLag               : std_logic;                                        --!packets are delayed
         wrStart                 : std_logic_vector(gPacketAddrWidth-1 downto 0);    --!Start address for storing data into the memory
+        packetSize              : std_logic_vector(cByteLength-1 downto 0);         --!Packet size of the current slots
+        headCnt                 : unsigned(1 downto 0);                             --!Number of read FIFO entries after reset, up to two
     end record;
 
     constant cRegInit   : tReg :=(
@@ -104,7 +118,9 @@ architecture two_seg_arch of Packet_Memory is
                                 safetyFrame             => '0',
                                 safetyFrame_posEdge_reg => '0',
                                 packetLag               => '0',
-                                wrStart                 => (gPacketAddrWidth-1 downto 0 => '0')
+                                wrStart                 => (gPacketAddrWidth-1 downto 0 => '0'),
+                                packetSize              => (cByteLength-1 downto 0 => '0'),
+                                headCnt                 => (1 downto 0 => '0')
                                 );
 
     signal reg      : tReg; --! Registers
@@ -116,6 +132,8 @@ architecture two_seg_arch of Packet_Memory is
 
     signal enLagCnt             : std_logic;    --!Count up one more packet, which will be delayed
 
+    signal resetBuff            : std_logic;    --!Resets the packet FIFO and the slots
+
 
     --Packet Memory FIFO
     signal dataMemory       : std_logic_vector(cByteLength-1 downto 0);         --! Data from Memory
@@ -128,8 +146,17 @@ architecture two_seg_arch of Packet_Memory is
     signal rdAddrEn         : std_logic;    --! Load start address of next packet to put out
     signal wrAddrEn         : std_logic;    --! Store current start address of stored packet
 
+    signal headAddrData     : std_logic_vector(gPacketAddrWidth-1 downto 0);    --! Start address at the head of the FIFO
+    signal headValid        : std_logic;                                        --! Head of the FIFO is a stored address
+
+    --Slot allocation
+    signal slotAddr         : std_logic_vector(gPacketAddrWidth-1 downto 0);    --! Start address of the next free slot
+    signal allocEn          : std_logic;                                        --! Take a slot for the next packet
+    signal freeEn           : std_logic;                                        --! Release the slot of the left FIFO entry
+    signal freeAddr         : std_logic_vector(gPacketAddrWidth-1 downto 0);    --! Start address of the released slot
+
     signal errorAddrBuff    : std_logic;    --! Overlapping addresses, could happen at to big incorrect sequence task
-    signal packetBuffOv     : std_logic;    --! Packet buffer overflow
+    signal errorNoSlot      : std_logic;    --! No free slot for the next packet
     signal addrBuffOv       : std_logic;    --! Address memory overflow
 
 begin
@@ -168,6 +195,20 @@ begin
 
 
 
+    -- Buffer reset -------------------------------------------------------------------------
+
+    --!Reset at operation, at a new memory region or at a new packet size, while no packets are delayed
+    resetBuff   <= '1' when iResetPaketBuff = '1' or iRegionInit = '1' or
+                            (iPacketSize /= reg.packetSize and reg.packetLag = '0')
+                        else '0';
+
+    --!Slots keep their size until the next reset
+    reg_next.packetSize <= iPacketSize when resetBuff = '1' else reg.packetSize;
+
+    -----------------------------------------------------------------------------------------
+
+
+
     -- Address counter ----------------------------------------------------------------------
 
     --! @brief Counter for memory
@@ -193,21 +234,10 @@ begin
 
     -- Memory for packets -------------------------------------------------------------------
 
-    --! @brief Packet memory
-    --! - RAM with the packet data
-    PacketRAM : entity work.FiFo_File
-    generic map(
-                gAddrWidth  => gPacketAddrWidth,
-                gDataWidth  => cByteLength
-                )
-    port map(
-            iClk    => iClk,
-            iWrEn   => iWrEn,
-            iWrAddr => wrAddr,
-            iWrData => iData,
-            iRdAddr => rdAddr,
-            oRdData => dataMemory
-            );
+    --! Packet memory is accessed with the addresses of the memory region
+    oMemWrAddr  <= wrAddr;
+    oMemRdAddr  <= rdAddr;
+    dataMemory  <= iMemRdData;
 
 
     --! @brief Data output
@@ -250,13 +280,14 @@ begin
     --! - Disable reading of new packet at Repetition and Packet-Delay task
     combAddr :
     process(iClonePacketEx, iZeroPacketEx, reg, wrEn_negEdge, safetyFrame_posEdge,
-            wrAddr, iTaskSafety, rdMemStartAddr, wrStartAddr)
+            slotAddr, iTaskSafety, rdMemStartAddr, wrStartAddr, resetBuff)
     begin
 
         wrStartAddr     <= (others => '0');
 
         rdAddrEn        <= '0';
         wrAddrEn        <= '0';
+        allocEn         <= '0';
 
         enLagCnt        <= '0';
 
@@ -271,11 +302,12 @@ begin
             wrStartAddr     <= reg.wrStart;
             rdAddrEn        <= reg.safetyFrame_posEdge_reg; --delayed edge, that it can be disabled with iClonePacketEx and iZeroPacketEx
             wrAddrEn        <= wrEn_negEdge;
+            allocEn         <= wrEn_negEdge;
 
 
-            --Store current write adress, at the end of the access
+            --Take a new slot for the next packet, at the end of the access
             if WrEn_negEdge     = '1' then
-                reg_next.wrStart    <= wrAddr;
+                reg_next.wrStart    <= slotAddr;
 
             end if;
 
@@ -290,12 +322,25 @@ begin
 
             rdStartAddr <= rdMemStartAddr;
 
+            --first entry after reset is slot zero
+            if reg.headCnt = 1 then
+                rdStartAddr <= (others => '0');
+
+            end if;
+
         else
             --use same address during other manipulations
             rdStartAddr <= wrStartAddr;
 
         end if;
 
+
+        --start again with slot zero
+        if resetBuff = '1' then
+            reg_next.wrStart    <= (others => '0');
+
+        end if;
+
     end process;
 
 
@@ -313,13 +358,73 @@ begin
     port map(
             iClk            => iClk,
             iReset          => iReset,
-            iResetPaketBuff => iResetPaketBuff,
+            iResetPaketBuff => resetBuff,
             iTwistPacketEx  => iTwistPacketEx,
             oErrorAddrBuff  => errorAddrBuff,
             iWrAddrEn       => wrAddrEn,
             iRdAddrEn       => rdAddrEn,
-            iAddrData       => wrAddr,
-            oAddrData       => rdMemStartAddr
+            iAddrData       => slotAddr,
+            oAddrData       => rdMemStartAddr,
+            oHeadAddrData   => headAddrData,
+            oHeadValid      => headValid
+            );
+
+
+    -----------------------------------------------------------------------------------------
+
+
+
+    -- Slot allocation ----------------------------------------------------------------------
+
+    --! @brief Counter of the read FIFO entries after reset
+    --! - First entry is invalid, second entry is slot zero
+    combHeadCnt :
+    process(reg, rdAddrEn, resetBuff)
+    begin
+        reg_next.headCnt    <= reg.headCnt;
+
+        if rdAddrEn = '1' and reg.headCnt /= 2 then
+            reg_next.headCnt    <= reg.headCnt + 1;
+
+        end if;
+
+
+        if resetBuff = '1' then
+            reg_next.headCnt    <= (others => '0');
+
+        end if;
+
+    end process;
+
+
+    --!Release the slot of the FIFO entry, which is left with the next read
+    freeEn      <= '1' when rdAddrEn = '1' and headValid = '1' and reg.headCnt /= 0 else '0';
+
+    freeAddr    <= (others => '0') when reg.headCnt = 1 else headAddrData;
+
+
+    --! @brief Slot allocator
+    --! - Fixed-size slots with the size of the safety packet
+    --! - Slot for the next packet is taken at the end of the current one
+    --! - Slot is released, when its start address leaves the FIFO
+    --! - Occupancy output and error, when no slot is left
+    SlotAlloc : entity work.Packet_SlotAllocator
+    generic map(
+                gPacketAddrWidth    => gPacketAddrWidth,
+                gAddrMemoryWidth    => gAddrMemoryWidth
+                )
+    port map(
+            iClk            => iClk,
+            iReset          => iReset,
+            iInit           => resetBuff,
+            iSlotSize       => iPacketSize,
+            iLimit          => iRegionSize,
+            iAlloc          => allocEn,
+            oSlotAddr       => slotAddr,
+            iFree           => freeEn,
+            iFreeAddr       => freeAddr,
+            oOccupancy      => oPacketOccupancy,
+            oError_noSlot   => errorNoSlot
             );
 
 
@@ -333,7 +438,7 @@ begin
     --! - Set at occured delay of packets
     --! - Reset at memory reset
     combPacketLag :
-    process(reg, EnLagCnt, iResetPaketBuff)
+    process(reg, EnLagCnt, resetBuff)
     begin
         reg_next.packetLag      <= reg.packetLag;
 
@@ -343,13 +448,15 @@ begin
         end if;
 
 
-        if iResetPaketBuff = '1' then
+        if resetBuff = '1' then
             reg_next.packetLag <= '0';
 
         end if;
 
     end process;
 
+    oPacketLag  <= reg.packetLag;
+
 
 
     --! @brief Counter for the Number of delayed packets
@@ -364,7 +471,7 @@ begin
     port map(
             iClk    => iClk,
             iReset  => iReset,
-            iClear  => iResetPaketBuff,
+            iClear  => resetBuff,
             iEn     => enLagCnt,
             oQ      => oNumDelPackets,
             oOv     => addrBuffOv   --Maximal number of delayed packets is also the number of stored addresses => Overflow is the same
@@ -377,11 +484,7 @@ begin
 
     -- Error Output -------------------------------------------------------------------------
 
-    --!error, when the write address outruns the read address and the lag began
-    packetBuffOv    <= '1' when unsigned(rdAddr)=unsigned(wrAddr)+1 and
-                                reg.packetLag='1' else '0';
-
     --! Error at packet buffer and address buffer overflow
-    oError_packetBuffOv   <= '1' when packetBuffOv='1' or addrBuffOv='1' or errorAddrBuff='1' else '0';
+    oError_packetBuffOv   <= '1' when errorNoSlot='1' or addrBuffOv='1' or errorAddrBuff='1' else '0';
 
 end two_seg_arch;
@@ -0,0 +1,283 @@
+-------------------------------------------------------------------------------
+--! @file Packet_SlotAllocator.vhd
+--! @brief Slot allocator of the packet memory
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+--! Use work library
+library work;
+
+--! Common library
+library libcommon;
+--! Use common library global package
+use libcommon.global.all;
+
+
+
+--! This is the entity of the slot allocator of the packet memory
+entity Packet_SlotAllocator is
+    generic(
+            gPacketAddrWidth    : natural := 14;    --!enough for 500 Packets with the size of 28 Bytes
+            gAddrMemoryWidth    : natural := 9      --!Width of the free list, limits the number of slots
+            );
+    port(
+        iClk            : in std_logic;                                         --! clk
+        iReset          : in std_logic;                                         --! reset
+        iInit           : in std_logic;                                         --! Rebuild the free list with the current slot size
+        iSlotSize       : in std_logic_vector(cByteLength-1 downto 0);          --! Size of the stored packets
+        iLimit          : in std_logic_vector(gPacketAddrWidth downto 0);       --! Size of the usable memory region in Byte
+        iAlloc          : in std_logic;                                         --! Take the next free slot
+        oSlotAddr       : out std_logic_vector(gPacketAddrWidth-1 downto 0);    --! Start address of the next free slot
+        iFree           : in std_logic;                                         --! Return a slot to the free list
+        iFreeAddr       : in std_logic_vector(gPacketAddrWidth-1 downto 0);     --! Start address of the returned slot
+        oOccupancy      : out std_logic_vector(gAddrMemoryWidth downto 0);      --! Number of used slots
+        oError_noSlot   : out std_logic                                         --! Error: Slot requested while all slots are used
+        );
+end Packet_SlotAllocator;
+
+
+--! @brief Packet_SlotAllocator architecture
+--! @details Free list with fixed-size slots of the packet memory
+--! - Slot size is the size of the safety packet plus one guard byte
+--! - Slots are created within the first iLimit Bytes of the packet memory
+--! - Slot zero is handed out at init as the first write slot
+--! - Free list stays empty after reset and is built up with one slot per clock cycle after init
+--! - Allocation and release of a slot within one clock cycle, also in consecutive clock cycles
+--! - Released slots are reused last
+architecture two_seg_arch of Packet_SlotAllocator is
+
+    --! Number of entries of the free list
+    constant cListSize  : natural := 2**gAddrMemoryWidth;
+
+    --! Typedef for registers
+    type tReg is record
+        filling     : std_logic;                                --!Free list is built up
+        stride      : unsigned(cByteLength downto 0);           --!Size of one slot
+        fillAddr    : unsigned(gPacketAddrWidth downto 0);      --!Start address of the last created slot
+        wrPtr       : unsigned(gAddrMemoryWidth-1 downto 0);    --!Write pointer of the free list
+        rdPtr       : unsigned(gAddrMemoryWidth-1 downto 0);    --!Read pointer of the free list
+        freeCnt     : unsigned(gAddrMemoryWidth downto 0);      --!Number of free slots
+        usedCnt     : unsigned(gAddrMemoryWidth downto 0);      --!Number of used slots
+    end record;
+
+    --! Init for registers
+    constant cRegInit   : tReg :=(
+                                filling     => '0',
+                                stride      => to_unsigned(1, cByteLength+1),
+                                fillAddr    => (others => '0'),
+                                wrPtr       => (others => '0'),
+                                rdPtr       => (others => '0'),
+                                freeCnt     => (others => '0'),
+                                usedCnt     => to_unsigned(1, gAddrMemoryWidth+1)
+                                );
+
+    signal reg          : tReg; --! Registers
+    signal reg_next     : tReg; --! Next value of registers
+
+    signal nextSlot     : unsigned(gPacketAddrWidth downto 0);  --! Start address of the next created slot
+    signal slotLeft     : std_logic;                            --! Next slot fits into the packet memory and the free list
+
+    signal pushEn       : std_logic;                                        --! Write to the free list
+    signal pushData     : std_logic_vector(gPacketAddrWidth-1 downto 0);    --! Slot address, written to the free list
+    signal popEn        : std_logic;                                        --! Read from the free list
+
+    signal listWrAddr   : std_logic_vector(gAddrMemoryWidth-1 downto 0);    --! Write address of the free list
+    signal listRdAddr   : std_logic_vector(gAddrMemoryWidth-1 downto 0);    --! Read address of the free list
+
+begin
+
+
+    --! @brief Registers
+    --! - Storing with asynchronous reset
+    registers :
+    process(iClk, iReset)
+    begin
+        if iReset='1' then
+            reg <= cRegInit;
+
+        elsif rising_edge(iClk) then
+            reg <= reg_next;
+
+        end if;
+    end process;
+
+
+
+    -- Slot creation ------------------------------------------------------------------------
+
+    --!Next slot follows the last created one
+    nextSlot    <= reg.fillAddr + resize(reg.stride, nextSlot'length);
+
+    --!Slot has to fit completely into the memory region and the free list mustn't be full
+    slotLeft    <= '1' when resize(nextSlot, gPacketAddrWidth+2) + reg.stride <= unsigned(iLimit) and
+                            reg.freeCnt + reg.usedCnt < cListSize
+                        else '0';
+
+    -----------------------------------------------------------------------------------------
+
+
+
+    -- Free list control --------------------------------------------------------------------
+
+    --! @brief Write access of the free list
+    --! - Released slots have priority
+    --! - Build up the list with new slots otherwise
+    combPush :
+    process(reg, iFree, iFreeAddr, nextSlot, slotLeft)
+    begin
+        pushEn      <= '0';
+        pushData    <= iFreeAddr;
+
+        if iFree = '1' then
+            pushEn      <= '1';
+
+        elsif reg.filling = '1' and slotLeft = '1' then
+            pushEn      <= '1';
+            pushData    <= std_logic_vector(nextSlot(pushData'range));
+
+        end if;
+    end process;
+
+
+    --!Take slot only, when one is available
+    popEn           <= '1' when iAlloc = '1' and reg.freeCnt /= 0 else '0';
+
+    --!Error, when all slots are in use
+    oError_noSlot   <= '1' when iAlloc = '1' and reg.freeCnt = 0 else '0';
+
+
+    --! @brief Next value logic of the free list
+    --! - Pointers and counters of free and used slots
+    --! - Stop building up the list, when no slot is left
+    --! - Restart with the new slot size at init
+    combReg :
+    process(reg, iInit, iSlotSize, iFree, pushEn, popEn, nextSlot, slotLeft)
+    begin
+        reg_next    <= reg;
+
+        if pushEn = '1' then
+            reg_next.wrPtr  <= reg.wrPtr + 1;
+
+        end if;
+
+
+        if popEn = '1' then
+            reg_next.rdPtr  <= reg.rdPtr + 1;
+
+        end if;
+
+
+        --free slots
+        if pushEn = '1' and popEn = '0' then
+            reg_next.freeCnt    <= reg.freeCnt + 1;
+
+        elsif pushEn = '0' and popEn = '1' then
+            reg_next.freeCnt    <= reg.freeCnt - 1;
+
+        end if;
+
+
+        --used slots
+        if popEn = '1' and iFree = '0' then
+            reg_next.usedCnt    <= reg.usedCnt + 1;
+
+        elsif popEn = '0' and iFree = '1' then
+            reg_next.usedCnt    <= reg.usedCnt - 1;
+
+        end if;
+
+
+        --build up the list, while no slot is released
+        if reg.filling = '1' and iFree = '0' then
+            if slotLeft = '1' then
+                reg_next.fillAddr   <= nextSlot;
+
+            else
+                reg_next.filling    <= '0';
+
+            end if;
+        end if;
+
+
+        --restart with slot zero in use
+        if iInit = '1' then
+            reg_next            <= cRegInit;
+            reg_next.filling    <= '1';
+            reg_next.stride     <= resize(unsigned(iSlotSize), reg.stride'length) + 1;
+
+        end if;
+
+    end process;
+
+    -----------------------------------------------------------------------------------------
+
+
+
+    -- Memory block -------------------------------------------------------------------------
+
+    listWrAddr  <= std_logic_vector(reg.wrPtr);
+
+    --!Read address is registered by the memory, so the head is prefetched with the next read pointer
+    listRdAddr  <= std_logic_vector(reg_next.rdPtr);
+
+
+    --! @brief Free list
+    --! - Start addresses of the free slots
+    --! - Head is the next slot to hand out, valid in the clock cycle after a pop
+    FreeList : entity work.FiFo_File
+    generic map(
+                gAddrWidth  => gAddrMemoryWidth,
+                gDataWidth  => gPacketAddrWidth
+                )
+    port map(
+            iClk    => iClk,
+            iWrEn   => pushEn,
+            iWrAddr => listWrAddr,
+            iWrData => pushData,
+            iRdAddr => listRdAddr,
+            oRdData => oSlotAddr
+            );
+
+
+    oOccupancy  <= std_logic_vector(reg.usedCnt);
+
+end two_seg_arch;
@@ -68,7 +68,9 @@ entity Packet_StartAddrMem is
         iWrAddrEn           : in std_logic;                                     --! Write current address
         iRdAddrEn           : in std_logic;                                     --! read current address
         iAddrData           : in std_logic_vector(gPacketAddrWidth-1 downto 0); --! Address in
-        oAddrData           : out std_logic_vector(gPacketAddrWidth-1 downto 0) --! Address out
+        oAddrData           : out std_logic_vector(gPacketAddrWidth-1 downto 0); --! Address out
+        oHeadAddrData       : out std_logic_vector(gPacketAddrWidth-1 downto 0); --! Address at the head of the FIFO, also during the LIFO output
+        oHeadValid          : out std_logic                                      --! Head of the FIFO holds a stored address
         );
 end Packet_StartAddrMem;
 
@@ -78,6 +80,7 @@ end Packet_StartAddrMem;
 --! - Address output like a FiFo
 --! - Temporary LiFo output at Incorrect-Sequence
 --! - Error output at overlapping packets
+--! - Head output for releasing the slots of the packet memory
 architecture two_seg_arch of Packet_StartAddrMem is
 
     --Last write address
@@ -202,6 +205,9 @@ begin
     oErrorAddrBuff  <= '1' when rdAddrBack      = fifoWrAddr and
                                 iTwistPacketEx  = '1'       else '0';
 
+    --!Head is valid, until the read address reaches the write address
+    oHeadValid      <= '1' when rdAddr /= fifoWrAddr else '0';
+
     -----------------------------------------------------------------------------------------
 
 
@@ -226,4 +232,22 @@ begin
             );
 
 
+    --! @brief Copy of the memory for packet start address
+    --! - Always read at the head of the FiFo
+    --! - Returns the slot, which is left at the next read
+    HeadAddressMem : entity work.FiFo_File
+    generic map(
+                gAddrWidth  => gAddrMemoryWidth,
+                gDataWidth  => gPacketAddrWidth
+                )
+    port map(
+            iClk    => iClk,
+            iWrEn   => iWrAddrEn,
+            iWrAddr => fifoWrAddr,
+            iWrData => iAddrData,
+            iRdAddr => rdAddr,
+            oRdData => oHeadAddrData
+            );
+
+
 end two_seg_arch;
@@ -0,0 +1,264 @@
+-------------------------------------------------------------------------------
+--! @file Phy_Fault.vhd
+--! @brief Injects faults of the PHY level into the stream of the new frame
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+--! Use work library
+library work;
+--! use fm library
+use work.framemanipulatorPkg.all;
+
+--! Common library
+library libcommon;
+--! Use common library global package
+use libcommon.global.all;
+
+
+--! This is the entity of the module, which injects faults of the PHY level into the new frame
+entity Phy_Fault is
+    generic(
+            gSettingWidth   : natural:=6*cByteLength    --! Width of the PHY setting
+            );
+    port(
+        iClk                : in std_logic;     --! clk
+        iReset              : in std_logic;     --! reset
+        --control signals
+        iStartNewFrame      : in std_logic;                                     --! data for a new frame is available
+        iNextFrame          : in std_logic;                                     --! frame-creator is ready for new data
+        iPhySetting         : in std_logic_vector(gSettingWidth-1 downto 0);    --! setting of the PHY task of the new frame
+        --frame stream
+        iTxData             : in std_logic_vector(1 downto 0);  --! stream of the new frame
+        iTxDV               : in std_logic;                     --! data valid of the new frame
+        oTxData             : out std_logic_vector(1 downto 0); --! stream with PHY faults
+        oTxDV               : out std_logic;                    --! data valid with PHY faults
+        oTxEr               : out std_logic                     --! TX error of the PHY
+     );
+end Phy_Fault;
+
+
+--! @brief Phy_Fault architecture
+--! @details Injects faults of the PHY level into the stream of the Frame_Creator
+--! - The setting is stored with the start of each frame. Frames without PHY task receive
+--!   a setting of zero and pass unchanged.
+--! - The dibits of the frame are counted from the first dibit of the preamble. The
+--!   position of the setting is counted in dibits from the destination MAC.
+--! - A shortened preamble drops the first Bytes of the preamble by keeping the data valid
+--!   low. The SFD is replaced by the Byte of the setting.
+--! - An aborted frame stops at the position without CRC. The TX error is set for the four
+--!   dibits of the Byte at the position.
+--! - Dribble dibits are appended behind the CRC within the IPG of the next frame.
+architecture two_seg_arch of Phy_Fault is
+
+    --constants
+    constant cCntWidth      : natural:=2*cByteLength+1;             --! Width of the dibit counter
+    constant cPreambleBytes : natural:=7;                           --! Bytes of the preamble without SFD
+    constant cSfdStart      : natural:=4*cPreambleBytes;            --! First dibit of the SFD
+    constant cFrameStart    : natural:=cCreateTime.preamble+1;      --! First dibit of the destination MAC
+    constant cDribbleData   : std_logic_vector(1 downto 0):="01";   --! Data of the dribble dibits
+
+    --! Typedef for registers
+    type tReg is record
+        setting     : std_logic_vector(gSettingWidth-1 downto 0);   --! Setting of the current frame
+        txDv        : std_logic;                                    --! Register for edge detection of iTxDV
+        cnt         : unsigned(cCntWidth-1 downto 0);               --! Dibit of the current frame
+        dribble     : unsigned(cByteLength-1 downto 0);             --! Remaining dribble dibits
+    end record;
+
+    --! Init for registers
+    constant cRegInit   : tReg :=(
+                                setting     => (others=>'0'),
+                                txDv        => '0',
+                                cnt         => (others=>'0'),
+                                dribble     => (others=>'0')
+                                );
+
+    signal reg          : tReg; --! Registers
+    signal reg_next     : tReg; --! Next value of registers
+
+    signal preambleStart    : unsigned(cCntWidth-1 downto 0);   --! First sent dibit of the preamble
+    signal faultPos         : unsigned(cCntWidth-1 downto 0);   --! Dibit of the abort and the TX error
+    signal preambleSkip     : std_logic;                        --! Dibit of the preamble is dropped
+    signal sfdActive        : std_logic;                        --! Dibit of the SFD is replaced
+    signal sfdData          : std_logic_vector(1 downto 0);     --! Dibit of the SFD of the setting
+    signal abortActive      : std_logic;                        --! Frame is aborted
+    signal txErrActive      : std_logic;                        --! TX error is set
+    signal dribbleStart     : std_logic;                        --! End of the frame with dribble dibits
+    signal dribbleActive    : std_logic;                        --! Dribble dibit is sent
+
+
+    --! Fault flags of cPhyFault in the setting
+    alias setting_flags     : std_logic_vector(cByteLength-1 downto 0)
+                                is reg.setting(gSettingWidth-1 downto gSettingWidth-cByteLength);
+
+    --! Bytes of the shortened preamble in the setting
+    alias setting_preamble  : std_logic_vector(cByteLength-1 downto 0)
+                                is reg.setting(gSettingWidth-cByteLength-1 downto gSettingWidth-2*cByteLength);
+
+    --! SFD in the setting
+    alias setting_sfd       : std_logic_vector(cByteLength-1 downto 0)
+                                is reg.setting(3*cByteLength-1 downto 2*cByteLength);
+
+    --! Number of dribble dibits in the setting
+    alias setting_dribble   : std_logic_vector(cByteLength-1 downto 0)
+                                is reg.setting(2*cByteLength-1 downto cByteLength);
+
+    --! Position of the abort and the TX error in the setting
+    alias setting_pos       : std_logic_vector(2*cByteLength-1 downto 0)
+                                is reg.setting(2*cByteLength-1 downto 0);
+
+begin
+
+    --! @brief Registers
+    --! - Storing with asynchronous reset
+    registers :
+    process(iClk, iReset)
+    begin
+        if iReset='1' then
+            reg <= cRegInit;
+
+        elsif rising_edge(iClk) then
+            reg <= reg_next;
+
+        end if;
+    end process;
+
+
+    --preamble of up to seven Bytes in front of the SFD
+    preambleStart   <= (others=>'0') when unsigned(setting_preamble)>=cPreambleBytes else
+                        resize((cPreambleBytes-unsigned(setting_preamble)) & "00", cCntWidth);
+
+    faultPos        <= resize(unsigned(setting_pos), cCntWidth)+cFrameStart;
+
+    preambleSkip    <= '1' when setting_flags(cPhyFault.preamble)='1' and reg.cnt<preambleStart else '0';
+
+    sfdActive       <= '1' when setting_flags(cPhyFault.sfd)='1' and reg.cnt>=cSfdStart
+                            and reg.cnt<cFrameStart else '0';
+
+    abortActive     <= '1' when setting_flags(cPhyFault.abort)='1' and reg.cnt>=faultPos else '0';
+
+    txErrActive     <= '1' when setting_flags(cPhyFault.txErr)='1' and reg.cnt>=faultPos
+                            and reg.cnt<faultPos+4 else '0';
+
+    --dribble dibits behind the CRC of a frame, which wasn't aborted
+    dribbleStart    <= '1' when reg.txDv='1' and iTxDV='0' and setting_flags(cPhyFault.dribble)='1'
+                            and abortActive='0' and unsigned(setting_dribble)/=0 else '0';
+
+    dribbleActive   <= '1' when iTxDV='0' and (dribbleStart='1' or reg.dribble/=0) else '0';
+
+
+    --! @brief Dibit of the SFD
+    --! - the LSB of the SFD is sent first
+    sfdMux :
+    process(reg)
+    begin
+        case reg.cnt(1 downto 0) is
+            when "00"   => sfdData  <= setting_sfd(1 downto 0);
+            when "01"   => sfdData  <= setting_sfd(3 downto 2);
+            when "10"   => sfdData  <= setting_sfd(5 downto 4);
+            when others => sfdData  <= setting_sfd(7 downto 6);
+        end case;
+    end process;
+
+
+    --! @brief Next register value logic
+    --! - Storing of the setting with the start of the frame
+    --! - Counting of the dibits and the dribble dibits
+    combNext :
+    process(reg, iStartNewFrame, iNextFrame, iPhySetting, iTxDV, dribbleStart, setting_dribble)
+    begin
+        reg_next    <= reg;
+
+        reg_next.txDv   <= iTxDV;
+
+        if iStartNewFrame='1' and iNextFrame='1' then
+            reg_next.setting    <= iPhySetting;
+        end if;
+
+        if iTxDV='1' then
+            reg_next.cnt    <= reg.cnt+1;
+        else
+            reg_next.cnt    <= (others=>'0');
+        end if;
+
+        if iTxDV='1' then
+            reg_next.dribble    <= (others=>'0');   --next frame has priority
+
+        elsif dribbleStart='1' then
+            reg_next.dribble    <= unsigned(setting_dribble)-1;
+
+        elsif reg.dribble/=0 then
+            reg_next.dribble    <= reg.dribble-1;
+
+        end if;
+    end process;
+
+
+    --! @brief Output stream
+    combOut :
+    process(iTxData, iTxDV, preambleSkip, abortActive, sfdActive, sfdData, txErrActive, dribbleActive)
+    begin
+        oTxData <= iTxData;
+        oTxDV   <= iTxDV;
+        oTxEr   <= '0';
+
+        if iTxDV='1' then
+            if preambleSkip='1' or abortActive='1' then
+                oTxData <= (others=>'0');
+                oTxDV   <= '0';
+
+            elsif sfdActive='1' then
+                oTxData <= sfdData;
+
+            end if;
+
+            oTxEr   <= txErrActive and not abortActive;
+
+        elsif dribbleActive='1' then
+            oTxData <= cDribbleData;
+            oTxDV   <= '1';
+
+        end if;
+    end process;
+
+
+end two_seg_arch;
@@ -131,7 +131,10 @@ begin
                 end if;
 
             when sWaitNewFrameData=>
-                if iDataReady='1' then          --if new data is ready
+                if iNextFrame='0' then          --if Frame-Creator is used by injected frames
+                    state_next  <= sIdle;          --wait for the next ready-signal
+
+                elsif iDataReady='1' then       --if new data is ready
                     state_next  <= sStartFrame;    --start a new frame
 
                 else
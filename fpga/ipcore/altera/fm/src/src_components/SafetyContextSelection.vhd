@@ -0,0 +1,197 @@
+-------------------------------------------------------------------------------
+--! @file SafetyContextSelection.vhd
+--! @brief Assignment of safety tasks to the safety contexts
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+--! Use work library
+library work;
+--! use fm library
+use work.framemanipulatorPkg.all;
+
+--! Common library
+library libcommon;
+--! Use common library global package
+use libcommon.global.all;
+
+
+--! This is the entity of the module for assigning safety tasks to the safety contexts
+entity SafetyContextSelection is
+    generic(
+            gWordWidth      : natural :=8*cByteLength;  --!8 Byte data
+            gSafetyContexts : natural :=2               --!Number of safety contexts
+            );
+    port(
+        iClk                : in std_logic;                                     --! clk
+        iReset              : in std_logic;                                     --! reset
+        iClearMem           : in std_logic;                                     --! clear all tasks
+        iTestActive         : in std_logic;                                     --! Testcycle is active
+        iSafetyActive       : in std_logic;                                     --! safety manipulations are active
+        iReadEn             : in std_logic;                                     --! Read active
+        iTaskMem            : in std_logic_vector(cByteLength-1 downto 0);      --! task from memory
+        iFrameMem           : in std_logic_vector(gWordWidth-1 downto 0);       --! Frame of the task
+        iMaskMem            : in std_logic_vector(gWordWidth-1 downto 0);       --! Frame mask of the task
+        oError_taskConf     : out std_logic;                                    --! Error: More frame filters than contexts
+        oContextSel         : out std_logic_vector(gSafetyContexts-1 downto 0)  --! Context of the current task
+     );
+end SafetyContextSelection;
+
+--! @brief SafetyContextSelection architecture
+--! @details Assignment of safety tasks to the safety contexts
+--! - Every context is bound to one frame filter during the reading of the tasks
+--! - Safety tasks with the same frame and mask are assigned to the same context
+--! - A new frame filter occupies the next free context
+architecture two_seg_arch of SafetyContextSelection is
+
+    --! Typedef for the frame filters of the contexts
+    type tFilter is array (gSafetyContexts-1 downto 0) of std_logic_vector(gWordWidth-1 downto 0);
+
+
+    --Registers
+    --! Typedef for registers
+    type tReg is record
+        readEn      : std_logic;                                    --!ReadEn for edge detection
+        filterValid : std_logic_vector(gSafetyContexts-1 downto 0); --!Context is bound to a frame filter
+        filterFrame : tFilter;                                      --!Frame of the context
+        filterMask  : tFilter;                                      --!Frame mask of the context
+    end record;
+
+
+    --! Init for registers
+    constant cRegInit   : tReg :=  (readEn      => '0',
+                                    filterValid => (others=>'0'),
+                                    filterFrame => (others=>(others=>'0')),
+                                    filterMask  => (others=>(others=>'0'))
+                                    );
+
+
+    signal reg          : tReg; --! Register
+    signal reg_next     : tReg; --! Next value of register
+
+    signal contextSel   : std_logic_vector(gSafetyContexts-1 downto 0); --! Context of the current task
+    signal contextOv    : std_logic;                                    --! No context is left for the frame filter
+
+begin
+
+    --! @brief Registers
+    --! - Storing with asynchronous reset
+    registers :
+    process(iClk, iReset, iClearMem)
+    begin
+        if iReset='1' or iClearMem = '1' then
+                reg <=cRegInit;
+
+        elsif rising_edge(iClk) then
+            reg<=reg_next;
+
+        end if;
+    end process;
+
+
+    --! @brief Selection of the context
+    --! - Release of the contexts at positive edge of iReadEn
+    --! - Context with the same frame filter is selected
+    --! - Otherwise the first free context is bound to the frame filter
+    --! - Overflow, when all contexts are bound to other frame filters
+    comb_select :
+    process(reg, iReadEn, iTaskMem, iFrameMem, iMaskMem)
+        variable vFound : boolean;
+        variable vValid : std_logic_vector(gSafetyContexts-1 downto 0);
+    begin
+        reg_next        <= reg;
+        reg_next.readEn <= iReadEn;
+
+        vValid          := reg.filterValid;
+
+        --new assignment of the contexts at rising edge of iReadEn
+        if reg.readEn = '0' and iReadEn = '1' then
+            vValid      := cRegInit.filterValid;
+
+        end if;
+
+        reg_next.filterValid    <= vValid;
+
+        contextSel      <= (others=>'0');
+        contextOv       <= '0';
+
+        if isSafetyTask(iTaskMem) then
+            vFound  := false;
+
+            --context with the same frame filter
+            for i in 0 to gSafetyContexts-1 loop
+                if  not vFound and vValid(i) = '1' and
+                    reg.filterFrame(i) = iFrameMem and reg.filterMask(i) = iMaskMem then
+
+                    contextSel(i)   <= '1';
+                    vFound          := true;
+
+                end if;
+            end loop;
+
+            --first free context
+            for i in 0 to gSafetyContexts-1 loop
+                if not vFound and vValid(i) = '0' then
+                    contextSel(i)               <= '1';
+                    reg_next.filterValid(i)     <= '1';
+                    reg_next.filterFrame(i)     <= iFrameMem;
+                    reg_next.filterMask(i)      <= iMaskMem;
+                    vFound                      := true;
+
+                end if;
+            end loop;
+
+            if not vFound then
+                contextOv   <= '1';
+
+            end if;
+
+        end if;
+
+    end process;
+
+
+    oContextSel     <= contextSel;
+
+    --only error, when configuration is done
+    oError_taskConf <= contextOv when iTestActive = '1' or iSafetyActive = '1' else '0';
+
+
+end two_seg_arch;
@@ -58,7 +58,8 @@ use libcommon.global.all;
 entity SafetyTaskSelection is
     generic(
             gWordWidth      : natural :=8*cByteLength;  --!8 Byte data
-            gSafetySetting  : natural :=5*cByteLength   --!5 Byte safety setting
+            gSafetySetting  : natural :=15*cByteLength; --!15 Byte safety setting
+            gSafetyPackets  : natural :=4               --!Number of safety packets per frame
             );
     port(
         iClk                : in std_logic;                                     --! clk
@@ -149,6 +150,14 @@ architecture two_seg_arch of SafetyTaskSelection is
                                         is iSettingMem(iSettingMem'left-5*cByteLength downto iSettingMem'left-6*cByteLength+1);
 
 
+    --! Typedef for Byte values of the safety packets within one setting
+    type tPacketByte is array (cParam.maxSafetyPackets-1 downto 0) of std_logic_vector(cByteLength-1 downto 0);
+
+    signal packetTask   : tPacketByte;  --!Task of each safety packet
+    signal packetStart  : tPacketByte;  --!Start position of each safety packet
+    signal packetSize   : tPacketByte;  --!Size of each safety packet
+
+
 
 
 begin
@@ -156,10 +165,7 @@ begin
     --CHECKING SAFETY TASK ----------------------------------------------------------------------
 
     --saving task, when task is a safety task
-    safetyTask      <= iTaskMem when iTaskMem=cTask.repetition  or iTaskMem=cTask.paLoss  or
-                                     iTaskMem=cTask.insertion   or iTaskMem=cTask.incSeq  or
-                                     iTaskMem=cTask.incData     or iTaskMem=cTask.paDelay or
-                                     iTaskMem=cTask.masquerade  else (iTaskMem'range => '0');
+    safetyTask      <= iTaskMem when isSafetyTask(iTaskMem) else (iTaskMem'range => '0');
 
     --! @brief Registers
     --! - Storing with asynchronous reset
@@ -277,6 +283,38 @@ begin
 
 
 
+    --SAFETY PACKETS OF THE SETTING -------------------------------------------------------------
+
+    --! @brief Packets of the safety setting
+    --! - Packet 1 with task, start and size of Byte 1-3
+    --! - Further packets with their descriptors of 3 Bytes after Byte 6
+    genPacket :
+    for i in 0 to cParam.maxSafetyPackets-1 generate
+
+        genFirstPacket :
+        if i = 0 generate
+            packetTask(i)   <= iTaskMem;
+            packetStart(i)  <= iSettingMem_PacketStart;
+            packetSize(i)   <= iSetting_PacketSize;
+
+        end generate;
+
+        genFurtherPacket :
+        if i > 0 generate
+            constant cDescrLeft : natural := iSettingMem'left-cSettingSize.safetyPacket-(i-1)*cSettingSize.safetyDescr;
+        begin
+            packetTask(i)   <= iSettingMem(cDescrLeft                 downto cDescrLeft-cByteLength+1);
+            packetStart(i)  <= iSettingMem(cDescrLeft-cByteLength     downto cDescrLeft-2*cByteLength+1);
+            packetSize(i)   <= iSettingMem(cDescrLeft-2*cByteLength   downto cDescrLeft-3*cByteLength+1);
+
+        end generate;
+
+    end generate;
+
+    ---------------------------------------------------------------------------------------------
+
+
+
     --ERROR DETECTION ---------------------------------------------------------------------------
 
 
@@ -287,8 +325,11 @@ begin
     --! - Error, when packet number differs at Incorrect-Sequence
     --! - Error, when packets at Insertion task are overlapping
     --! - Error, when new safety task should start, but current one is still active
+    --! - Error, when a further packet has no safety task or exceeds the number of packets
+    --! - Error, when the packets of one setting are overlapping
     comb_errortask:
-    process(safetyTask, reg, iCycleNr, iCycleMem, iSafetyActive, iTestActive)
+    process(safetyTask, reg, iCycleNr, iCycleMem, iSafetyActive, iTestActive,
+            packetTask, packetStart, packetSize)
     begin
         oError_taskConf    <= '0';
 
@@ -378,6 +419,39 @@ begin
             end if;
         end if;
 
+
+        --check of further packets of a safety task
+        if safetyTask /= (cByteLength-1 downto 0=>'0') then
+
+            for i in 1 to cParam.maxSafetyPackets-1 loop
+                if packetTask(i) /= (cByteLength-1 downto 0=>'0') then
+                    if i >= gSafetyPackets or not isSafetyTask(packetTask(i)) then  --packet can't be handled
+
+                        oError_taskConf    <= '1';         --error
+
+                    end if;
+                end if;
+            end loop;
+
+
+            --packets of the frame are overlapping
+            for i in 0 to cParam.maxSafetyPackets-2 loop
+                for j in i+1 to cParam.maxSafetyPackets-1 loop
+                    if  packetTask(i) /= (cByteLength-1 downto 0=>'0') and
+                        packetTask(j) /= (cByteLength-1 downto 0=>'0') then
+
+                        if  unsigned(packetStart(i)) < ('0' & unsigned(packetStart(j))) + unsigned(packetSize(j)) and
+                            unsigned(packetStart(j)) < ('0' & unsigned(packetStart(i))) + unsigned(packetSize(i)) then
+
+                            oError_taskConf    <= '1';         --error
+
+                        end if;
+                    end if;
+                end loop;
+            end loop;
+
+        end if;
+
         end if;
 
     end process;
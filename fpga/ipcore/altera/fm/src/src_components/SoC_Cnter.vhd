@@ -63,6 +63,8 @@ entity SoC_Cnter is
         iReset      : in std_logic;                                 --! reset
         iTestSync   : in std_logic;                                 --! sync for counter reset
         iFrameSync  : in std_logic;                                 --! sync for new incoming frame
+        iFrameTagged: in std_logic;                                 --! frame has a VLAN tag
+        iFrameBypass: in std_logic;                                 --! frame with unknown EtherType
         iEn         : in std_logic;                                 --! counter enable
         iData       : in std_logic_vector(gCnterWidth-1 downto 0);  --! frame-data
         oFrameIsSoc : out std_logic;                                --! current frame is a SoC
@@ -78,6 +80,10 @@ architecture two_seg_arch of SoC_Cnter is
     signal cntEn                : std_logic;                                --! Counter Enable
     signal collectorFinished    : std_logic;                                --! messageType has received
     signal messageType          : std_logic_vector(cByteLength-1 downto 0); --! value of messageType
+    signal collectorFinishedEth : std_logic;                                --! messageType of an untagged frame has received
+    signal messageTypeEth       : std_logic_vector(cByteLength-1 downto 0); --! messageType of an untagged frame
+    signal collectorFinishedVlan: std_logic;                                --! messageType of a tagged frame has received
+    signal messageTypeVlan      : std_logic_vector(cByteLength-1 downto 0); --! messageType of a tagged frame
 
     --Edge Detection
     signal next_frameFit    : std_logic;    --! Next value for register
@@ -112,13 +118,33 @@ begin
             iReset              => iReset,
             iData               => iData,
             iSync               => iFrameSync,
-            oFrameData          => messageType,
-            ocollectorFinished  => collectorFinished
+            oFrameData          => messageTypeEth,
+            ocollectorFinished  => collectorFinishedEth
             );
 
 
+    --! @brief Collector for POWERLINK SoC behind a VLAN tag
+    messageTypeVlan_Collector : entity work.Frame_collector
+    generic map(
+                gFrom   => cEth.StartmessageType+cEth.sizeVlanTag,
+                gTo     => cEth.StartmessageType+cEth.sizeVlanTag
+                )
+    port map(
+            iClk                => iClk,
+            iReset              => iReset,
+            iData               => iData,
+            iSync               => iFrameSync,
+            oFrameData          => messageTypeVlan,
+            ocollectorFinished  => collectorFinishedVlan
+            );
+
+
+    messageType         <= messageTypeVlan          when iFrameTagged='1' else messageTypeEth;
+    collectorFinished   <= collectorFinishedVlan    when iFrameTagged='1' else collectorFinishedEth;
+
+
     --Frame is SoC, when messageType=SoC and data is valid
-    next_frameFit   <= collectorFinished when messageType = cEth.messageTypeSoC else '0';
+    next_frameFit   <= collectorFinished when messageType = cEth.messageTypeSoC and iFrameBypass='0' else '0';
 
     --Edge Detection for Counter
     cntEn   <= '1' when iEn='1' and next_frameFit='1' and reg_frameFit='0' else '0';
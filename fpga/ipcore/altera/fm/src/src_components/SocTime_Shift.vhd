@@ -0,0 +1,282 @@
+-------------------------------------------------------------------------------
+--! @file SocTime_Shift.vhd
+--! @brief Shifts the NetTime and RelativeTime of the selected SoCs
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+--! Use work library
+library work;
+--! use fm library
+use work.framemanipulatorPkg.all;
+
+--! Common library
+library libcommon;
+--! Use common library global package
+use libcommon.global.all;
+
+
+--! This is the entity of the module, which calculates the shifted time of the SoC time task
+entity SocTime_Shift is
+    generic(
+            gSettingWidth   : natural:=14*cByteLength   --! Width of the setting of the SoC time task
+            );
+    port(
+        iClk                : in std_logic;     --! clk
+        iReset              : in std_logic;     --! reset
+        --control signals
+        iTestSync           : in std_logic;                                         --! Start of the test
+        iTaskSocTimeEn      : in std_logic;                                         --! task: shift the time of the SoC
+        iFrameIsSoc         : in std_logic;                                         --! current frame is a SoC
+        iTimeSetting        : in std_logic_vector(gSettingWidth-1 downto 0);        --! setting of the SoC time task
+        --time of the SoC
+        iSocTime            : in std_logic_vector(2*cEth.sizeSocTime-1 downto 0);   --! NetTime and RelativeTime of the current frame
+        oSocTimeEn          : out std_logic;                                        --! shifted time is ready for the frame buffer
+        oSocTime            : out std_logic_vector(2*cEth.sizeSocTime-1 downto 0)   --! shifted NetTime and RelativeTime
+     );
+end SocTime_Shift;
+
+
+--! @brief SocTime_Shift architecture
+--! @details Calculates the shifted time of the SoCs of the SoC time task
+--! - The shift of the n-th selected SoC is the offset plus n-1 times the drift. With the flag
+--!   walk, the random step is added or subtracted in each selected SoC as well.
+--! - The NetTime is shifted in ns with the carry into the seconds. Its shift is limited to
+--!   one second. The RelativeTime is shifted by the same limited shift in us, truncated toward
+--!   zero, so both times of a SoC keep the same shift.
+--! - The division by 1000 is a multiplication with the reciprocal 2**40/1000, rounded up. It is
+--!   exact for shifts below one second and registered before the shifted time is put out.
+--! - Both times are kept in the order of the frame, the first Byte at the bottom. Times without
+--!   their flag are passed unchanged, so the frame buffer always receives both.
+--! - The drift and the random walk start again with each series of test.
+architecture two_seg_arch of SocTime_Shift is
+
+    --constants
+    constant cShiftWidth    : natural:=6*cByteLength;       --! Width of the accumulated shift
+    constant cValueWidth    : natural:=4*cByteLength;       --! Width of offset, drift and step
+    constant cLfsrWidth     : natural:=4*cByteLength;       --! Width of the LFSR of the random walk
+    constant cNsPerSec      : natural:=1000000000;          --! Nanoseconds of one second
+    constant cMaxNsShift    : natural:=cNsPerSec-1;         --! Limit of the shift of the NetTime
+    constant cUsRecipShift  : natural:=40;                  --! Fraction bits of the reciprocal of 1000
+    constant cUsRecip       : natural:=1099511628;          --! 2**40/1000, rounded up
+
+    --! Typedef for registers
+    type tReg is record
+        taskEn      : std_logic;                                    --! Register for edge detection of iTaskSocTimeEn
+        calc        : std_logic;                                    --! Shift in us is calculated
+        conv        : std_logic;                                    --! Shifted time is calculated
+        dev         : signed(cShiftWidth-1 downto 0);               --! Deviation of drift and random walk
+        shift       : signed(cShiftWidth-1 downto 0);               --! Shift of the current SoC
+        usShift     : signed(cValueWidth downto 0);                 --! Shift of the RelativeTime in us
+        lfsr        : std_logic_vector(cLfsrWidth-1 downto 0);      --! Random number generator of the walk
+        socTimeEn   : std_logic;                                    --! Shifted time is ready
+        socTime     : std_logic_vector(2*cEth.sizeSocTime-1 downto 0);  --! Shifted time
+    end record;
+
+    --! Init for registers
+    constant cRegInit   : tReg :=(
+                                taskEn      => '0',
+                                calc        => '0',
+                                conv        => '0',
+                                dev         => (others=>'0'),
+                                shift       => (others=>'0'),
+                                usShift     => (others=>'0'),
+                                lfsr        => (others=>'1'),
+                                socTimeEn   => '0',
+                                socTime     => (others=>'0')
+                                );
+
+    signal reg          : tReg; --! Registers
+    signal reg_next     : tReg; --! Next value of registers
+
+    signal taskStart    : std_logic;                                    --! Positive edge of the task of a SoC
+    signal step         : signed(cShiftWidth-1 downto 0);               --! Random step of the walk
+    signal nsShift      : signed(cValueWidth downto 0);                 --! Limited shift of the NetTime
+    signal nsSum        : signed(cValueWidth+1 downto 0);               --! Shifted nanoseconds before the carry
+    signal nsShiftAbs   : unsigned(cValueWidth-1 downto 0);             --! Magnitude of the limited shift
+    signal usProduct    : unsigned(2*cValueWidth-1 downto 0);           --! Magnitude multiplied with the reciprocal of 1000
+    signal usShift      : signed(cValueWidth downto 0);                 --! Limited shift in us, truncated toward zero
+    signal newNetTime   : std_logic_vector(cEth.sizeSocTime-1 downto 0);    --! Shifted NetTime
+    signal newRelTime   : std_logic_vector(cEth.sizeSocTime-1 downto 0);    --! Shifted RelativeTime
+
+
+    --! Flags of cTimeShift in the setting
+    alias setting_flags     : std_logic_vector(cByteLength-1 downto 0)
+                                is iTimeSetting(gSettingWidth-1 downto gSettingWidth-cByteLength);
+
+    --! Constant offset in the setting
+    alias setting_offset    : std_logic_vector(cValueWidth-1 downto 0)
+                                is iTimeSetting(gSettingWidth-cByteLength-1 downto gSettingWidth-5*cByteLength);
+
+    --! Drift per selected SoC in the setting
+    alias setting_drift     : std_logic_vector(cValueWidth-1 downto 0)
+                                is iTimeSetting(2*cValueWidth-1 downto cValueWidth);
+
+    --! Step of the random walk in the setting
+    alias setting_step      : std_logic_vector(cValueWidth-1 downto 0)
+                                is iTimeSetting(cValueWidth-1 downto 0);
+
+    --! Seconds of the NetTime, in front of the nanoseconds in the frame
+    alias soc_sec           : std_logic_vector(cValueWidth-1 downto 0)
+                                is iSocTime(cValueWidth-1 downto 0);
+
+    --! Nanoseconds of the NetTime
+    alias soc_ns            : std_logic_vector(cValueWidth-1 downto 0)
+                                is iSocTime(cEth.sizeSocTime-1 downto cValueWidth);
+
+    --! RelativeTime
+    alias soc_rel           : std_logic_vector(cEth.sizeSocTime-1 downto 0)
+                                is iSocTime(2*cEth.sizeSocTime-1 downto cEth.sizeSocTime);
+
+begin
+
+    --! @brief Registers
+    --! - Storing with asynchronous reset
+    registers :
+    process(iClk, iReset)
+    begin
+        if iReset='1' then
+            reg <= cRegInit;
+
+        elsif rising_edge(iClk) then
+            reg <= reg_next;
+
+        end if;
+    end process;
+
+
+    taskStart   <= '1' when iTaskSocTimeEn='1' and reg.taskEn='0' and iFrameIsSoc='1' else '0';
+
+    --step of the walk with a random sign
+    step        <= (others=>'0') when setting_flags(cTimeShift.walk)='0' else
+                    resize(signed('0' & setting_step), cShiftWidth) when reg.lfsr(0)='0' else
+                    -resize(signed('0' & setting_step), cShiftWidth);
+
+
+    --shift of the NetTime within one second
+    nsShift     <= to_signed(cMaxNsShift, nsShift'length) when reg.shift>cMaxNsShift else
+                    to_signed(-cMaxNsShift, nsShift'length) when reg.shift<-cMaxNsShift else
+                    resize(reg.shift, nsShift'length);
+
+    nsSum       <= resize(signed('0' & soc_ns), nsSum'length)+nsShift;
+
+
+    --! @brief NetTime with the carry of the nanoseconds
+    combNetTime :
+    process(nsSum, iSocTime)
+    begin
+        newNetTime  <= std_logic_vector(resize(unsigned(nsSum), cValueWidth)) & std_logic_vector(unsigned(soc_sec));
+
+        if nsSum>=cNsPerSec then
+            newNetTime  <= std_logic_vector(resize(unsigned(nsSum-cNsPerSec), cValueWidth))
+                            & std_logic_vector(unsigned(soc_sec)+1);
+
+        elsif nsSum<0 then
+            newNetTime  <= std_logic_vector(resize(unsigned(nsSum+cNsPerSec), cValueWidth))
+                            & std_logic_vector(unsigned(soc_sec)-1);
+
+        end if;
+    end process;
+
+    --shift of the RelativeTime in us with the sign of the shift in ns
+    nsShiftAbs  <= resize(unsigned(abs(nsShift)), cValueWidth);
+
+    usProduct   <= nsShiftAbs*to_unsigned(cUsRecip, cValueWidth);
+
+    usShift     <= -signed(resize(usProduct(usProduct'left downto cUsRecipShift), usShift'length)) when nsShift<0 else
+                    signed(resize(usProduct(usProduct'left downto cUsRecipShift), usShift'length));
+
+    newRelTime  <= std_logic_vector(unsigned(soc_rel)+unsigned(resize(reg.usShift, cEth.sizeSocTime)));
+
+
+    --! @brief Next register value logic
+    --! - Shift of the SoC with the old deviation, new deviation with drift and step
+    --! - Shift in us one cycle later, calculation of the shifted time another cycle later
+    combNext :
+    process(reg, iTaskSocTimeEn, iTestSync, taskStart, step, iTimeSetting, iSocTime, newNetTime, newRelTime,
+            usShift)
+    begin
+        reg_next    <= reg;
+
+        reg_next.taskEn     <= iTaskSocTimeEn;
+        reg_next.calc       <= taskStart;
+        reg_next.conv       <= reg.calc;
+        reg_next.socTimeEn  <= reg.conv;
+
+        --Galois LFSR with the taps 32, 22, 2 and 1
+        if reg.lfsr(0)='1' then
+            reg_next.lfsr   <= ('0' & reg.lfsr(cLfsrWidth-1 downto 1)) xor X"80200003";
+        else
+            reg_next.lfsr   <= '0' & reg.lfsr(cLfsrWidth-1 downto 1);
+        end if;
+
+        if iTestSync='1' then
+            reg_next.dev    <= (others=>'0');
+
+        elsif taskStart='1' then
+            reg_next.shift  <= resize(signed(setting_offset), cShiftWidth)+reg.dev;
+            reg_next.dev    <= reg.dev+resize(signed(setting_drift), cShiftWidth)+step;
+
+        end if;
+
+        if reg.calc='1' then
+            reg_next.usShift    <= usShift;
+        end if;
+
+        if reg.conv='1' then
+            reg_next.socTime    <= iSocTime;
+
+            if setting_flags(cTimeShift.net)='1' then
+                reg_next.socTime(cEth.sizeSocTime-1 downto 0)   <= newNetTime;
+            end if;
+
+            if setting_flags(cTimeShift.rel)='1' then
+                reg_next.socTime(2*cEth.sizeSocTime-1 downto cEth.sizeSocTime)  <= newRelTime;
+            end if;
+        end if;
+    end process;
+
+
+    oSocTimeEn  <= reg.socTimeEn;
+    oSocTime    <= reg.socTime;
+
+
+end two_seg_arch;
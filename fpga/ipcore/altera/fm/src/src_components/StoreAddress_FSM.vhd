@@ -51,13 +51,15 @@ library work;
 library libcommon;
 --! Use common library global package
 use libcommon.global.all;
-
 --! This is the entity of the FSM for storing the start- and end-position of the frame-data
 entity StoreAddress_FSM is
     generic(
             gAddrDataWidth  : natural:=11;              --! Address width of the frame buffer
             gSize_Time      : natural:=5*cByteLength;   --! Delay in 10ns steps
-            gFiFoBitWidth   : natural:=52               --! Width of Fifo
+            gIpgWidth       : natural:=2*cByteLength;   --! Width of the IPG in Byte
+            gPhyWidth       : natural:=6*cByteLength;   --! Width of the PHY faults
+            gCntWidth       : natural:=cByteLength;     --! Width of the number of copies and overtaking frames
+            gFiFoBitWidth   : natural:=117              --! Width of Fifo
             );
     port(
         iClk                : in std_logic;                                     --! clk
@@ -65,11 +67,18 @@ entity StoreAddress_FSM is
         --control signals
         iStartStorage       : in std_logic;                                     --! start storing positions
         iFrameEnd           : in std_logic;                                     --! end position is valid
+        iFrameIsSoC         : in std_logic;                                     --! current frame is a SoC
         iDataInEndAddr      : in std_logic_vector(gAddrDataWidth-1 downto 0);   --! end position of the current frame
         oDataInStartAddr    : out std_logic_vector(gAddrDataWidth-1 downto 0);  --! new start position of the next frame
         --tasks
         iCRCManEn           : in std_logic;                                     --! task: crc distortion
         iDelayTime          : in std_logic_vector(gSize_Time-1 downto 0);       --! delay timestamp
+        iFrameIpg           : in std_logic_vector(gIpgWidth-1 downto 0);        --! inter packet gap before the frame
+        iPhyFault           : in std_logic_vector(gPhyWidth-1 downto 0);        --! PHY faults of the frame
+        iCopies             : in std_logic_vector(gCntWidth-1 downto 0);        --! task: number of copies of the frame
+        iCopyIpg            : in std_logic_vector(gIpgWidth-1 downto 0);        --! inter packet gap before each copy
+        iReorder            : in std_logic_vector(gCntWidth-1 downto 0);        --! task: number of frames overtaking the frame
+        iShapeEn            : in std_logic;                                     --! frame is limited by the traffic shaper
         --storing data
         oWr                 : out std_logic;                                    --! write Fifo
         oFiFoData           : out std_logic_vector(gFiFoBitWidth-1 downto 0)    --! Fifo data
@@ -79,19 +88,28 @@ end StoreAddress_FSM;
 
 --! @brief StoreAddress_FSM architecture
 --! @details FSM for storing the start- and end-position of the frame-data into the fifo
---! - The delay timestamp is connected to the start-address and the CRC-distortion flag
---!   to the end-address.
+--! - The delay timestamp, the IPG, the PHY faults and the shaper flag are connected to the
+--!   start-address and the CRC-distortion flag to the end-address.
 --! - The Frame-Receiver receives also a new start address for the next frame.
+--! - The positions of a duplicated frame are written again for each copy with the IPG of
+--!   the task.
+--! - The positions of a reordered frame are held back, until the number of overtaking
+--!   frames has been stored. They are written in front of the next SoC at the latest. Only
+--!   one frame is held back at the same time, further reorder tasks pass their frames.
 architecture two_seg_arch of StoreAddress_FSM is
 
     --states
     type tMcState is
         (
-        sIdle,      --! Wait for new incoming frame
-        sWrStart,   --! Write start address + delay-timestamp to the fifo
-        sWait_end,  --! Wait for the valid end address/end of the frame
-        sWrEnd,     --! Write end position + CRC-distortion flag
-        sWait_stop  --! Wait until the start signal is zero
+        sIdle,          --! Wait for new incoming frame
+        sWrStart,       --! Write start address + delay-timestamp + IPG to the fifo
+        sWait_end,      --! Wait for the valid end address/end of the frame
+        sWrEnd,         --! Write end position + CRC-distortion flag
+        sWrCopyStart,   --! Write start address of a copy
+        sWrCopyEnd,     --! Write end address of a copy
+        sRelStart,      --! Write start address of the held back frame
+        sRelEnd,        --! Write end address of the held back frame
+        sWait_stop      --! Wait until the start signal is zero
         );
 
 
@@ -102,6 +120,31 @@ architecture two_seg_arch of StoreAddress_FSM is
     signal next_DataInStartAddr : std_logic_vector(gAddrDataWidth-1 downto 0);  --! Next start address
     signal reg_DataInStartAddr  : std_logic_vector(gAddrDataWidth-1 downto 0);  --! Start address of next frame
 
+    --duplication registers
+    signal next_copies      : std_logic_vector(gCntWidth-1 downto 0);           --! Next number of copies
+    signal reg_copies       : std_logic_vector(gCntWidth-1 downto 0);           --! Remaining copies of the current frame
+    signal next_copyStart   : std_logic_vector(gFiFoBitWidth-1 downto 0);       --! Next start entry of the copies
+    signal reg_copyStart    : std_logic_vector(gFiFoBitWidth-1 downto 0);       --! Start entry of the copies
+    signal next_copyEnd     : std_logic_vector(gFiFoBitWidth-1 downto 0);       --! Next end entry of the copies
+    signal reg_copyEnd      : std_logic_vector(gFiFoBitWidth-1 downto 0);       --! End entry of the copies
+
+    --reorder registers
+    signal next_holdFrame   : std_logic;                                        --! Next value of reg_holdFrame
+    signal reg_holdFrame    : std_logic;                                        --! Current frame is held back
+    signal next_held        : std_logic;                                        --! Next value of reg_held
+    signal reg_held         : std_logic;                                        --! A frame is held back
+    signal next_relFirst    : std_logic;                                        --! Next value of reg_relFirst
+    signal reg_relFirst     : std_logic;                                        --! Held back frame is released in front of the current frame
+    signal next_window      : std_logic_vector(gCntWidth-1 downto 0);           --! Next number of overtaking frames
+    signal reg_window       : std_logic_vector(gCntWidth-1 downto 0);           --! Remaining overtaking frames
+    signal next_holdStart   : std_logic_vector(gFiFoBitWidth-1 downto 0);       --! Next start entry of the held back frame
+    signal reg_holdStart    : std_logic_vector(gFiFoBitWidth-1 downto 0);       --! Start entry of the held back frame
+    signal next_holdEnd     : std_logic_vector(gFiFoBitWidth-1 downto 0);       --! Next end entry of the held back frame
+    signal reg_holdEnd      : std_logic_vector(gFiFoBitWidth-1 downto 0);       --! End entry of the held back frame
+
+    signal startEntry       : std_logic_vector(gFiFoBitWidth-1 downto 0);       --! Start entry of the current frame
+    signal endEntry         : std_logic_vector(gFiFoBitWidth-1 downto 0);       --! End entry of the current frame
+
 begin
 
 
@@ -113,23 +156,49 @@ begin
     begin
         if iReset='1' then
             reg_DataInStartAddr <= (others=>'0');
+            reg_copies          <= (others=>'0');
+            reg_copyStart       <= (others=>'0');
+            reg_copyEnd         <= (others=>'0');
+            reg_holdFrame       <= '0';
+            reg_held            <= '0';
+            reg_relFirst        <= '0';
+            reg_window          <= (others=>'0');
+            reg_holdStart       <= (others=>'0');
+            reg_holdEnd         <= (others=>'0');
             state_reg           <= sIdle;
 
         elsif rising_edge(iClk) then
             reg_DataInStartAddr <= next_DataInStartAddr;
+            reg_copies          <= next_copies;
+            reg_copyStart       <= next_copyStart;
+            reg_copyEnd         <= next_copyEnd;
+            reg_holdFrame       <= next_holdFrame;
+            reg_held            <= next_held;
+            reg_relFirst        <= next_relFirst;
+            reg_window          <= next_window;
+            reg_holdStart       <= next_holdStart;
+            reg_holdEnd         <= next_holdEnd;
             state_reg           <= state_next;
 
         end if;
     end process;
 
 
+    --fifo data: start entry=shaper flag+PHY faults+IPG+delay-timestamp+start position, end entry=CRC Task Flag + end position
+    startEntry  <= iShapeEn & iPhyFault & iFrameIpg & iDelayTime & reg_DataInStartAddr;
+    endEntry    <= (gFiFoBitWidth-1 downto gAddrDataWidth+1 =>'0')& iCRCManEn & iDataInEndAddr;
+
+
     --! @brief next state logic
-    process(state_reg,iStartStorage,iFrameEnd)
+    process(state_reg,iStartStorage,iFrameEnd,iFrameIsSoC,reg_held,reg_holdFrame,reg_relFirst,reg_window,reg_copies)
     begin
        case state_reg is
 
             when sIdle=>
-                if iStartStorage='1' then
+                if iStartStorage='1' and reg_held='1' and iFrameIsSoC='1' then
+                    state_next  <= sRelStart;   --release held back frame in front of the SoC
+
+                elsif iStartStorage='1' then
                     state_next  <= sWrStart;    --when start, then write start position
 
                 else
@@ -150,7 +219,43 @@ begin
                 end if;
 
             when sWrEnd=>
-                state_next  <= sWait_stop;      --goto end
+                if reg_copies/=(reg_copies'range=>'0') then
+                    state_next  <= sWrCopyStart;    --write copies of the frame
+
+                elsif reg_held='1' and reg_holdFrame='0' and unsigned(reg_window)=1 then
+                    state_next  <= sRelStart;       --last overtaking frame was stored
+
+                else
+                    state_next  <= sWait_stop;      --goto end
+
+                end if;
+
+            when sWrCopyStart=>
+                state_next  <= sWrCopyEnd;
+
+            when sWrCopyEnd=>
+                if unsigned(reg_copies)>1 then
+                    state_next  <= sWrCopyStart;    --write next copy
+
+                elsif reg_held='1' and reg_window=(reg_window'range=>'0') then
+                    state_next  <= sRelStart;       --last overtaking frame was stored
+
+                else
+                    state_next  <= sWait_stop;
+
+                end if;
+
+            when sRelStart=>
+                state_next  <= sRelEnd;
+
+            when sRelEnd=>
+                if reg_relFirst='1' then
+                    state_next  <= sWrStart;        --store the current frame behind the released one
+
+                else
+                    state_next  <= sWait_stop;
+
+                end if;
 
             when sWait_stop=>
                 if iStartStorage='0' then
@@ -167,31 +272,88 @@ begin
 
 
     --! @brief Moore output
-    process(state_reg,reg_DataInStartAddr,iDelayTime,iCRCManEn, iDataInEndAddr)
+    process(state_reg,reg_DataInStartAddr,reg_copies,reg_copyStart,reg_copyEnd,reg_holdFrame,reg_held,
+            reg_relFirst,reg_window,reg_holdStart,reg_holdEnd,startEntry,endEntry,iStartStorage,
+            iFrameIsSoC,iCopies,iCopyIpg,iReorder,iDataInEndAddr)
     begin
         --store and output of new start position
         next_DataInStartAddr    <= reg_DataInStartAddr;
         oDataInStartAddr        <= reg_DataInStartAddr;
 
+        next_copies     <= reg_copies;
+        next_copyStart  <= reg_copyStart;
+        next_copyEnd    <= reg_copyEnd;
+        next_holdFrame  <= reg_holdFrame;
+        next_held       <= reg_held;
+        next_relFirst   <= reg_relFirst;
+        next_window     <= reg_window;
+        next_holdStart  <= reg_holdStart;
+        next_holdEnd    <= reg_holdEnd;
+
         oWr         <= '0';
         oFiFoData   <= (others=>'0');
 
         case state_reg is
             when sIdle=>
+                next_relFirst   <= iStartStorage and reg_held and iFrameIsSoC;
 
-            when sWrStart=>     --writeEnable and fifo-data=delay-timestamp+start position
-                oWr         <= '1';
-                oFiFoData   <= iDelayTime & reg_DataInStartAddr;
+            when sWrStart=>     --writeEnable and fifo-data=shaper flag+IPG+delay-timestamp+start position
+                next_copies     <= iCopies;
+                next_copyStart  <= '0' & (gPhyWidth-1 downto 0 =>'0') & iCopyIpg & (gSize_Time-1 downto 0 =>'0') & reg_DataInStartAddr;
+                next_relFirst   <= '0';
+
+                if iReorder/=(iReorder'range=>'0') and reg_held='0' then
+                    next_holdFrame  <= '1';         --hold back the frame instead of writing it
+                    next_holdStart  <= startEntry;
+                    next_window     <= iReorder;
+
+                else
+                    oWr         <= '1';
+                    oFiFoData   <= startEntry;
+
+                end if;
 
             when sWait_end=>
                 null;
 
             when sWrEnd=>       --writeEnable and fifo-data= CRC Task Flag + end position
-                oWr                     <= '1';
-                oFiFoData               <= (gFiFoBitWidth-1 downto gAddrDataWidth+1 =>'0')& iCRCManEn & iDataInEndAddr;  --end Address
+                next_copyEnd            <= (gFiFoBitWidth-1 downto gAddrDataWidth =>'0') & iDataInEndAddr;
                 next_DataInStartAddr    <= iDataInEndAddr;
                                 --start position of the next frame is current end position
 
+                if reg_holdFrame='1' then
+                    next_holdFrame  <= '0';
+                    next_held       <= '1';
+                    next_holdEnd    <= endEntry;
+
+                else
+                    oWr         <= '1';
+                    oFiFoData   <= endEntry;
+
+                    if reg_held='1' then
+                        next_window <= std_logic_vector(unsigned(reg_window)-1);
+                    end if;
+
+                end if;
+
+            when sWrCopyStart=>
+                oWr         <= '1';
+                oFiFoData   <= reg_copyStart;
+
+            when sWrCopyEnd=>
+                oWr         <= '1';
+                oFiFoData   <= reg_copyEnd;
+                next_copies <= std_logic_vector(unsigned(reg_copies)-1);
+
+            when sRelStart=>
+                oWr         <= '1';
+                oFiFoData   <= reg_holdStart;
+
+            when sRelEnd=>
+                oWr         <= '1';
+                oFiFoData   <= reg_holdEnd;
+                next_held   <= '0';
+
             when sWait_stop=>
                 null;
 
@@ -201,4 +363,4 @@ begin
 
 
 
-end two_seg_arch;
\ No newline at end of file
+end two_seg_arch;
@@ -0,0 +1,190 @@
+-------------------------------------------------------------------------------
+--! @file Task_Mem_Burst.vhd
+--! @brief Burst transfers of the task slave
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+
+--! This is the entity of the module for burst transfers of the task slave.
+entity Task_Mem_Burst is
+    generic(
+            gAddrWidth  : natural := 8;     --! Address width of the task slave
+            gBurstWidth : natural := 4      --! Width of the burst count
+            );
+    port(
+        iClk            : in std_logic;                                     --! clk of the avalon slave
+        iReset          : in std_logic;                                     --! reset
+        --avalon bus
+        iAddress        : in std_logic_vector(gAddrWidth-1 downto 0);       --! avalon address of the first word
+        iBurstcount     : in std_logic_vector(gBurstWidth-1 downto 0);      --! number of words of the transfer
+        iWrite          : in std_logic;                                     --! avalon write enable
+        iRead           : in std_logic;                                     --! avalon read enable
+        oWaitrequest    : out std_logic;                                    --! no new transfer during a read burst
+        oReadDataValid  : out std_logic;                                    --! read data of a word is valid
+        --memory
+        oMemAddr        : out std_logic_vector(gAddrWidth-1 downto 0);      --! address of the task memory
+        oMemWrEn        : out std_logic;                                    --! write enable of the task memory
+        oMemRdEn        : out std_logic                                     --! read enable of the task memory
+    );
+end Task_Mem_Burst;
+
+
+--! @brief Task_Mem_Burst architecture
+--! @details Counts the addresses of avalon bursts to the task memory
+--! - The first word of a transfer is accessed with the avalon address, the following ones
+--!   with the incremented address. Bursts can cross the borders of the DPRAMs.
+--! - Write bursts: one word per cycle with write enable
+--! - Read bursts: one word per cycle, the read data is valid one cycle after the address.
+--!   New transfers wait until the last word of the burst is read.
+architecture two_seg_arch of Task_Mem_Burst is
+
+    --! states
+    type tMcState is (
+            sIdle,      --! waiting for a transfer, accesses the first word
+            sWrBurst,   --! writes the following words of a burst
+            sRdBurst    --! reads the following words of a burst
+            );
+
+    signal state_reg    : tMcState; --! Current state
+    signal state_next   : tMcState; --! Next state
+
+    signal addr_reg     : std_logic_vector(gAddrWidth-1 downto 0);  --! Address of the next word
+    signal addr_next    : std_logic_vector(gAddrWidth-1 downto 0);  --! Next value of the address
+    signal cnt_reg      : std_logic_vector(gBurstWidth-1 downto 0); --! Remaining words of the burst
+    signal cnt_next     : std_logic_vector(gBurstWidth-1 downto 0); --! Next value of the remaining words
+    signal valid_reg    : std_logic;                                --! Word was read in the last cycle
+    signal valid_next   : std_logic;                                --! Word is read
+
+begin
+
+    --! @brief Registers
+    --! - Storing with asynchronous reset
+    registers :
+    process(iClk, iReset)
+    begin
+        if iReset='1' then
+            state_reg   <= sIdle;
+            addr_reg    <= (others=>'0');
+            cnt_reg     <= (others=>'0');
+            valid_reg   <= '0';
+
+        elsif rising_edge(iClk) then
+            state_reg   <= state_next;
+            addr_reg    <= addr_next;
+            cnt_reg     <= cnt_next;
+            valid_reg   <= valid_next;
+
+        end if;
+    end process;
+
+
+    --! @brief next state logic and outputs
+    --! - sIdle: first word with the avalon address, stores the address of the next word
+    --! - sWrBurst and sRdBurst: following words until the burst count is reached
+    combFsm :
+    process(state_reg, addr_reg, cnt_reg, iAddress, iBurstcount, iWrite, iRead)
+    begin
+        state_next      <= state_reg;
+        addr_next       <= addr_reg;
+        cnt_next        <= cnt_reg;
+        valid_next      <= '0';
+
+        oWaitrequest    <= '0';
+        oMemAddr        <= iAddress;
+        oMemWrEn        <= iWrite;
+        oMemRdEn        <= iRead;
+
+        case state_reg is
+            when sIdle=>
+                addr_next   <= std_logic_vector(unsigned(iAddress)+1);
+                cnt_next    <= std_logic_vector(unsigned(iBurstcount)-1);
+
+                if iWrite='1' then
+                    if unsigned(iBurstcount)>1 then
+                        state_next  <= sWrBurst;
+                    end if;
+
+                elsif iRead='1' then
+                    valid_next  <= '1';
+
+                    if unsigned(iBurstcount)>1 then
+                        state_next  <= sRdBurst;
+                    end if;
+
+                end if;
+
+            when sWrBurst=>
+                oMemAddr    <= addr_reg;
+                oMemRdEn    <= '0';
+
+                if iWrite='1' then  --master can insert idle cycles
+                    addr_next   <= std_logic_vector(unsigned(addr_reg)+1);
+                    cnt_next    <= std_logic_vector(unsigned(cnt_reg)-1);
+
+                    if unsigned(cnt_reg)=1 then
+                        state_next  <= sIdle;
+                    end if;
+
+                end if;
+
+            when sRdBurst=>
+                oWaitrequest    <= '1';     --the burst is read without the master
+                oMemAddr        <= addr_reg;
+                oMemWrEn        <= '0';
+                oMemRdEn        <= '1';
+                valid_next      <= '1';
+
+                addr_next   <= std_logic_vector(unsigned(addr_reg)+1);
+                cnt_next    <= std_logic_vector(unsigned(cnt_reg)-1);
+
+                if unsigned(cnt_reg)=1 then
+                    state_next  <= sIdle;
+                end if;
+
+        end case;
+    end process;
+
+
+    oReadDataValid  <= valid_reg;
+
+end two_seg_arch;
@@ -45,6 +45,8 @@ use ieee.numeric_std.all;
 
 --! Use work library
 library work;
+--! use fm library
+use work.framemanipulatorPkg.all;
 
 --! Common library
 library libcommon;
@@ -54,10 +56,11 @@ use libcommon.global.all;
 
 --! This is the entity of the task memory
 entity Task_Memory is
-    generic(gSlaveWordWidth : natural := 4*cByteLength; --! Word width of avalon bus for the transfer of tasks
+    generic(gSlaveWordWidth : natural := 8*cByteLength; --! Word width of avalon bus for the transfer of tasks (32, 64 or 128 bit)
             gWordWidth      : natural := 8*cByteLength; --! Word width of the tasks
             gSlaveAddrWidth : natural := 11;            --! Address width of avalon bus for the transfer of tasks
-            gAddresswidth   : natural := 8              --! Address width of the tasks
+            gAddresswidth   : natural := 8;             --! Address width of the tasks
+            gNoOfBanks      : natural := 1              --! Number of banks of complete task tables
             );
     port(
         iClk            : in std_logic;    --! FM clock
@@ -71,10 +74,15 @@ entity Task_Memory is
         oSc_ReadData     : out std_logic_vector(gSlaveWordWidth-1 downto 0);               --! Task avalon slave read data
         --memory signals
         iTaskAddr       : in std_logic_vector(gAddresswidth-1 downto 0);        --! Address of the current task
-        iClTaskMem      : in std_logic;                                         --! Delete task
+        iBank           : in std_logic_vector(cByteLength-1 downto 0);          --! Bank of the current task
+        iClearMem       : in std_logic;                                         --! Delete all tasks
+        oTaskValid      : out std_logic;                                        --! output task has a setting other than zero since the last clear
+        oTaskRemain     : out std_logic;                                        --! output task or one of the following tasks is valid
         oSettingData    : out std_logic_vector(2*gWordWidth-1 downto 0);        --! output task setting
         oCompFrame      : out std_logic_vector(gWordWidth-1 downto 0);          --! output task frame
-        oCompMask       : out std_logic_vector(gWordWidth-1 downto 0)           --! output task
+        oCompMask       : out std_logic_vector(gWordWidth-1 downto 0);          --! output task
+        oWindowData     : out std_logic_vector(cParam.noOfFilterWindows*gWordWidth-1 downto 0); --! output filter windows
+        oChainData      : out std_logic_vector(gWordWidth-1 downto 0)           --! output task chain
     );
 end Task_Memory;
 
@@ -84,25 +92,77 @@ end Task_Memory;
 --! @details Memory for the different manipulation tasks
 --! - Shared memory interface between the Framemanipulator and its POWERLINK Slave
 --! - Stores the tasks
---! - It consists of 4 DPRams, which act like one big memory for the avalon slave. The
---!   four DPRams are selected by the first two bits of the avalon slave address with
---!   a data size of 32 bit.
---! - The Framemanipulator receives the data of all 4 DPRams at once with a word size
+--! - It consists of 4 DPRams for the objects 0x3001-0x3004, one DPRam per filter window
+--!   for the objects 0x3007-0x3008 and one for the task chain of object 0x300B, which act
+--!   like one big memory for the avalon slave. The
+--!   DPRams are selected by the first three bits of the avalon slave address below the bank
+--!   with a data size of 32, 64 or 128 bit.
+--! - The read data is selected with the DPRam of the last read address, like it is valid
+--!   one cycle after the address.
+--! - With gNoOfBanks>1 the DPRams hold several complete task tables. The bank is selected
+--!   by the address bits above the DPRam selection, so every bank has the layout of a
+--!   single task table. Port B reads the tasks of the bank iBank.
+--! - A task is valid, when the Bytes of its setting (objects 0x3001-0x3002), which were written
+--!   since the last clear, aren't zero. The valid bits are kept in the FM clock domain. They
+--!   are transferred from the slave clock domain with a toggle handshake, which hands over
+--!   the valid bits of all tasks at once.
+--! - The rising edge of iClearMem deletes all tasks by clearing the valid bits in one cycle of
+--!   the FM clock, the DPRams keep their data. Every clear toggles a tag, which is transferred
+--!   to the slave clock domain. Valid bits of the slave with an old tag are discarded.
+--! - Tasks, which weren't written since the last clear, are read as zeroes by the slave.
+--! - oTaskValid and oTaskRemain belong to the task data of port B, oTaskRemain is '0' when
+--!   no valid task of the bank follows.
+--! - The Framemanipulator receives the data of all DPRams at once with a word size
 --!   of 64 bits.
 architecture two_seg_arch of Task_Memory is
 
-    signal slaveWriteEn     : std_logic_vector(3 downto 0);               --! write enable
-    signal slaveSelEn       : std_logic_vector(1 downto 0);               --! DPRam Selection
-    signal slaveWrTaskAddr  : std_logic_vector(gAddresswidth downto 0);   --! write address
-    signal rdTaskMem        : std_logic;                                  --! read task
+    constant cNoOfMem       : natural := 5+cParam.noOfFilterWindows;       --! Number of DPRams
+    constant cChainMem      : natural := 4+cParam.noOfFilterWindows;       --! DPRam of the task chain
+    constant cBankWidth     : natural := LogDualis(gNoOfBanks);            --! Address bits of the bank
+    constant cNoOfBanks     : natural := 2**cBankWidth;                    --! Number of banks within the DPRams
+    constant cAddrWidthB    : natural := cBankWidth+gAddresswidth;         --! Address width of port B with the bank
+    --! Address width of port A, the same memory with a different word width of the slave
+    constant cAddrWidthA    : natural := cAddrWidthB+LogDualis(gWordWidth)-LogDualis(gSlaveWordWidth);
+    constant cBankAddrWidth : natural := cAddrWidthA-cBankWidth;           --! Slave address bits below the DPRam selection
+    constant cNoOfTasks     : natural := 2**gAddresswidth;                                  --! Number of tasks of a bank
+    constant cWordsPerTask  : natural := (gWordWidth+gSlaveWordWidth-1)/gSlaveWordWidth;    --! Slave words of a task word
+    constant cTasksPerWord  : natural := (gSlaveWordWidth+gWordWidth-1)/gWordWidth;         --! Task words of a slave word
+    constant cLaneWidth     : natural := gSlaveWordWidth/cTasksPerWord;                     --! Bits of a task within a slave word
+    constant cLaneBytes     : natural := cLaneWidth/cByteLength;                            --! Bytes of a task within a slave word
+    constant cSetBytes      : natural := 2*gWordWidth/cByteLength;                          --! Bytes of the setting of a task
+
+    signal slaveWriteEn     : std_logic_vector(cNoOfMem-1 downto 0);      --! write enable
+    signal slaveSelEn       : std_logic_vector(2 downto 0);               --! DPRam Selection
+    signal slaveRdSel_reg   : std_logic_vector(2 downto 0):=(others=>'0');    --! DPRam Selection of the last read
+    signal slaveWrTaskAddr  : std_logic_vector(cAddrWidthA-1 downto 0);   --! write address
+    signal taskAddrB        : std_logic_vector(cAddrWidthB-1 downto 0);   --! Address of port B within all banks
+
+    --slave clock domain
+    signal taskWritten_reg  : std_logic_vector(cNoOfBanks*cNoOfTasks-1 downto 0):=(others=>'0');              --! Task was written since the last clear
+    signal settingNz_reg    : std_logic_vector(cNoOfBanks*cNoOfTasks*cSetBytes-1 downto 0):=(others=>'0');    --! Byte of a setting isn't zero
+    signal slaveRdValid_reg : std_logic_vector(cTasksPerWord-1 downto 0):=(others=>'0');  --! Written bits of the last read word
+    signal clearTogSync_reg : std_logic_vector(2 downto 0):=(others=>'0');                --! clearTog_reg in the slave clock domain, last stage for edge detection
+    signal clearSlave       : std_logic;                                                  --! Clear the tasks of the slave clock domain
+    signal snapValid_reg    : std_logic_vector(cNoOfBanks*cNoOfTasks-1 downto 0):=(others=>'0');              --! Valid bits of the handover
+    signal snapClear_reg    : std_logic:='0';                                             --! Clear tag of the valid bits of the handover
+    signal snapReq_reg      : std_logic:='0';                                             --! Toggles with new valid bits of the handover
+    signal snapAckSync_reg  : std_logic_vector(1 downto 0):=(others=>'0');                --! Acknowledge of the handover in the slave clock domain
+
+    --FM clock domain
+    signal taskValid_reg    : std_logic_vector(cNoOfBanks*cNoOfTasks-1 downto 0):=(others=>'0');              --! Task has a setting other than zero
+    signal clearMem_reg     : std_logic:='0';                                             --! iClearMem of the last cycle for edge detection
+    signal clearTog_reg     : std_logic:='0';                                             --! Clear tag, toggles with every clear
+    signal snapReqSync_reg  : std_logic_vector(2 downto 0):=(others=>'0');                --! snapReq_reg in the FM clock domain, last stage for edge detection and acknowledge
+    signal taskValidB_reg   : std_logic:='0';                                             --! Valid bit of the task at port B
+    signal taskRemainB_reg  : std_logic:='0';                                             --! Valid task at or behind the address of port B
 
 
     --! Typedef for read data Port A
-    type tRdDataA is array (3 downto 0) of
-        std_logic_vector(gWordWidth/2-1 downto 0);
+    type tRdDataA is array (cNoOfMem-1 downto 0) of
+        std_logic_vector(gSlaveWordWidth-1 downto 0);
 
     --! Typedef for read data Port B
-    type tRdDataB is array (3 downto 0) of
+    type tRdDataB is array (cNoOfMem-1 downto 0) of
         std_logic_vector(gWordWidth-1 downto 0);
 
     signal readDataA    : tRdDataA;
@@ -111,47 +171,176 @@ architecture two_seg_arch of Task_Memory is
 begin
 
     --Isolate the selection of the Buffers from the address line----------------------------------------
-    slaveSelEn      <= iSc_addr(iSc_addr'left downto iSc_addr'left-1);  --! first two address-bits => DPRAM selection
-    slaveWrTaskAddr <= iSc_addr(gAddresswidth downto 0);                --! remaining address-bits => real address
+    slaveSelEn      <= iSc_addr(cBankAddrWidth+2 downto cBankAddrWidth);    --! three address-bits below the bank => DPRAM selection
+
+    --! remaining address-bits => real address, the bank above the DPRAM selection becomes the upper part
+    slaveWrTaskAddr <= std_logic_vector(resize(
+                            shift_left(shift_right(unsigned(iSc_addr), cBankAddrWidth+3), cBankAddrWidth)
+                            or resize(unsigned(iSc_addr(cBankAddrWidth-1 downto 0)), iSc_addr'length),
+                            cAddrWidthA));
+
+    --! task of port B within the selected bank
+    taskAddrB       <= std_logic_vector(to_unsigned(
+                            (to_integer(unsigned(iBank)) mod cNoOfBanks)*cNoOfTasks+to_integer(unsigned(iTaskAddr)),
+                            cAddrWidthB));
+
+
+    --! @brief Registers of the slave clock domain
+    --! - DPRAM selection and written bits of the read data
+    --! - Written bits are set by the written Bytes of a task
+    --! - The Bytes of the setting store, if they aren't zero
+    --! - Handover of the valid bits to the FM clock domain, when the last one was acknowledged
+    --! - The tasks are cleared with the edge of the synchronized clear tag
+    regSlave :
+    process(iS_clk)
+        variable vTask  : natural;  --! Task of a lane of the slave word
+        variable vByte  : natural;  --! Byte of the settings of all tasks
+    begin
+        if rising_edge(iS_clk) then
+            clearTogSync_reg    <= clearTogSync_reg(1 downto 0) & clearTog_reg;
+            snapAckSync_reg     <= snapAckSync_reg(0) & snapReqSync_reg(2);
+
+            for j in 0 to cTasksPerWord-1 loop
+                vTask   := to_integer(unsigned(slaveWrTaskAddr))/cWordsPerTask*cTasksPerWord+j;
+
+                if iSc_wrEn='1' and to_integer(unsigned(slaveSelEn)) < cNoOfMem
+                    and iSc_byteEn((j+1)*cLaneBytes-1 downto j*cLaneBytes)
+                        /=(cLaneBytes-1 downto 0=>'0') then
+                    taskWritten_reg(vTask)  <= '1';
+
+                end if;
+
+                if iSc_rdEn='1' then
+                    slaveRdValid_reg(j) <= taskWritten_reg(vTask);
+                end if;
+            end loop;
+
+            --Bytes of the settings in the DPRAMs 0 and 1
+            if iSc_wrEn='1' and to_integer(unsigned(slaveSelEn)) < 2 then
+                for b in 0 to gSlaveWordWidth/cByteLength-1 loop
+                    vTask   := to_integer(unsigned(slaveWrTaskAddr))/cWordsPerTask*cTasksPerWord+b/cLaneBytes;
+                    vByte   := vTask*cSetBytes+to_integer(unsigned(slaveSelEn))*gWordWidth/cByteLength
+                                +(to_integer(unsigned(slaveWrTaskAddr)) mod cWordsPerTask)*cLaneBytes+b mod cLaneBytes;
+
+                    if iSc_byteEn(b)='1' then
+                        if iSc_writeData((b+1)*cByteLength-1 downto b*cByteLength)/=(cByteLength-1 downto 0=>'0') then
+                            settingNz_reg(vByte)    <= '1';
+                        else
+                            settingNz_reg(vByte)    <= '0';
+                        end if;
+                    end if;
+                end loop;
+            end if;
+
+            --new handover with the tag of the last clear
+            if snapAckSync_reg(1)=snapReq_reg then
+                for i in 0 to cNoOfBanks*cNoOfTasks-1 loop
+                    if settingNz_reg((i+1)*cSetBytes-1 downto i*cSetBytes)/=(cSetBytes-1 downto 0=>'0') then
+                        snapValid_reg(i)    <= '1';
+                    else
+                        snapValid_reg(i)    <= '0';
+                    end if;
+                end loop;
+
+                snapClear_reg   <= clearTogSync_reg(2);
+                snapReq_reg     <= not snapReq_reg;
+            end if;
+
+            if clearSlave='1' then  --clear has priority
+                taskWritten_reg <= (others=>'0');
+                settingNz_reg   <= (others=>'0');
+            end if;
+
+            if iSc_rdEn='1' then
+                slaveRdSel_reg  <= slaveSelEn;
+            end if;
+        end if;
+    end process;
+
+    clearSlave  <= clearTogSync_reg(1) xor clearTogSync_reg(2);
+
+
+    --! @brief Registers of the FM clock domain
+    --! - The edge of iClearMem clears the valid bits and toggles the clear tag
+    --! - Valid bits of the handover are taken, when they carry the current clear tag
+    --! - Valid bits of the task at port B, registered like the address of the DPRAMs
+    --! - Only the tasks of the same bank are remaining
+    regPortB :
+    process(iClk)
+        variable vRemain    : std_logic;    --! Valid task at or behind the address
+        variable vAddr      : natural;      --! Task within all banks
+    begin
+        if rising_edge(iClk) then
+            clearMem_reg    <= iClearMem;
+            snapReqSync_reg <= snapReqSync_reg(1 downto 0) & snapReq_reg;
+
+            if iClearMem='1' and clearMem_reg='0' then
+                clearTog_reg    <= not clearTog_reg;
+                taskValid_reg   <= (others=>'0');
+
+            elsif snapReqSync_reg(1)/=snapReqSync_reg(2) and snapClear_reg=clearTog_reg then
+                taskValid_reg   <= snapValid_reg;
+
+            end if;
+
+            vRemain := '0';
+            vAddr   := to_integer(unsigned(taskAddrB));
+
+            for i in 0 to cNoOfBanks*cNoOfTasks-1 loop
+                if i>=vAddr and i/cNoOfTasks=vAddr/cNoOfTasks then
+                    vRemain := vRemain or taskValid_reg(i);
+                end if;
+            end loop;
+
+            taskValidB_reg  <= taskValid_reg(vAddr);
+            taskRemainB_reg <= vRemain;
+        end if;
+    end process;
+
+    oTaskValid  <= taskValidB_reg;
+    oTaskRemain <= taskRemainB_reg;
 
 
     --! @brief Selection of task DPRAM
     --! - Select write enable as one-hot
-    --! - Select read data
+    --! - Select read data of the last read address, invalid tasks are read as zeroes
     combSelRam :
-    process(iSc_wrEn, slaveSelEn, readDataA)
+    process(iSc_wrEn, slaveSelEn, slaveRdSel_reg, slaveRdValid_reg, readDataA)
     begin
 
         slaveWriteEn    <= (others => '0');
         oSc_ReadData    <= (others => '0');
 
-        if iSc_wrEn  = '1' then  --write
+        if to_integer(unsigned(slaveSelEn)) < cNoOfMem and iSc_wrEn = '1' then
             slaveWriteEn(to_integer(unsigned(slaveSelEn)))  <= '1'; --! Convert to one-hot
-
-        else                    --read
-            oSc_ReadData <= readDataA(to_integer(unsigned(slaveSelEn)));
-
         end if;
 
-    end process;
+        if to_integer(unsigned(slaveRdSel_reg)) < cNoOfMem then     --unused address range reads zeros
+            oSc_ReadData <= readDataA(to_integer(unsigned(slaveRdSel_reg)));
+        end if;
 
+        for j in 0 to cTasksPerWord-1 loop
+            if slaveRdValid_reg(j)='0' then
+                oSc_ReadData((j+1)*cLaneWidth-1 downto j*cLaneWidth)    <= (others => '0');
+            end if;
+        end loop;
 
-    rdTaskMem <= not iClTaskMem;
+    end process;
 
 
     --Mapping of the four Buffers ---------------------------------------------------------------------
 
-    --! @brief task memorys for the four Objects 0x3001-0x3004
+    --! @brief task memorys for the Objects 0x3001-0x3004, the filter windows 0x3007-0x3008 and the chain 0x300B
     genTaskMem :
-    for i in 0 to 3 generate
+    for i in 0 to cNoOfMem-1 generate
     begin
 
         --! @brief Memory
         ManiDataBuffer : entity work.DpramAdjustable
         generic map(
-                    gAddresswidthA  => gAddresswidth+1,
-                    gAddresswidthB  => gAddresswidth,
-                    gWordWidthA     => gWordWidth/2,
+                    gAddresswidthA  => cAddrWidthA,
+                    gAddresswidthB  => cAddrWidthB,
+                    gWordWidthA     => gSlaveWordWidth,
                     gWordWidthB     => gWordWidth
                     )
         port map(
@@ -164,11 +353,11 @@ begin
                 iWren_a     => slaveWriteEn(i),
                 iRden_a     => iSc_rdEn,
                 --port B FM
-                iAddress_b  => iTaskAddr,
+                iAddress_b  => taskAddrB,
                 iByteena_b  => (others=>'1'),
                 iData_b     => (others=>'0'),
-                iWren_b     => iClTaskMem,
-                iRden_b     => rdTaskMem,
+                iWren_b     => '0',
+                iRden_b     => '1',
                 --output
                 oQ_a        => readDataA(i),
                 oQ_b        => readDataB(i)
@@ -181,4 +370,12 @@ begin
     oCompFrame      <= readDataB(2);                --! Frame data
     oCompMask       <= readDataB(3);                --! Frame mask
 
+    --! Filter windows
+    genWindow :
+    for i in 0 to cParam.noOfFilterWindows-1 generate
+        oWindowData((i+1)*gWordWidth-1 downto i*gWordWidth) <= readDataB(4+i);
+    end generate genWindow;
+
+    oChainData      <= readDataB(cChainMem);    --! Task chain
+
 end two_seg_arch;
@@ -0,0 +1,303 @@
+-------------------------------------------------------------------------------
+--! @file Traffic_Shaper.vhd
+--! @brief Limits the rate of the outgoing frames with a token bucket
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+--! Use work library
+library work;
+--! use fm library
+use work.framemanipulatorPkg.all;
+
+--! Common library
+library libcommon;
+--! Use common library global package
+use libcommon.global.all;
+
+
+--! This is the entity of the module, which limits the rate of the outgoing frames
+entity Traffic_Shaper is
+    generic(
+            gAddrDataWidth  : natural:=11;              --! Address width of the frame buffer
+            gSettingWidth   : natural:=7*cByteLength    --! Width of the shape setting
+            );
+    port(
+        iClk                : in std_logic;     --! clk
+        iReset              : in std_logic;     --! reset
+        --control signals
+        iTestActive         : in std_logic;     --! Series of test is active
+        iTestSync           : in std_logic;     --! sync: Test started
+        iTestStop           : in std_logic;     --! Test abort
+        iFrameIsSoC         : in std_logic;     --! current frame is a SoC
+        iTaskShapeEn        : in std_logic;                                     --! task: limit the rate of the frames
+        iShapeSetting       : in std_logic_vector(gSettingWidth-1 downto 0);    --! setting: rate, burst, limit and window
+        --frame storing
+        iStartStorage       : in std_logic;     --! frame position can be stored
+        oStartStorage       : out std_logic;    --! frame position can be stored, frame wasn't dropped
+        oShapeFrame         : out std_logic;    --! current frame is stored as shaped frame
+        --frame reading
+        iFrameShape         : in std_logic;                                     --! read frame is a shaped frame
+        iRdStart            : in std_logic;                                     --! start address is read from the fifo
+        iRdEnd              : in std_logic;                                     --! end address is read from the fifo
+        iRdAddr             : in std_logic_vector(gAddrDataWidth-1 downto 0);   --! read address of the fifo
+        oConform            : out std_logic                                     --! a shaped frame can be sent
+     );
+end Traffic_Shaper;
+
+
+--! @brief Traffic_Shaper architecture
+--! @details Limits the rate of the outgoing frames with a token bucket
+--! - The shape task is stored at the edge of its enable signal. All following frames
+--!   except SoCs are shaped, until the window of SoCs has passed or the test has finished.
+--!   A window of 0 shapes the frames until the end of the test.
+--! - The bucket is filled with the rate of the setting every clock cycle up to the burst
+--!   size. It is emptied by the size of each shaped frame, when its end address is read.
+--!   The frame and its overhead of Preamble and IPG are charged after the start of the
+--!   frame, as the frame size is unknown before. Thus a shaped frame starts, when the
+--!   bucket isn't negative.
+--! - Frames are dropped instead of stored, when the limit of waiting shaped frames is
+--!   reached. A limit of 0 never drops frames.
+architecture two_seg_arch of Traffic_Shaper is
+
+    --constants
+    constant cFracWidth     : natural:=cParam.sizeShapeRate;                        --! Fraction of the bucket
+    constant cTokenWidth    : natural:=cFracWidth+cParam.sizeShapeBurst+2;          --! Width of the bucket with sign
+    constant cOverhead      : natural:=cCreateTime.ipgSize+8;                       --! Preamble and IPG of each frame in Byte
+
+    --! Typedef for registers
+    type tReg is record
+        taskShapeEn     : std_logic;                                            --! Register for edge detection of iTaskShapeEn
+        frameIsSoc      : std_logic;                                            --! Register for edge detection of iFrameIsSoc
+        startStorage    : std_logic;                                            --! Register for edge detection of iStartStorage
+        active          : std_logic;                                            --! Frames are shaped
+        drop            : std_logic;                                            --! Current frame is dropped
+        charge          : std_logic;                                            --! Read frame is charged at its end address
+        rate            : std_logic_vector(cParam.sizeShapeRate-1 downto 0);    --! Tokens per clock cycle
+        burst           : std_logic_vector(cParam.sizeShapeBurst-1 downto 0);   --! Size of the bucket
+        limit           : std_logic_vector(cByteLength-1 downto 0);             --! Maximal number of waiting frames
+        window          : std_logic_vector(cByteLength-1 downto 0);             --! Remaining SoCs
+        windowEn        : std_logic;                                            --! Number of SoCs is limited
+        pending         : std_logic_vector(cByteLength-1 downto 0);             --! Number of waiting frames
+        rdStart         : std_logic_vector(gAddrDataWidth-1 downto 0);          --! Start address of the read frame
+        tokens          : signed(cTokenWidth-1 downto 0);                       --! Tokens of the bucket
+    end record;
+
+    --! Init for registers
+    constant cRegInit   : tReg :=(
+                                taskShapeEn     => '0',
+                                frameIsSoc      => '0',
+                                startStorage    => '0',
+                                active          => '0',
+                                drop            => '0',
+                                charge          => '0',
+                                rate            => (others=>'0'),
+                                burst           => (others=>'0'),
+                                limit           => (others=>'0'),
+                                window          => (others=>'0'),
+                                windowEn        => '0',
+                                pending         => (others=>'0'),
+                                rdStart         => (others=>'0'),
+                                tokens          => (others=>'0')
+                                );
+
+    signal reg          : tReg; --! Registers
+    signal reg_next     : tReg; --! Next value of registers
+
+    signal taskShapeEn_posEdge  : std_logic;    --! positive edge of iTaskShapeEn
+    signal frameIsSoc_posEdge   : std_logic;    --! positive edge of iFrameIsSoc
+    signal startStorage_posEdge : std_logic;    --! positive edge of iStartStorage
+    signal shapeFrame           : std_logic;    --! current frame is shaped
+    signal dropFrame            : std_logic;    --! current frame exceeds the limit of waiting frames
+
+
+    --! Rate of the bucket in the task setting
+    alias iShapeSetting_rate    : std_logic_vector(cParam.sizeShapeRate-1 downto 0)
+                                    is iShapeSetting(gSettingWidth-1 downto gSettingWidth-cParam.sizeShapeRate);
+
+    --! Burst size in the task setting
+    alias iShapeSetting_burst   : std_logic_vector(cParam.sizeShapeBurst-1 downto 0)
+                                    is iShapeSetting(2*cByteLength+cParam.sizeShapeBurst-1 downto 2*cByteLength);
+
+    --! Limit of waiting frames in the task setting
+    alias iShapeSetting_limit   : std_logic_vector(cByteLength-1 downto 0)
+                                    is iShapeSetting(2*cByteLength-1 downto cByteLength);
+
+    --! Window of SoCs in the task setting
+    alias iShapeSetting_window  : std_logic_vector(cByteLength-1 downto 0)
+                                    is iShapeSetting(cByteLength-1 downto 0);
+
+begin
+
+    --! @brief Registers
+    --! - Storing with asynchronous reset
+    registers :
+    process(iClk, iReset)
+    begin
+        if iReset='1' then
+            reg <= cRegInit;
+
+        elsif rising_edge(iClk) then
+            reg <= reg_next;
+
+        end if;
+    end process;
+
+
+    taskShapeEn_posEdge     <= '1' when reg.taskShapeEn='0' and iTaskShapeEn='1' else '0';
+    frameIsSoc_posEdge      <= '1' when reg.frameIsSoc='0' and iFrameIsSoC='1' else '0';
+    startStorage_posEdge    <= '1' when reg.startStorage='0' and iStartStorage='1' else '0';
+
+    --SoCs are never shaped, the frame of the task is already shaped
+    shapeFrame  <= (reg.active or iTaskShapeEn) and not iFrameIsSoC;
+
+    --tail drop, when the limit of waiting frames is reached
+    dropFrame   <= '1' when startStorage_posEdge='1' and shapeFrame='1' and unsigned(reg.limit)/=0
+                        and unsigned(reg.pending)>=unsigned(reg.limit) else '0';
+
+
+    --! @brief Next register value logic
+    --! - Storing of the setting at the edge of the task enable
+    --! - Counting of the SoCs and the waiting frames
+    --! - Filling and emptying of the bucket
+    nextComb :
+    process(reg, iTaskShapeEn, iFrameIsSoC, iStartStorage, taskShapeEn_posEdge, frameIsSoc_posEdge,
+            startStorage_posEdge, shapeFrame, dropFrame, iShapeSetting, iTestActive, iTestSync,
+            iTestStop, iFrameShape, iRdStart, iRdEnd, iRdAddr)
+        variable vTokens    : signed(cTokenWidth-1 downto 0);   --! Tokens after filling the bucket
+        variable vBurst     : signed(cTokenWidth-1 downto 0);   --! Full bucket
+        variable vSize      : unsigned(gAddrDataWidth-1 downto 0);  --! Size of the read frame
+    begin
+        reg_next    <= reg;
+
+        reg_next.taskShapeEn    <= iTaskShapeEn;
+        reg_next.frameIsSoc     <= iFrameIsSoC;
+        reg_next.startStorage   <= iStartStorage;
+
+        --fill the bucket up to the burst size
+        vBurst  := shift_left(resize(signed('0' & reg.burst), cTokenWidth), cFracWidth);
+        vTokens := reg.tokens + resize(signed('0' & reg.rate), cTokenWidth);
+
+        if vTokens>vBurst then
+            vTokens := vBurst;
+        end if;
+
+        --charge the read frame with its size and overhead
+        vSize   := unsigned(iRdAddr)-unsigned(reg.rdStart);
+
+        if iRdEnd='1' and reg.charge='1' then
+            reg_next.charge <= '0';
+            vTokens := vTokens-shift_left(resize(signed('0' & vSize), cTokenWidth)+cOverhead, cFracWidth);
+        end if;
+
+        reg_next.tokens <= vTokens;
+
+        if iRdStart='1' and iFrameShape='1' then
+            reg_next.charge     <= '1';
+            reg_next.rdStart    <= iRdAddr;
+        end if;
+
+
+        --store setting of a new task with a full bucket
+        if taskShapeEn_posEdge='1' then
+            reg_next.active     <= '1';
+            reg_next.rate       <= iShapeSetting_rate;
+            reg_next.burst      <= iShapeSetting_burst;
+            reg_next.limit      <= iShapeSetting_limit;
+            reg_next.window     <= iShapeSetting_window;
+            reg_next.tokens     <= shift_left(resize(signed('0' & iShapeSetting_burst), cTokenWidth), cFracWidth);
+
+            if unsigned(iShapeSetting_window)/=0 then
+                reg_next.windowEn   <= '1';
+            else
+                reg_next.windowEn   <= '0';
+            end if;
+
+        --passed SoC
+        elsif frameIsSoc_posEdge='1' and reg.windowEn='1' then
+            reg_next.window <= std_logic_vector(unsigned(reg.window)-1);
+
+            if unsigned(reg.window)=1 then
+                reg_next.active <= '0';     --window has passed
+            end if;
+
+        end if;
+
+
+        --number of waiting frames: stored shaped frames, which haven't been started yet
+        if startStorage_posEdge='1' and shapeFrame='1' and dropFrame='0' then
+            if unsigned(reg.pending)/=2**cByteLength-1 then
+                reg_next.pending    <= std_logic_vector(unsigned(reg.pending)+1);
+            end if;
+
+        elsif iRdStart='1' and iFrameShape='1' and unsigned(reg.pending)/=0 then
+            reg_next.pending    <= std_logic_vector(unsigned(reg.pending)-1);
+
+        end if;
+
+        --drop the whole frame
+        if dropFrame='1' then
+            reg_next.drop   <= '1';
+        elsif iStartStorage='0' then
+            reg_next.drop   <= '0';
+        end if;
+
+
+        --end of the series of test
+        if iTestActive='0' or iTestStop='1' then
+            reg_next.active <= '0';
+        end if;
+
+        if iTestSync='1' then
+            reg_next.pending    <= (others=>'0');
+        end if;
+
+    end process;
+
+
+    oStartStorage   <= iStartStorage and not (dropFrame or reg.drop);
+    oShapeFrame     <= shapeFrame;
+
+    --stored frames are released without shaping, when the shaper isn't active anymore
+    oConform        <= '1' when reg.active='0' or reg.tokens>=0 else '0';
+
+
+end two_seg_arch;
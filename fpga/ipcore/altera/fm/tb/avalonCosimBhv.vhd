@@ -0,0 +1,295 @@
+-------------------------------------------------------------------------------
+--! @file avalonCosimBhv.vhd
+--! @brief Testbench module to transfer the accesses of the firmware to the Avalon slaves
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+--! Use work library
+library work;
+--! Use interface to the firmware
+use work.fmCosimPkg.all;
+
+--! Common library
+library libcommon;
+--! Use common library global package
+use libcommon.global.all;
+
+
+--! This is the testbench module to transfer the accesses of the firmware to the Avalon slaves
+entity avalonCosim is
+    generic(
+            gTaskAddr           : natural := 8;     --! Address width of Avalon slave for transfer of tasks
+            gTaskWordWidth      : natural := 64;    --! Word width of Avalon slave for transfer of tasks
+            gTaskBurstWidth     : natural := 4;     --! Width of the burst count of Avalon slave for transfer of tasks
+            gControlAddr        : natural := 5;     --! Address width of Avalon slave for transfer of operations
+            gControlWordWidth   : natural := 8      --! Word width of Avalon slave for transfer of operations
+            );
+    port(
+        iClk            : in std_logic;                                         --! clock of avalon slaves
+        iReset          : in std_logic;                                         --! reset
+        iRXDV           : in std_logic;                                         --! RMII data valid to FM for the SoC detection
+        iRXD            : in std_logic_vector(1 downto 0);                      --! RMII data to FM for the SoC detection
+        --Avalon Slave Task Memory
+        oSt_address     : out std_logic_vector(gTaskAddr-1 downto 0);           --! Task avalon slave address
+        oSt_writedata   : out std_logic_vector(gTaskWordWidth-1 downto 0);      --! Task avalon slave data write
+        oSt_write       : out std_logic;                                        --! Task avalon slave write enable
+        oSt_read        : out std_logic;                                        --! Task avalon slave read enable
+        iSt_readdata    : in std_logic_vector(gTaskWordWidth-1 downto 0);       --! Task avalon slave read data
+        iSt_readdatavalid : in std_logic;                                       --! Task avalon slave read data valid
+        oSt_byteenable  : out std_logic_vector(gTaskWordWidth/8-1 downto 0);    --! Task avalon slave byte enable
+        oSt_burstcount  : out std_logic_vector(gTaskBurstWidth-1 downto 0);     --! Task avalon slave burst count
+        iSt_waitrequest : in std_logic;                                         --! Task avalon slave wait request
+        --Avalon Slave Contol Memory
+        oSc_address     : out std_logic_vector(gControlAddr-1 downto 0);        --! FM-control avalon slave address
+        oSc_writedata   : out std_logic_vector(gControlWordWidth-1 downto 0);   --! FM-control avalon slave data write
+        oSc_write       : out std_logic;                                        --! FM-control avalon slave write enable
+        oSc_read        : out std_logic;                                        --! FM-control avalon slave read enable
+        iSc_readdata    : in std_logic_vector(gControlWordWidth-1 downto 0);    --! FM-control avalon slave read data
+        oSc_byteenable  : out std_logic_vector(gControlWordWidth/8-1 downto 0)  --! FM-control avalon slave byte enable
+        );
+end avalonCosim;
+
+--! @brief avalonCosim architecture
+--! @details Testbench module to transfer the accesses of the firmware to the Avalon slaves
+--! - The firmware runs in tb/cosim/fmcosim.c and is called once per clock cycle
+--! - Writes take one cycle, reads of the control slave two cycles like its readWaitTime
+--! - Reads of the task slave wait for the read data valid
+--! - The 32 bit accesses of the firmware are adapted to the word width of the task slave
+--!   with the byte enable, like the Avalon interconnect
+--! - frameman_syncCb is called at the end of every received SoC
+architecture bhv of avalonCosim is
+
+    constant cSfd       : std_logic_vector(7 downto 0) := X"D5";    --! Start frame delimiter
+    constant cPlkType   : std_logic_vector(15 downto 0) := X"88AB"; --! EtherType of POWERLINK
+    constant cSocType   : std_logic_vector(7 downto 0) := X"01";    --! MessageType of the SoC
+    constant cTaskLanes : natural := gTaskWordWidth/32;             --! 32 bit words of the firmware per word of the task slave
+
+begin
+
+    oSc_byteenable  <= (others => '1');
+
+
+    --! Transfer the accesses of the firmware
+    transfer:
+    process
+
+        variable vRet       : integer;
+        variable vRequest   : natural;
+        variable vAccess    : natural;
+        variable vControl   : boolean;
+        variable vAddress   : natural;
+        variable vBurst     : boolean;
+        variable vBurstCnt  : natural := 0;     --! Remaining words of the current burst of the DMA
+        variable vBurstWord : natural := 0;     --! Current word of the burst
+        variable vReadWait  : natural := 0;     --! Remaining cycles of the current read
+        variable vTaskRead  : boolean := false; --! Read of the task slave waits for the data
+        variable vLane      : natural := 0;     --! 32 bit word within the word of the task slave
+        variable vData      : std_logic_vector(31 downto 0);
+
+        variable vByte      : std_logic_vector(7 downto 0);
+        variable vDibitCnt  : natural := 0;
+        variable vByteCnt   : natural := 0;
+        variable vFrame     : boolean := false; --! SFD was received
+        variable vEtherType : std_logic_vector(15 downto 0);
+        variable vMType     : std_logic_vector(7 downto 0);
+        variable vRXDV_reg  : std_logic := '0';
+        variable vSoc       : boolean := false;
+
+    begin
+
+        oSt_address     <= (others => '0');
+        oSt_writedata   <= (others => '0');
+        oSt_write       <= cInactivated;
+        oSt_read        <= cInactivated;
+        oSt_byteenable  <= (others => '1');
+        oSt_burstcount  <= std_logic_vector(to_unsigned(1, gTaskBurstWidth));
+        oSc_address     <= (others => '0');
+        oSc_writedata   <= (others => '0');
+        oSc_write       <= cInactivated;
+        oSc_read        <= cInactivated;
+
+        wait until iReset = cInactivated;
+
+        vRet := fmCosimInit;
+        assert vRet = 0 report "Initialisation of the firmware failed" severity failure;
+
+        loop
+
+            wait until rising_edge(iClk);
+
+            --SoC detection---------------------------------------------------
+            if iRXDV = cActivated then
+                vByte       := iRXD & vByte(7 downto 2);    --LSB first
+                vDibitCnt   := vDibitCnt + 1;
+
+                if vDibitCnt = 4 then
+                    vDibitCnt   := 0;
+
+                    if not vFrame then
+                        vFrame      := vByte = cSfd;
+                        vByteCnt    := 0;
+
+                    else
+                        case vByteCnt is
+                            when 12 =>  vEtherType(15 downto 8) := vByte;
+                            when 13 =>  vEtherType(7 downto 0)  := vByte;
+                            when 14 =>  vMType                  := vByte;
+                            when others =>
+                        end case;
+
+                        vByteCnt    := vByteCnt + 1;
+
+                    end if;
+                end if;
+
+            elsif vRXDV_reg = cActivated then
+                vSoc        := vFrame and vByteCnt > 14 and vEtherType = cPlkType and vMType = cSocType;
+                vFrame      := false;
+                vDibitCnt   := 0;
+
+            end if;
+
+            vRXDV_reg   := iRXDV;
+
+
+            --Accesses--------------------------------------------------------
+            oSt_write   <= cInactivated;
+            oSt_read    <= cInactivated;
+            oSc_write   <= cInactivated;
+
+            if vBurstCnt /= 0 then
+                --next word, when the slave accepted the last one
+                if iSt_waitrequest = cInactivated then
+                    vBurstCnt   := vBurstCnt - 1;
+                    vBurstWord  := vBurstWord + 1;
+                end if;
+
+                if vBurstCnt = 0 then
+                    vRet    := fmCosimComplete(0);
+                else
+                    for i in 0 to cTaskLanes-1 loop
+                        oSt_writedata(32*i+31 downto 32*i)  <= std_logic_vector(to_signed(fmCosimBurstData(vBurstWord*cTaskLanes+i), 32));
+                    end loop;
+                    oSt_write   <= cActivated;
+                end if;
+
+            elsif vTaskRead then
+                if iSt_readdatavalid = cActivated then
+                    vTaskRead   := false;
+                    vRet        := fmCosimComplete(to_integer(signed(iSt_readdata(32*vLane+31 downto 32*vLane))));
+                end if;
+
+            elsif vReadWait /= 0 then
+                vReadWait   := vReadWait - 1;
+
+                if vReadWait = 0 then
+                    oSc_read    <= cInactivated;
+                    vRet        := fmCosimComplete(to_integer(unsigned(iSc_readdata)));
+                end if;
+
+            else
+                if vSoc then
+                    vSoc    := false;
+                    vRet    := fmCosimSoc;
+                end if;
+
+                vRequest    := fmCosimRequest;
+                vAccess     := vRequest mod 4;
+                vControl    := (vRequest / 4) mod 2 = 1;
+                vBurst      := (vRequest / 8) mod 2 = 1;
+                vAddress    := (vRequest / 256) mod 65536;
+                vLane       := vAddress mod cTaskLanes;
+
+                assert vAccess /= cCosimError report "Firmware failed" severity failure;
+
+                if vAccess = cCosimWrite and vBurst then
+                    --DMA transfer of the image in bursts of whole words
+                    vBurstCnt   := vRequest / 2**24;
+                    vBurstWord  := 0;
+
+                    oSt_address     <= std_logic_vector(to_unsigned(vAddress / cTaskLanes, gTaskAddr));
+                    oSt_burstcount  <= std_logic_vector(to_unsigned(vBurstCnt, gTaskBurstWidth));
+                    oSt_byteenable  <= (others => '1');
+                    for i in 0 to cTaskLanes-1 loop
+                        oSt_writedata(32*i+31 downto 32*i)  <= std_logic_vector(to_signed(fmCosimBurstData(i), 32));
+                    end loop;
+                    oSt_write       <= cActivated;
+
+                elsif vAccess = cCosimWrite then
+                    vData   := std_logic_vector(to_signed(fmCosimWriteData, vData'length));
+
+                    if vControl then
+                        oSc_address     <= std_logic_vector(to_unsigned(vAddress, gControlAddr));
+                        oSc_writedata   <= vData(gControlWordWidth-1 downto 0);
+                        oSc_write       <= cActivated;
+                    else
+                        oSt_address     <= std_logic_vector(to_unsigned(vAddress / cTaskLanes, gTaskAddr));
+                        oSt_burstcount  <= std_logic_vector(to_unsigned(1, gTaskBurstWidth));
+                        oSt_writedata   <= (others => '0');
+                        oSt_writedata(32*vLane+31 downto 32*vLane)  <= vData;
+                        oSt_byteenable  <= (others => '0');
+                        oSt_byteenable(4*vLane+3 downto 4*vLane)    <= (others => '1');
+                        oSt_write       <= cActivated;
+                    end if;
+
+                    vRet    := fmCosimComplete(0);
+
+                elsif vAccess = cCosimRead then
+                    if vControl then
+                        oSc_address     <= std_logic_vector(to_unsigned(vAddress, gControlAddr));
+                        oSc_read        <= cActivated;
+                        vReadWait       := 2;
+                    else
+                        oSt_address     <= std_logic_vector(to_unsigned(vAddress / cTaskLanes, gTaskAddr));
+                        oSt_burstcount  <= std_logic_vector(to_unsigned(1, gTaskBurstWidth));
+                        oSt_read        <= cActivated;
+                        vTaskRead       := true;
+                    end if;
+
+                end if;
+            end if;
+
+        end loop;
+
+    end process transfer;
+
+end bhv;
@@ -0,0 +1,154 @@
+-------------------------------------------------------------------------------
+--! @file avalonMemBhv.vhd
+--! @brief Testbench module of an external memory with an Avalon slave like the SDRAM
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+--! Use work library
+library work;
+
+--! Common library
+library libcommon;
+--! Use common library global package
+use libcommon.global.all;
+
+
+--! This is the testbench module of an external memory with an Avalon slave like the SDRAM
+entity avalonMem is
+    generic(
+            gAddrWidth      : natural := 16;    --! Byte address width of the memory
+            gWaitCycles     : natural := 1;     --! Wait cycles of every access
+            gReadLatency    : natural := 3;     --! Cycles from the accepted read until the read data is valid
+            gRefreshPeriod  : natural := 390;   --! Cycles between two refreshes (7.8 us at 50 MHz)
+            gRefreshCycles  : natural := 8      --! Cycles of every refresh
+            );
+    port(
+        iClk            : in std_logic;                         --! clock
+        iReset          : in std_logic;                         --! reset
+        iAddress        : in std_logic_vector(31 downto 0);     --! Avalon slave address in Byte
+        iWrite          : in std_logic;                         --! Avalon slave write enable
+        iWritedata      : in std_logic_vector(31 downto 0);     --! Avalon slave data write
+        iRead           : in std_logic;                         --! Avalon slave read enable
+        oReaddata       : out std_logic_vector(31 downto 0);    --! Avalon slave read data
+        oWaitrequest    : out std_logic;                        --! Avalon slave wait request
+        oReaddatavalid  : out std_logic                         --! Avalon slave read data valid
+        );
+end avalonMem;
+
+--! @brief avalonMem architecture
+--! @details Testbench module of an external memory with an Avalon slave like the SDRAM
+--! - Every access waits for gWaitCycles, accesses during a refresh wait until its end
+--! - Reads are pipelined, the read data follows gReadLatency cycles after the accepted read
+--! - Only the lower gAddrWidth bits of the address are decoded
+architecture bhv of avalonMem is
+
+    --! Typedef of the memory
+    type tMem is array (0 to 2**(gAddrWidth-2)-1) of std_logic_vector(31 downto 0);
+
+    --! Typedef of the read pipeline
+    type tPipe is array (0 to gReadLatency-1) of std_logic_vector(31 downto 0);
+
+    signal waitCnt      : natural := 0;                                                 --! Wait cycles of the current access
+    signal refreshCnt   : natural := 0;                                                 --! Cycles of the refresh period
+    signal refresh      : std_logic;                                                    --! Refresh is active
+    signal waitrequest  : std_logic;                                                    --! Current access has to wait
+    signal rdValid      : std_logic_vector(gReadLatency-1 downto 0) := (others=>'0');  --! Read pipeline valid
+    signal rdData       : tPipe := (others=>(others=>'0'));                            --! Read pipeline data
+
+begin
+
+    refresh     <= '1' when refreshCnt<gRefreshCycles else '0';
+
+    waitrequest <= '1' when (iRead='1' or iWrite='1') and (waitCnt<gWaitCycles or refresh='1') else '0';
+
+
+    --! Memory with pipelined reads
+    memory:
+    process(iClk)
+
+        variable vMem   : tMem := (others=>(others=>'0'));
+        variable vAddr  : natural;
+
+    begin
+        if rising_edge(iClk) then
+
+            refreshCnt  <= (refreshCnt+1) mod gRefreshPeriod;
+
+            if waitrequest='1' then
+                waitCnt <= waitCnt+1;
+            else
+                waitCnt <= 0;
+            end if;
+
+            for i in gReadLatency-1 downto 1 loop
+                rdValid(i)  <= rdValid(i-1);
+                rdData(i)   <= rdData(i-1);
+            end loop;
+
+            rdValid(0)  <= '0';
+
+            if waitrequest='0' and (iWrite='1' or iRead='1') then
+                vAddr   := to_integer(unsigned(iAddress(gAddrWidth-1 downto 2)));
+
+                if iWrite='1' then
+                    vMem(vAddr) := iWritedata;
+                else
+                    rdValid(0)  <= '1';
+                    rdData(0)   <= vMem(vAddr);
+                end if;
+
+            end if;
+
+            if iReset='1' then
+                waitCnt     <= 0;
+                rdValid     <= (others=>'0');
+            end if;
+
+        end if;
+    end process memory;
+
+
+    oWaitrequest    <= waitrequest;
+    oReaddatavalid  <= rdValid(gReadLatency-1);
+    oReaddata       <= rdData(gReadLatency-1);
+
+end bhv;
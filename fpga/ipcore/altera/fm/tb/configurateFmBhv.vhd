@@ -57,13 +57,25 @@ entity configurateFm is
             gTestSetting        : string := "passTest"              --! Task configuration
             );
     port(
-        iWrCommAddr : in std_logic_vector(7 downto 0);      --! clock
-        oCommData   : out std_logic_vector(31 downto 0)     --! Test finished
+        iWrCommAddr : in std_logic_vector(8 downto 0);      --! Address of the configuration
+        oCommData   : out std_logic_vector(31 downto 0) := (others => '0')  --! Configuration data of the address, zero without a matching setting
         );
 end configurateFm;
 
 --! @brief configurateFm architecture
 --! @details Testbench module to configure predefined tests
+--! - The address has the layout of the task memory with gTaskAddr=9 and 32 bit words:
+--!   three bits of the DPRAM selection, five bits of the task and the upper (1) or lower (0)
+--!   part of the 64 bit word
+--! - DPRAM selection 000 to 011 for the objects 0x3001-0x3004, 100 and 101 for the filter
+--!   windows 0x3007-0x3008 and 110 for the task chain 0x300B
+--! - The unused DPRAM selection 111 holds the control register configuration: "1110" & the
+--!   address of the control register with the Byte in the lowest 8 bits of the data
+--! - Task bank b>0 of tbFramemanipulator is configured by a second instance with the setting
+--!   gTestSetting & "Bank" & b, its control register configuration isn't used
+--! - The template memory of the inject task is configured by an instance with the setting
+--!   gTestSetting & "Template": "0" & the address of the 32 bit word with the first Byte of the
+--!   template in the lowest 8 bits
 architecture bhv of configurateFm is
 
 begin
@@ -73,14 +85,14 @@ begin
 
         --! Generate configuration
         with iWrCommAddr select
-        oCommData<= X"00000000" when "00000001",    --Setting 1 part 1
-                    X"00000000" when "00000000",    --Setting 1 part 2
-                    X"00000000" when "01000001",    --Setting 2 part 1
-                    X"00000000" when "01000000",    --Setting 2 part 2
-                    X"00000000" when "10000001",    --Frame data part 1
-                    X"00000000" when "10000000",    --Frame data part 2
-                    X"00000000" when "11000001",    --Frame mask part 1
-                    X"00000000" when "11000000",    --Frame mask part 2
+        oCommData<= X"00000000" when "000000001",    --Setting 1 part 1
+                    X"00000000" when "000000000",    --Setting 1 part 2
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"00000000" when "010000001",    --Frame data part 1
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"00000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
                     X"00000000" when others;
 
     end generate pass;
@@ -91,14 +103,14 @@ begin
 
         --! Generate configuration
         with iWrCommAddr select
-        oCommData<= X"02010000" when "00000001",    --Setting 1 part 1: Drop in cycle 2
-                    X"00000000" when "00000000",    --Setting 1 part 2
-                    X"00000000" when "01000001",    --Setting 2 part 1
-                    X"00000000" when "01000000",    --Setting 2 part 2
-                    X"01FF0000" when "10000001",    --Frame data part 1: SoC from Master
-                    X"00000000" when "10000000",    --Frame data part 2
-                    X"FFFF0000" when "11000001",    --Frame mask part 1
-                    X"00000000" when "11000000",    --Frame mask part 2
+        oCommData<= X"02010000" when "000000001",    --Setting 1 part 1: Drop in cycle 2
+                    X"00000000" when "000000000",    --Setting 1 part 2
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"01FF0000" when "010000001",    --Frame data part 1: SoC from Master
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FFFF0000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
                     X"00000000" when others;
 
     end generate drop;
@@ -109,31 +121,82 @@ begin
 
         --! Generate configuration
         with iWrCommAddr select
-        oCommData<= X"01020100" when "00000001",    --Setting 1 part 1: Delay in cycle 1 with type 1
-                    X"000009C4" when "00000000",    --Setting 1 part 2: 2500=25.000 ns
-                    X"00000000" when "01000001",    --Setting 2 part 1
-                    X"00000000" when "01000000",    --Setting 2 part 2
-                    X"04000000" when "10000001",    --Frame data part 1: PRes
-                    X"00000000" when "10000000",    --Frame data part 2
-                    X"FF000000" when "11000001",    --Frame mask part 1
-                    X"00000000" when "11000000",    --Frame mask part 2
+        oCommData<= X"01020100" when "000000001",    --Setting 1 part 1: Delay in cycle 1 with type 1
+                    X"000009C4" when "000000000",    --Setting 1 part 2: 2500=25.000 ns
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
                     X"00000000" when others;
 
     end generate delay;
 
+    delayLine:
+    if gTestSetting="line50UsPResCycle1" generate
+
+        --! Generate configuration
+        with iWrCommAddr select
+        oCommData<= X"01020800" when "000000001",    --Setting 1 part 1: Delay in cycle 1 with type 8 (external delay line)
+                    X"00001388" when "000000000",    --Setting 1 part 2: 5000=50.000 ns
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000000" when others;
+
+    end generate delayLine;
+
+    delayLineAll:
+    if gTestSetting="line20UsPResAllCycles" generate
+
+        --! Generate configuration
+        with iWrCommAddr select
+        oCommData<= X"FF020800" when "000000001",    --Setting 1 part 1: Delay in every cycle with type 8 (external delay line)
+                    X"000007D0" when "000000000",    --Setting 1 part 2: 2000=20.000 ns
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000000" when others;
+
+    end generate delayLineAll;
+
+    delayLineFull:
+    if gTestSetting="lineFull400UsSocAllCycles" generate
+
+        --! Generate configuration
+        with iWrCommAddr select
+        oCommData<= X"FF020800" when "000000001",    --Setting 1 part 1: Delay in every cycle with type 8 (external delay line)
+                    X"00009C40" when "000000000",    --Setting 1 part 2: 40000=400.000 ns
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"01000000" when "010000001",    --Frame data part 1: SoC
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000000" when others;
+
+    end generate delayLineFull;
+
     manipulate:
     if gTestSetting="maniMtype9PResCycle2" generate
 
         --! Generate configuration
         with iWrCommAddr select
-        oCommData<= X"02040000" when "00000001",    --Setting 1 part 1: Manipulate in cycle 2
-                    X"0000000F" when "00000000",    --Setting 1 part 2: MessageType (offset 15)
-                    X"00000000" when "01000001",    --Setting 2 part 1
-                    X"00000009" when "01000000",    --Setting 2 part 2: to value "9"
-                    X"04000000" when "10000001",    --Frame data part 1: PRes
-                    X"00000000" when "10000000",    --Frame data part 2
-                    X"FF000000" when "11000001",    --Frame mask part 1
-                    X"00000000" when "11000000",    --Frame mask part 2
+        oCommData<= X"02040000" when "000000001",    --Setting 1 part 1: Manipulate in cycle 2
+                    X"0000000F" when "000000000",    --Setting 1 part 2: MessageType (offset 15)
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000009" when "001000000",    --Setting 2 part 2: to value "9"
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
                     X"00000000" when others;
 
     end generate manipulate;
@@ -144,14 +207,14 @@ begin
 
         --! Generate configuration
         with iWrCommAddr select
-        oCommData<= X"02080000" when "00000001",    --Setting 1 part 1: Distort CRC in cycle 2
-                    X"00000000" when "00000000",    --Setting 1 part 2
-                    X"00000000" when "01000001",    --Setting 2 part 1
-                    X"00000000" when "01000000",    --Setting 2 part 2
-                    X"04000000" when "10000001",    --Frame data part 1: PRes
-                    X"00000000" when "10000000",    --Frame data part 2
-                    X"FF000000" when "11000001",    --Frame mask part 1
-                    X"00000000" when "11000000",    --Frame mask part 2
+        oCommData<= X"02080000" when "000000001",    --Setting 1 part 1: Distort CRC in cycle 2
+                    X"00000000" when "000000000",    --Setting 1 part 2
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
                     X"00000000" when others;
 
     end generate crc;
@@ -161,14 +224,14 @@ begin
 
         --! Generate configuration
         with iWrCommAddr select
-        oCommData<= X"02100000" when "00000001",    --Setting 1 part 1: Cut frame in cycle 2
-                    X"00000032" when "00000000",    --Setting 1 part 2: to 50 Byte
-                    X"00000000" when "01000001",    --Setting 2 part 1
-                    X"00000000" when "01000000",    --Setting 2 part 2
-                    X"04000000" when "10000001",    --Frame data part 1: PRes
-                    X"00000000" when "10000000",    --Frame data part 2
-                    X"FF000000" when "11000001",    --Frame mask part 1
-                    X"00000000" when "11000000",    --Frame mask part 2
+        oCommData<= X"02100000" when "000000001",    --Setting 1 part 1: Cut frame in cycle 2
+                    X"00000032" when "000000000",    --Setting 1 part 2: to 50 Byte
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
                     X"00000000" when others;
 
     end generate cut;
@@ -179,14 +242,14 @@ begin
 
         --! Generate configuration
         with iWrCommAddr select
-        oCommData<= X"0381290B" when "00000001",    --Setting 1 part 1: Packet Repetition in cycle 3 at start 41 with size 11
-                    X"00020000" when "00000000",    --Setting 1 part 2: of 2 packets
-                    X"00000000" when "01000001",    --Setting 2 part 1
-                    X"00000000" when "01000000",    --Setting 2 part 2
-                    X"04000000" when "10000001",    --Frame data part 1: PRes
-                    X"00000000" when "10000000",    --Frame data part 2
-                    X"FF000000" when "11000001",    --Frame mask part 1
-                    X"00000000" when "11000000",    --Frame mask part 2
+        oCommData<= X"0381290B" when "000000001",    --Setting 1 part 1: Packet Repetition in cycle 3 at start 41 with size 11
+                    X"00020000" when "000000000",    --Setting 1 part 2: of 2 packets
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
                     X"00000000" when others;
 
     end generate safetyRep;
@@ -196,14 +259,14 @@ begin
 
         --! Generate configuration
         with iWrCommAddr select
-        oCommData<= X"0382290B" when "00000001",    --Setting 1 part 1: Packet Loss in cycle 3 at start 41 with size 11
-                    X"00020000" when "00000000",    --Setting 1 part 2: of 2 packets
-                    X"00000000" when "01000001",    --Setting 2 part 1
-                    X"00000000" when "01000000",    --Setting 2 part 2
-                    X"04000000" when "10000001",    --Frame data part 1: PRes
-                    X"00000000" when "10000000",    --Frame data part 2
-                    X"FF000000" when "11000001",    --Frame mask part 1
-                    X"00000000" when "11000000",    --Frame mask part 2
+        oCommData<= X"0382290B" when "000000001",    --Setting 1 part 1: Packet Loss in cycle 3 at start 41 with size 11
+                    X"00020000" when "000000000",    --Setting 1 part 2: of 2 packets
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
                     X"00000000" when others;
 
     end generate safetyLoss;
@@ -214,14 +277,14 @@ begin
 
         --! Generate configuration
         with iWrCommAddr select
-        oCommData<= X"0383290B" when "00000001",    --Setting 1 part 1: Packet Insertion in cycle 3 at start 41 with size 11
-                    X"00023400" when "00000000",    --Setting 1 part 2: of 2 packets and start of other packet at 52
-                    X"00000000" when "01000001",    --Setting 2 part 1
-                    X"00000000" when "01000000",    --Setting 2 part 2
-                    X"04000000" when "10000001",    --Frame data part 1: PRes
-                    X"00000000" when "10000000",    --Frame data part 2
-                    X"FF000000" when "11000001",    --Frame mask part 1
-                    X"00000000" when "11000000",    --Frame mask part 2
+        oCommData<= X"0383290B" when "000000001",    --Setting 1 part 1: Packet Insertion in cycle 3 at start 41 with size 11
+                    X"00023400" when "000000000",    --Setting 1 part 2: of 2 packets and start of other packet at 52
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
                     X"00000000" when others;
 
     end generate safetyInsertion;
@@ -232,14 +295,14 @@ begin
 
         --! Generate configuration
         with iWrCommAddr select
-        oCommData<= X"0484290B" when "00000001",    --Setting 1 part 1: Incorrect Sequence in cycle 4 at start 41 with size 11
-                    X"00020000" when "00000000",    --Setting 1 part 2: of 2 packets
-                    X"00000000" when "01000001",    --Setting 2 part 1
-                    X"00000000" when "01000000",    --Setting 2 part 2
-                    X"04000000" when "10000001",    --Frame data part 1: PRes
-                    X"00000000" when "10000000",    --Frame data part 2
-                    X"FF000000" when "11000001",    --Frame mask part 1
-                    X"00000000" when "11000000",    --Frame mask part 2
+        oCommData<= X"0484290B" when "000000001",    --Setting 1 part 1: Incorrect Sequence in cycle 4 at start 41 with size 11
+                    X"00020000" when "000000000",    --Setting 1 part 2: of 2 packets
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
                     X"00000000" when others;
 
     end generate incSeq;
@@ -249,14 +312,14 @@ begin
 
         --! Generate configuration
         with iWrCommAddr select
-        oCommData<= X"0385290B" when "00000001",    --Setting 1 part 1: Incorrect Data in cycle 3 at start 41 with size 11
-                    X"00020000" when "00000000",    --Setting 1 part 2: of 2 packets
-                    X"00000000" when "01000001",    --Setting 2 part 1
-                    X"00000000" when "01000000",    --Setting 2 part 2
-                    X"04000000" when "10000001",    --Frame data part 1: PRes
-                    X"00000000" when "10000000",    --Frame data part 2
-                    X"FF000000" when "11000001",    --Frame mask part 1
-                    X"00000000" when "11000000",    --Frame mask part 2
+        oCommData<= X"0385290B" when "000000001",    --Setting 1 part 1: Incorrect Data in cycle 3 at start 41 with size 11
+                    X"00020000" when "000000000",    --Setting 1 part 2: of 2 packets
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
                     X"00000000" when others;
 
     end generate incData;
@@ -266,33 +329,426 @@ begin
 
         --! Generate configuration
         with iWrCommAddr select
-        oCommData<= X"0386290B" when "00000001",    --Setting 1 part 1: Packet delay in cycle 3 at start 41 with size 11
-                    X"00020000" when "00000000",    --Setting 1 part 2: of 2 packets
-                    X"00000000" when "01000001",    --Setting 2 part 1
-                    X"00000000" when "01000000",    --Setting 2 part 2
-                    X"04000000" when "10000001",    --Frame data part 1: PRes
-                    X"00000000" when "10000000",    --Frame data part 2
-                    X"FF000000" when "11000001",    --Frame mask part 1
-                    X"00000000" when "11000000",    --Frame mask part 2
+        oCommData<= X"0386290B" when "000000001",    --Setting 1 part 1: Packet delay in cycle 3 at start 41 with size 11
+                    X"00020000" when "000000000",    --Setting 1 part 2: of 2 packets
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
                     X"00000000" when others;
 
     end generate paDelay;
 
+    paDelayLong:
+    if gTestSetting="safetyDelay100Start41Size11PResCycle1" generate
+
+        --! Generate configuration
+        with iWrCommAddr select
+        oCommData<= X"0186290B" when "000000001",    --Setting 1 part 1: Packet delay in cycle 1 at start 41 with size 11
+                    X"00640000" when "000000000",    --Setting 1 part 2: of 100 packets
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000000" when others;
+
+    end generate paDelayLong;
+
     paMasqu:
     if gTestSetting="safetyMasq2Start41Size11PResCycle3" generate
 
         --! Generate configuration
         with iWrCommAddr select
-        oCommData<= X"0387290B" when "00000001",    --Setting 1 part 1: Packet masquerade in cycle 3 at start 41 with size 11
-                    X"00020000" when "00000000",    --Setting 1 part 2: of 2 packets
-                    X"00000000" when "01000001",    --Setting 2 part 1
-                    X"00000000" when "01000000",    --Setting 2 part 2
-                    X"04000000" when "10000001",    --Frame data part 1: PRes
-                    X"00000000" when "10000000",    --Frame data part 2
-                    X"FF000000" when "11000001",    --Frame mask part 1
-                    X"00000000" when "11000000",    --Frame mask part 2
+        oCommData<= X"0387290B" when "000000001",    --Setting 1 part 1: Packet masquerade in cycle 3 at start 41 with size 11
+                    X"00020000" when "000000000",    --Setting 1 part 2: of 2 packets
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
                     X"00000000" when others;
 
     end generate paMasqu;
 
+
+    paDelaySlots:
+    if gTestSetting="safetyDelay3Start54Size4PResCycle2" generate
+
+        --! Generate configuration: three packets occupy a slot at the same time
+        with iWrCommAddr select
+        oCommData<= X"02863604" when "000000001",    --Setting 1 part 1: Packet delay in cycle 2 at start 54 with size 4
+                    X"00030000" when "000000000",    --Setting 1 part 2: of 3 packets
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000000" when others;
+
+    end generate paDelaySlots;
+
+    safetyLossMulti:
+    if gTestSetting="safetyLoss2Start41Size11Start54Size4PResCycle3" generate
+
+        --! Generate configuration
+        with iWrCommAddr select
+        oCommData<= X"0382290B" when "000000001",    --Setting 1 part 1: Packet Loss in cycle 3 at start 41 with size 11
+                    X"00020082" when "000000000",    --Setting 1 part 2: of 2 packets and Packet Loss of a second packet
+                    X"36040000" when "001000001",    --Setting 2 part 1: second packet at start 54 with size 4
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000000" when others;
+
+    end generate safetyLossMulti;
+
+    safetyLossContexts:
+    if gTestSetting="safetyLoss2Start41Size11Ctx2Start54Size4PResCycle3" generate
+
+        --! Generate configuration
+        with iWrCommAddr select
+        oCommData<= X"0382290B" when "000000001",    --Setting 1 part 1: Packet Loss in cycle 3 at start 41 with size 11
+                    X"00020000" when "000000000",    --Setting 1 part 2: of 2 packets
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"03823604" when "000000011",    --Task 2 setting 1 part 1: Packet Loss in cycle 3 at start 54 with size 4
+                    X"00020000" when "000000010",    --Task 2 setting 1 part 2: of 2 packets
+                    X"04FF0000" when "010000011",    --Task 2 frame data part 1: PRes to all nodes => second safety context
+                    X"FFFF0000" when "011000011",    --Task 2 frame mask part 1
+                    X"00000000" when others;
+
+    end generate safetyLossContexts;
+
+
+    ipgStretch:
+    if gTestSetting="ipg80PResCycle2" generate
+
+        --! Generate configuration
+        with iWrCommAddr select
+        oCommData<= X"02200000" when "000000001",    --Setting 1 part 1: IPG in cycle 2
+                    X"00000050" when "000000000",    --Setting 1 part 2: gap of 80 Byte
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000000" when others;
+
+    end generate ipgStretch;
+
+
+    inject:
+    if gTestSetting="inject3PResCycle2" generate
+
+        --! Generate configuration
+        with iWrCommAddr select
+        oCommData<= X"02400000" when "000000001",    --Setting 1 part 1: Inject in cycle 2 of the template at address 0
+                    X"003C0003" when "000000000",    --Setting 1 part 2: with 60 Byte, 3 copies
+                    X"000C0000" when "001000001",    --Setting 2 part 1: standard IPG of 12 Byte
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000000" when others;
+
+    end generate inject;
+
+
+    injectTemplate:
+    if gTestSetting="inject3PResCycle2Template" generate
+
+        --! Generate template frame: ASnd of node 17 with 60 Byte
+        with iWrCommAddr select
+        oCommData<= X"001E1101" when "000000000",    --Destination MAC 01-11-1E-00-00-04
+                    X"60000400" when "000000001",    --Source MAC 00-60-65-00-00-11
+                    X"11000065" when "000000010",
+                    X"FF06AB88" when "000000011",    --EtherType 88AB, ASnd to all nodes
+                    X"00000111" when "000000100",    --from node 17, ServiceID 1, zero padding
+                    X"00000000" when others;
+
+    end generate injectTemplate;
+
+
+    duplicate:
+    if gTestSetting="duplicate2PResCycle2" generate
+
+        --! Generate configuration
+        with iWrCommAddr select
+        oCommData<= X"02030000" when "000000001",    --Setting 1 part 1: Duplicate in cycle 2
+                    X"0002000C" when "000000000",    --Setting 1 part 2: 2 copies with the standard IPG of 12 Byte
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000000" when others;
+
+    end generate duplicate;
+
+
+    reorder:
+    if gTestSetting="reorder1SocCycle4" generate
+
+        --! Generate configuration
+        with iWrCommAddr select
+        oCommData<= X"04050000" when "000000001",    --Setting 1 part 1: Reorder in cycle 4
+                    X"00000001" when "000000000",    --Setting 1 part 2: behind 1 following frame
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"01000000" when "010000001",    --Frame data part 1: SoC
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000000" when others;
+
+    end generate reorder;
+
+
+    shape:
+    if gTestSetting="shape25MbitPResCycle2" generate
+
+        --! Generate configuration
+        with iWrCommAddr select
+        oCommData<= X"02061000" when "000000001",    --Setting 1 part 1: Shape in cycle 2 with the rate 0x100000 (25 Mbit/s)
+                    X"00006400" when "000000000",    --Setting 1 part 2: bucket of 100 Byte, no limit
+                    X"00000000" when "001000001",    --Setting 2 part 1: no window
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000000" when others;
+
+    end generate shape;
+
+
+    filterWindow:
+    if gTestSetting="dropWin29PResCycle3" generate
+
+        --! Generate configuration: PRes of cycle 3 has 0x2B at Byte 29, the one of cycle 4 0x3F
+        with iWrCommAddr select
+        oCommData<= X"03010000" when "000000001",    --Setting 1 part 1: Drop in cycle 3
+                    X"00000000" when "000000000",    --Setting 1 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"001D2B00" when "100000001",    --Filter window 1 part 1: 0x2B at Byte 29
+                    X"00FF0000" when "100000000",    --Filter window 1 part 2: mask of the Byte
+                    X"04010000" when "000000011",    --Task 2 setting 1 part 1: Drop in cycle 4
+                    X"00000000" when "000000010",    --Task 2 setting 1 part 2
+                    X"04000000" when "010000011",    --Task 2 frame data part 1: PRes
+                    X"00000000" when "010000010",    --Task 2 frame data part 2
+                    X"FF000000" when "011000011",    --Task 2 frame mask part 1
+                    X"00000000" when "011000010",    --Task 2 frame mask part 2
+                    X"001D2B00" when "100000011",    --Task 2 filter window 1 part 1: 0x2B at Byte 29 => no match
+                    X"00FF0000" when "100000010",    --Task 2 filter window 1 part 2: mask of the Byte
+                    X"00000000" when others;
+
+    end generate filterWindow;
+
+
+    forward:
+    if gTestSetting="forwardVlanDropPResCycle2" generate
+
+        --! Generate configuration for tbFramemanipulatorForward_stim.txt
+        with iWrCommAddr select
+        oCommData<= X"02010000" when "000000001",    --Setting 1 part 1: Drop in cycle 2
+                    X"00000000" when "000000000",    --Setting 1 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000003" when "111000100",    --Control register 4: forward all EtherTypes and parse VLAN tags
+                    X"00000000" when others;
+
+    end generate forward;
+
+
+    sparse:
+    if gTestSetting="dropSocCycle2Task4" generate
+
+        --! Generate configuration: tasks 1 to 3 are empty and skipped by their valid bit
+        with iWrCommAddr select
+        oCommData<= X"02010000" when "000000111",    --Task 4 setting 1 part 1: Drop in cycle 2
+                    X"00000000" when "000000110",    --Task 4 setting 1 part 2
+                    X"01000000" when "010000111",    --Task 4 frame data part 1: SoC
+                    X"00000000" when "010000110",    --Task 4 frame data part 2
+                    X"FF000000" when "011000111",    --Task 4 frame mask part 1
+                    X"00000000" when "011000110",    --Task 4 frame mask part 2
+                    X"00000000" when others;
+
+    end generate sparse;
+
+
+    bankSwitch:
+    if gTestSetting="bankSwitchDropSocCycle1" generate
+
+        --! Generate configuration: bank 0 has no tasks, bank 1 is selected
+        with iWrCommAddr select
+        oCommData<= X"00000001" when "111000101",    --Control register 5: select task bank 1
+                    X"00000000" when others;
+
+    end generate bankSwitch;
+
+
+    bankSwitchBank1:
+    if gTestSetting="bankSwitchDropSocCycle1Bank1" generate
+
+        --! Generate configuration of bank 1
+        with iWrCommAddr select
+        oCommData<= X"01010000" when "000000001",    --Setting 1 part 1: Drop in cycle 1
+                    X"00000000" when "000000000",    --Setting 1 part 2
+                    X"01FF0000" when "010000001",    --Frame data part 1: SoC from Master
+                    X"FFFF0000" when "011000001",    --Frame mask part 1
+                    X"00000000" when others;
+
+    end generate bankSwitchBank1;
+
+
+    chain:
+    if gTestSetting="chainDropSocCycle3" generate
+
+        --! Generate configuration: the second PRes arms the drop of the next SoC
+        with iWrCommAddr select
+        oCommData<= X"FF070000" when "000000001",    --Setting 1 part 1: Trigger in every cycle
+                    X"00000000" when "000000000",    --Setting 1 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00020200" when "110000001",    --Chain part 1: arm task 2 after 2 hits
+                    X"00000000" when "110000000",    --Chain part 2
+                    X"FF010000" when "000000011",    --Task 2 setting 1 part 1: Drop in every cycle
+                    X"00000000" when "000000010",    --Task 2 setting 1 part 2
+                    X"01000000" when "010000011",    --Task 2 frame data part 1: SoC
+                    X"00000000" when "010000010",    --Task 2 frame data part 2
+                    X"FF000000" when "011000011",    --Task 2 frame mask part 1
+                    X"00000000" when "011000010",    --Task 2 frame mask part 2
+                    X"03010000" when "110000011",    --Task 2 chain part 1: standby, disarm itself after 1 hit
+                    X"00000000" when "110000010",    --Task 2 chain part 2
+                    X"00000000" when others;
+
+    end generate chain;
+
+
+    startTrigger:
+    if gTestSetting="startTriggerDropSocCycle3" generate
+
+        --! Generate configuration: the PRes of cycle 2 starts the test, so the SoC of cycle 3 is cycle 1
+        with iWrCommAddr select
+        oCommData<= X"00090000" when "000000001",    --Setting 1 part 1: Start
+                    X"00000000" when "000000000",    --Setting 1 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"001D1700" when "100000001",    --Filter window 1 part 1: 0x17 at Byte 29
+                    X"00FF0000" when "100000000",    --Filter window 1 part 2: mask of the Byte
+                    X"01010000" when "000000011",    --Task 2 setting 1 part 1: Drop in cycle 1
+                    X"00000000" when "000000010",    --Task 2 setting 1 part 2
+                    X"01000000" when "010000011",    --Task 2 frame data part 1: SoC
+                    X"00000000" when "010000010",    --Task 2 frame data part 2
+                    X"FF000000" when "011000011",    --Task 2 frame mask part 1
+                    X"00000000" when "011000010",    --Task 2 frame mask part 2
+                    X"00000001" when "111001111",    --Control register 15: start mode trigger
+                    X"00000000" when others;
+
+    end generate startTrigger;
+
+
+    phyFault:
+    if gTestSetting="phyPre3SfdDDPResCycle2" generate
+
+        --! Generate configuration
+        with iWrCommAddr select
+        oCommData<= X"020A0303" when "000000001",    --Setting 1 part 1: PHY in cycle 2 with the faults preamble and SFD, preamble of 3 Bytes
+                    X"DD000000" when "000000000",    --Setting 1 part 2: SFD 0xDD
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000000" when others;
+
+    end generate phyFault;
+
+
+    bitError:
+    if gTestSetting="berBurst8PResAllCycles" generate
+
+        --! Generate configuration
+        with iWrCommAddr select
+        oCommData<= X"FF0BF909" when "000000001",    --Setting 1 part 1: BER in every cycle with the rate 0xF9096BBA (1.9e-3)
+                    X"6BBA0800" when "000000000",    --Setting 1 part 2: bursts of 8 dibits
+                    X"00000000" when "001000001",    --Setting 2 part 1
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000000" when others;
+
+    end generate bitError;
+
+
+    socTime:
+    if gTestSetting="socOffset1000Drift500AllCycles" generate
+
+        --! Generate configuration
+        with iWrCommAddr select
+        oCommData<= X"FF0C0300" when "000000001",    --Setting 1 part 1: SoC time in every cycle of NetTime and RelativeTime
+                    X"0003E800" when "000000000",    --Setting 1 part 2: offset 1000 ns
+                    X"000001F4" when "001000001",    --Setting 2 part 1: drift 500 ns
+                    X"00000000" when "001000000",    --Setting 2 part 2
+                    X"01000000" when "010000001",    --Frame data part 1: SoC
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000000" when others;
+
+    end generate socTime;
+
+
+    cyclePhase:
+    if gTestSetting="dropPResSlot2ASndInvited5" generate
+
+        --! Generate configuration: the MC flag of the SoC toggles in cycle 2, the SoA invites node 5 in cycles 1 and 3
+        with iWrCommAddr select
+        oCommData<= X"FF010000" when "000000001",    --Setting 1 part 1: Drop in every cycle
+                    X"00000000" when "000000000",    --Setting 1 part 2
+                    X"04000000" when "010000001",    --Frame data part 1: PRes
+                    X"00000000" when "010000000",    --Frame data part 2
+                    X"FF000000" when "011000001",    --Frame mask part 1
+                    X"00000000" when "011000000",    --Frame mask part 2
+                    X"00000000" when "110000001",    --Chain part 1
+                    X"00020000" when "110000000",    --Chain part 2: multiplexed slot 2
+                    X"FF010000" when "000000011",    --Task 2 setting 1 part 1: Drop in every cycle
+                    X"00000000" when "000000010",    --Task 2 setting 1 part 2
+                    X"06000000" when "010000011",    --Task 2 frame data part 1: ASnd
+                    X"00000000" when "010000010",    --Task 2 frame data part 2
+                    X"FF000000" when "011000011",    --Task 2 frame mask part 1
+                    X"00000000" when "011000010",    --Task 2 frame mask part 2
+                    X"00000000" when "110000011",    --Task 2 chain part 1
+                    X"02000500" when "110000010",    --Task 2 chain part 2: asynchronous phase, invited node 5
+                    X"00000000" when others;
+
+    end generate cyclePhase;
+
 end bhv;
@@ -0,0 +1,1020 @@
+/**
+********************************************************************************
+\file   fmcosim.c
+
+\brief  Firmware of the Framemanipulator within the co-simulation
+
+The file runs frameman.c on the host and forwards its register accesses to the
+Avalon slaves of the simulated Framemanipulator. The functions fmcosim_init,
+fmcosim_soc, fmcosim_request, fmcosim_writeData and fmcosim_complete are called
+by tb/avalonCosimBhv.vhd via VHPIDIRECT.
+
+The firmware runs in its own thread. Each register access blocks the thread
+until the simulation has completed the Avalon transfer, so the firmware and
+the IP-core proceed in the order of the simulated time.
+
+The scenario is taken from the environment:
+- FMCOSIM_TASKS:     Object entries SCENARIO_NAME.txt of tools/fm-scenario.sh
+- FMCOSIM_OPERATION: Operation register 0x3000/1 per SoC, e.g. "1:0x01 40:0x02",
+                     default "1:0x01" to start the series of test with the first SoC
+*******************************************************************************/
+
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+
+#include <frameman.h>
+#include <user/pdou.h>
+#include <sys/alt_dma.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+#define FMCOSIM_IDLE            0   //Access codes of fmcosim_request
+#define FMCOSIM_WRITE           1
+#define FMCOSIM_READ            2
+#define FMCOSIM_ERROR           3
+#define FMCOSIM_CONTROL         0x04
+#define FMCOSIM_BURST           0x08    //Write burst of the DMA controller
+#define FMCOSIM_ADDR_SHIFT      8
+#define FMCOSIM_COUNT_SHIFT     24      //Words of the burst
+
+#define FMCOSIM_MAX_ENTRIES     1024    //Object entries of the scenario
+#define FMCOSIM_MAX_OPERATIONS  256     //Changes of the operation register
+#define FMCOSIM_MAX_BURST       8       //Words of a burst, 2^(gTaskBurstWidth-1) of the task slave
+#define FMCOSIM_ABORT_BUSY      0x08000022  //SDO abort code of frameman.c during the upload of the image
+
+//Step of the task pointer of frameman.c, one Avalon word on the target
+#define FMCOSIM_TASK_WORD       sizeof(unsigned long)
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief  State of the firmware thread
+*/
+typedef enum
+{
+    kFmcosimRunning,    ///< Firmware is executed
+    kFmcosimAccess,     ///< Firmware waits for the completion of an access
+    kFmcosimIdle,       ///< Firmware waits for the next SoC
+    kFmcosimDma,        ///< Firmware waits for the end of the DMA transfer
+    kFmcosimError       ///< Firmware detected an error
+} tFmcosimState;
+
+/**
+\brief  Object entry of the scenario
+*/
+typedef struct
+{
+    UINT        index;      ///< Object 0x3001-0x3004, 0x3006-0x3009
+    UINT        subIndex;   ///< Task
+    uint64_t    value;      ///< Task word
+} tFmcosimEntry;
+
+/**
+\brief  Value of the operation register from a SoC on
+*/
+typedef struct
+{
+    unsigned    soc;        ///< Number of the SoC
+    BYTE        operation;  ///< Operation register 0x3000/1
+} tFmcosimOperation;
+
+/**
+\brief  Transfer of the emulated DMA controller
+
+The transfer starts, when the send and the receive request are queued.
+*/
+typedef struct
+{
+    const BYTE*         pFrom;      ///< Source of the send request
+    uintptr_t           to;         ///< Destination of the receive request
+    unsigned int        length;     ///< Bytes of the transfer
+    unsigned int        done;       ///< Bytes moved by the simulation
+    alt_txchan_done*    pfnTxDone;  ///< Callback of the send request
+    void*               pTxHandle;  ///< Handle of the send callback
+    alt_rxchan_done*    pfnRxDone;  ///< Callback of the receive request
+    void*               pRxHandle;  ///< Handle of the receive callback
+    BOOL                fSend;      ///< Send request is queued
+    BOOL                fReceive;   ///< Receive request is queued
+} tFmcosimDma;
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+static pthread_t            thread_l;
+static pthread_mutex_t      mutex_l = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t       cond_l = PTHREAD_COND_INITIALIZER;
+static tFmcosimState        state_l = kFmcosimRunning;
+static unsigned             socPending_l;
+
+static int                  accessWrite_l;
+static uintptr_t            accessAddr_l;
+static uint32_t             accessData_l;
+
+static tFmcosimEntry        aEntry_l[FMCOSIM_MAX_ENTRIES];
+static unsigned             entryCount_l;
+static tFmcosimOperation    aOperation_l[FMCOSIM_MAX_OPERATIONS];
+static unsigned             operationCount_l;
+
+static BYTE*                pControlReg_l;      //Object 0x3000 of frameman.c
+static uint64_t             readEntry_l;        //Last entry of obd_writeEntry
+
+static BYTE                 aImage_l[FRAMEMANIPULATOR_0_ST_SLAVE_TASKS_SPAN];  //Image of object 0x300A/1
+static unsigned             imageSize_l;
+static tFmcosimDma          dma_l;
+static unsigned             burstWords_l;       //Words of the running burst
+static unsigned             dmaBytes_l;         //Bytes of all DMA transfers
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+static int      loadScenario(void);
+static int      loadImage(void);
+static void     setState(tFmcosimState state_p);
+static int      waitDma(void);
+static int      uploadImage(void);
+static BOOL     isImageObject(UINT index_p);
+static void*    firmwareThread(void* pArg_p);
+
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start the firmware
+
+\return The function returns 0 or -1 at an error.
+*/
+//------------------------------------------------------------------------------
+int fmcosim_init(void)
+{
+    if (loadScenario() != 0)
+        return -1;
+
+    if (pthread_create(&thread_l, NULL, firmwareThread, NULL) != 0)
+        return -1;
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Signal the reception of a SoC
+
+\return The function returns 0.
+*/
+//------------------------------------------------------------------------------
+int fmcosim_soc(void)
+{
+    pthread_mutex_lock(&mutex_l);
+    socPending_l++;
+    pthread_cond_broadcast(&cond_l);
+    pthread_mutex_unlock(&mutex_l);
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the next access of the firmware
+
+Waits until the firmware accesses a register or waits for the next SoC. A
+queued DMA transfer is moved in bursts, while the firmware doesn't run.
+
+\return The function returns the access code with the slave and the address.
+*/
+//------------------------------------------------------------------------------
+int fmcosim_request(void)
+{
+    int ret;
+
+    pthread_mutex_lock(&mutex_l);
+
+    while ((state_l == kFmcosimRunning) || ((state_l == kFmcosimIdle) && (socPending_l != 0)) ||
+           ((state_l == kFmcosimDma) && !(dma_l.fSend && dma_l.fReceive)))
+        pthread_cond_wait(&cond_l, &mutex_l);
+
+    //the DMA controller gets the bus before the CPU
+    if (dma_l.fSend && dma_l.fReceive)
+    {
+        uintptr_t base = FRAMEMANIPULATOR_0_ST_SLAVE_TASKS_BASE;
+
+        burstWords_l = (dma_l.length - dma_l.done) / FRAMEMANIPULATOR_0_TASK_WORD_SIZE;
+        if (burstWords_l > FMCOSIM_MAX_BURST)
+            burstWords_l = FMCOSIM_MAX_BURST;
+
+        ret = FMCOSIM_WRITE | FMCOSIM_BURST | (burstWords_l << FMCOSIM_COUNT_SHIFT);
+        ret |= ((dma_l.to + dma_l.done - base) / sizeof(DWORD)) << FMCOSIM_ADDR_SHIFT;
+
+        pthread_mutex_unlock(&mutex_l);
+        return ret;
+    }
+
+    switch (state_l)
+    {
+        case kFmcosimAccess:
+        {
+            uintptr_t base = FRAMEMANIPULATOR_0_SC_SLAVE_CONTROL_BASE;
+
+            ret = accessWrite_l ? FMCOSIM_WRITE : FMCOSIM_READ;
+
+            if ((accessAddr_l >= base) && (accessAddr_l < base + FRAMEMANIPULATOR_0_SC_SLAVE_CONTROL_SPAN))
+            {
+                ret |= FMCOSIM_CONTROL | ((accessAddr_l - base) << FMCOSIM_ADDR_SHIFT);
+            }
+            else
+            {
+                base = FRAMEMANIPULATOR_0_ST_SLAVE_TASKS_BASE;
+                ret |= ((accessAddr_l - base) / FMCOSIM_TASK_WORD) << FMCOSIM_ADDR_SHIFT;
+            }
+            break;
+        }
+
+        case kFmcosimError:
+            ret = FMCOSIM_ERROR;
+            break;
+
+        default:
+            ret = FMCOSIM_IDLE;
+            break;
+    }
+
+    pthread_mutex_unlock(&mutex_l);
+
+    return ret;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the write data of the current access
+
+\return The function returns the data.
+*/
+//------------------------------------------------------------------------------
+int fmcosim_writeData(void)
+{
+    return (int)accessData_l;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the write data of the current burst
+
+\param  index_p             32 bit word of the burst
+
+\return The function returns the data.
+*/
+//------------------------------------------------------------------------------
+int fmcosim_burstData(int index_p)
+{
+    DWORD data;
+
+    memcpy(&data, dma_l.pFrom + dma_l.done + index_p * sizeof(DWORD), sizeof(data));
+
+    return (int)data;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Complete the current access
+
+The end of the last burst of a DMA transfer calls the callbacks of the requests
+like the interrupt of the DMA controller.
+
+\param  readData_p          Data of a read access
+
+\return The function returns 0.
+*/
+//------------------------------------------------------------------------------
+int fmcosim_complete(int readData_p)
+{
+    pthread_mutex_lock(&mutex_l);
+
+    if (burstWords_l != 0)
+    {
+        dma_l.done += burstWords_l * FRAMEMANIPULATOR_0_TASK_WORD_SIZE;
+        dmaBytes_l += burstWords_l * FRAMEMANIPULATOR_0_TASK_WORD_SIZE;
+        burstWords_l = 0;
+
+        if (dma_l.done == dma_l.length)
+        {
+            dma_l.fSend = FALSE;
+            dma_l.fReceive = FALSE;
+
+            if (dma_l.pfnTxDone != NULL)
+                dma_l.pfnTxDone(dma_l.pTxHandle);
+            if (dma_l.pfnRxDone != NULL)
+                dma_l.pfnRxDone(dma_l.pRxHandle, (void*)dma_l.to);
+
+            pthread_cond_broadcast(&cond_l);
+        }
+
+        pthread_mutex_unlock(&mutex_l);
+        return 0;
+    }
+
+    accessData_l = (uint32_t)readData_p;
+    state_l = kFmcosimRunning;
+    pthread_cond_broadcast(&cond_l);
+    pthread_mutex_unlock(&mutex_l);
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Register access of the firmware
+
+Called by the macros of io.h. Blocks until the access is completed by the
+simulation.
+
+\param  write_p             Write access
+\param  address_p           Address of the register
+\param  data_p              Write data
+
+\return The function returns the read data.
+*/
+//------------------------------------------------------------------------------
+uint32_t fmcosim_access(int write_p, uintptr_t address_p, uint32_t data_p)
+{
+    uint32_t data;
+
+    pthread_mutex_lock(&mutex_l);
+
+    accessWrite_l = write_p;
+    accessAddr_l = address_p;
+    accessData_l = data_p;
+    state_l = kFmcosimAccess;
+    pthread_cond_broadcast(&cond_l);
+
+    while (state_l == kFmcosimAccess)
+        pthread_cond_wait(&cond_l, &mutex_l);
+
+    data = accessData_l;
+    pthread_mutex_unlock(&mutex_l);
+
+    return data;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Link object to a variable
+
+Stores the object 0x3000 of frameman.c to set the operation register.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+tEplKernel oplk_linkObject(UINT objIndex_p, void* pVar_p, UINT* pVarEntries_p,
+                           tObdSize* pEntrySize_p, UINT firstSubindex_p)
+{
+    (void)pVarEntries_p;
+    (void)pEntrySize_p;
+    (void)firstSubindex_p;
+
+    if (objIndex_p != 0x3000)
+        return kEplInvalidParam;
+
+    pControlReg_l = (BYTE*)pVar_p;
+    return kEplSuccessful;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write object entry
+
+Stores the entry, which frameman.c has read from the task memory.
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+tEplKernel obd_writeEntry(UINT index_p, UINT subIndex_p, void* pSrcData_p, tObdSize size_p)
+{
+    (void)index_p;
+    (void)subIndex_p;
+
+    readEntry_l = 0;
+    memcpy(&readEntry_l, pSrcData_p, size_p < sizeof(readEntry_l) ? size_p : sizeof(readEntry_l));
+
+    return kEplSuccessful;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy RPDOs to the process image
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+tEplKernel pdou_copyRxPdoToPi(void)
+{
+    return kEplSuccessful;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy the process image to the TPDOs
+
+\return The function returns a tEplKernel error code.
+*/
+//------------------------------------------------------------------------------
+tEplKernel pdou_copyTxPdoFromPi(void)
+{
+    return kEplSuccessful;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Open the send channel of the DMA controller
+
+\param  name_p              Name of the DMA controller
+
+\return The function returns the channel or NULL for an unknown name.
+*/
+//------------------------------------------------------------------------------
+alt_dma_txchan alt_dma_txchan_open(const char* name_p)
+{
+    if (strcmp(name_p, DMA_0_NAME) != 0)
+        return NULL;
+
+    return (alt_dma_txchan)&dma_l;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Open the receive channel of the DMA controller
+
+\param  name_p              Name of the DMA controller
+
+\return The function returns the channel or NULL for an unknown name.
+*/
+//------------------------------------------------------------------------------
+alt_dma_rxchan alt_dma_rxchan_open(const char* name_p)
+{
+    if (strcmp(name_p, DMA_0_NAME) != 0)
+        return NULL;
+
+    return (alt_dma_rxchan)&dma_l;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set the mode of the send channel
+
+The bursts always have the word width of the task slave.
+
+\return The function returns 0.
+*/
+//------------------------------------------------------------------------------
+int alt_dma_txchan_ioctl(alt_dma_txchan dma_p, int req_p, void* pArg_p)
+{
+    (void)dma_p;
+    (void)req_p;
+    (void)pArg_p;
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set the mode of the receive channel
+
+\return The function returns 0.
+*/
+//------------------------------------------------------------------------------
+int alt_dma_rxchan_ioctl(alt_dma_rxchan dma_p, int req_p, void* pArg_p)
+{
+    (void)dma_p;
+    (void)req_p;
+    (void)pArg_p;
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free requests of the send channel
+
+\return The function returns the number of requests, which can be queued.
+*/
+//------------------------------------------------------------------------------
+int alt_dma_txchan_space(alt_dma_txchan dma_p)
+{
+    int ret;
+
+    (void)dma_p;
+
+    pthread_mutex_lock(&mutex_l);
+    ret = dma_l.fSend ? 0 : 1;
+    pthread_mutex_unlock(&mutex_l);
+
+    return ret;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Queue the send request of a transfer
+
+\return The function returns 0 or a negative errno.
+*/
+//------------------------------------------------------------------------------
+int alt_dma_txchan_send(alt_dma_txchan dma_p, const void* pFrom_p, unsigned int length_p,
+                        alt_txchan_done* pfnDone_p, void* pHandle_p)
+{
+    (void)dma_p;
+
+    if ((length_p == 0) || (length_p % FRAMEMANIPULATOR_0_TASK_WORD_SIZE != 0))
+        return -EINVAL;
+
+    pthread_mutex_lock(&mutex_l);
+
+    if (dma_l.fSend || (dma_l.fReceive && (dma_l.length != length_p)))
+    {
+        pthread_mutex_unlock(&mutex_l);
+        return dma_l.fSend ? -ENOSPC : -EINVAL;
+    }
+
+    dma_l.pFrom = (const BYTE*)pFrom_p;
+    dma_l.length = length_p;
+    dma_l.done = 0;
+    dma_l.pfnTxDone = pfnDone_p;
+    dma_l.pTxHandle = pHandle_p;
+    dma_l.fSend = TRUE;
+    pthread_cond_broadcast(&cond_l);
+
+    pthread_mutex_unlock(&mutex_l);
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Queue the receive request of a transfer
+
+\return The function returns 0 or a negative errno.
+*/
+//------------------------------------------------------------------------------
+int alt_dma_rxchan_prepare(alt_dma_rxchan dma_p, void* pData_p, unsigned int length_p,
+                           alt_rxchan_done* pfnDone_p, void* pHandle_p)
+{
+    (void)dma_p;
+
+    if ((length_p == 0) || (length_p % FRAMEMANIPULATOR_0_TASK_WORD_SIZE != 0))
+        return -EINVAL;
+
+    pthread_mutex_lock(&mutex_l);
+
+    if (dma_l.fReceive || (dma_l.fSend && (dma_l.length != length_p)))
+    {
+        pthread_mutex_unlock(&mutex_l);
+        return dma_l.fReceive ? -ENOSPC : -EINVAL;
+    }
+
+    dma_l.to = (uintptr_t)pData_p;
+    dma_l.length = length_p;
+    dma_l.done = 0;
+    dma_l.pfnRxDone = pfnDone_p;
+    dma_l.pRxHandle = pHandle_p;
+    dma_l.fReceive = TRUE;
+    pthread_cond_broadcast(&cond_l);
+
+    pthread_mutex_unlock(&mutex_l);
+
+    return 0;
+}
+
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Load the scenario from the environment
+
+\return The function returns 0 or -1 at an error.
+*/
+//------------------------------------------------------------------------------
+static int loadScenario(void)
+{
+    const char* pTasks = getenv("FMCOSIM_TASKS");
+    const char* pOperation = getenv("FMCOSIM_OPERATION");
+    char        aLine[256];
+    char*       pPos;
+    char*       pEnd;
+
+    if (pTasks != NULL)
+    {
+        FILE* pFile = fopen(pTasks, "r");
+
+        if (pFile == NULL)
+        {
+            perror(pTasks);
+            return -1;
+        }
+
+        while (fgets(aLine, sizeof(aLine), pFile) != NULL)
+        {
+            unsigned            index;
+            unsigned            subIndex;
+            unsigned            size;
+            unsigned long long  value;
+
+            if (sscanf(aLine, "%x %x %x %llx", &index, &subIndex, &size, &value) != 4)
+                continue;
+
+            if (entryCount_l == FMCOSIM_MAX_ENTRIES)
+            {
+                fprintf(stderr, "fmcosim: %s has more than %d entries\n", pTasks, FMCOSIM_MAX_ENTRIES);
+                fclose(pFile);
+                return -1;
+            }
+
+            aEntry_l[entryCount_l].index = index;
+            aEntry_l[entryCount_l].subIndex = subIndex;
+            aEntry_l[entryCount_l].value = value;
+            entryCount_l++;
+        }
+
+        fclose(pFile);
+    }
+
+    if (pOperation == NULL)
+        pOperation = "1:0x01";
+
+    strncpy(aLine, pOperation, sizeof(aLine) - 1);
+    aLine[sizeof(aLine) - 1] = '\0';
+
+    for (pPos = strtok(aLine, " "); pPos != NULL; pPos = strtok(NULL, " "))
+    {
+        if (operationCount_l == FMCOSIM_MAX_OPERATIONS)
+            return -1;
+
+        aOperation_l[operationCount_l].soc = strtoul(pPos, &pEnd, 0);
+        if (*pEnd != ':')
+        {
+            fprintf(stderr, "fmcosim: Invalid operation %s\n", pPos);
+            return -1;
+        }
+        aOperation_l[operationCount_l].operation = strtoul(pEnd + 1, NULL, 0);
+        operationCount_l++;
+    }
+
+    return loadImage();
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Load the image of object 0x300A/1 from the environment
+
+The image of FMCOSIM_IMAGE, e.g. SCENARIO_NAME.bin of tools/fm-scenario.sh,
+replaces the objects of the task memory.
+
+\return The function returns 0 or -1 at an error.
+*/
+//------------------------------------------------------------------------------
+static int loadImage(void)
+{
+    const char* pImage = getenv("FMCOSIM_IMAGE");
+    FILE*       pFile;
+
+    if ((pImage == NULL) || (*pImage == '\0'))
+        return 0;
+
+    pFile = fopen(pImage, "rb");
+    if (pFile == NULL)
+    {
+        perror(pImage);
+        return -1;
+    }
+
+    imageSize_l = fread(aImage_l, 1, sizeof(aImage_l), pFile);
+    if ((imageSize_l == 0) || (fgetc(pFile) != EOF))
+    {
+        fprintf(stderr, "fmcosim: %s is empty or exceeds %u Bytes\n", pImage, (unsigned)sizeof(aImage_l));
+        fclose(pFile);
+        return -1;
+    }
+
+    fclose(pFile);
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set the state of the firmware thread
+
+\param  state_p             New state
+*/
+//------------------------------------------------------------------------------
+static void setState(tFmcosimState state_p)
+{
+    pthread_mutex_lock(&mutex_l);
+    state_l = state_p;
+    pthread_cond_broadcast(&cond_l);
+    pthread_mutex_unlock(&mutex_l);
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wait for the end of the DMA transfer
+
+The simulation moves the bursts, while the firmware waits.
+
+\return The function returns 0 or -1, if only one channel has a request.
+*/
+//------------------------------------------------------------------------------
+static int waitDma(void)
+{
+    int ret = 0;
+
+    pthread_mutex_lock(&mutex_l);
+
+    if (dma_l.fSend != dma_l.fReceive)
+    {
+        fprintf(stderr, "fmcosim: DMA request of only one channel is queued\n");
+        ret = -1;
+    }
+    else
+    {
+        state_l = kFmcosimDma;
+        pthread_cond_broadcast(&cond_l);
+
+        while (dma_l.fSend)
+            pthread_cond_wait(&cond_l, &mutex_l);
+
+        state_l = kFmcosimRunning;
+    }
+
+    pthread_mutex_unlock(&mutex_l);
+
+    return ret;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Upload of the image like the SDO transfer of the domain 0x300A/1
+
+The image is moved by the DMA controller after the post write event. Accesses
+to single tasks have to be aborted until the end of the transfer.
+
+\return The function returns 0 or -1 at an error.
+*/
+//------------------------------------------------------------------------------
+static int uploadImage(void)
+{
+    tObdCbParam         param;
+    tObdVStringDomain   domain;
+    uint64_t            value = 0;
+
+    memset(&domain, 0, sizeof(domain));
+    domain.downloadSize = imageSize_l;
+
+    memset(&param, 0, sizeof(param));
+    param.obdEvent = kObdEvWrStringDomain;
+    param.index = 0x300A;
+    param.subIndex = 1;
+    param.pArg = &domain;
+    if ((frameman_configObdAccessCb(&param) != kEplSuccessful) || (domain.pData == NULL))
+    {
+        fprintf(stderr, "fmcosim: Image of %u Bytes is aborted with 0x%08X\n", imageSize_l, param.abortCode);
+        return -1;
+    }
+
+    memcpy(domain.pData, aImage_l, imageSize_l);
+
+    param.obdEvent = kObdEvPostWrite;
+    param.pArg = domain.pData;
+    frameman_configObdAccessCb(&param);
+
+    //the simulation doesn't run until the firmware waits => the transfer is still running
+    memset(&param, 0, sizeof(param));
+    param.obdEvent = kObdEvPreWrite;
+    param.index = 0x3001;
+    param.subIndex = 1;
+    param.pArg = &value;
+    if ((frameman_configObdAccessCb(&param) != kEplObdAccessViolation) || (param.abortCode != FMCOSIM_ABORT_BUSY))
+    {
+        fprintf(stderr, "fmcosim: Access to a task isn't aborted during the upload of the image\n");
+        return -1;
+    }
+
+    if (waitDma() != 0)
+        return -1;
+
+    if (dmaBytes_l != imageSize_l)
+    {
+        fprintf(stderr, "fmcosim: DMA moved %u Bytes of the image of %u Bytes\n", dmaBytes_l, imageSize_l);
+        return -1;
+    }
+
+    printf("fmcosim: %u Bytes of the image uploaded in bursts\n", imageSize_l);
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check for an object of the task memory
+
+\param  index_p             Index of the object
+
+\return The function returns TRUE for the objects of the image of 0x300A/1.
+*/
+//------------------------------------------------------------------------------
+static BOOL isImageObject(UINT index_p)
+{
+    switch (index_p)
+    {
+        case 0x3001:
+        case 0x3002:
+        case 0x3003:
+        case 0x3004:
+        case 0x3007:
+        case 0x3008:
+        case 0x300B:
+            return TRUE;
+
+        default:
+            return FALSE;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Thread of the firmware
+
+Initialises frameman.c, writes the tasks of the scenario via the SDO callback
+and reads them back. With FMCOSIM_IMAGE the task memory is uploaded as image.
+Afterwards frameman_syncCb is called for every SoC.
+
+\param  pArg_p              Unused
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* firmwareThread(void* pArg_p)
+{
+    tObdCbParam     param;
+    uint64_t        value;
+    unsigned        entry;
+    unsigned        soc = 0;
+    unsigned        op;
+
+    (void)pArg_p;
+
+    if (frameman_init() != kEplSuccessful)
+    {
+        fprintf(stderr, "fmcosim: frameman_init failed\n");
+        setState(kFmcosimError);
+        return NULL;
+    }
+
+    if ((imageSize_l != 0) && (uploadImage() != 0))
+    {
+        setState(kFmcosimError);
+        return NULL;
+    }
+
+    //Configure the tasks like the SDO transfer of the MN
+    for (entry = 0; entry < entryCount_l; entry++)
+    {
+        if ((imageSize_l != 0) && isImageObject(aEntry_l[entry].index))
+            continue;
+
+        value = aEntry_l[entry].value;
+
+        memset(&param, 0, sizeof(param));
+        param.obdEvent = kObdEvPreWrite;
+        param.index = aEntry_l[entry].index;
+        param.subIndex = aEntry_l[entry].subIndex;
+        param.pArg = &value;
+        frameman_configObdAccessCb(&param);
+    }
+
+    //Verify the task memory
+    for (entry = 0; entry < entryCount_l; entry++)
+    {
+        memset(&param, 0, sizeof(param));
+        param.obdEvent = kObdEvPreRead;
+        param.index = aEntry_l[entry].index;
+        param.subIndex = aEntry_l[entry].subIndex;
+        param.pArg = &value;
+        frameman_configObdAccessCb(&param);
+
+        if (readEntry_l != aEntry_l[entry].value)
+        {
+            fprintf(stderr, "fmcosim: 0x%04X/%u is 0x%016llX instead of 0x%016llX\n",
+                    param.index, param.subIndex, (unsigned long long)readEntry_l,
+                    (unsigned long long)aEntry_l[entry].value);
+            setState(kFmcosimError);
+            return NULL;
+        }
+    }
+
+    printf("fmcosim: %u task words configured\n", entryCount_l);
+
+    for (;;)
+    {
+        pthread_mutex_lock(&mutex_l);
+        state_l = kFmcosimIdle;
+        pthread_cond_broadcast(&cond_l);
+
+        while (socPending_l == 0)
+            pthread_cond_wait(&cond_l, &mutex_l);
+
+        socPending_l--;
+        state_l = kFmcosimRunning;
+        pthread_mutex_unlock(&mutex_l);
+
+        soc++;
+
+        //Operation of the PReq
+        for (op = 0; op < operationCount_l; op++)
+        {
+            if (aOperation_l[op].soc == soc)
+                pControlReg_l[0] = aOperation_l[op].operation;
+        }
+
+        frameman_syncCb();
+
+        printf("fmcosim: SoC %u operation 0x%02X status 0x%02X occupancy %u\n", soc,
+               pControlReg_l[0], pControlReg_l[1], pControlReg_l[2] | (pControlReg_l[3] << 8));
+    }
+
+    return NULL;
+}
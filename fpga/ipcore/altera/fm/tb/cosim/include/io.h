@@ -0,0 +1,64 @@
+/**
+********************************************************************************
+\file   io.h
+
+\brief  Register accesses of the Nios II for the co-simulation
+
+The file replaces the header of the target for the host build of frameman.c
+within the co-simulation.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_io_H_
+#define _INC_io_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+
+#include <stdint.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+#define IORD_32DIRECT(base, offset)         fmcosim_access(0, (uintptr_t)(base) + (offset), 0)
+#define IORD_16DIRECT(base, offset)         fmcosim_access(0, (uintptr_t)(base) + (offset), 0)
+#define IORD_8DIRECT(base, offset)          fmcosim_access(0, (uintptr_t)(base) + (offset), 0)
+#define IOWR_32DIRECT(base, offset, data)   fmcosim_access(1, (uintptr_t)(base) + (offset), (data))
+#define IOWR_16DIRECT(base, offset, data)   fmcosim_access(1, (uintptr_t)(base) + (offset), (data))
+#define IOWR_8DIRECT(base, offset, data)    fmcosim_access(1, (uintptr_t)(base) + (offset), (data))
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+uint32_t fmcosim_access(int write_p, uintptr_t address_p, uint32_t data_p);
+
+#endif
@@ -0,0 +1,80 @@
+/**
+********************************************************************************
+\file   alt_dma.h
+
+\brief  DMA channels of the Nios II HAL for the co-simulation
+
+The file replaces the header of the target for the host build of frameman.c
+within the co-simulation. The transfers are moved in bursts by the simulation.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_alt_dma_H_
+#define _INC_alt_dma_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+
+#include <stddef.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+#define ALT_DMA_SET_MODE_8      0
+#define ALT_DMA_SET_MODE_16     1
+#define ALT_DMA_SET_MODE_32     2
+#define ALT_DMA_SET_MODE_64     3
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+typedef struct alt_dma_txchan_dev_s*    alt_dma_txchan;
+typedef struct alt_dma_rxchan_dev_s*    alt_dma_rxchan;
+
+typedef void (alt_txchan_done)(void* handle);
+typedef void (alt_rxchan_done)(void* handle, void* data);
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+alt_dma_txchan alt_dma_txchan_open(const char* name);
+alt_dma_rxchan alt_dma_rxchan_open(const char* name);
+int alt_dma_txchan_ioctl(alt_dma_txchan dma, int req, void* arg);
+int alt_dma_rxchan_ioctl(alt_dma_rxchan dma, int req, void* arg);
+int alt_dma_txchan_space(alt_dma_txchan dma);
+int alt_dma_txchan_send(alt_dma_txchan dma, const void* from, unsigned int length,
+                        alt_txchan_done* done, void* handle);
+int alt_dma_rxchan_prepare(alt_dma_rxchan dma, void* data, unsigned int length,
+                           alt_rxchan_done* done, void* handle);
+
+#endif
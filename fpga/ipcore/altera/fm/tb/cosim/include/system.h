@@ -0,0 +1,56 @@
+/**
+********************************************************************************
+\file   system.h
+
+\brief  System definitions of the Nios II for the co-simulation
+
+The file replaces the header of the target for the host build of frameman.c
+within the co-simulation.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_system_H_
+#define _INC_system_H_
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//Addresses only identify the slave, the accesses are forwarded to the simulation
+#define FRAMEMANIPULATOR_0_ST_SLAVE_TASKS_BASE      0x100000
+#define FRAMEMANIPULATOR_0_ST_SLAVE_TASKS_SPAN      2048
+#define FRAMEMANIPULATOR_0_SC_SLAVE_CONTROL_BASE    0x200000
+#define FRAMEMANIPULATOR_0_SC_SLAVE_CONTROL_SPAN    32
+#define FRAMEMANIPULATOR_0_TASK_BANKS               1
+#define FRAMEMANIPULATOR_0_TASK_WORD_SIZE           8
+
+//DMA controller of the image upload, emulated by fmcosim.c
+#define DMA_0_NAME                                  "/dev/dma_0"
+
+#endif
@@ -0,0 +1,177 @@
+-------------------------------------------------------------------------------
+--! @file ethPktGenBinBhv.vhd
+--! @brief Testbench module to generate Ethernet frames from a binary stimulation file
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+--! Common library
+library libcommon;
+--! Use common library global package
+use libcommon.global.all;
+
+
+--! This is the testbench module to generate Ethernet frames from a binary stimulation file
+entity ethPktGenBin is
+    generic(
+            gDataWidth  : natural := 2  --! Data width of output port
+            );
+    port(
+        iClk        : in std_logic;                                 --! clock
+        iRst        : in std_logic;                                 --! reset
+        iSrcFile    : in string := "ethPacket.bin";                 --! Binary stimulation file
+        oTxEnable   : out std_logic;                                --! Data valid
+        oTxData     : out std_logic_vector(gDataWidth-1 downto 0);  --! Data
+        oTxDone     : out std_logic;                                --! Frame was sent
+        oStimDone   : out std_logic                                 --! End of stimulation file
+        );
+end ethPktGenBin;
+
+--! @brief ethPktGenBin architecture
+--! @details Testbench module to generate Ethernet frames from a binary stimulation file
+--! - Each frame of the file consists of the start time in ns (8 Byte), the
+--!   length (2 Byte), both little endian, and the Bytes of the frame with
+--!   preamble and CRC like the text files of ethPktGen
+--! - A frame is read at once and sent at its start time. Frames, which start
+--!   before the end of the previous one, are sent after the inter-packet gap
+--! - The file is read as file of characters, which are the Bytes of the file
+--!   with ModelSim and GHDL
+architecture bhv of ethPktGenBin is
+
+    constant cEthPacketMax  : natural := 1526;  --! Maximal frame size with preamble
+    constant cIpgBytes      : natural := 12;    --! Inter-packet gap
+
+    type tCharFile is file of character;
+    type tByteArray is array (natural range <>) of std_logic_vector(cByteLength-1 downto 0);
+    type tNaturalArray is array (natural range <>) of natural;
+
+begin
+
+    --! Read and send the frames
+    genEthPkt:
+    process
+
+        file        fp          : tCharFile;
+        variable    vFrame      : tByteArray(0 to cEthPacketMax-1);
+        variable    vLength     : natural;
+        variable    vStart      : time;
+        variable    vTime       : tNaturalArray(0 to 7);
+
+        --! Read Byte from the file
+        impure function readByte return natural is
+            variable vChar  : character;
+        begin
+            read(fp, vChar);
+            return character'pos(vChar);
+        end function;
+
+    begin
+
+        oTxEnable   <= cInactivated;
+        oTxData     <= (others => cInactivated);
+        oTxDone     <= cInactivated;
+        oStimDone   <= cInactivated;
+
+        wait until iRst = cInactivated;
+
+        file_open(fp, iSrcFile, READ_MODE);
+
+        while not endfile(fp) loop
+
+            --Header
+            for i in 0 to 7 loop
+                vTime(i)    := readByte;
+            end loop;
+
+            vStart  := 0 ns;
+            for i in 7 downto 0 loop
+                vStart  := vStart * 256 + vTime(i) * 1 ns;
+            end loop;
+
+            vLength := readByte;
+            vLength := vLength + readByte * 256;
+
+            assert vLength <= cEthPacketMax report "Frame of " & iSrcFile & " exceeds the maximal size" severity failure;
+
+            for i in 0 to vLength-1 loop
+                vFrame(i)   := std_logic_vector(to_unsigned(readByte, cByteLength));
+            end loop;
+
+            --Wait for start time
+            if now < vStart then
+                wait for vStart - now;
+            end if;
+
+            wait until rising_edge(iClk);
+
+            --Send frame, LSB first
+            for i in 0 to vLength-1 loop
+                for j in 0 to cByteLength/gDataWidth-1 loop
+                    oTxEnable   <= cActivated;
+                    oTxData     <= vFrame(i)((j+1)*gDataWidth-1 downto j*gDataWidth);
+
+                    wait until rising_edge(iClk);
+                end loop;
+            end loop;
+
+            oTxEnable   <= cInactivated;
+            oTxData     <= (others => cInactivated);
+            oTxDone     <= cActivated;
+
+            wait until rising_edge(iClk);
+
+            oTxDone     <= cInactivated;
+
+            for i in 2 to cIpgBytes*cByteLength/gDataWidth loop
+                wait until rising_edge(iClk);
+            end loop;
+
+        end loop;
+
+        file_close(fp);
+
+        oStimDone   <= cActivated;
+
+        wait;
+
+    end process genEthPkt;
+
+end bhv;
@@ -0,0 +1,163 @@
+-------------------------------------------------------------------------------
+--! @file ethPktStorageBin.vhd
+--! @brief Testbench module to store Ethernet frames in a binary file
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+--! Common library
+library libcommon;
+--! Use common library global package
+use libcommon.global.all;
+
+
+--! This is the testbench module to store Ethernet frames in a binary file
+entity ethPktStorageBin is
+    generic(
+            gFileFrameOut   : string := "out.bin"           --! Output of frame data
+            );
+    port(
+        iClk        : in std_logic;                     --! clock
+        iTestDone   : in std_logic;                     --! Test finished
+        iDataValid  : in std_logic;                     --! RMII data valid
+        iData       : in std_logic_vector(1 downto 0)   --! RMII data
+        );
+end ethPktStorageBin;
+
+--! @brief ethPktStorageBin architecture
+--! @details Testbench module to store Ethernet frames in a binary file
+--! - Storage of frames in the format of ethPktGenBin with the time of the
+--!   first Byte as start time
+--! - A frame is written at once after its end
+architecture bhv of ethPktStorageBin is
+
+    constant cEthPacketMax  : natural := 1526;  --! Maximal frame size with preamble
+
+    type tCharFile is file of character;
+    type tNaturalArray is array (natural range <>) of natural;
+
+begin
+
+
+    --! Output Ethernet stream
+    writing :
+    process
+
+        file        fOutFile    : tCharFile;
+        variable    vEthByte    : std_logic_vector(cByteLength-1 downto 0);
+        variable    vFrame      : tNaturalArray(0 to cEthPacketMax-1);
+        variable    vLength     : natural;
+        variable    vStart      : time;     --! Start time of the frame
+        variable    vUnit       : time;     --! Value of the current Byte of the start time
+        variable    vStartByte  : tNaturalArray(0 to 7);
+
+    begin
+
+        file_open(fOutFile, gFileFrameOut, WRITE_MODE);
+
+        while iTestDone/='1' loop
+
+            if iDataValid='1' then
+
+                vStart  := now;
+                vLength := 0;
+
+                while iDataValid='1' loop
+
+                    vEthByte(1 downto 0)    := iData;
+
+                    wait until rising_edge(iClk);
+
+                    vEthByte(3 downto 2)    := iData;
+
+                    wait until rising_edge(iClk);
+
+                    vEthByte(5 downto 4)    := iData;
+
+                    wait until rising_edge(iClk);
+
+                    vEthByte(7 downto 6)    := iData;
+
+                    wait until rising_edge(iClk);
+
+                    if vLength < cEthPacketMax then
+                        vFrame(vLength) := to_integer(unsigned(vEthByte));
+                        vLength         := vLength+1;
+                    end if;
+
+                end loop;
+
+                --Start time in ns of 8 Byte, from the highest Byte within the range of time
+                vStartByte  := (others => 0);
+                for i in 5 downto 0 loop
+                    vUnit   := 1 ns;
+                    for j in 1 to i loop
+                        vUnit   := vUnit * 256;
+                    end loop;
+
+                    vStartByte(i)   := vStart / vUnit;
+                    vStart          := vStart - vStartByte(i) * vUnit;
+                end loop;
+
+                for i in 0 to 7 loop
+                    write(fOutFile, character'val(vStartByte(i) mod 256));
+                end loop;
+
+                write(fOutFile, character'val(vLength mod 256));
+                write(fOutFile, character'val(vLength / 256));
+
+                for i in 0 to vLength-1 loop
+                    write(fOutFile, character'val(vFrame(i)));
+                end loop;
+
+            else
+                wait until rising_edge(iClk) or iTestDone='1';
+
+            end if;
+        end loop;
+
+        file_close(fOutFile);
+
+        wait;
+
+    end process writing;
+
+end bhv;
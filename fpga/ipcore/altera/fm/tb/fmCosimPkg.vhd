@@ -0,0 +1,117 @@
+-------------------------------------------------------------------------------
+--! @file fmCosimPkg.vhd
+--! @brief Interface to the firmware of the co-simulation
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+--! This is the package with the interface to the firmware of the co-simulation
+--! @details The functions are implemented by tb/cosim/fmcosim.c and linked
+--! via VHPIDIRECT of GHDL. The bodies are only used, when the library isn't
+--! linked to the simulation.
+package fmCosimPkg is
+
+    --! Access codes of fmCosimRequest
+    constant cCosimIdle     : natural := 0;     --! No access of the firmware
+    constant cCosimWrite    : natural := 1;     --! Write access
+    constant cCosimRead     : natural := 2;     --! Read access
+    constant cCosimError    : natural := 3;     --! Firmware detected an error
+
+    --! Start the firmware with frameman_init and the configuration of the tasks
+    impure function fmCosimInit return integer;
+    attribute foreign of fmCosimInit : function is "VHPIDIRECT fmcosim_init";
+
+    --! Call frameman_syncCb for a received SoC
+    impure function fmCosimSoc return integer;
+    attribute foreign of fmCosimSoc : function is "VHPIDIRECT fmcosim_soc";
+
+    --! Get next access: access code (bit 1-0), slave (bit 2, '1' for control), DMA burst (bit 3),
+    --! address of 32 bit words (bit 23-8), words of the burst (bit 30-24)
+    impure function fmCosimRequest return integer;
+    attribute foreign of fmCosimRequest : function is "VHPIDIRECT fmcosim_request";
+
+    --! Get write data of the current access
+    impure function fmCosimWriteData return integer;
+    attribute foreign of fmCosimWriteData : function is "VHPIDIRECT fmcosim_writeData";
+
+    --! Get write data of a 32 bit word of the current burst
+    impure function fmCosimBurstData(iIndex : integer) return integer;
+    attribute foreign of fmCosimBurstData : function is "VHPIDIRECT fmcosim_burstData";
+
+    --! Complete the current access with the read data
+    impure function fmCosimComplete(iReadData : integer) return integer;
+    attribute foreign of fmCosimComplete : function is "VHPIDIRECT fmcosim_complete";
+
+end fmCosimPkg;
+
+
+package body fmCosimPkg is
+
+    impure function fmCosimInit return integer is
+    begin
+        assert false report "VHPIDIRECT fmcosim_init isn't linked" severity failure;
+        return 0;
+    end function;
+
+    impure function fmCosimSoc return integer is
+    begin
+        assert false report "VHPIDIRECT fmcosim_soc isn't linked" severity failure;
+        return 0;
+    end function;
+
+    impure function fmCosimRequest return integer is
+    begin
+        assert false report "VHPIDIRECT fmcosim_request isn't linked" severity failure;
+        return 0;
+    end function;
+
+    impure function fmCosimWriteData return integer is
+    begin
+        assert false report "VHPIDIRECT fmcosim_writeData isn't linked" severity failure;
+        return 0;
+    end function;
+
+    impure function fmCosimBurstData(iIndex : integer) return integer is
+    begin
+        assert false report "VHPIDIRECT fmcosim_burstData isn't linked" severity failure;
+        return 0;
+    end function;
+
+    impure function fmCosimComplete(iReadData : integer) return integer is
+    begin
+        assert false report "VHPIDIRECT fmcosim_complete isn't linked" severity failure;
+        return 0;
+    end function;
+
+end fmCosimPkg;
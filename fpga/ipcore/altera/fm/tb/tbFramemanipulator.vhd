@@ -66,7 +66,10 @@ entity tbFramemanipulator is
             gFileFrameOutStim   : string := "outStim.txt";          --! Output of stimulation file
             gFileFrameOutFm     : string := "outFm.txt";            --! Output of stimulation file
             gFileFrameOutTiming : string := "outTiming.txt";        --! Output of frame delay
-            gTestSetting        : string := "passTest"              --! Task configuration
+            gTestSetting        : string := "passTest";             --! Task configuration
+            gTaskBanks          : natural := 1;                     --! Number of task banks, the bank b>0 is configured with gTestSetting & "Bank" & b
+            gExtDelayLine       : natural := 0;                     --! External delay line with the memory model
+            gLineAddr           : natural := 16                     --! Address width of the delay line in Byte
             );
 end tbFramemanipulator;
 
@@ -77,14 +80,39 @@ end tbFramemanipulator;
 --!   separate files. The data is allocated to bash-variables
 --! - Testbench won't stop in case of an error
 --! - The module check will be processed in the shell post script afterwards
+--! - With gTaskBanks>1 the frames start later, until the configuration of all banks is written
+--! - The external delay line uses the SDRAM model avalonMemBhv.vhd
+--! - At the end the status register with the error flags is read and stored with the frame delay
 architecture bhv of tbFramemanipulator is
 
     constant cPeriode   : time := 20 ns;     -- used 50 MHz clock cycle FM/RMII-clock
+    constant cBankAddr  : natural := 9;                             --! Address width of a task bank
+    constant cTaskAddr  : natural := cBankAddr+LogDualis(gTaskBanks);   --! Address width of all task banks
 
-    signal wrCommAddr   : std_logic_vector(7 downto 0) := (others => '0');  --! Write address of task-buffer
+    --! Typedef for the configuration of the banks
+    type tBankData is array (gTaskBanks-1 downto 0) of std_logic_vector(31 downto 0);
+
+    signal wrCommAddr   : std_logic_vector(cTaskAddr-1 downto 0) := (others => '0');  --! Write address of task-buffer
     signal commData     : std_logic_vector(31 downto 0) := (others => '0'); --! data of task-buffer
+    signal bankData     : tBankData;                                        --! data of the task banks
     signal writeEn      : std_logic;                                        --! write enable
 
+    signal wrCtrlAddr   : std_logic_vector(4 downto 0) := (others => '0');  --! Write address of the control register
+    signal ctrlCommAddr : std_logic_vector(8 downto 0);                     --! Address of the control register configuration
+    signal ctrlData     : std_logic_vector(31 downto 0);                    --! Control register configuration
+    signal scWriteData  : std_logic_vector(7 downto 0);                     --! Written Byte of the control register
+    signal scAddr       : std_logic_vector(4 downto 0);                     --! Address of the control register
+    signal scWrite      : std_logic;                                        --! Write of the control register
+    signal scReadData   : std_logic_vector(7 downto 0);                     --! Data of the control register
+
+    signal statusRd     : std_logic;                                        --! Read of the status register
+    signal statusValid  : std_logic;                                        --! Status register is valid
+    signal status       : std_logic_vector(7 downto 0);                     --! Status register with the error flags
+
+    signal wrInjectAddr : std_logic_vector(7 downto 0) := (others => '0');  --! Write address of the template memory
+    signal injectData   : std_logic_vector(31 downto 0);                    --! Template frame data of the address
+    signal injectWrEn   : std_logic;                                        --! write enable of the template memory
+
     signal clk      : std_logic := '0'; --! 50 MHz clock
     signal reset    : std_logic := '1'; --! reset
     signal testDone : std_logic;        --! test finished
@@ -97,6 +125,14 @@ architecture bhv of tbFramemanipulator is
     signal TXD  : std_logic_vector(1 downto 0);                     --! RMII data from FM
     signal LED  : std_logic_vector(1 downto 0);                     --! FM LED output
 
+    signal mAddress         : std_logic_vector(31 downto 0);    --! Delay line master address
+    signal mWrite           : std_logic;                        --! Delay line master write enable
+    signal mWritedata       : std_logic_vector(31 downto 0);    --! Delay line master data write
+    signal mRead            : std_logic;                        --! Delay line master read enable
+    signal mReaddata        : std_logic_vector(31 downto 0);    --! Delay line master read data
+    signal mWaitrequest     : std_logic;                        --! Delay line master wait request
+    signal mReaddatavalid   : std_logic;                        --! Delay line master read data valid
+
 begin
 
 
@@ -115,11 +151,14 @@ begin
 
         testDone    <= '0';
         trig        <= '0';
+        statusRd    <= '0';
+        statusValid <= '0';
+        status      <= (others=>'0');
 
         wait until reset='0';
 
-        -- Delay to transfer the Framemanipulator configuration
-        wait for 10000 ns;
+        -- Delay to transfer the Framemanipulator configuration of all banks
+        wait for gTaskBanks*10000 ns;
 
         while stimDone/= '1' loop
 
@@ -138,6 +177,19 @@ begin
         -- Complete all manipulation tasks before simulation is done
         wait for 50000 ns;
 
+        --Read status register with the error flags
+        statusRd    <= '1';
+
+        wait until rising_edge(clk);
+        wait until rising_edge(clk);
+
+        status      <= scReadData;
+        statusValid <= '1';
+        statusRd    <= '0';
+
+        wait until rising_edge(clk);
+
+        statusValid <= '0';
         testDone    <= '1';
 
         wait;
@@ -149,7 +201,14 @@ begin
 
     --! DUT
     FM : entity work.FrameManipulator
-    generic map(gBytesOfTheFrameBuffer=>1600)
+    generic map(
+                gBytesOfTheFrameBuffer  => 1600,
+                gTaskBytesPerWord       => 4,   --32 bit words of configurateFmBhv
+                gTaskAddr               => cTaskAddr,
+                gTaskBanks              => gTaskBanks,
+                gExtDelayLine           => gExtDelayLine,
+                gLineAddr               => gLineAddr
+                )
     port map(
             iClk50          => clk,
             iReset          => reset,
@@ -161,19 +220,58 @@ begin
             iSt_write       => writeEn,
             iSt_read        => '0',
             iSt_byteenable  => "1111",
-            iSc_address     => "0",
-            iSc_writedata   => X"01",
-            iSc_write       => '1',
-            iSc_read        => '0',
+            iSc_address     => scAddr,
+            iSc_writedata   => scWriteData,
+            iSc_write       => scWrite,
+            iSc_read        => statusRd,
             iSc_byteenable  => "1",
+            iSi_address     => wrInjectAddr,
+            iSi_writedata   => injectData,
+            iSi_write       => injectWrEn,
+            iSi_read        => '0',
+            iSi_byteenable  => "1111",
             oSt_readdata    => open,
-            oSc_readdata    => open,
+            oSc_readdata    => scReadData,
+            oSi_readdata    => open,
             oTXData         => TXD,
             oTXDV           => TXDV,
-            oLED            => LED
+            oLED            => LED,
+            oM_address      => mAddress,
+            oM_write        => mWrite,
+            oM_writedata    => mWritedata,
+            oM_read         => mRead,
+            iM_readdata     => mReaddata,
+            iM_waitrequest  => mWaitrequest,
+            iM_readdatavalid => mReaddatavalid
             );
 
 
+    --! SDRAM of the external delay line
+    genMem:
+    if gExtDelayLine/=0 generate
+        Mem : entity work.avalonMem
+        generic map(gAddrWidth  => gLineAddr)
+        port map(
+                iClk            => clk,
+                iReset          => reset,
+                iAddress        => mAddress,
+                iWrite          => mWrite,
+                iWritedata      => mWritedata,
+                iRead           => mRead,
+                oReaddata       => mReaddata,
+                oWaitrequest    => mWaitrequest,
+                oReaddatavalid  => mReaddatavalid
+                );
+    end generate genMem;
+
+    genNoMem:
+    if gExtDelayLine=0 generate
+        mReaddata       <= (others=>'0');
+        mWaitrequest    <= '0';
+        mReaddatavalid  <= '0';
+    end generate genNoMem;
+
+
     --! Ethernet packet generator
     packGen : entity work.ethPktGen
     generic map(gDataWidth  => 2)
@@ -189,15 +287,52 @@ begin
             );
 
 
-    --! Generate configuration
+    --! Generate configuration of bank 0
     Conv : entity work.configurateFm
     generic map(gTestSetting    => gTestSetting)
     port map(
-            iWrCommAddr => wrCommAddr,
-            oCommData   => commData
+            iWrCommAddr => wrCommAddr(cBankAddr-1 downto 0),
+            oCommData   => bankData(0)
+            );
+
+
+    --! Generate configuration of the further banks
+    genBank:
+    for b in 1 to gTaskBanks-1 generate
+
+        ConvBank : entity work.configurateFm
+        generic map(gTestSetting    => gTestSetting & "Bank" & integer'image(b))
+        port map(
+                iWrCommAddr => wrCommAddr(cBankAddr-1 downto 0),
+                oCommData   => bankData(b)
+                );
+
+    end generate genBank;
+
+
+    --! The bank is the upper part of the address
+    commData    <= bankData(to_integer(unsigned(wrCommAddr)) / 2**cBankAddr);
+
+
+
+    --! Generate configuration of the control register
+    ConvCtrl : entity work.configurateFm
+    generic map(gTestSetting    => gTestSetting)
+    port map(
+            iWrCommAddr => ctrlCommAddr,
+            oCommData   => ctrlData
             );
 
 
+    ctrlCommAddr    <= "1110" & wrCtrlAddr;
+
+    --! Operation start at address 0, configuration of the other registers
+    scWriteData     <= X"01" when wrCtrlAddr=(wrCtrlAddr'range=>'0') else ctrlData(7 downto 0);
+
+    --! The status register is read at the end of the test instead of writing the configuration
+    scAddr          <= "00001" when statusRd='1' else wrCtrlAddr;
+    scWrite         <= not statusRd;
+
 
     --! Generate configuration
     genAddr:
@@ -223,6 +358,68 @@ begin
     end process;
 
 
+    --! Generate template frames of the inject task
+    ConvInject : entity work.configurateFm
+    generic map(gTestSetting    => gTestSetting & "Template")
+    port map(
+            iWrCommAddr => '0' & wrInjectAddr,
+            oCommData   => injectData
+            );
+
+
+    --! Write the template memory
+    genInjectAddr:
+    process
+    begin
+        wrInjectAddr    <= (others=>'0');
+        injectWrEn      <= '1';
+
+        wait until reset='0';
+
+        while wrInjectAddr/= (wrInjectAddr'range=>'1') loop
+
+            wait until rising_edge(clk);
+
+            wrInjectAddr    <= std_logic_vector(unsigned(wrInjectAddr)+1);
+
+        end loop;
+
+        wait until rising_edge(clk);
+
+        injectWrEn      <= '0';
+
+        wait;
+
+    end process;
+
+
+    --! @brief Configuration of the control register
+    --! - Writes the configuration of the addresses 1 to 31 once
+    --! - Afterwards the start operation is written to address 0
+    genCtrlAddr:
+    process
+    begin
+        wrCtrlAddr  <= std_logic_vector(to_unsigned(1, wrCtrlAddr'length));
+
+        wait until reset='0';
+
+        while wrCtrlAddr/= (wrCtrlAddr'range=>'1') loop
+
+            wait until rising_edge(clk);
+
+            wrCtrlAddr  <= std_logic_vector(unsigned(wrCtrlAddr)+1);
+
+        end loop;
+
+        wait until rising_edge(clk);
+
+        wrCtrlAddr  <= (others=>'0');
+
+        wait;
+
+    end process;
+
+
     --! Output input data
     writingStim : entity work.ethPktStorage
     generic map(
@@ -251,7 +448,7 @@ begin
             );
 
 
-    --! Measure frame delay and the gap between the outgoing frames
+    --! Measure frame delay and the gap between the outgoing frames, store the status register at the end
     writingTiming :
     process
 
@@ -317,6 +514,16 @@ begin
 
             end if;
 
+            --Store the status register at the end of the test
+            if statusValid='1' then
+
+                write(vLineData, string'("FM_STATUS=") );
+                write(vLineData, to_integer(unsigned(status)) );
+
+                writeline(fOutFile, vLineData);
+
+            end if;
+
             --Reset gap at end of frame
             if TXDV='0' and vTXDV_reg='1' then
                 vTimeGap    := 0 ns;
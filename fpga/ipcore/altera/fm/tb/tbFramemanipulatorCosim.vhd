@@ -0,0 +1,304 @@
+-------------------------------------------------------------------------------
+--! @file tbFramemanipulatorCosim.vhd
+--! @brief Testbench of the Framemanipulator with the firmware in co-simulation
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+--! use work library
+library work;
+
+--! Common library
+library libcommon;
+--! Use common library global package
+use libcommon.global.all;
+
+
+--! This is the testbench of Framemanipulator IP-core with the firmware in co-simulation
+entity tbFramemanipulatorCosim is
+    generic(gStimIn             : string := "stimEthPacket.txt";    --! Stimulation file in
+            gFileFrameOutStim   : string := "outStim.txt";          --! Output of stimulation file
+            gFileFrameOutFm     : string := "outFm.txt";            --! Output of stimulation file
+            gBinary             : boolean := false                  --! Stimulation and output files of ethPktGenBin
+            );
+end tbFramemanipulatorCosim;
+
+--! @brief tbFramemanipulatorCosim architecture
+--! @details Testbench for Framemanipulator IP-core with the firmware in co-simulation
+--! - Testbench creates Ethernet stream from stimulation file
+--! - The tasks and operations are transfered by frameman.c via the Avalon slaves.
+--!   The scenario is set by the environment of tb/cosim/fmcosim.c
+--! - Stimulated data stream and output stream will be stored in separate files
+--! - With gBinary the files have the binary format of ethPktGenBin. The frames are
+--!   sent at their start time instead of the trigger
+architecture bhv of tbFramemanipulatorCosim is
+
+    constant cPeriode   : time := 20 ns;     -- used 50 MHz clock cycle FM/RMII-clock
+
+    signal st_address   : std_logic_vector(7 downto 0);     --! Task avalon slave address
+    signal st_writedata : std_logic_vector(63 downto 0);    --! Task avalon slave data write
+    signal st_write     : std_logic;                        --! Task avalon slave write enable
+    signal st_read      : std_logic;                        --! Task avalon slave read enable
+    signal st_readdata  : std_logic_vector(63 downto 0);    --! Task avalon slave read data
+    signal st_rdvalid   : std_logic;                        --! Task avalon slave read data valid
+    signal st_byteen    : std_logic_vector(7 downto 0);     --! Task avalon slave byte enable
+    signal st_burstcnt  : std_logic_vector(3 downto 0);     --! Task avalon slave burst count
+    signal st_waitreq   : std_logic;                        --! Task avalon slave wait request
+    signal sc_address   : std_logic_vector(4 downto 0);     --! FM-control avalon slave address
+    signal sc_writedata : std_logic_vector(7 downto 0);     --! FM-control avalon slave data write
+    signal sc_write     : std_logic;                        --! FM-control avalon slave write enable
+    signal sc_read      : std_logic;                        --! FM-control avalon slave read enable
+    signal sc_readdata  : std_logic_vector(7 downto 0);     --! FM-control avalon slave read data
+    signal sc_byteen    : std_logic_vector(0 downto 0);     --! FM-control avalon slave byte enable
+
+    signal clk      : std_logic := '0'; --! 50 MHz clock
+    signal reset    : std_logic := '1'; --! reset
+    signal testDone : std_logic;        --! test finished
+    signal stimDone : std_logic;        --! end of stimulation file
+    signal trig     : std_logic;        --! trigger of the next frame
+
+    signal RXDV : std_logic := '0';                                 --! RMII data valid to FM
+    signal RXD  : std_logic_vector(1 downto 0) := (others => '0');  --! RMII data to FM
+    signal TXDV : std_logic;                                        --! RMII data valid from FM
+    signal TXD  : std_logic_vector(1 downto 0);                     --! RMII data from FM
+    signal LED  : std_logic_vector(1 downto 0);                     --! FM LED output
+
+begin
+
+
+    clk     <= not clk after cPeriode/2 when testDone /= '1' else '0' after cPeriode/2;
+
+    reset   <= '1', '0' after 50 ns;
+
+
+    --! Start of next frame every 10µs
+    newFrame:
+    process
+    begin
+
+        testDone    <= '0';
+        trig        <= '0';
+
+        wait until reset='0';
+
+        -- Delay to transfer the Framemanipulator configuration by the firmware
+        wait for 50000 ns;
+
+        while stimDone/= '1' loop
+
+            trig    <= '1';
+
+            wait for 20 ns;
+
+            trig    <= '0';
+
+            wait for 10000 ns;
+
+        end loop;
+
+        -- Complete all manipulation tasks before simulation is done
+        wait for 50000 ns;
+
+        testDone    <= '1';
+
+        wait;
+
+    end process;
+
+
+    --! DUT
+    FM : entity work.FrameManipulator
+    generic map(gBytesOfTheFrameBuffer=>1600)
+    port map(
+            iClk50          => clk,
+            iReset          => reset,
+            iS_clk          => clk,
+            iRXDV           => RXDV,
+            iRXD            => RXD,
+            iSt_address     => st_address,
+            iSt_writedata   => st_writedata,
+            iSt_write       => st_write,
+            iSt_read        => st_read,
+            iSt_byteenable  => st_byteen,
+            iSt_burstcount  => st_burstcnt,
+            oSt_waitrequest => st_waitreq,
+            iSc_address     => sc_address,
+            iSc_writedata   => sc_writedata,
+            iSc_write       => sc_write,
+            iSc_read        => sc_read,
+            iSc_byteenable  => sc_byteen,
+            iSi_address     => (others=>'0'),
+            iSi_writedata   => (others=>'0'),
+            iSi_write       => '0',
+            iSi_read        => '0',
+            iSi_byteenable  => "0000",
+            oSt_readdata    => st_readdata,
+            oSt_readdatavalid => st_rdvalid,
+            oSc_readdata    => sc_readdata,
+            oSi_readdata    => open,
+            oTXData         => TXD,
+            oTXDV           => TXDV,
+            oLED            => LED
+            );
+
+
+    --! Ethernet packet generator
+    genText:
+    if not gBinary generate
+
+        packGen : entity work.ethPktGen
+        generic map(gDataWidth  => 2)
+        port map(
+                iClk        => clk,
+                iRst        => reset,
+                iTrigTx     => trig,
+                iSrcFile    => gStimIn,
+                oTxEnable   => RXDV,
+                oTxData     => RXD,
+                oTxDone     => open,
+                oStimDone   => stimDone
+                );
+
+    end generate genText;
+
+
+    --! Ethernet packet generator of binary stimulation file
+    genBinary:
+    if gBinary generate
+
+        packGen : entity work.ethPktGenBin
+        generic map(gDataWidth  => 2)
+        port map(
+                iClk        => clk,
+                iRst        => reset,
+                iSrcFile    => gStimIn,
+                oTxEnable   => RXDV,
+                oTxData     => RXD,
+                oTxDone     => open,
+                oStimDone   => stimDone
+                );
+
+    end generate genBinary;
+
+
+    --! Firmware frameman.c
+    Firmware : entity work.avalonCosim
+    port map(
+            iClk            => clk,
+            iReset          => reset,
+            iRXDV           => RXDV,
+            iRXD            => RXD,
+            oSt_address     => st_address,
+            oSt_writedata   => st_writedata,
+            oSt_write       => st_write,
+            oSt_read        => st_read,
+            iSt_readdata    => st_readdata,
+            iSt_readdatavalid => st_rdvalid,
+            oSt_byteenable  => st_byteen,
+            oSt_burstcount  => st_burstcnt,
+            iSt_waitrequest => st_waitreq,
+            oSc_address     => sc_address,
+            oSc_writedata   => sc_writedata,
+            oSc_write       => sc_write,
+            oSc_read        => sc_read,
+            iSc_readdata    => sc_readdata,
+            oSc_byteenable  => sc_byteen
+            );
+
+
+    --! Output input and FM data
+    storeText:
+    if not gBinary generate
+
+        writingStim : entity work.ethPktStorage
+        generic map(
+                    gVariableName   => "FRAME",
+                    gFileFrameOut   => gFileFrameOutStim
+                    )
+        port map(
+                iClk        => clk,
+                iTestDone   => testDone,
+                iDataValid  => RXDV,
+                iData       => RXD
+                );
+
+        writingTx : entity work.ethPktStorage
+        generic map(
+                    gVariableName   => "FM_FRAME",
+                    gFileFrameOut   => gFileFrameOutFm
+                    )
+        port map(
+                iClk        => clk,
+                iTestDone   => testDone,
+                iDataValid  => TXDV,
+                iData       => TXD
+                );
+
+    end generate storeText;
+
+
+    --! Output input and FM data in binary files
+    storeBinary:
+    if gBinary generate
+
+        writingStim : entity work.ethPktStorageBin
+        generic map(gFileFrameOut   => gFileFrameOutStim)
+        port map(
+                iClk        => clk,
+                iTestDone   => testDone,
+                iDataValid  => RXDV,
+                iData       => RXD
+                );
+
+        writingTx : entity work.ethPktStorageBin
+        generic map(gFileFrameOut   => gFileFrameOutFm)
+        port map(
+                iClk        => clk,
+                iTestDone   => testDone,
+                iDataValid  => TXDV,
+                iData       => TXD
+                );
+
+    end generate storeBinary;
+
+
+end bhv;
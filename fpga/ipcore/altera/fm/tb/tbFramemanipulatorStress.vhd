@@ -0,0 +1,340 @@
+-------------------------------------------------------------------------------
+--! @file tbFramemanipulatorStress.vhd
+--! @brief Line-rate stress testbench of the Framemanipulator
+-------------------------------------------------------------------------------
+--
+--    (c) B&R, 2014
+--
+--    Redistribution and use in source and binary forms, with or without
+--    modification, are permitted provided that the following conditions
+--    are met:
+--
+--    1. Redistributions of source code must retain the above copyright
+--       notice, this list of conditions and the following disclaimer.
+--
+--    2. Redistributions in binary form must reproduce the above copyright
+--       notice, this list of conditions and the following disclaimer in the
+--       documentation and/or other materials provided with the distribution.
+--
+--    3. Neither the name of B&R nor the names of its
+--       contributors may be used to endorse or promote products derived
+--       from this software without prior written permission. For written
+--       permission, please contact office@br-automation.com
+--
+--    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+--    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+--    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+--    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+--    COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+--    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+--    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+--    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+--    CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+--    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+--    ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+--    POSSIBILITY OF SUCH DAMAGE.
+--
+-------------------------------------------------------------------------------
+
+
+--! Use standard ieee library
+library ieee;
+--! Use logic elements
+use ieee.std_logic_1164.all;
+--! Use numeric functions
+use ieee.numeric_std.all;
+
+--! Use std library
+library std;
+--! Use text functions
+use std.textio.all;
+
+--! use work library
+library work;
+
+--! Common library
+library libcommon;
+--! Use common library global package
+use libcommon.global.all;
+
+
+--! This is the line-rate stress testbench of the Framemanipulator
+entity tbFramemanipulatorStress is
+    generic(gStimIn                 : string := "stress.bin";       --! Binary stimulation file of fm-stimbin.sh
+            gFileResult             : string := "stressResult.txt"; --! Result of the run, appended as line
+            gTestSetting            : string := "passTest";         --! Task configuration of configurateFm
+            gFrameSize              : natural := 64;                --! Frame size of the stimulation for the report
+            gIpg                    : natural := 12;                --! Inter-packet gap of the stimulation for the report
+            gBurst                  : natural := 10;                --! Frames per cycle of the stimulation for the report
+            gBytesOfTheFrameBuffer  : natural := 1600;              --! Frame buffer size
+            gBytesOfThePackBuffer   : natural := 16000;             --! Packet buffer size
+            gNumberOfPackets        : natural := 500;               --! Maximal number of safety packets
+            gExtDelayLine           : natural := 0;                 --! External delay line with the memory model
+            gLineAddr               : natural := 16                 --! Address width of the delay line in Byte
+            );
+end tbFramemanipulatorStress;
+
+--! @brief tbFramemanipulatorStress architecture
+--! @details Line-rate stress testbench of the Framemanipulator
+--! - The binary stimulation sends bursts of frames with the given gap
+--! - The incoming and outgoing frames are counted and the status register is
+--!   read at the end of the stimulation
+--! - One line with the stimulation, the generics and the result is appended to
+--!   gFileResult. The report is created in the shell post script afterwards
+--! - The external delay line uses the SDRAM model avalonMemBhv.vhd
+architecture bhv of tbFramemanipulatorStress is
+
+    constant cPeriode   : time := 20 ns;     -- used 50 MHz clock cycle FM/RMII-clock
+
+    signal wrCommAddr   : std_logic_vector(8 downto 0) := (others => '0');  --! Write address of task-buffer
+    signal commData     : std_logic_vector(31 downto 0) := (others => '0'); --! data of task-buffer
+    signal writeEn      : std_logic;                                        --! write enable
+
+    signal scAddr       : std_logic_vector(4 downto 0);     --! Address of the control register
+    signal scWrite      : std_logic;                        --! Write of the control register
+    signal scRead       : std_logic;                        --! Read of the control register
+    signal scReadData   : std_logic_vector(7 downto 0);     --! Data of the control register
+
+    signal clk      : std_logic := '0'; --! 50 MHz clock
+    signal reset    : std_logic := '1'; --! reset
+    signal testDone : std_logic;        --! test finished
+    signal stimDone : std_logic;        --! end of stimulation file
+
+    signal RXDV : std_logic := '0';                                 --! RMII data valid to FM
+    signal RXD  : std_logic_vector(1 downto 0) := (others => '0');  --! RMII data to FM
+    signal TXDV : std_logic;                                        --! RMII data valid from FM
+    signal TXD  : std_logic_vector(1 downto 0);                     --! RMII data from FM
+    signal LED  : std_logic_vector(1 downto 0);                     --! FM LED output
+
+    signal mAddress         : std_logic_vector(31 downto 0);    --! Delay line master address
+    signal mWrite           : std_logic;                        --! Delay line master write enable
+    signal mWritedata       : std_logic_vector(31 downto 0);    --! Delay line master data write
+    signal mRead            : std_logic;                        --! Delay line master read enable
+    signal mReaddata        : std_logic_vector(31 downto 0);    --! Delay line master read data
+    signal mWaitrequest     : std_logic;                        --! Delay line master wait request
+    signal mReaddatavalid   : std_logic;                        --! Delay line master read data valid
+
+begin
+
+
+    clk     <= not clk after cPeriode/2 when testDone /= '1' else '0' after cPeriode/2;
+
+    reset   <= '1', '0' after 50 ns;
+
+
+    --! DUT
+    FM : entity work.FrameManipulator
+    generic map(
+                gBytesOfTheFrameBuffer  => gBytesOfTheFrameBuffer,
+                gBytesOfThePackBuffer   => gBytesOfThePackBuffer,
+                gNumberOfPackets        => gNumberOfPackets,
+                gTaskBytesPerWord       => 4,   --32 bit words of configurateFmBhv
+                gTaskAddr               => 9,
+                gExtDelayLine           => gExtDelayLine,
+                gLineAddr               => gLineAddr
+                )
+    port map(
+            iClk50          => clk,
+            iReset          => reset,
+            iS_clk          => clk,
+            iRXDV           => RXDV,
+            iRXD            => RXD,
+            iSt_address     => wrCommAddr,
+            iSt_writedata   => commData,
+            iSt_write       => writeEn,
+            iSt_read        => '0',
+            iSt_byteenable  => "1111",
+            iSc_address     => scAddr,
+            iSc_writedata   => X"01",
+            iSc_write       => scWrite,
+            iSc_read        => scRead,
+            iSc_byteenable  => "1",
+            iSi_address     => (others=>'0'),
+            iSi_writedata   => (others=>'0'),
+            iSi_write       => '0',
+            iSi_read        => '0',
+            iSi_byteenable  => "0000",
+            oSt_readdata    => open,
+            oSc_readdata    => scReadData,
+            oSi_readdata    => open,
+            oM_address      => mAddress,
+            oM_write        => mWrite,
+            oM_writedata    => mWritedata,
+            oM_read         => mRead,
+            iM_readdata     => mReaddata,
+            iM_waitrequest  => mWaitrequest,
+            iM_readdatavalid => mReaddatavalid,
+            oTXData         => TXD,
+            oTXDV           => TXDV,
+            oLED            => LED
+            );
+
+
+    --! SDRAM of the external delay line
+    genMem:
+    if gExtDelayLine/=0 generate
+        Mem : entity work.avalonMem
+        generic map(gAddrWidth  => gLineAddr)
+        port map(
+                iClk            => clk,
+                iReset          => reset,
+                iAddress        => mAddress,
+                iWrite          => mWrite,
+                iWritedata      => mWritedata,
+                iRead           => mRead,
+                oReaddata       => mReaddata,
+                oWaitrequest    => mWaitrequest,
+                oReaddatavalid  => mReaddatavalid
+                );
+    end generate genMem;
+
+    genNoMem:
+    if gExtDelayLine=0 generate
+        mReaddata       <= (others=>'0');
+        mWaitrequest    <= '0';
+        mReaddatavalid  <= '0';
+    end generate genNoMem;
+
+
+    --! Ethernet packet generator of binary stimulation file
+    packGen : entity work.ethPktGenBin
+    generic map(gDataWidth  => 2)
+    port map(
+            iClk        => clk,
+            iRst        => reset,
+            iSrcFile    => gStimIn,
+            oTxEnable   => RXDV,
+            oTxData     => RXD,
+            oTxDone     => open,
+            oStimDone   => stimDone
+            );
+
+
+    --! Generate configuration
+    Conv : entity work.configurateFm
+    generic map(gTestSetting    => gTestSetting)
+    port map(
+            iWrCommAddr => wrCommAddr,
+            oCommData   => commData
+            );
+
+
+    --! Generate configuration
+    genAddr:
+    process
+    begin
+        wrCommAddr  <= (others=>'0');
+        writeEn     <= '1';
+
+        wait until reset='0';
+
+        while wrCommAddr/= (wrCommAddr'range=>'1') loop
+
+            wait until rising_edge(clk);
+
+            wrCommAddr  <= std_logic_vector(unsigned(wrCommAddr)+1);
+
+        end loop;
+
+        writeEn     <= '0';
+
+        wait;
+
+    end process;
+
+
+    --! Count the frames, start the test and store the result
+    result:
+    process
+
+        file        fOutFile    : text;
+        variable    vLineData   : line;
+        variable    vFramesIn   : natural := 0;
+        variable    vFramesOut  : natural := 0;
+        variable    vRXDV_reg   : std_logic := '0';
+        variable    vTXDV_reg   : std_logic := '0';
+        variable    vIdle       : natural := 0;
+        variable    vStatus     : std_logic_vector(7 downto 0);
+
+    begin
+
+        testDone    <= '0';
+
+        --Start of the series of test
+        scAddr      <= "00000";
+        scWrite     <= '1';
+        scRead      <= '0';
+
+        wait until reset='0';
+        wait until rising_edge(clk);
+
+        scWrite     <= '0';
+
+        --Count frames until the stimulation is done and the FM is idle for 100 us
+        while vIdle < 100000 ns / cPeriode loop
+
+            wait until rising_edge(clk);
+
+            if RXDV='1' and vRXDV_reg='0' then
+                vFramesIn   := vFramesIn+1;
+            end if;
+
+            if TXDV='1' and vTXDV_reg='0' then
+                vFramesOut  := vFramesOut+1;
+            end if;
+
+            if stimDone='1' and TXDV='0' then
+                vIdle   := vIdle+1;
+            else
+                vIdle   := 0;
+            end if;
+
+            vRXDV_reg   := RXDV;
+            vTXDV_reg   := TXDV;
+
+        end loop;
+
+        --Read status register with the error flags
+        scAddr      <= "00001";
+        scRead      <= '1';
+
+        wait until rising_edge(clk);
+        wait until rising_edge(clk);
+
+        vStatus     := scReadData;
+        scRead      <= '0';
+
+        file_open(fOutFile, gFileResult, APPEND_MODE);
+
+        write(vLineData, gTestSetting);
+        write(vLineData, ' ');
+        write(vLineData, gFrameSize);
+        write(vLineData, ' ');
+        write(vLineData, gIpg);
+        write(vLineData, ' ');
+        write(vLineData, gBurst);
+        write(vLineData, ' ');
+        write(vLineData, gBytesOfTheFrameBuffer);
+        write(vLineData, ' ');
+        write(vLineData, gBytesOfThePackBuffer);
+        write(vLineData, ' ');
+        write(vLineData, gNumberOfPackets);
+        write(vLineData, ' ');
+        write(vLineData, vFramesIn);
+        write(vLineData, ' ');
+        write(vLineData, vFramesOut);
+        write(vLineData, ' ');
+        write(vLineData, to_integer(unsigned(vStatus)));
+
+        writeline(fOutFile, vLineData);
+
+        file_close(fOutFile);
+
+        testDone    <= '1';
+
+        wait;
+
+    end process result;
+
+
+end bhv;
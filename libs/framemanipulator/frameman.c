@@ -45,6 +45,25 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <system.h>
 #include <user/pdou.h>
 
+//the image of the task memory is uploaded by the DMA controller, if the system has one
+#if defined(DMA_0_NAME) && !defined(FRAMEMAN_DMA_NAME)
+#define FRAMEMAN_DMA_NAME             DMA_0_NAME
+#endif
+
+#ifdef FRAMEMAN_DMA_NAME
+#include <sys/alt_dma.h>
+#include <sys/alt_cache.h>
+#endif
+
+//the task banks are loaded from the EPCS flash at boot, if the application sets the offset of the image
+#if defined(FRAMEMAN_FLASH_OFFSET) && defined(EPCS_FLASH_CONTROLLER_0_NAME) && !defined(FRAMEMAN_FLASH_NAME)
+#define FRAMEMAN_FLASH_NAME           EPCS_FLASH_CONTROLLER_0_NAME
+#endif
+
+#if defined(FRAMEMAN_FLASH_OFFSET) && defined(FRAMEMAN_FLASH_NAME)
+#include <sys/alt_flash.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -60,13 +79,76 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define IOWR16(base, offset, data)  IOWR_16DIRECT(base+offset, 0, data)
 #define IOWR8(base, offset, data)   IOWR_8DIRECT(base+offset, 0, data)
 
-#define FRAMEMAN_CONTROL_REG_OPERATION 0
+#define FRAMEMAN_CONTROL_REG_OPERATION 0    //Indices of aControlReg_l
 #define FRAMEMAN_CONTROL_REG_STATUS    1
+#define FRAMEMAN_CONTROL_REG_OCC_LOW   2    //Used slots of the packet buffer, low byte
+#define FRAMEMAN_CONTROL_REG_OCC_HIGH  3    //Used slots of the packet buffer, high byte
+#define FRAMEMAN_CONTROL_REG_BANK      4    //Selected task bank, entry of object 0x3000/5
+#define FRAMEMAN_CONTROL_REG_ACT_BANK  5    //Active task bank, entry of object 0x3000/6
+#define FRAMEMAN_CONTROL_REG_COUNT     6    //Entries of object 0x3000
+
+#define FRAMEMAN_OPERATION_ADDR        0    //Addresses of the control register (Control_Register.vhd)
+#define FRAMEMAN_STATUS_ADDR           1
+#define FRAMEMAN_OCC_LOW_ADDR          2    //Used slots of the packet buffer, low byte
+#define FRAMEMAN_OCC_HIGH_ADDR         3    //Used slots of the packet buffer, high byte
+#define FRAMEMAN_FORWARD_ADDR          4    //Forwarding flags of object 0x3009/1
+#define FRAMEMAN_BANK_SEL_ADDR         5    //Selected task bank
+#define FRAMEMAN_ETHERTYPE_ADDR        6    //EtherTypes of object 0x3009/2-5, high byte first
+#define FRAMEMAN_BANK_ACT_ADDR         14   //Active task bank
+#define FRAMEMAN_START_ADDR            15   //Start mode of object 0x300C/1
+#define FRAMEMAN_TIME_ADDR             16   //Start time of object 0x300C/2, low byte first
+#define FRAMEMAN_BIT_ERR_ADDR          24   //Bit errors of object 0x300D/1, low byte first
+#define FRAMEMAN_NO_OF_ETHERTYPES      4
+#define FRAMEMAN_SIZE_START_TIME       8
+#define FRAMEMAN_SIZE_BIT_ERRORS       4
+
+#ifdef FRAMEMANIPULATOR_0_TASK_BANKS
+#define FRAMEMAN_NO_OF_BANKS          FRAMEMANIPULATOR_0_TASK_BANKS
+#else
+#define FRAMEMAN_NO_OF_BANKS          1
+#endif
+
+#ifdef FRAMEMANIPULATOR_0_TASK_WORD_SIZE
+#define FRAMEMAN_TASK_WORD_SIZE       FRAMEMANIPULATOR_0_TASK_WORD_SIZE
+#else
+#define FRAMEMAN_TASK_WORD_SIZE       8
+#endif
 
 #define FRAMEMAN_TASK_BASE            FRAMEMANIPULATOR_0_ST_SLAVE_TASKS_BASE
 #define FRAMEMAN_CONTROL_BASE         FRAMEMANIPULATOR_0_SC_SLAVE_CONTROL_BASE
-#define FRAMEMAN_NO_OF_TASKS          FRAMEMANIPULATOR_0_ST_SLAVE_TASKS_SPAN/(8*4)    //Whole Span in Bytes
-                                        // 8Byte for a Word in 4 Memory-Blocks
+#define FRAMEMAN_NO_OF_MEMS           8             //Memory blocks of a bank, selected by three address bits
+#define FRAMEMAN_NO_OF_TASKS          (FRAMEMANIPULATOR_0_ST_SLAVE_TASKS_SPAN/(FRAMEMAN_TASK_WORD_SIZE*FRAMEMAN_NO_OF_MEMS*FRAMEMAN_NO_OF_BANKS))
+                                        //Whole span in Bytes: one word per task in every memory block of every bank,
+                                        //the objects access bank 0
+
+#define FRAMEMAN_MAX_SUBINDEX         0xFE          //Highest subindex of an object, subindex 0 is UNSIGNED8
+#ifndef FRAMEMAN_TASK_IMAGE_SIZE
+#define FRAMEMAN_TASK_IMAGE_SIZE      FRAMEMANIPULATOR_0_ST_SLAVE_TASKS_SPAN     //Maximal size of object 0x300A/1,
+                                        //the local buffer takes the same size in Bytes
+#endif
+#if (FRAMEMAN_TASK_IMAGE_SIZE > FRAMEMANIPULATOR_0_ST_SLAVE_TASKS_SPAN) || (FRAMEMAN_TASK_IMAGE_SIZE%8 != 0)
+#error "FRAMEMAN_TASK_IMAGE_SIZE has to be whole 64 bit words within the span of the task slave"
+#endif
+#define FRAMEMAN_ABORT_LENGTH_HIGH    0x06070012    //SDO abort code: Length of service parameter too high
+#define FRAMEMAN_ABORT_DEVICE_STATE   0x08000022    //SDO abort code: Data can't be stored because of the device state
+#define FRAMEMAN_FLASH_MAGIC          0x4B4E4246    //"FBNK": Header of the task image in the flash
+
+#ifdef FRAMEMAN_DMA_NAME
+#ifndef FRAMEMAN_DMA_MODE
+#define FRAMEMAN_DMA_MODE             ALT_DMA_SET_MODE_32   //ALT_DMA_SET_MODE_64 for DMA controllers with doubleword transfers
+#endif
+#endif
+
+#ifdef FRAMEMANIPULATOR_0_SI_SLAVE_INJECT_BASE
+#define FRAMEMAN_INJECT_BASE          FRAMEMANIPULATOR_0_SI_SLAVE_INJECT_BASE
+#define FRAMEMAN_NO_OF_TEMPLATE_WORDS (FRAMEMANIPULATOR_0_SI_SLAVE_INJECT_SPAN/8) //Whole Span in Bytes
+                                        // 8Byte for a Word of object 0x3006
+#if FRAMEMAN_NO_OF_TEMPLATE_WORDS > FRAMEMAN_MAX_SUBINDEX
+#define FRAMEMAN_NO_OF_TEMPLATE_SUBS  FRAMEMAN_MAX_SUBINDEX    //Words beyond the subindexes aren't accessible
+#else
+#define FRAMEMAN_NO_OF_TEMPLATE_SUBS  FRAMEMAN_NO_OF_TEMPLATE_WORDS
+#endif
+#endif
 
 #define OPERATION_POS_EDGE_MASK         0x0F    //Mask for edge detected inputs of the status register
 #define OPERATION_DIRECT_MASK           0xF0    //Mask for the directly transfered inputs
@@ -97,19 +179,38 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // local vars
 //------------------------------------------------------------------------------
 
-static BYTE    aControlReg_l[2];
+static BYTE    aControlReg_l[FRAMEMAN_CONTROL_REG_COUNT];
+
+static DWORD            aTaskImage_l[FRAMEMAN_TASK_IMAGE_SIZE/4];   //Received object 0x300A/1
+static tObdSize         imageSize_l;
+static volatile BOOL    fImageBusy_l = FALSE;       //DMA still reads aTaskImage_l
+
+#ifdef FRAMEMAN_DMA_NAME
+static alt_dma_txchan   dmaTxChan_l;
+static alt_dma_rxchan   dmaRxChan_l;
+#endif
 
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
 
+static void accessInjectTemplate(tObdCbParam MEM* pParam_p);
+static void accessForwarding(tObdCbParam MEM* pParam_p);
+static void accessStart(tObdCbParam MEM* pParam_p);
+static void accessBitErrors(tObdCbParam MEM* pParam_p);
+static tEplKernel accessTaskImage(tObdCbParam MEM* pParam_p);
+static void uploadTaskImage(void);
+#if defined(FRAMEMAN_FLASH_OFFSET) && defined(FRAMEMAN_FLASH_NAME)
+static void loadTaskImage(void);
+#endif
 
 
 //------------------------------------------------------------------------------
 /**
 \brief  Framemanipulator Initialisation
 
-Linking of Object 0x3000 for PDO-transfer
+Linking of Object 0x3000 for PDO-transfer. The task banks are loaded from the
+flash, if the application defines FRAMEMAN_FLASH_OFFSET.
 
 \return The function returns a tEplKernel error code.
 
@@ -121,11 +222,25 @@ tEplKernel frameman_init(void)
     tObdSize        obdSize;
     UINT            varEntries;
 
-    aControlReg_l[0]=0;
-    aControlReg_l[1]=0;
+    aControlReg_l[FRAMEMAN_CONTROL_REG_OPERATION]=0;
+    aControlReg_l[FRAMEMAN_CONTROL_REG_STATUS]=0;
+    aControlReg_l[FRAMEMAN_CONTROL_REG_OCC_LOW]=0;
+    aControlReg_l[FRAMEMAN_CONTROL_REG_OCC_HIGH]=0;
+    aControlReg_l[FRAMEMAN_CONTROL_REG_BANK]=0;
+    aControlReg_l[FRAMEMAN_CONTROL_REG_ACT_BANK]=0;
 
     obdSize = sizeof(aControlReg_l[0]);
-    varEntries = 2;
+    varEntries = FRAMEMAN_CONTROL_REG_COUNT;
+
+#ifdef FRAMEMAN_DMA_NAME
+    //without channels the image is copied by the CPU
+    dmaTxChan_l = alt_dma_txchan_open(FRAMEMAN_DMA_NAME);
+    dmaRxChan_l = alt_dma_rxchan_open(FRAMEMAN_DMA_NAME);
+#endif
+
+#if defined(FRAMEMAN_FLASH_OFFSET) && defined(FRAMEMAN_FLASH_NAME)
+    loadTaskImage();
+#endif
 
     return oplk_linkObject(0x3000, aControlReg_l, &varEntries, &obdSize, 0x01);
 
@@ -174,10 +289,18 @@ tEplKernel frameman_syncCb(void)
    operation_in=(operationByte& OPERATION_DIRECT_MASK) | operation_pos_edge;
 
    //reading word 1 = status register for PRes + Feedback of edge detected inputs
-   *pErrorByte_p=operation_pos_edge|IORD8(c_base,FRAMEMAN_CONTROL_REG_STATUS);
+   *pErrorByte_p=operation_pos_edge|IORD8(c_base,FRAMEMAN_STATUS_ADDR);
+
+   //reading word 2 and 3 = occupancy of the packet buffer
+   aControlReg_l[FRAMEMAN_CONTROL_REG_OCC_LOW]=IORD8(c_base,FRAMEMAN_OCC_LOW_ADDR);
+   aControlReg_l[FRAMEMAN_CONTROL_REG_OCC_HIGH]=IORD8(c_base,FRAMEMAN_OCC_HIGH_ADDR);
+
+   //bank of the tasks in use, the selected bank follows at the next SoC
+   aControlReg_l[FRAMEMAN_CONTROL_REG_ACT_BANK]=IORD8(c_base,FRAMEMAN_BANK_ACT_ADDR);
+   IOWR8(c_base,FRAMEMAN_BANK_SEL_ADDR,aControlReg_l[FRAMEMAN_CONTROL_REG_BANK]%FRAMEMAN_NO_OF_BANKS);
 
    //writing word 0 = operation register of PReq
-   IOWR8(c_base,FRAMEMAN_CONTROL_REG_OPERATION,operation_in);
+   IOWR8(c_base,FRAMEMAN_OPERATION_ADDR,operation_in);
 
    //storing of old data
    old_operationByte_p=operationByte;
@@ -228,11 +351,54 @@ tEplKernel frameman_configObdAccessCb(tObdCbParam MEM* pParam_p)
 
 
 
+    //image of the task memory is a domain with its own events
+    if (uiIndexType==0x300A)
+    {
+        Ret = accessTaskImage(pParam_p);
+        goto Exit;
+    }
+
     if ((pParam_p->obdEvent != kObdEvPreWrite)&&(pParam_p->obdEvent !=kObdEvPreRead))
     {   // read accesses, post write events etc. are OK
         goto Exit;
     }
 
+    //template frames of the inject task have their own memory
+    if (uiIndexType==0x3006)
+    {
+        accessInjectTemplate(pParam_p);
+        goto Exit;
+    }
+
+    //forwarding settings are stored in the control register
+    if (uiIndexType==0x3009)
+    {
+        accessForwarding(pParam_p);
+        goto Exit;
+    }
+
+    //start mode and time are stored in the control register
+    if (uiIndexType==0x300C)
+    {
+        accessStart(pParam_p);
+        goto Exit;
+    }
+
+    //counter of the BER task is stored in the control register
+    if (uiIndexType==0x300D)
+    {
+        accessBitErrors(pParam_p);
+        goto Exit;
+    }
+
+
+    //single tasks aren't accessed during a running upload of the image
+    if (fImageBusy_l)
+    {
+        pParam_p->abortCode = FRAMEMAN_ABORT_DEVICE_STATE;
+        Ret = kEplObdAccessViolation;
+        goto Exit;
+    }
 
     //SDO-WRITE------------------------------------------------------------------
     //Write => SDO => Object and FM
@@ -268,6 +434,24 @@ tEplKernel frameman_configObdAccessCb(tObdCbParam MEM* pParam_p)
                         IOWR32(t_base,(uiSubIndType-1+FRAMEMAN_NO_OF_TASKS*3)*2+1,pTmp[1]);
                         break;
                     }
+                case 0x3007:
+                    {
+                        IOWR32(t_base,(uiSubIndType-1+FRAMEMAN_NO_OF_TASKS*4)*2,pTmp[0]);
+                        IOWR32(t_base,(uiSubIndType-1+FRAMEMAN_NO_OF_TASKS*4)*2+1,pTmp[1]);
+                        break;
+                    }
+                case 0x3008:
+                    {
+                        IOWR32(t_base,(uiSubIndType-1+FRAMEMAN_NO_OF_TASKS*5)*2,pTmp[0]);
+                        IOWR32(t_base,(uiSubIndType-1+FRAMEMAN_NO_OF_TASKS*5)*2+1,pTmp[1]);
+                        break;
+                    }
+                case 0x300B:
+                    {
+                        IOWR32(t_base,(uiSubIndType-1+FRAMEMAN_NO_OF_TASKS*6)*2,pTmp[0]);
+                        IOWR32(t_base,(uiSubIndType-1+FRAMEMAN_NO_OF_TASKS*6)*2+1,pTmp[1]);
+                        break;
+                    }
                 default:
                     {
                         break;
@@ -321,6 +505,24 @@ tEplKernel frameman_configObdAccessCb(tObdCbParam MEM* pParam_p)
                             temp_ar[1]=IORD32(t_base,(uiSubIndType-1+FRAMEMAN_NO_OF_TASKS*3)*2+1);
                             break;
                         }
+                    case 0x3007:
+                        {
+                            temp_ar[0]=IORD32(t_base,(uiSubIndType-1+FRAMEMAN_NO_OF_TASKS*4)*2);
+                            temp_ar[1]=IORD32(t_base,(uiSubIndType-1+FRAMEMAN_NO_OF_TASKS*4)*2+1);
+                            break;
+                        }
+                    case 0x3008:
+                        {
+                            temp_ar[0]=IORD32(t_base,(uiSubIndType-1+FRAMEMAN_NO_OF_TASKS*5)*2);
+                            temp_ar[1]=IORD32(t_base,(uiSubIndType-1+FRAMEMAN_NO_OF_TASKS*5)*2+1);
+                            break;
+                        }
+                    case 0x300B:
+                        {
+                            temp_ar[0]=IORD32(t_base,(uiSubIndType-1+FRAMEMAN_NO_OF_TASKS*6)*2);
+                            temp_ar[1]=IORD32(t_base,(uiSubIndType-1+FRAMEMAN_NO_OF_TASKS*6)*2+1);
+                            break;
+                        }
                     default:
                         {
                             break;
@@ -344,3 +546,401 @@ Exit:
     return Ret;
 }
 
+
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Access of the template frames
+
+Transfers object 0x3006 to and from the template memory of the inject task.
+Subindexes beyond the memory are read as zeroes. A memory of more than
+FRAMEMAN_MAX_SUBINDEX words is only accessible up to this subindex.
+
+\param  pParam_p            OBD parameter
+
+\ingroup module_FM
+*/
+//------------------------------------------------------------------------------
+static void accessInjectTemplate(tObdCbParam MEM* pParam_p)
+{
+    unsigned int        uiSubIndType = pParam_p->subIndex;
+
+    //temporary data signals
+    DWORD               *pTmp = (DWORD*)(pParam_p->pArg);
+    DWORD               temp_ar[2] = {0, 0};
+
+#ifdef FRAMEMAN_INJECT_BASE
+    //memory pointer
+    volatile unsigned long  *i_base = (unsigned long *)FRAMEMAN_INJECT_BASE;
+
+    if (uiSubIndType==0)
+    {
+        if (pParam_p->obdEvent==kObdEvPreRead)
+        {
+            //subindex 0 = number of available words
+            BYTE temp_char=FRAMEMAN_NO_OF_TEMPLATE_SUBS;
+            obd_writeEntry(0x3006, 0,&temp_char,1);
+        }
+        return;
+    }
+
+    if (uiSubIndType<=FRAMEMAN_NO_OF_TEMPLATE_SUBS)
+    {
+        if (pParam_p->obdEvent==kObdEvPreWrite)
+        {
+            //store SDO data to template memory
+            IOWR32(i_base,(uiSubIndType-1)*2,pTmp[0]);
+            IOWR32(i_base,(uiSubIndType-1)*2+1,pTmp[1]);
+            return;
+        }
+
+        temp_ar[0]=IORD32(i_base,(uiSubIndType-1)*2);
+        temp_ar[1]=IORD32(i_base,(uiSubIndType-1)*2+1);
+    }
+#else
+    (void)pTmp;
+#endif
+
+    if ((pParam_p->obdEvent==kObdEvPreRead)&&(uiSubIndType!=0))
+    {
+        //updates objects with the true value or zeroes
+        obd_writeEntry(0x3006, uiSubIndType,&temp_ar,8);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Access of the forwarding settings
+
+Transfers object 0x3009 to and from the control register. Subindex 1 holds
+the forwarding flags, subindexes 2 to 5 the additional EtherTypes.
+
+\param  pParam_p            OBD parameter
+
+\ingroup module_FM
+*/
+//------------------------------------------------------------------------------
+static void accessForwarding(tObdCbParam MEM* pParam_p)
+{
+    unsigned int        uiSubIndType = pParam_p->subIndex;
+    unsigned int        uiOffset;
+
+    //temporary data signals
+    BYTE                *pTmp = (BYTE*)(pParam_p->pArg);
+    WORD                temp_word;
+    BYTE                temp_char;
+
+    //memory pointer
+    volatile BYTE       *c_base = (BYTE *)FRAMEMAN_CONTROL_BASE;
+
+    if (uiSubIndType==1)
+    {
+        if (pParam_p->obdEvent==kObdEvPreWrite)
+        {
+            IOWR8(c_base,FRAMEMAN_FORWARD_ADDR,pTmp[0]);
+        }
+        else
+        {
+            temp_char=IORD8(c_base,FRAMEMAN_FORWARD_ADDR);
+            obd_writeEntry(0x3009, 1,&temp_char,1);
+        }
+        return;
+    }
+
+    if ((uiSubIndType<2)||(uiSubIndType>FRAMEMAN_NO_OF_ETHERTYPES+1))
+    {
+        return;
+    }
+
+    uiOffset=FRAMEMAN_ETHERTYPE_ADDR+(uiSubIndType-2)*2;
+
+    if (pParam_p->obdEvent==kObdEvPreWrite)
+    {
+        //EtherType is stored high byte first like on the wire
+        temp_word=*(WORD*)pTmp;
+        IOWR8(c_base,uiOffset,temp_word>>8);
+        IOWR8(c_base,uiOffset+1,temp_word&0xFF);
+    }
+    else
+    {
+        temp_word=(IORD8(c_base,uiOffset)<<8)|IORD8(c_base,uiOffset+1);
+        obd_writeEntry(0x3009, uiSubIndType,&temp_word,2);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Access of the start settings
+
+Transfers object 0x300C to and from the control register. Subindex 1 holds
+the start mode, subindex 2 the SoC time of the start. The time is stored with
+the low byte first like in the SoC.
+
+\param  pParam_p            OBD parameter
+
+\ingroup module_FM
+*/
+//------------------------------------------------------------------------------
+static void accessStart(tObdCbParam MEM* pParam_p)
+{
+    unsigned int        uiSubIndType = pParam_p->subIndex;
+    unsigned int        i;
+
+    //temporary data signals
+    BYTE                *pTmp = (BYTE*)(pParam_p->pArg);
+    BYTE                temp_ar[FRAMEMAN_SIZE_START_TIME];
+
+    //memory pointer
+    volatile BYTE       *c_base = (BYTE *)FRAMEMAN_CONTROL_BASE;
+
+    if (uiSubIndType==1)
+    {
+        if (pParam_p->obdEvent==kObdEvPreWrite)
+        {
+            IOWR8(c_base,FRAMEMAN_START_ADDR,pTmp[0]);
+        }
+        else
+        {
+            temp_ar[0]=IORD8(c_base,FRAMEMAN_START_ADDR);
+            obd_writeEntry(0x300C, 1,temp_ar,1);
+        }
+        return;
+    }
+
+    if (uiSubIndType!=2)
+    {
+        return;
+    }
+
+    if (pParam_p->obdEvent==kObdEvPreWrite)
+    {
+        for (i=0;i<FRAMEMAN_SIZE_START_TIME;i++)
+        {
+            IOWR8(c_base,FRAMEMAN_TIME_ADDR+i,pTmp[i]);
+        }
+    }
+    else
+    {
+        for (i=0;i<FRAMEMAN_SIZE_START_TIME;i++)
+        {
+            temp_ar[i]=IORD8(c_base,FRAMEMAN_TIME_ADDR+i);
+        }
+        obd_writeEntry(0x300C, 2,temp_ar,FRAMEMAN_SIZE_START_TIME);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Access of the bit errors
+
+Reads object 0x300D/1 from the control register. It holds the number of bits,
+which were flipped by the BER task since the start of the test. The IP-core
+writes the counter with the low byte first every 32 cycles, so it is read
+again, until two reads are equal.
+
+\param  pParam_p            OBD parameter
+
+\ingroup module_FM
+*/
+//------------------------------------------------------------------------------
+static void accessBitErrors(tObdCbParam MEM* pParam_p)
+{
+    unsigned int        i;
+    DWORD               bitErrors = 0;
+    DWORD               lastRead;
+
+    //memory pointer
+    volatile BYTE       *c_base = (BYTE *)FRAMEMAN_CONTROL_BASE;
+
+    if ((pParam_p->subIndex!=1)||(pParam_p->obdEvent!=kObdEvPreRead))
+    {
+        return;
+    }
+
+    do
+    {
+        lastRead=bitErrors;
+        bitErrors=0;
+        for (i=0;i<FRAMEMAN_SIZE_BIT_ERRORS;i++)
+        {
+            bitErrors|=((DWORD)IORD8(c_base,FRAMEMAN_BIT_ERR_ADDR+i))<<(8*i);
+        }
+    } while (bitErrors!=lastRead);
+    obd_writeEntry(0x300D, 1,&bitErrors,FRAMEMAN_SIZE_BIT_ERRORS);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Access of the image of the task memory
+
+Object 0x300A/1 is received in a local buffer and uploaded to the task memory
+in one go after the SDO transfer. The image has the layout of the task memory,
+e.g. the *.bin file of tools/fm-scenario.sh, and is written from address 0.
+The images of several banks follow each other, see tools/fm-bank.sh.
+
+\param  pParam_p            OBD parameter
+
+\return The function returns a tEplKernel error code.
+
+\ingroup module_FM
+*/
+//------------------------------------------------------------------------------
+static tEplKernel accessTaskImage(tObdCbParam MEM* pParam_p)
+{
+    tObdVStringDomain*  pDomain = (tObdVStringDomain*)(pParam_p->pArg);
+
+    if (pParam_p->subIndex!=1)
+    {
+        return kEplSuccessful;
+    }
+
+    switch (pParam_p->obdEvent)
+    {
+        case kObdEvWrStringDomain:
+            {
+                //image of whole 64 bit words, which fits in the task memory
+                if ((pDomain->downloadSize>FRAMEMAN_TASK_IMAGE_SIZE)||(pDomain->downloadSize%8!=0))
+                {
+                    pParam_p->abortCode = FRAMEMAN_ABORT_LENGTH_HIGH;
+                    return kEplInvalidParam;
+                }
+
+                //buffer of the last image may still be in use
+                if (fImageBusy_l)
+                {
+                    pParam_p->abortCode = FRAMEMAN_ABORT_DEVICE_STATE;
+                    return kEplObdAccessViolation;
+                }
+
+                //receive the image in the local buffer
+                pDomain->objSize = pDomain->downloadSize;
+                pDomain->pData = aTaskImage_l;
+                imageSize_l = pDomain->downloadSize;
+                break;
+            }
+        case kObdEvPostWrite:
+            {
+                uploadTaskImage();
+                break;
+            }
+        default:
+            {
+                break;
+            }
+    }
+
+    return kEplSuccessful;
+}
+
+#ifdef FRAMEMAN_DMA_NAME
+//------------------------------------------------------------------------------
+/**
+\brief  End of the DMA transfer of the image
+
+\param  pHandle_p           Unused
+\param  pData_p             Destination of the transfer
+
+\ingroup module_FM
+*/
+//------------------------------------------------------------------------------
+static void taskImageDone(void* pHandle_p, void* pData_p)
+{
+    (void)pHandle_p;
+    (void)pData_p;
+
+    fImageBusy_l = FALSE;
+}
+#endif
+
+//------------------------------------------------------------------------------
+/**
+\brief  Upload of the image to the task memory
+
+The DMA controller moves the image in bursts, while the CPU returns to the
+POWERLINK stack. Without a DMA controller the image is copied word by word.
+
+\ingroup module_FM
+*/
+//------------------------------------------------------------------------------
+static void uploadTaskImage(void)
+{
+    //memory pointer
+    volatile unsigned long  *t_base = (unsigned long *)FRAMEMAN_TASK_BASE;
+    unsigned int            i;
+
+    if (imageSize_l==0)
+    {
+        return;
+    }
+
+#ifdef FRAMEMAN_DMA_NAME
+    //a request of only one channel would be paired with the next transfer => the send request
+    //is queued only after the receive request, which checks the length and the mode first
+    if ((dmaTxChan_l!=NULL)&&(dmaRxChan_l!=NULL)&&(!fImageBusy_l)&&
+        (alt_dma_txchan_space(dmaTxChan_l)>0))
+    {
+        alt_dma_txchan_ioctl(dmaTxChan_l, FRAMEMAN_DMA_MODE, NULL);
+        alt_dma_rxchan_ioctl(dmaRxChan_l, FRAMEMAN_DMA_MODE, NULL);
+
+        //DMA reads the image from the memory, not from the cache
+        alt_dcache_flush(aTaskImage_l, imageSize_l);
+
+        fImageBusy_l = TRUE;
+
+        //the transfer starts with the send request, which has a free slot
+        if ((alt_dma_rxchan_prepare(dmaRxChan_l, (void*)t_base, imageSize_l, taskImageDone, NULL)>=0)&&
+            (alt_dma_txchan_send(dmaTxChan_l, aTaskImage_l, imageSize_l, NULL, NULL)>=0))
+        {
+            return;
+        }
+
+        //DMA isn't ready => copy by the CPU
+        fImageBusy_l = FALSE;
+    }
+#endif
+
+    for (i=0; i<imageSize_l/4; i++)
+    {
+        IOWR32(t_base,i,aTaskImage_l[i]);
+    }
+}
+
+#if defined(FRAMEMAN_FLASH_OFFSET) && defined(FRAMEMAN_FLASH_NAME)
+//------------------------------------------------------------------------------
+/**
+\brief  Load of the task banks from the flash
+
+The flash holds the header FRAMEMAN_FLASH_MAGIC and the size of the image in
+Bytes at FRAMEMAN_FLASH_OFFSET, followed by the image of tools/fm-bank.sh.
+An erased flash or an invalid header leaves the task memory empty.
+
+\ingroup module_FM
+*/
+//------------------------------------------------------------------------------
+static void loadTaskImage(void)
+{
+    alt_flash_fd*   pFlash;
+    DWORD           aHeader[2];
+
+    pFlash = alt_flash_open_dev(FRAMEMAN_FLASH_NAME);
+    if (pFlash==NULL)
+    {
+        return;
+    }
+
+    if ((alt_read_flash(pFlash, FRAMEMAN_FLASH_OFFSET, aHeader, sizeof(aHeader))==0)&&
+        (aHeader[0]==FRAMEMAN_FLASH_MAGIC)&&
+        (aHeader[1]<=FRAMEMAN_TASK_IMAGE_SIZE)&&(aHeader[1]%8==0)&&
+        (alt_read_flash(pFlash, FRAMEMAN_FLASH_OFFSET+sizeof(aHeader), aTaskImage_l, aHeader[1])==0))
+    {
+        imageSize_l = aHeader[1];
+        uploadTaskImage();
+    }
+
+    alt_flash_close_dev(pFlash);
+}
+#endif
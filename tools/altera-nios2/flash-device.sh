@@ -13,6 +13,8 @@ SKIP_CONV_ELF=
 SKIP_CONV_SOF=
 SKIP_BASE=
 IGNORE_SYS=
+BANK_IMAGE=
+BANK_OFFSET=
 
 NAME_ELF_FLASH="elf"
 NAME_SOF_FLASH="sof"
@@ -47,6 +49,16 @@ do
           BASE=$1
           echo "INFO: Set base-address to $BASE"
           ;;
+      --bank-image)
+          shift
+          BANK_IMAGE=$1
+          echo "INFO: Task banks $BANK_IMAGE will be downloaded"
+          ;;
+      --bank-offset)
+          shift
+          BANK_OFFSET=$1
+          echo "INFO: Set offset of the task banks to $BANK_OFFSET"
+          ;;
       --help)
           echo "Usage: ${0} [OPTION]"
           echo
@@ -55,6 +67,8 @@ do
           echo "  --use-elf-flash NAME          use existing elf .flash-file"
           echo "  --use-sof-flash NAME          use existing sof .flash-file"
           echo "  --set-base      BASE-ADDRESS  set base-address manually via 0x.."
+          echo "  --bank-image    FILE          download .boot-file of tools/fm-bank.sh"
+          echo "  --bank-offset   OFFSET        flash offset of the bank image (FRAMEMAN_FLASH_OFFSET)"
           echo
           exit 1
           ;;
@@ -92,6 +106,18 @@ if [ -z "$SKIP_BASE" ]; then
     }
 fi
 
+if [ -n "$BANK_IMAGE" ]; then
+    ls $BANK_IMAGE || {
+        echo "Missing bank-image"
+        exit 1
+    }
+
+    if [ -z "$BANK_OFFSET" ]; then
+        echo "Missing offset of the bank-image"
+        exit 1
+    fi
+fi
+
 ######################
 #Flash device
 
@@ -118,6 +144,14 @@ if [ -z "$SKIP_CONV_ELF" ]; then
     elf2flash --after="$SOURCE_SOF_FLASH" --input="$SOURCE_ELF" --outfile="$SOURCE_ELF_FLASH" --epcs
 fi
 
+#convert task banks to flash file
+SOURCE_BANK_FLASH=$SOURCE_DIR/bank.flash
+
+if [ -n "$BANK_IMAGE" ]; then
+    echo "Convert bank-image $BANK_IMAGE to flash $SOURCE_BANK_FLASH"
+    bin2flash --epcs --location=$BANK_OFFSET --input="$BANK_IMAGE" --output="$SOURCE_BANK_FLASH"
+fi
+
 #Load SysID from file
 if [ -z "$IGNORE_SYS" ]; then
     echo "Load SysID $SOURCE_DIR/SysID.data"
@@ -136,6 +170,10 @@ fi
 echo "Download flash"
 DOWNLOAD_PARAM="$SOURCE_SOF_FLASH $SOURCE_ELF_FLASH --base=$BASE --epcs --override=nios2-flash-override.txt"
 
+if [ -n "$BANK_IMAGE" ]; then
+    DOWNLOAD_PARAM+=" $SOURCE_BANK_FLASH"
+fi
+
 if [ -z "$IGNORE_SYS" ]; then
     DOWNLOAD_PARAM+=" $SYSID"
 fi
@@ -0,0 +1,709 @@
+#!/bin/bash
+# Checks the tasks of a scenario file for buffer overflows and configuration errors.
+# Call e.g. ./tools/fm-analyze.sh SCENARIO-FILE [OUTPUT-DIR]
+#
+# Additionally to the keys of fm-scenario.sh, the scenario file sets:
+#   GENERIC_LIST    Generics of FrameManipulator.vhd, which differ from their defaults,
+#                   e.g. "gBytesOfTheFrameBuffer=1600 gNumberOfPackets=500"
+#   CYCLE_TIME      POWERLINK cycle time in us
+#   TRAFFIC_LIST    One entry per frame of a cycle with its frame filter and size, e.g.
+#                   "mtype=PRes src=1 size=62"
+#
+# The worst case occupancy of the buffers is reported for every cycle of the series of test.
+# The script fails, when a task would set one of the error flags erDataOv, erFrameOv,
+# erPacketOv or erTaskConf.
+#
+# With OUTPUT-DIR the files of fm-scenario.sh are decoded again and compared with the
+# scenario file: the image SCENARIO_NAME.bin, the object entries SCENARIO_NAME.txt and
+# the generate block SCENARIO_NAME.vhd with the address layout of the testbench.
+
+DIR_TOOLS=$(dirname $0)
+FM_TOP=${FM_TOP:-$DIR_TOOLS/../fpga/ipcore/altera/fm/src/FrameManipulator.vhd}
+
+source $DIR_TOOLS/fm-scenarioLib.sh
+
+# Get *.scenario file
+SCENARIO_FILE=$1
+OUTPUT_DIR=$2
+
+# Set defaults
+GENERIC_LIST=
+CYCLE_TIME=
+TRAFFIC_LIST=()
+
+# Number of cycles of the series of test
+MAX_CYCLE=255
+
+declare -A GENERIC
+declare -A PARAM
+declare -A TASK_NAME
+
+ERRORS=0
+
+# Print analysis error: proc_fail TASK FLAG MESSAGE
+proc_fail() {
+    echo "ERROR: task $1: $3 ($2)"
+    ERRORS=$(( ERRORS + 1 ))
+}
+
+# Print error of a decoded word: proc_failWord FILE WHAT DECODED EXPECTED
+proc_failWord() {
+    printf 'ERROR: %s: %s is 0x%X instead of 0x%X\n' $1 "$2" $3 $4
+    ERRORS=$(( ERRORS + 1 ))
+}
+
+# Print analysis warning: proc_warn TASK MESSAGE
+proc_warn() {
+    echo "WARNING: task $1: $2"
+}
+
+# Read the default values of the generics of the toplevel
+proc_readGenerics() {
+    local line
+
+    while read -r line
+    do
+        [[ $line =~ ^port ]] && return
+        if [[ $line =~ (g[a-zA-Z0-9]+)\ *:\ *natural\ *:=\ *([0-9]+) ]]; then
+            GENERIC[${BASH_REMATCH[1]}]=${BASH_REMATCH[2]}
+        fi
+    done < $FM_TOP
+}
+
+# Width of an address for N entries like libcommon LogDualis: proc_logDualis N
+proc_logDualis() {
+    LOG=0
+    while (( (1 << LOG) < $1 ))
+    do
+        LOG=$(( LOG + 1 ))
+    done
+}
+
+# Last cycle of a task, which lasts N further cycles: proc_cycleEnd CYCLE N
+proc_cycleEnd() {
+    CYCLE_END=$(( $1 + $2 ))
+    (( CYCLE_END <= MAX_CYCLE )) || CYCLE_END=$MAX_CYCLE
+}
+
+# Store the maximum occupancy of the cycles: proc_occupancy ARRAY FIRST LAST VALUE
+proc_occupancy() {
+    local -n occ=$1
+    local -i cycle
+
+    for (( cycle=$2; cycle<=$3; cycle++ ))
+    do
+        (( ${occ[$cycle]:-0} >= $4 )) || occ[$cycle]=$4
+    done
+}
+
+# Add to the occupancy of the cycles: proc_occupancyAdd ARRAY FIRST LAST VALUE
+proc_occupancyAdd() {
+    local -n occ=$1
+    local -i cycle
+
+    for (( cycle=$2; cycle<=$3; cycle++ ))
+    do
+        occ[$cycle]=$(( ${occ[$cycle]:-0} + $4 ))
+    done
+}
+
+
+# Get scenario and task words
+proc_compile
+
+proc_readGenerics
+proc_readPkg cParam PARAM
+
+for i in $GENERIC_LIST
+do
+    [[ $i =~ ^(g[a-zA-Z0-9]+)=([0-9]+)$ ]] || {
+        echo "ERROR: invalid generic $i" >&2
+        exit 1
+    }
+    [ "${GENERIC[${BASH_REMATCH[1]}]}" ] || {
+        echo "ERROR: unknown generic ${BASH_REMATCH[1]}" >&2
+        exit 1
+    }
+    GENERIC[${BASH_REMATCH[1]}]=${BASH_REMATCH[2]}
+done
+
+if [ ${#WORD_SETTING1[@]} -gt ${GENERIC[gTaskCount]} ]; then
+    echo "ERROR: ${#WORD_SETTING1[@]} tasks exceed gTaskCount of ${GENERIC[gTaskCount]}" >&2
+    exit 1
+fi
+
+for i in ${!TASK_CODE[@]}
+do
+    TASK_NAME[${TASK_CODE[$i]}]=$i
+done
+
+
+# Traffic profile ---------------------------------------------------------------------------
+
+declare -a TRAFFIC_FRAME TRAFFIC_SIZE TRAFFIC_SOC TRAFFIC_PHASE
+
+# Frames in front of the first SoC belong to the asynchronous phase of the previous cycle
+phase=async
+
+TRAFFIC_NO=1
+for i in "${TRAFFIC_LIST[@]}"
+do
+    ENTRY="frame $TRAFFIC_NO"
+    unset arg
+    declare -A arg=()
+    proc_parse "$i"
+    proc_filter
+    proc_range size "${arg[size]}" 1 1518
+
+    TRAFFIC_FRAME+=($FRAME)
+    TRAFFIC_SIZE+=(${arg[size]})
+    [ "${arg[mtype]}" = SoC ] && TRAFFIC_SOC+=(1) || TRAFFIC_SOC+=(0)
+    [ "${arg[mtype]}" = SoC ] && phase=isochronous
+    [ "${arg[mtype]}" = SoA ] && phase=async
+    TRAFFIC_PHASE+=(${PHASE_FLAG[$phase]})
+    TRAFFIC_NO=$(( TRAFFIC_NO + 1 ))
+done
+
+if [ ${#TRAFFIC_LIST[@]} -gt 0 ]; then
+    proc_range CYCLE_TIME "$CYCLE_TIME" 1 1000000
+else
+    echo "WARNING: no traffic profile, one frame per cycle is assumed for each task"
+fi
+
+
+# Resources ---------------------------------------------------------------------------------
+
+# Frame buffer and fifo of Address_Manager with two entries per frame
+proc_logDualis ${GENERIC[gBytesOfTheFrameBuffer]}
+DATA_ADDR_WIDTH=$LOG
+DATA_BUFF_SIZE=$(( 1 << DATA_ADDR_WIDTH ))
+proc_logDualis $(( DATA_BUFF_SIZE / 60 * 2 ))
+ADDR_FIFO_FRAMES=$(( (1 << LOG) / 2 ))
+
+# Packet buffer is shared by the Packet_Handler instances of all contexts, each has its own free list
+HANDLERS=$(( GENERIC[gSafetyContexts] * GENERIC[gSafetyPackets] ))
+proc_logDualis ${GENERIC[gBytesOfThePackBuffer]}
+PACK_BUFF_SIZE=$(( 1 << LOG ))
+proc_logDualis ${GENERIC[gNumberOfPackets]}
+HANDLER_LIST=$(( 1 << LOG ))
+
+echo "$SCENARIO_NAME: ${#WORD_SETTING1[@]} tasks"
+echo "Frame buffer: $DATA_BUFF_SIZE Byte, $ADDR_FIFO_FRAMES frames"
+echo "Packet buffer: $PACK_BUFF_SIZE Byte shared by up to $HANDLERS handlers with $HANDLER_LIST slots each"
+
+
+# Analysis of the tasks ---------------------------------------------------------------------
+
+declare -A CONTEXT          # Context of the frame filter
+declare -a CONTEXT_LAST     # Last safety task of each context
+declare -a CONTEXT_MATCH    # Matching frames per cycle of the last safety task of each context
+declare -a OCC_DATA OCC_FRAMES
+declare -a OCC_PACKET
+declare -a PK_TASK PK_NR PK_HANDLER PK_SIZE PK_STORED PK_FIRST PK_LAST
+DELAY_TASK=
+SAFETY_TASK_NO=
+
+for task in ${!WORD_SETTING1[@]}
+do
+    taskNo=$(( task + 1 ))
+    s1=${WORD_SETTING1[task]}
+    s2=${WORD_SETTING2[task]}
+    frame=${WORD_FRAME[task]}
+    mask=${WORD_MASK[task]}
+
+    phase=$(( WORD_CHAIN[task] >> 24 & 0xFF ))
+
+    cycle=$(( s1 >> 56 & 0xFF ))
+    name=${TASK_NAME[$(( s1 >> 48 & 0xFF ))]}
+
+    # Frames of the traffic profile, which match to the filter
+    # The filter windows aren't part of the profile, so the matching frames are the worst case
+    matchCnt=0
+    matchSize=0
+    for i in ${!TRAFFIC_FRAME[@]}
+    do
+        if (( (TRAFFIC_FRAME[i] & mask) == (frame & mask) &&
+              (phase == 0 || (phase & 1 << TRAFFIC_PHASE[i]) != 0) )); then
+            matchCnt=$(( matchCnt + 1 ))
+            (( matchSize >= TRAFFIC_SIZE[i] )) || matchSize=${TRAFFIC_SIZE[i]}
+        fi
+    done
+
+    if [ ${#TRAFFIC_LIST[@]} -eq 0 ]; then
+        matchCnt=1
+    elif [ $matchCnt -eq 0 ]; then
+        proc_warn $taskNo "$name doesn't match any frame of the traffic profile"
+        continue
+    fi
+
+    if [ "$name" = delay ]; then
+        DELAY_TASK=$taskNo
+        [ ${#TRAFFIC_LIST[@]} -gt 0 ] || continue
+
+        delayType=$(( s1 >> 40 & 0xFF ))
+        delayCycles=$(( ((s1 & 0xFFFFFFFFFF) / 100 + CYCLE_TIME - 1) / CYCLE_TIME ))
+
+        # All following frames pass the external delay line, without it the type acts like pass
+        if (( delayType == DELAY_CODE[line] && GENERIC[gExtDelayLine] != 0 )); then
+            # Preamble, CRC and two header words per frame in 32 bit words
+            lineBytes=0
+            for i in ${!TRAFFIC_FRAME[@]}
+            do
+                lineBytes=$(( lineBytes + ((TRAFFIC_SIZE[i] + 12 + 3) / 4 + 2) * 4 ))
+            done
+            lineBytes=$(( lineBytes * (delayCycles + 1) ))
+
+            (( lineBytes < 1 << GENERIC[gLineAddr] )) ||
+                proc_fail $taskNo erFrameOv "delay line stores $lineBytes Byte in the ring buffer of $(( 1 << GENERIC[gLineAddr] )) Byte"
+            (( (s1 & 0xFFFFFFFFFF) < 1 << 32 )) ||
+                proc_warn $taskNo "latency is limited to 42.9 s"
+            continue
+        fi
+
+        # Frames, which are stored behind the delayed frames
+        storedFrames=$matchCnt
+        storedBytes=$(( matchCnt * matchSize ))
+        for i in ${!TRAFFIC_FRAME[@]}
+        do
+            if (( delayType == DELAY_CODE[pass] || delayType == DELAY_CODE[line] ||
+                  (delayType == DELAY_CODE[passSoC] && TRAFFIC_SOC[i] == 1) )); then
+                storedFrames=$(( storedFrames + delayCycles ))
+                storedBytes=$(( storedBytes + delayCycles * TRAFFIC_SIZE[i] ))
+            fi
+        done
+
+        (( storedBytes < DATA_BUFF_SIZE )) ||
+            proc_fail $taskNo erDataOv "delay stores $storedBytes Byte in the frame buffer of $DATA_BUFF_SIZE Byte"
+        (( storedFrames <= ADDR_FIFO_FRAMES )) ||
+            proc_fail $taskNo erFrameOv "delay stores $storedFrames frames in the address buffer of $ADDR_FIFO_FRAMES frames"
+        (( matchCnt <= PARAM[noDelFrames] )) ||
+            proc_fail $taskNo erFrameOv "delay of $matchCnt frames exceeds noDelFrames of ${PARAM[noDelFrames]}"
+
+        proc_cycleEnd $cycle $delayCycles
+        proc_occupancy OCC_DATA $cycle $CYCLE_END $storedBytes
+        proc_occupancy OCC_FRAMES $cycle $CYCLE_END $storedFrames
+        continue
+    fi
+
+    if [ "$name" = ipg ]; then
+        # Frames behind a stretched gap are kept in the frame buffer
+        gap=$(( s1 & 0xFFFF ))
+        (( gap >= 12 )) || proc_warn $taskNo "gap of $gap Byte is below the standard IPG of 12 Byte"
+        if [ "$CYCLE_TIME" ] && (( matchCnt * gap * 80 >= CYCLE_TIME * 1000 )); then
+            proc_warn $taskNo "gaps of $(( matchCnt * gap * 80 / 1000 )) us exceed the cycle time"
+        fi
+        continue
+    fi
+
+    if [ "$name" = phy ]; then
+        # The abort and the TX error need a position within the matching frames
+        flags=$(( s1 >> 40 & 0xFF ))
+        if (( flags & (1 << PHY_FLAG[abort] | 1 << PHY_FLAG[txErr]) )) && [ ${#TRAFFIC_LIST[@]} -gt 0 ] &&
+           (( (s1 & 0xFFFF) / 4 + 1 > matchSize )); then
+            proc_warn $taskNo "position at Byte $(( (s1 & 0xFFFF) / 4 + 1 )) is behind the matching frames of up to $matchSize Byte"
+        fi
+        (( (flags & 1 << PHY_FLAG[txErr]) == 0 )) ||
+            proc_warn $taskNo "TX error needs a PHY with TX_ER at FrameManipulator.oTXER"
+        continue
+    fi
+
+    if [ "$name" = ber ]; then
+        # Expected bit errors per 1000 matching frames at the rate of 2^-41 per bit
+        rate=$(( s1 >> 16 & 0xFFFFFFFF ))
+        if [ ${#TRAFFIC_LIST[@]} -gt 0 ] && (( matchSize * 8 * 1000 * rate >> 41 >= 1000 )); then
+            proc_warn $taskNo "about $(( matchSize * 8 * rate >> 41 )) bit errors per matching frame, nearly all of them are lost"
+        fi
+        continue
+    fi
+
+    if [ "$name" = socTime ]; then
+        # Only SoCs are shifted, both times within one second
+        flags=$(( s1 >> 40 & 0xFF ))
+        offset=$(( s1 >> 8 & 0xFFFFFFFF ))
+        (( offset < 1 << 31 )) || offset=$(( offset - (1 << 32) ))
+        if (( (flags & (1 << TIME_FLAG[net] | 1 << TIME_FLAG[rel])) != 0 && (offset > 999999999 || offset < -999999999) )); then
+            proc_warn $taskNo "Time offset of $offset ns is limited to +-999999999 ns"
+        fi
+        socCnt=0
+        for i in ${!TRAFFIC_FRAME[@]}
+        do
+            if (( (TRAFFIC_FRAME[i] & mask) == (frame & mask) && TRAFFIC_SOC[i] == 1 )); then
+                socCnt=$(( socCnt + 1 ))
+            fi
+        done
+        [ ${#TRAFFIC_LIST[@]} -eq 0 ] || [ $socCnt -gt 0 ] ||
+            proc_warn $taskNo "socTime doesn't match any SoC of the traffic profile"
+        continue
+    fi
+
+    if [ "$name" = inject ]; then
+        # Injected frames only use idle slots, but may occupy the whole line
+        gap=$(( s2 >> 48 & 0xFFFF ))
+        (( gap >= 12 )) || proc_warn $taskNo "gap of $gap Byte is below the standard IPG of 12 Byte"
+        (( (s1 & 0xFFFF) != 0 || (s2 >> 40 & 0xFF) != 0 )) ||
+            proc_warn $taskNo "injection isn't limited by count or window and runs until the end of the test"
+        continue
+    fi
+
+    if [ "$name" = duplicate ]; then
+        # Each copy occupies the address buffer like another stored frame
+        copies=$(( s1 >> 16 & 0xFF ))
+        gap=$(( s1 & 0xFFFF ))
+        (( gap >= 12 )) || proc_warn $taskNo "gap of $gap Byte is below the standard IPG of 12 Byte"
+        (( matchCnt * (copies + 1) <= ADDR_FIFO_FRAMES )) ||
+            proc_fail $taskNo erFrameOv "$copies copies of $matchCnt frames exceed the address buffer of $ADDR_FIFO_FRAMES frames"
+        if [ "$CYCLE_TIME" ] && (( matchCnt * copies * (matchSize + gap + 8) * 80 >= CYCLE_TIME * 1000 )); then
+            proc_warn $taskNo "copies of $(( matchCnt * copies * (matchSize + gap + 8) * 80 / 1000 )) us exceed the cycle time"
+        fi
+        continue
+    fi
+
+    if [ "$name" = shape ]; then
+        # All frames except SoCs share the rate of the token bucket
+        rate=$(( (s1 >> 24 & 0xFFFFFF) * 400000 >> 24 ))
+        limit=$(( s1 & 0xFF ))
+        (( limit <= ADDR_FIFO_FRAMES )) ||
+            proc_fail $taskNo erFrameOv "limit of $limit frames exceeds the address buffer of $ADDR_FIFO_FRAMES frames"
+        (( (s2 >> 56 & 0xFF) != 0 )) ||
+            proc_warn $taskNo "shaping isn't limited by a window and runs until the end of the test"
+        [ ${#TRAFFIC_LIST[@]} -gt 0 ] && [ "$CYCLE_TIME" ] || continue
+
+        shapedBytes=0
+        for i in ${!TRAFFIC_SIZE[@]}
+        do
+            (( TRAFFIC_SOC[i] == 1 )) || shapedBytes=$(( shapedBytes + TRAFFIC_SIZE[i] + 20 ))
+        done
+        rateBytes=$(( rate * CYCLE_TIME / 8000 ))
+        if (( shapedBytes > rateBytes )); then
+            if (( limit == 0 )); then
+                proc_fail $taskNo erFrameOv "$shapedBytes Byte per cycle exceed the rate of $rateBytes Byte per cycle without limit"
+            else
+                proc_warn $taskNo "$shapedBytes Byte per cycle exceed the rate of $rateBytes Byte per cycle, frames are dropped"
+            fi
+        fi
+        continue
+    fi
+
+    if [ "$name" = reorder ]; then
+        # The held frame has to stay in the frame buffer, until the following frames are sent
+        window=$(( s1 & 0xFF ))
+        [ ${#TRAFFIC_LIST[@]} -gt 0 ] || continue
+        (( window < ${#TRAFFIC_LIST[@]} )) ||
+            proc_warn $taskNo "window of $window frames exceeds the cycle, the frame is released before the next SoC"
+        maxSize=0
+        for i in ${!TRAFFIC_SIZE[@]}
+        do
+            (( maxSize >= TRAFFIC_SIZE[i] )) || maxSize=${TRAFFIC_SIZE[i]}
+        done
+        storedBytes=$(( matchSize + window * maxSize ))
+        (( storedBytes < DATA_BUFF_SIZE )) ||
+            proc_fail $taskNo erDataOv "reorder holds $storedBytes Byte in the frame buffer of $DATA_BUFF_SIZE Byte"
+        continue
+    fi
+
+    [ "${SAFETY_TASK[$name]}" ] || continue
+
+    SAFETY_TASK_NO=$taskNo
+
+    # Context of the safety task
+    key="$frame:$mask"
+    if [ -z "${CONTEXT[$key]}" ]; then
+        CONTEXT[$key]=${#CONTEXT[@]}
+        (( CONTEXT[$key] < GENERIC[gSafetyContexts] )) ||
+            proc_fail $taskNo erTaskConf "frame filter exceeds the ${GENERIC[gSafetyContexts]} safety contexts"
+    fi
+    ctx=${CONTEXT[$key]}
+
+    size=$(( s1 >> 32 & 0xFF ))
+    packets=$(( s1 >> 16 & 0xFFFF ))
+
+    # Rules of SafetyTaskSelection within the context
+    last=${CONTEXT_LAST[ctx]}
+    if [ "$last" ]; then
+        lastS1=${WORD_SETTING1[last-1]}
+        lastName=${TASK_NAME[$(( lastS1 >> 48 & 0xFF ))]}
+        lastCycle=$(( lastS1 >> 56 & 0xFF ))
+        lastPackets=$(( lastS1 >> 16 & 0xFFFF ))
+
+        [ "$lastName" = "$name" ] ||
+            proc_fail $taskNo erTaskConf "$name differs from $lastName of task $last in the same context"
+        (( (lastS1 >> 32 & 0xFF) == size )) ||
+            proc_fail $taskNo erTaskConf "packet size differs from task $last in the same context"
+        [ "$name" != incSeq ] || (( lastPackets == packets )) ||
+            proc_fail $taskNo erTaskConf "number of packets differs from task $last at incSeq"
+        (( cycle >= lastCycle + (lastPackets + ${CONTEXT_MATCH[ctx]} - 1) / CONTEXT_MATCH[ctx] )) ||
+            proc_fail $taskNo erTaskConf "starts while task $last is still active"
+    fi
+    CONTEXT_LAST[ctx]=$taskNo
+    CONTEXT_MATCH[ctx]=$matchCnt
+
+    if [ "$name" = insertion ]; then
+        start=$(( s1 >> 40 & 0xFF ))
+        sn2Start=$(( s1 >> 8 & 0xFF ))
+        (( sn2Start >= start + size || start >= sn2Start + size )) ||
+            proc_fail $taskNo erTaskConf "packet of the second SN overlaps with the manipulated packet"
+    fi
+
+    # Packets of the setting with task, start and size
+    paTask=($name)
+    paStart=($(( s1 >> 40 & 0xFF )))
+    paSize=($size)
+    descr=( $(( (s1 & 0xFF) << 16 | s2 >> 48 & 0xFFFF )) $(( s2 >> 24 & 0xFFFFFF )) $(( s2 & 0xFFFFFF )) )
+    for i in 0 1 2
+    do
+        (( descr[i] >> 16 != 0 )) || continue
+        if (( i + 1 >= GENERIC[gSafetyPackets] )); then
+            proc_fail $taskNo erTaskConf "packet $(( i + 2 )) exceeds gSafetyPackets of ${GENERIC[gSafetyPackets]}"
+            continue
+        fi
+        paTask+=(${TASK_NAME[$(( descr[i] >> 16 ))]})
+        paStart+=($(( descr[i] >> 8 & 0xFF )))
+        paSize+=($(( descr[i] & 0xFF )))
+    done
+
+    # Packets of the Packet_Handler instances, the slots are checked after all tasks are known
+    activeCycles=$(( (packets + matchCnt - 1) / matchCnt ))
+    for i in ${!paTask[@]}
+    do
+        if [ ${#TRAFFIC_LIST[@]} -gt 0 ] && (( paStart[i] + paSize[i] - 1 > matchSize )); then
+            proc_warn $taskNo "packet $(( i + 1 )) ends behind the frame of $matchSize Byte"
+        fi
+
+        proc_cycleEnd $cycle $(( activeCycles - 1 ))
+        last=$CYCLE_END
+
+        # Delaying tasks keep their packets until the operation Reset-Packet-Delay
+        case ${paTask[i]} in
+            repetition)         stored=$(( packets + 1 )); last=$MAX_CYCLE ;;
+            paDelay|incSeq)     stored=$packets; last=$MAX_CYCLE ;;
+            insertion|masquerade)   stored=1 ;;
+            *)                  stored=0 ;;
+        esac
+
+        PK_TASK+=($taskNo)
+        PK_NR+=($(( i + 1 )))
+        PK_HANDLER+=($(( ctx * GENERIC[gSafetyPackets] + i )))
+        PK_SIZE+=(${paSize[i]})
+        PK_STORED+=($stored)
+        PK_FIRST+=($cycle)
+        PK_LAST+=($last)
+
+        proc_occupancyAdd OCC_PACKET $cycle $CYCLE_END $stored
+    done
+done
+
+
+# Regions of the packet buffer --------------------------------------------------------------
+
+# Every handler with a packet gets an equal region, which is renewed at a SoC,
+# while no handler is active or delays packets
+declare -A HANDLER_FIRST
+for i in ${!PK_HANDLER[@]}
+do
+    h=${PK_HANDLER[i]}
+    [ "${HANDLER_FIRST[$h]}" ] && (( HANDLER_FIRST[$h] <= PK_FIRST[i] )) || HANDLER_FIRST[$h]=${PK_FIRST[i]}
+done
+
+if [ ${#HANDLER_FIRST[@]} -gt 0 ]; then
+    REGION_SIZE=$(( PACK_BUFF_SIZE / ${#HANDLER_FIRST[@]} ))
+    echo "Packet buffer regions: ${#HANDLER_FIRST[@]} handlers with $REGION_SIZE Byte each"
+fi
+
+for i in ${!PK_HANDLER[@]}
+do
+    # Slots of the region, one is always used by the next packet
+    slots=$(( REGION_SIZE / (PK_SIZE[i] + 1) ))
+    (( slots <= HANDLER_LIST )) || slots=$HANDLER_LIST
+    (( PK_STORED[i] < slots )) ||
+        proc_fail ${PK_TASK[i]} erPacketOv "packet ${PK_NR[i]} stores ${PK_STORED[i]} packets in $(( slots - 1 )) free slots of its region"
+
+    # A handler, which starts while another one is active or delays packets, gets no region
+    first=${HANDLER_FIRST[${PK_HANDLER[i]}]}
+    (( PK_FIRST[i] == first )) || continue
+    for j in ${!PK_HANDLER[@]}
+    do
+        if (( PK_HANDLER[j] != PK_HANDLER[i] && PK_FIRST[j] < first && PK_LAST[j] >= first )); then
+            proc_fail ${PK_TASK[i]} erPacketOv "packet ${PK_NR[i]} gets no region, because task ${PK_TASK[j]} is active or delays packets in cycle $first"
+            break
+        fi
+    done
+done
+
+if [ "$DELAY_TASK" ] && [ "$SAFETY_TASK_NO" ]; then
+    proc_fail $DELAY_TASK erTaskConf "delay task is mixed with safety task $SAFETY_TASK_NO"
+fi
+
+
+# Round trip of the generated files --------------------------------------------------------
+
+if [ "$OUTPUT_DIR" ]; then
+    proc_readCtrl
+    proc_readTb
+
+    for ext in bin txt vhd
+    do
+        if [ ! -f $OUTPUT_DIR/$SCENARIO_NAME.$ext ]; then
+            echo "ERROR: $OUTPUT_DIR/$SCENARIO_NAME.$ext not found, run fm-scenario.sh first" >&2
+            exit 1
+        fi
+    done
+
+    declare -A DEC_BIN DEC_TXT DEC_VHD DEC_CTRL DEC_TEMPLATE
+    declare -A EXPECTED
+    OBJECTS="1 2 3 4 7 8 B"
+
+    # Expected words of the objects
+    for task in ${!WORD_SETTING1[@]}
+    do
+        EXPECTED[1,$task]=${WORD_SETTING1[task]}
+        EXPECTED[2,$task]=${WORD_SETTING2[task]}
+        EXPECTED[3,$task]=${WORD_FRAME[task]}
+        EXPECTED[4,$task]=${WORD_MASK[task]}
+        EXPECTED[7,$task]=${WORD_WINDOW1[task]}
+        EXPECTED[8,$task]=${WORD_WINDOW2[task]}
+        EXPECTED[B,$task]=${WORD_CHAIN[task]}
+    done
+
+    # Image: blocks of TASK_COUNT little endian words in the order of OBJECTS
+    BYTES=($(od -An -v -tu1 $OUTPUT_DIR/$SCENARIO_NAME.bin))
+    (( ${#BYTES[@]} == 7 * 8 * TASK_COUNT )) ||
+        proc_failWord $SCENARIO_NAME.bin "size in Byte" ${#BYTES[@]} $(( 7 * 8 * TASK_COUNT ))
+    i=0
+    for obj in $OBJECTS
+    do
+        for (( task=0; task<TASK_COUNT; task++ ))
+        do
+            word=0
+            for (( b=7; b>=0; b-- ))
+            do
+                word=$(( word << 8 | ${BYTES[i+b]:-0} ))
+            done
+            DEC_BIN[$obj,$task]=$word
+            i=$(( i + 8 ))
+        done
+    done
+
+    # Object entries: index subindex size value
+    while read -r index sub size value
+    do
+        [[ $index =~ ^0x300([0-9A-F])$ ]] || continue
+        obj=${BASH_REMATCH[1]}
+        case $obj in
+            6) DEC_TEMPLATE[$(( sub - 1 ))]=$(( value )) ;;
+            9) DEC_CTRL[forward,$(( sub ))]=$(( value )) ;;
+            C) DEC_CTRL[start,$(( sub ))]=$(( value )) ;;
+            *) DEC_TXT[$obj,$(( sub - 1 ))]=$(( value )) ;;
+        esac
+    done < $OUTPUT_DIR/$SCENARIO_NAME.txt
+
+    # Generate block: upper part of the words at odd addresses, Bytes of the control register
+    # at the DPRAM selection ctrl
+    declare -A OBJECT_OF_SEL
+    for obj in $OBJECTS
+    do
+        OBJECT_OF_SEL[${TB_SEL[$obj]}]=$obj
+    done
+    declare -A CTRL_BYTE
+    while read -r line
+    do
+        [[ $line =~ X\"([0-9A-Fa-f]{8})\"\ when\ \"([01]+)\" ]] || continue
+        data=$(( 16#${BASH_REMATCH[1]} ))
+        addr=$(( 2#${BASH_REMATCH[2]} ))
+        if (( ${#BASH_REMATCH[2]} != TB_ADDR_WIDTH )); then
+            echo "ERROR: $SCENARIO_NAME.vhd: address ${BASH_REMATCH[2]} hasn't the $TB_ADDR_WIDTH bits of cBankAddr"
+            ERRORS=$(( ERRORS + 1 ))
+            continue
+        fi
+        sel=$(( addr >> (TB_TASK_BITS + 1) ))
+        task=$(( addr >> 1 & (TB_TASK_COUNT - 1) ))
+        if (( sel == TB_SEL[ctrl] )); then
+            CTRL_BYTE[$(( addr & (1 << (TB_TASK_BITS + 1)) - 1 ))]=$data
+            continue
+        fi
+        obj=${OBJECT_OF_SEL[$sel]}
+        if (( addr & 1 )); then
+            DEC_VHD[$obj,$task]=$(( ${DEC_VHD[$obj,$task]:-0} & 0xFFFFFFFF | data << 32 ))
+        else
+            DEC_VHD[$obj,$task]=$(( ${DEC_VHD[$obj,$task]:-0} & ~0xFFFFFFFF | data ))
+        fi
+    done < $OUTPUT_DIR/$SCENARIO_NAME.vhd
+
+    # Compare the task words, the testbench is limited to TB_TASK_COUNT tasks
+    for obj in $OBJECTS
+    do
+        for (( task=0; task<TASK_COUNT; task++ ))
+        do
+            word=${EXPECTED[$obj,$task]:-0}
+            (( DEC_BIN[$obj,$task] == word )) ||
+                proc_failWord $SCENARIO_NAME.bin "task $(( task + 1 )) of 0x300$obj" ${DEC_BIN[$obj,$task]} $word
+            (( ${DEC_TXT[$obj,$task]:-0} == word )) ||
+                proc_failWord $SCENARIO_NAME.txt "task $(( task + 1 )) of 0x300$obj" ${DEC_TXT[$obj,$task]:-0} $word
+            (( task >= TB_TASK_COUNT || ${DEC_VHD[$obj,$task]:-0} == word )) ||
+                proc_failWord $SCENARIO_NAME.vhd "task $(( task + 1 )) of 0x300$obj" ${DEC_VHD[$obj,$task]:-0} $word
+        done
+    done
+
+    for i in ${!WORD_TEMPLATE[@]}
+    do
+        (( ${DEC_TEMPLATE[$i]:-0} == WORD_TEMPLATE[i] )) ||
+            proc_failWord $SCENARIO_NAME.txt "word $(( i + 1 )) of 0x3006" ${DEC_TEMPLATE[$i]:-0} ${WORD_TEMPLATE[i]}
+    done
+
+    # Forwarding and start of the object entries and of the control register
+    for sub in 1 2 3 4 5
+    do
+        word=${WORD_FORWARD[sub]:-0}
+        if (( sub == 1 )); then
+            byte=${CTRL_BYTE[${CTRL_ADDR[cAddrForward]}]:-0}
+        else
+            addr=$(( CTRL_ADDR[cAddrEtherType] + 2*(sub-2) ))
+            byte=$(( ${CTRL_BYTE[$addr]:-0} << 8 | ${CTRL_BYTE[$(( addr + 1 ))]:-0} ))
+        fi
+        (( ${DEC_CTRL[forward,$sub]:-0} == word )) ||
+            proc_failWord $SCENARIO_NAME.txt "0x3009/$sub" ${DEC_CTRL[forward,$sub]:-0} $word
+        (( byte == word )) ||
+            proc_failWord $SCENARIO_NAME.vhd "forwarding 0x3009/$sub" $byte $word
+    done
+
+    startTime=0
+    for (( i=7; i>=0; i-- ))
+    do
+        startTime=$(( startTime << 8 | ${CTRL_BYTE[$(( CTRL_ADDR[cAddrStartTime] + i ))]:-0} ))
+    done
+    for sub in 1 2
+    do
+        word=${WORD_START[sub]}
+        (( sub == 1 )) && byte=${CTRL_BYTE[${CTRL_ADDR[cAddrStartMode]}]:-0} || byte=$startTime
+        (( ${DEC_CTRL[start,$sub]:-0} == word )) ||
+            proc_failWord $SCENARIO_NAME.txt "0x300C/$sub" ${DEC_CTRL[start,$sub]:-0} $word
+        (( byte == word )) ||
+            proc_failWord $SCENARIO_NAME.vhd "start 0x300C/$sub" $byte $word
+    done
+
+    echo "Round trip of $OUTPUT_DIR/$SCENARIO_NAME.bin, .txt and .vhd with cBankAddr=$TB_ADDR_WIDTH of the testbench"
+fi
+
+
+# Report ------------------------------------------------------------------------------------
+
+echo
+echo "Worst case occupancy from cycle on"
+printf '%-6s %-20s %-20s %-20s\n' cycle "frame buffer[Byte]" "address buffer" "packet slots"
+lastLine=
+for (( cycle=1; cycle<=MAX_CYCLE; cycle++ ))
+do
+    printf -v line '%-20d %-20d %-20d' ${OCC_DATA[cycle]:-0} ${OCC_FRAMES[cycle]:-0} ${OCC_PACKET[cycle]:-0}
+    if [ "$line" != "$lastLine" ]; then
+        printf '%-6d %s\n' $cycle "$line"
+        lastLine=$line
+    fi
+done
+
+echo
+if [ $ERRORS -ne 0 ]; then
+    echo "FAILED with $ERRORS errors"
+    exit 1
+fi
+
+echo "PASS"
+exit 0
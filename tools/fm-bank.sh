@@ -0,0 +1,90 @@
+#!/bin/bash
+# Combines the task images of several scenarios to the image of the task banks.
+# Call e.g. ./tools/fm-bank.sh [-t TASK_COUNT] BANK-NAME SCENARIO1.bin [SCENARIO2.bin ...]
+#
+# The SCENARIO_NAME.bin files of tools/fm-scenario.sh are placed one after the
+# other, the first one in bank 0. Each bank is filled up with zeroes to the span
+# of one task table: 8 memory blocks of TASK_COUNT (rounded up to a power of 2)
+# words of 8 Byte. TASK_COUNT is FrameManipulator.gTaskCount, default 32.
+#
+# Generated files:
+#   BANK-NAME.bin   Image of all banks, can be written to object 0x300A/1
+#   BANK-NAME.boot  Image with the header of frameman.c for the flash:
+#                   4 Byte "FBNK", 4 Byte size of the image, little endian
+#                   It is programmed with tools/altera-nios2/flash-device.sh --bank-image
+
+proc_error() {
+    echo "ERROR: $1" >&2
+    exit 1
+}
+
+# Append little endian value to FILE: proc_binValue VALUE BYTES FILE
+proc_binValue() {
+    local -i i
+    local byte
+    for (( i=0; i<$2; i++ ))
+    do
+        printf -v byte '\\x%02X' $(( ($1 >> (8 * i)) & 0xFF ))
+        printf '%b' "$byte" >> $3
+    done
+}
+
+# Maximal number of banks of FrameManipulator.gTaskBanks
+MAX_BANKS=16
+
+TASK_COUNT=32
+if [ "$1" == "-t" ]; then
+    TASK_COUNT=$2
+    shift 2
+fi
+
+BANK_NAME=$1
+shift
+
+if [ -z "$BANK_NAME" ] || [ $# -eq 0 ]; then
+    proc_error "Usage: $0 [-t TASK_COUNT] BANK-NAME SCENARIO1.bin [SCENARIO2.bin ...]"
+fi
+
+if [ $# -gt $MAX_BANKS ]; then
+    proc_error "More than $MAX_BANKS banks"
+fi
+
+# Span of one bank in Byte
+TASKS=1
+while [ $TASKS -lt $TASK_COUNT ]
+do
+    TASKS=$(( TASKS * 2 ))
+done
+BANK_SIZE=$(( 8 * TASKS * 8 ))
+
+# Number of banks of the IP-core, the image covers a power of 2
+BANKS=1
+while [ $BANKS -lt $# ]
+do
+    BANKS=$(( BANKS * 2 ))
+done
+
+> $BANK_NAME.bin
+for IMAGE in "$@"
+do
+    [ -f "$IMAGE" ] || proc_error "Missing image $IMAGE"
+
+    SIZE=$(stat -c %s "$IMAGE")
+    if [ $SIZE -gt $BANK_SIZE ]; then
+        proc_error "$IMAGE has $SIZE Byte, a bank only $BANK_SIZE Byte"
+    fi
+
+    cat "$IMAGE" >> $BANK_NAME.bin
+    head -c $(( BANK_SIZE - SIZE )) /dev/zero >> $BANK_NAME.bin
+done
+
+IMAGE_SIZE=$(stat -c %s $BANK_NAME.bin)
+
+> $BANK_NAME.boot
+proc_binValue 0x4B4E4246 4 $BANK_NAME.boot
+proc_binValue $IMAGE_SIZE 4 $BANK_NAME.boot
+cat $BANK_NAME.bin >> $BANK_NAME.boot
+
+echo "$BANK_NAME.bin: $# banks of $BANK_SIZE Byte, FrameManipulator.gTaskBanks>=$BANKS"
+
+exit 0
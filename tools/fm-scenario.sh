@@ -0,0 +1,240 @@
+#!/bin/bash
+# Compiles a scenario file to the task words of the objects 0x3001-0x3004, 0x3007-0x3008 and 0x300B
+# the template frames of object 0x3006, the forwarding of object 0x3009 and the start of object 0x300C.
+# Call e.g. ./tools/fm-scenario.sh SCENARIO-FILE [OUTPUT-DIR]
+#
+# The scenario file is sourced like a *.settings file and sets:
+#   SCENARIO_NAME   Name of the scenario and of the generated files
+#   TASK_COUNT      Number of configurable tasks (FrameManipulator.gTaskCount), default 32
+#   TASK_LIST       One entry of key=value pairs per task, e.g.
+#                   "task=paLoss cycle=3 mtype=PRes start=41 size=11 packets=2"
+#   TEMPLATE_SIZE   Size of the template memory (FrameManipulator.gBytesOfTheInjectBuffer), default 1024
+#   TEMPLATE_LIST   One entry NAME=HEX per template frame without CRC, e.g.
+#                   "flood=FFFFFFFFFFFF0060654000018... (14-1514 Byte)"
+#   FORWARD_ALL     1 forwards frames of all EtherTypes unchanged, default 0 (only POWERLINK)
+#   FORWARD_VLAN    1 parses VLAN tags in front of the EtherType, default 0
+#   FORWARD_ETHERTYPES  Up to 4 additional EtherTypes (HEX), which are handled like POWERLINK frames
+#   START_MODE      Start of the test of cStartMode, default edge (start operation of 0x3000/1);
+#                   trigger, netTime and relTime arm the test with the start operation
+#   START_TIME      SoC time of the start: SEC:NS for netTime, microseconds for relTime
+#
+# Keys of all tasks:
+#   task=NAME       Task of cTask in framemanipulatorPkg.vhd
+#   cycle=N         Cycle of the series of test (1-255), not for the task start
+#   mtype=NAME      Filter of the MessageType (SoC, PReq, PRes, SoA, ASnd)
+#   dest=N src=N    Filter of the destination and source node
+#   frame=HEX mask=HEX  Raw frame filter and mask of 8 Byte from the MessageType on
+#   filter1=OFFSET:HEX[:MASK] filter2=...
+#                   Filter windows of 1-3 Byte anywhere in the first 48 Byte of the frame,
+#                   offset 1-46 counted from the destination MAC without a VLAN tag,
+#                   default mask of all bits
+#   hits=N          Task chain: number of selected frames (1-255, default 1), after which
+#   arm=TASK disarm=TASK    the task number TASK of TASK_LIST is armed or disarmed,
+#   once=1 stop=1   the task disarms itself or the series of test stops
+#   standby=1       Task is disarmed at the start of the test, until another task arms it
+#   phase=NAME[,NAME]   Phase of the POWERLINK cycle (flags of cCyclePhase: isochronous from the SoC,
+#                   async from the SoA), also for the task start
+#   slot=N          Multiplexed slot (1-255), counted from the SoC, whose flag MC toggled
+#   invited=N service=NAME  Frames behind a SoA, which invited the node N (1-255) and requested the
+#                   service NAME (IdentRequest, StatusRequest, NmtRequest, Unspecified or 1-255)
+# Keys of the single tasks:
+#   trigger:        no settings, the frame is only counted for the task chain
+#   start:          no settings, no cycle and no chain except the phase keys, the first matching frame starts the test
+#                   armed with START_MODE trigger
+#   delay:          type=NAME (cDelayType) time=N (delay in steps of 10 ns)
+#   mani:           mani=OFFSET:HEX[,OFFSET:HEX...] (up to 8 Bytes, offset 1-63)
+#   cut:            size=N (new size of the frame in Byte)
+#   ipg:            gap=N (IPG before the frame in Byte, standard is 12)
+#   duplicate:      copies=N [gap=N] (copies after the frame 1-15, IPG before each copy in Byte)
+#   reorder:        window=N (number of following frames 1-255, which are sent before the frame)
+#   phy:            fault=NAME[,NAME...] (flags of cPhyFault) [preamble=N] [sfd=HEX] [dribble=N] [at=BYTE[.DIBIT]]
+#                   (preamble Bytes in front of the SFD 0-7, SFD instead of D5, dribble dibits behind the CRC 1-15,
+#                    Byte from the destination MAC and dibit 0-3 of abort and txErr)
+#   ber:            ber=MANTISSAe-EXPONENT [burst=N]
+#                   (bit error rate 5e-13 - 1e-3 like 1e-6 or 25e-8, following dibits 0-255 of a burst,
+#                    which flip one bit with a probability of 1/2 after each error)
+#   socTime:        field=NAME[,NAME] (net and/or rel) [offset=N] [drift=N] [walk=N]
+#                   (signed offset and drift per selected SoC in ns for the NetTime and in us for the
+#                    RelativeTime, random step of +-N per selected SoC; only SoCs are shifted)
+#   shape:          rate=N [burst=N] [limit=N] [window=N]
+#                   (rate in kbit/s, bucket size in Byte, waiting frames until the tail drop, SoCs until the end;
+#                    SoCs are never shaped, limit=0 and window=0 don't limit the shaping)
+#   inject:         template=NAME [count=N] [gap=N] [window=N] [inc=OFFSET:STEP[,OFFSET:STEP]]
+#                   (copies after the frame, IPG in Byte, SoCs until the end, up to 2 incremented Bytes;
+#                    count=0 and window=0 don't limit the injection)
+#   safety tasks:   start=N size=N packets=N [sn2start=N]
+#                   [packet2=TASK:START:SIZE packet3=... packet4=...]
+#
+# Generated files in OUTPUT-DIR:
+#   SCENARIO_NAME.bin   Image of the task memory as written by frameman.c, can be written to object 0x300A/1
+#   SCENARIO_NAME.txt   Object entries for the configuration of the CN (index subindex size value)
+#                       including the template frames of object 0x3006, the forwarding of object 0x3009
+#                       and the start of object 0x300C
+#   SCENARIO_NAME.vhd   Generate block for tb/configurateFmBhv.vhd with the address width cBankAddr of a task bank of
+#                       tb/tbFramemanipulator.vhd, including the forwarding and the start in the control register
+
+DIR_TOOLS=$(dirname $0)
+
+source $DIR_TOOLS/fm-scenarioLib.sh
+
+# Get *.scenario file
+SCENARIO_FILE=$1
+OUTPUT_DIR=${2:-.}
+
+# Append 64 bit word as little endian Bytes to BIN
+proc_binWord() {
+    local word
+    printf -v word '\\x%02X' $(( $1 & 0xFF )) $(( $1 >> 8 & 0xFF )) $(( $1 >> 16 & 0xFF )) $(( $1 >> 24 & 0xFF )) \
+                               $(( $1 >> 32 & 0xFF )) $(( $1 >> 40 & 0xFF )) $(( $1 >> 48 & 0xFF )) $(( $1 >> 56 & 0xFF ))
+    BIN+=($word)
+}
+
+# Append word of a task to the VHDL select: proc_vhdWord WORD ADDRESS COMMENT
+proc_vhdWord() {
+    local line
+    printf -v line '                    X"%08X" when "%s",    --%s' $(( $1 & 0xFFFFFFFF )) $2 "$3"
+    VHD+=("$line")
+}
+
+# Address of configurateFmBhv.vhd with the layout of proc_readTb: proc_vhdAddr DPRAM TASK PART
+proc_vhdAddr() {
+    local -i i value=$(( $1 << (TB_TASK_BITS + 1) | $2 << 1 | $3 ))
+    ADDR=
+    for (( i=TB_ADDR_WIDTH-1; i>=0; i-- ))
+    do
+        ADDR+=$(( value >> i & 1 ))
+    done
+}
+
+# Append both parts of a task word: proc_vhdTaskWord OBJECT TASK WORD NAME [DESCRIPTION]
+proc_vhdTaskWord() {
+    proc_vhdAddr ${TB_SEL[$1]} $2 1
+    proc_vhdWord $(( $3 >> 32 )) $ADDR "Task $(( $2 + 1 )) $4 part 1$5"
+    proc_vhdAddr ${TB_SEL[$1]} $2 0
+    proc_vhdWord $3 $ADDR "Task $(( $2 + 1 )) $4 part 2"
+}
+
+# Append a Byte of the control register, zero is the default: proc_vhdCtrl ADDRESS BYTE COMMENT
+proc_vhdCtrl() {
+    (( $2 != 0 )) || return 0
+    proc_vhdAddr ${TB_SEL[ctrl]} $(( $1 >> 1 )) $(( $1 & 1 ))
+    proc_vhdWord $2 $ADDR "$3"
+}
+
+proc_compile
+proc_readCtrl
+proc_readTb
+
+mkdir -p $OUTPUT_DIR
+
+# Image of the task memory: seven blocks of TASK_COUNT words, one for each object
+BIN=()
+TXT=("//// Task configuration $SCENARIO_NAME")
+for obj in 1 2 3 4 7 8 B
+do
+    case $obj in
+        1) words=("${WORD_SETTING1[@]}") ;;
+        2) words=("${WORD_SETTING2[@]}") ;;
+        3) words=("${WORD_FRAME[@]}") ;;
+        4) words=("${WORD_MASK[@]}") ;;
+        7) words=("${WORD_WINDOW1[@]}") ;;
+        8) words=("${WORD_WINDOW2[@]}") ;;
+        B) words=("${WORD_CHAIN[@]}") ;;
+    esac
+
+    for (( task=0; task<TASK_COUNT; task++ ))
+    do
+        proc_binWord ${words[task]:-0}
+    done
+
+    for task in ${!words[@]}
+    do
+        [[ $obj =~ [1-4] ]] || (( words[task] != 0 )) || continue
+        printf -v line '0x300%s\t0x%02X\t0x00000008\t0x%016X' $obj $(( task + 1 )) ${words[task]}
+        TXT+=("$line")
+    done
+done
+
+# Template frames
+if [ ${#WORD_TEMPLATE[@]} -gt 0 ]; then
+    TXT+=("//// Template frames $SCENARIO_NAME")
+    for word in ${!WORD_TEMPLATE[@]}
+    do
+        printf -v line '0x3006\t0x%02X\t0x00000008\t0x%016X' $(( word + 1 )) ${WORD_TEMPLATE[word]}
+        TXT+=("$line")
+    done
+fi
+
+# Forwarding, only if it differs from the default
+if [[ " ${WORD_FORWARD[*]} " =~ \ [1-9] ]]; then
+    TXT+=("//// Forwarding $SCENARIO_NAME")
+    printf -v line '0x3009\t0x01\t0x00000001\t0x%02X' ${WORD_FORWARD[1]}
+    TXT+=("$line")
+    for sub in 2 3 4 5
+    do
+        printf -v line '0x3009\t0x%02X\t0x00000002\t0x%04X' $sub ${WORD_FORWARD[sub]:-0}
+        TXT+=("$line")
+    done
+fi
+
+# Start, only if it differs from the default
+if [[ " ${WORD_START[*]} " =~ \ [1-9] ]]; then
+    TXT+=("//// Start $SCENARIO_NAME")
+    printf -v line '0x300C\t0x01\t0x00000001\t0x%02X' ${WORD_START[1]}
+    TXT+=("$line")
+    printf -v line '0x300C\t0x02\t0x00000008\t0x%016X' ${WORD_START[2]}
+    TXT+=("$line")
+fi
+
+printf '%b' "${BIN[@]}" > $OUTPUT_DIR/$SCENARIO_NAME.bin
+printf '%s\n' "${TXT[@]}" > $OUTPUT_DIR/$SCENARIO_NAME.txt
+
+# Generate block of configurateFmBhv.vhd
+if [ ${#TASK_LIST[@]} -gt $TB_TASK_COUNT ]; then
+    echo "WARNING: Testbench configuration is limited to $TB_TASK_COUNT tasks" >&2
+fi
+
+VHD=()
+for (( task=0; task<${#TASK_LIST[@]} && task<TB_TASK_COUNT; task++ ))
+do
+    proc_vhdTaskWord 1 $task ${WORD_SETTING1[task]} "setting 1" ": ${TASK_LIST[task]}"
+    proc_vhdTaskWord 2 $task ${WORD_SETTING2[task]} "setting 2"
+    proc_vhdTaskWord 3 $task ${WORD_FRAME[task]} "frame data"
+    proc_vhdTaskWord 4 $task ${WORD_MASK[task]} "frame mask"
+
+    (( WORD_WINDOW1[task] == 0 )) || proc_vhdTaskWord 7 $task ${WORD_WINDOW1[task]} "filter window 1"
+    (( WORD_WINDOW2[task] == 0 )) || proc_vhdTaskWord 8 $task ${WORD_WINDOW2[task]} "filter window 2"
+    (( WORD_CHAIN[task] == 0 )) || proc_vhdTaskWord B $task ${WORD_CHAIN[task]} "chain"
+done
+
+# Forwarding and start within the control register
+proc_vhdCtrl ${CTRL_ADDR[cAddrForward]} ${WORD_FORWARD[1]} "Forwarding flags"
+for sub in 2 3 4 5
+do
+    addr=$(( CTRL_ADDR[cAddrEtherType] + 2*(sub-2) ))
+    proc_vhdCtrl $addr $(( ${WORD_FORWARD[sub]:-0} >> 8 )) "EtherType $(( sub - 1 )) high Byte"
+    proc_vhdCtrl $(( addr + 1 )) $(( ${WORD_FORWARD[sub]:-0} & 0xFF )) "EtherType $(( sub - 1 )) low Byte"
+done
+
+proc_vhdCtrl ${CTRL_ADDR[cAddrStartMode]} ${WORD_START[1]} "Start mode"
+for (( i=0; i<8; i++ ))
+do
+    proc_vhdCtrl $(( CTRL_ADDR[cAddrStartTime] + i )) $(( WORD_START[2] >> 8*i & 0xFF )) "Start time Byte $i"
+done
+
+{
+    echo "    $SCENARIO_NAME:"
+    echo "    if gTestSetting=\"$SCENARIO_NAME\" generate"
+    echo
+    echo "        --! Generate configuration"
+    echo "        with iWrCommAddr select"
+    printf '%s\n' "${VHD[0]/#                    /        oCommData<= }"
+    [ ${#VHD[@]} -gt 1 ] && printf '%s\n' "${VHD[@]:1}"
+    echo "                    X\"00000000\" when others;"
+    echo
+    echo "    end generate $SCENARIO_NAME;"
+} > $OUTPUT_DIR/$SCENARIO_NAME.vhd
+
+echo "$SCENARIO_NAME: ${#TASK_LIST[@]} tasks, ${#TEMPLATE_LIST[@]} templates"
+
+exit 0
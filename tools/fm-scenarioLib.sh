@@ -0,0 +1,675 @@
+#!/bin/bash
+# Common functions of the scenario tools, sourced by fm-scenario.sh and fm-analyze.sh.
+# See fm-scenario.sh for the format of the scenario file.
+
+FM_PKG=${FM_PKG:-$(dirname ${BASH_SOURCE[0]})/../fpga/ipcore/altera/fm/src/framemanipulatorPkg.vhd}
+FM_CTRL=${FM_CTRL:-$(dirname ${BASH_SOURCE[0]})/../fpga/ipcore/altera/fm/src/src_components/Control_Register.vhd}
+FM_TB=${FM_TB:-$(dirname ${BASH_SOURCE[0]})/../fpga/ipcore/altera/fm/tb/tbFramemanipulator.vhd}
+
+# Set defaults
+SCENARIO_NAME=
+TASK_COUNT=32
+TASK_LIST=()
+TEMPLATE_SIZE=1024
+TEMPLATE_LIST=()
+
+# POWERLINK MessageTypes
+declare -A MTYPE=([SoC]=0x01 [PReq]=0x03 [PRes]=0x04 [SoA]=0x05 [ASnd]=0x06)
+
+# RequestedServiceIDs of the SoA
+declare -A SERVICE=([IdentRequest]=0x01 [StatusRequest]=0x02 [NmtRequest]=0x03 [Unspecified]=0xFF)
+
+declare -A TASK_CODE
+declare -A DELAY_CODE
+declare -A CHAIN_FLAG
+declare -A START_CODE
+declare -A PHY_FLAG
+declare -A PHASE_FLAG
+declare -A TIME_FLAG
+declare -A SAFETY_TASK
+declare -A TEMPLATE_START
+declare -A TEMPLATE_LENGTH
+declare -A CTRL_ADDR
+declare -A TB_SEL
+
+# Print error of the current entry and exit
+proc_error() {
+    echo "ERROR: $SCENARIO_FILE $ENTRY: $1" >&2
+    exit 1
+}
+
+# Read the codes and numbers of a record constant in the package: proc_readPkg CONSTANT ARRAY
+proc_readPkg() {
+    local line inConst=0
+    local pattern="^constant $1 "
+    local -n codes=$2
+
+    while read -r line
+    do
+        if [[ $line =~ $pattern ]]; then
+            inConst=1
+        elif [ $inConst -eq 1 ]; then
+            if [[ $line =~ ^([a-zA-Z0-9]+)\ *=\>\ *X\"([0-9A-Fa-f]+)\" ]]; then
+                codes[${BASH_REMATCH[1]}]=$(( 16#${BASH_REMATCH[2]} ))
+            elif [[ $line =~ ^([a-zA-Z0-9]+)\ *=\>\ *([0-9]+) ]]; then
+                codes[${BASH_REMATCH[1]}]=${BASH_REMATCH[2]}
+            elif [[ $line =~ \)\; ]]; then
+                return
+            fi
+        fi
+    done < $FM_PKG
+}
+
+# Read the tasks of isSafetyTask in the package body
+proc_readSafetyTasks() {
+    local line inBody=0
+
+    while read -r line
+    do
+        if [[ $line =~ ^package\ body ]]; then
+            inBody=1
+        elif [ $inBody -eq 1 ]; then
+            while [[ $line =~ cTask\.([a-zA-Z0-9]+)(.*) ]]
+            do
+                SAFETY_TASK[${BASH_REMATCH[1]}]=1
+                line=${BASH_REMATCH[2]}
+            done
+        fi
+    done < $FM_PKG
+}
+
+# Read the addresses cAddr* of the control register
+proc_readCtrl() {
+    local line
+
+    while read -r line
+    do
+        if [[ $line =~ ^constant\ (cAddr[a-zA-Z]+)\ *:\ *natural\ *:=\ *([0-9]+)\; ]]; then
+            CTRL_ADDR[${BASH_REMATCH[1]}]=${BASH_REMATCH[2]}
+        fi
+    done < $FM_CTRL
+}
+
+# Read the address layout of tb/configurateFmBhv.vhd from the address width of a task bank (cBankAddr)
+# and the word width (gTaskBytesPerWord) of the testbench
+# Address: DPRAM selection of the object (3 bit) & task (TB_TASK_BITS) & part of the 64 bit word (1 bit)
+# The DPRAMs are selected like in Task_Memory.vhd, the unused selection 7 holds the control register
+proc_readTb() {
+    local line bytes=
+    local -A param=()
+
+    TB_ADDR_WIDTH=
+    while read -r line
+    do
+        if [[ $line =~ constant\ +cBankAddr\ *:\ *natural\ *:=\ *([0-9]+) ]]; then
+            TB_ADDR_WIDTH=${BASH_REMATCH[1]}
+        elif [[ $line =~ gTaskBytesPerWord\ *=\>\ *([0-9]+) ]]; then
+            bytes=${BASH_REMATCH[1]}
+        fi
+    done < $FM_TB
+
+    if [ -z "$TB_ADDR_WIDTH" ] || [ "$bytes" != 4 ]; then
+        echo "ERROR: $FM_TB doesn't set cBankAddr with gTaskBytesPerWord of 4" >&2
+        exit 1
+    fi
+
+    proc_readPkg cParam param
+    if (( 5 + param[noOfFilterWindows] > 7 )); then
+        echo "ERROR: Testbench configuration needs an unused DPRAM for the control register" >&2
+        exit 1
+    fi
+
+    TB_TASK_BITS=$(( TB_ADDR_WIDTH - 4 ))
+    TB_TASK_COUNT=$(( 1 << TB_TASK_BITS ))
+    TB_SEL=([1]=0 [2]=1 [3]=2 [4]=3 [7]=4 [8]=5 [B]=$(( 4 + param[noOfFilterWindows] )) [ctrl]=7)
+}
+
+# Check value of a key: proc_range KEY VALUE MIN MAX
+proc_range() {
+    [[ $2 =~ ^(0x[0-9A-Fa-f]+|[0-9]+)$ ]] || proc_error "$1=$2 isn't a number"
+    (( $2 >= $3 && $2 <= $4 )) || proc_error "$1=$2 is out of range $3-$4"
+}
+
+# Split an entry into the key value pairs of the array arg of the caller
+proc_parse() {
+    local pair
+
+    for pair in $1
+    do
+        [[ $pair =~ ^([a-zA-Z0-9]+)=(.+)$ ]] || proc_error "invalid key value pair $pair"
+        arg[${BASH_REMATCH[1]}]=${BASH_REMATCH[2]}
+    done
+}
+
+# Get the frame filter FRAME and MASK from the array arg of the caller
+proc_filter() {
+    local key value
+
+    FRAME=0
+    MASK=0
+
+    if [ "${arg[mtype]}" ]; then
+        [ "${MTYPE[${arg[mtype]}]}" ] || proc_error "unknown MessageType ${arg[mtype]}"
+        FRAME=$(( FRAME | MTYPE[${arg[mtype]}] << 56 ))
+        MASK=$(( MASK | 0xFF << 56 ))
+    fi
+
+    if [ "${arg[dest]}" ]; then
+        proc_range dest "${arg[dest]}" 0 255
+        FRAME=$(( FRAME | arg[dest] << 48 ))
+        MASK=$(( MASK | 0xFF << 48 ))
+    fi
+
+    if [ "${arg[src]}" ]; then
+        proc_range src "${arg[src]}" 0 255
+        FRAME=$(( FRAME | arg[src] << 40 ))
+        MASK=$(( MASK | 0xFF << 40 ))
+    fi
+
+    for key in frame mask
+    do
+        value=${arg[$key]}
+        if [ "$value" ]; then
+            [[ $value =~ ^[0-9A-Fa-f]{1,16}$ ]] || proc_error "$key=$value isn't a hex value of 8 Byte"
+            if [ $key = frame ]; then
+                FRAME=$(( FRAME | 16#$value ))
+            else
+                MASK=$(( MASK | 16#$value ))
+            fi
+        fi
+    done
+}
+
+# Get the filter windows WINDOW1 and WINDOW2 from the array arg of the caller
+# Window word: offset of the first Byte << 48 | 3 Byte data << 24 | 3 Byte mask
+proc_windows() {
+    local -i win offset bytes data mask
+    local value
+
+    for win in 1 2
+    do
+        printf -v WINDOW$win '%d' 0
+        value=${arg[filter$win]}
+        [ "$value" ] || continue
+
+        [[ $value =~ ^([0-9]+):([0-9A-Fa-f]{2,6})(:([0-9A-Fa-f]{2,6}))?$ ]] || proc_error "invalid filter$win=$value, use OFFSET:HEX[:MASK]"
+        offset=${BASH_REMATCH[1]}
+        bytes=$(( ${#BASH_REMATCH[2]} / 2 ))
+        (( ${#BASH_REMATCH[2]} % 2 == 0 )) || proc_error "filter$win=$value has an odd number of hex digits"
+        data=$(( 16#${BASH_REMATCH[2]} << (8*(3-bytes)) ))
+        if [ "${BASH_REMATCH[4]}" ]; then
+            (( ${#BASH_REMATCH[4]} == 2*bytes )) || proc_error "mask of filter$win=$value doesn't fit with the data"
+            mask=$(( 16#${BASH_REMATCH[4]} << (8*(3-bytes)) ))
+        else
+            mask=$(( (1 << 8*bytes) - 1 << (8*(3-bytes)) ))
+        fi
+        (( mask != 0 )) || proc_error "mask of filter$win=$value is zero"
+        proc_range offset $offset 1 46
+
+        printf -v WINDOW$win '%d' $(( offset << 48 | data << 24 | mask ))
+    done
+}
+
+# Get the task chain CHAIN from the array arg of the caller
+# Chain word: flags of cChain << 56 | hits << 48 | armed task << 40 | disarmed task << 32
+#             | flags of cCyclePhase << 24 | multiplexed slot << 16 | invited node << 8 | service
+proc_chain() {
+    local key value flags=0 hits=0 phase=0 service=0
+
+    CHAIN=0
+    for key in standby once stop
+    do
+        [ "${arg[$key]}" ] || continue
+        proc_range $key "${arg[$key]}" 0 1
+        flags=$(( flags | arg[$key] << CHAIN_FLAG[$key] ))
+    done
+
+    for key in arm disarm
+    do
+        [ "${arg[$key]}" ] && proc_range $key "${arg[$key]}" 1 ${#TASK_LIST[@]}
+    done
+
+    if [ "${arg[arm]}${arg[disarm]}" ] || (( flags & ~(1 << CHAIN_FLAG[standby]) )); then
+        proc_range hits "${arg[hits]:-1}" 1 255
+        hits=${arg[hits]:-1}
+    elif [ "${arg[hits]}" ]; then
+        proc_error "hits without arm, disarm, once or stop"
+    fi
+
+    for value in ${arg[phase]//,/ }
+    do
+        [ "${PHASE_FLAG[$value]}" ] || proc_error "unknown phase $value"
+        phase=$(( phase | 1 << PHASE_FLAG[$value] ))
+    done
+
+    for key in slot invited
+    do
+        [ "${arg[$key]}" ] && proc_range $key "${arg[$key]}" 1 255
+    done
+
+    if [ "${arg[service]}" ]; then
+        service=${SERVICE[${arg[service]}]:-${arg[service]}}
+        proc_range service $service 1 255
+    fi
+
+    CHAIN=$(( flags << 56 | hits << 48 | ${arg[arm]:-0} << 40 | ${arg[disarm]:-0} << 32 |
+              phase << 24 | ${arg[slot]:-0} << 16 | ${arg[invited]:-0} << 8 | service ))
+}
+
+# Encode the entry of a task into SETTING1, SETTING2, FRAME, MASK, WINDOW1, WINDOW2 and CHAIN
+proc_encode() {
+    local key value pair offset data
+    local -A arg=()
+    local -a paStart paSize
+
+    proc_parse "$1"
+
+    key=${arg[task]}
+    [ "$key" ] || proc_error "task is missing"
+    [ "${TASK_CODE[$key]}" ] || proc_error "unknown task $key"
+    if [ $key = start ]; then
+        # Start tasks are compared before the test regardless of the cycle
+        [ -z "${arg[cycle]}" ] || proc_error "start task without cycle"
+        arg[cycle]=0
+    else
+        proc_range cycle "${arg[cycle]}" 1 255
+    fi
+
+    SETTING1=$(( arg[cycle] << 56 | TASK_CODE[$key] << 48 ))
+    SETTING2=0
+
+    proc_filter
+    (( MASK != 0 )) || proc_error "frame filter is missing"
+    proc_windows
+    proc_chain
+    [ $key != start ] || (( CHAIN >> 32 == 0 )) || proc_error "start task without task chain"
+
+    # Settings of the task
+    case ${arg[task]} in
+        delay)
+            [ "${DELAY_CODE[${arg[type]}]}" ] || proc_error "unknown delay type ${arg[type]}"
+            proc_range time "${arg[time]}" 1 $(( (1 << 40) - 1 ))
+            SETTING1=$(( SETTING1 | DELAY_CODE[${arg[type]}] << 40 | arg[time] ))
+            ;;
+
+        mani)
+            [ "${arg[mani]}" ] || proc_error "mani is missing"
+            local -i cnt=0
+            for pair in ${arg[mani]//,/ }
+            do
+                [[ $pair =~ ^([0-9]+):([0-9A-Fa-f]{1,2})$ ]] || proc_error "invalid manipulation $pair"
+                offset=${BASH_REMATCH[1]}
+                data=$(( 16#${BASH_REMATCH[2]} ))
+                proc_range offset $offset 1 63
+                (( cnt < 8 )) || proc_error "more than 8 manipulated Bytes"
+                SETTING1=$(( SETTING1 | offset << (6*cnt) ))
+                SETTING2=$(( SETTING2 | data << (8*cnt) ))
+                cnt+=1
+            done
+            ;;
+
+        cut)
+            proc_range size "${arg[size]}" 1 2047
+            SETTING1=$(( SETTING1 | arg[size] ))
+            ;;
+
+        ipg)
+            proc_range gap "${arg[gap]}" 0 65535
+            SETTING1=$(( SETTING1 | arg[gap] ))
+            ;;
+
+        duplicate)
+            proc_range copies "${arg[copies]}" 1 15
+            proc_range gap "${arg[gap]:-12}" 0 65535
+            SETTING1=$(( SETTING1 | arg[copies] << 16 | ${arg[gap]:-12} ))
+            ;;
+
+        reorder)
+            proc_range window "${arg[window]}" 1 255
+            SETTING1=$(( SETTING1 | arg[window] ))
+            ;;
+
+        shape)
+            # Rate in kbit/s as fraction of a Byte per clock cycle of 20 ns
+            proc_range rate "${arg[rate]}" 1 100000
+            proc_range burst "${arg[burst]:-1514}" 0 65535
+            proc_range limit "${arg[limit]:-0}" 0 255
+            proc_range window "${arg[window]:-0}" 0 255
+            value=$(( (arg[rate] * (1 << 24) + 200000) / 400000 ))
+            SETTING1=$(( SETTING1 | value << 24 | ${arg[burst]:-1514} << 8 | ${arg[limit]:-0} ))
+            SETTING2=$(( ${arg[window]:-0} << 56 ))
+            ;;
+
+        inject)
+            key=${arg[template]}
+            [ "$key" ] || proc_error "template is missing"
+            [ "${TEMPLATE_START[$key]}" ] || proc_error "unknown template $key"
+            proc_range count "${arg[count]:-0}" 0 65535
+            proc_range gap "${arg[gap]:-12}" 0 65535
+            proc_range window "${arg[window]:-0}" 0 255
+            SETTING1=$(( SETTING1 | TEMPLATE_START[$key] << 32 | TEMPLATE_LENGTH[$key] << 16 | ${arg[count]:-0} ))
+            SETTING2=$(( ${arg[gap]:-12} << 48 | ${arg[window]:-0} << 40 ))
+
+            # Incremented Bytes: first one at Byte 4-5, second one at Byte 6-7 of SETTING2
+            local -i cnt=0
+            for pair in ${arg[inc]//,/ }
+            do
+                [[ $pair =~ ^([0-9]+):([0-9]+)$ ]] || proc_error "invalid increment $pair"
+                offset=${BASH_REMATCH[1]}
+                data=${BASH_REMATCH[2]}
+                proc_range offset $offset 1 ${TEMPLATE_LENGTH[$key]}
+                (( offset <= 255 )) || proc_error "offset=$offset is out of range 1-255"
+                proc_range step $data 0 255
+                (( cnt < 2 )) || proc_error "more than 2 incremented Bytes"
+                SETTING2=$(( SETTING2 | (offset << 8 | data) << (24-16*cnt) ))
+                cnt+=1
+            done
+            ;;
+
+        phy)
+            # Flags of cPhyFault << 40 | preamble << 32 | SFD << 24 | dribble dibits << 16 | position in dibits
+            local -i flags=0 pos=0
+            [ "${arg[fault]}" ] || proc_error "fault is missing"
+            for value in ${arg[fault]//,/ }
+            do
+                [ "${PHY_FLAG[$value]}" ] || proc_error "unknown fault $value"
+                [ "$value" != ber ] || proc_error "fault ber is set by the task ber"
+                flags=$(( flags | 1 << PHY_FLAG[$value] ))
+            done
+
+            if (( flags & 1 << PHY_FLAG[preamble] )); then
+                proc_range preamble "${arg[preamble]}" 0 7
+                SETTING1=$(( SETTING1 | arg[preamble] << 32 ))
+            fi
+            if (( flags & 1 << PHY_FLAG[sfd] )); then
+                [[ ${arg[sfd]} =~ ^[0-9A-Fa-f]{1,2}$ ]] || proc_error "sfd=${arg[sfd]} isn't a HEX Byte"
+                SETTING1=$(( SETTING1 | 16#${arg[sfd]} << 24 ))
+            fi
+            if (( flags & 1 << PHY_FLAG[dribble] )); then
+                proc_range dribble "${arg[dribble]}" 1 15
+                SETTING1=$(( SETTING1 | arg[dribble] << 16 ))
+            fi
+            if (( flags & (1 << PHY_FLAG[abort] | 1 << PHY_FLAG[txErr]) )); then
+                # Byte counted from the destination MAC and dibit within the Byte
+                [[ ${arg[at]} =~ ^([0-9]+)(\.([0-3]))?$ ]] || proc_error "at=${arg[at]} isn't BYTE[.DIBIT]"
+                pos=$(( 10#${BASH_REMATCH[1]} ))
+                value=${BASH_REMATCH[3]:-0}
+                proc_range at $pos 1 2047
+                SETTING1=$(( SETTING1 | (4 * (pos - 1) + value) ))
+            fi
+            SETTING1=$(( SETTING1 | flags << 40 ))
+            ;;
+
+        ber)
+            # Rate << 16 | burst dibits << 8, bit error rate = rate / 2^41
+            [[ ${arg[ber]} =~ ^([0-9]{1,4})[eE]-([0-9]{1,2})$ ]] || proc_error "ber=${arg[ber]} isn't MANTISSAe-EXPONENT"
+            local -i mant=$(( 10#${BASH_REMATCH[1]} )) exp=$(( 10#${BASH_REMATCH[2]} )) div=1
+            proc_range burst "${arg[burst]:-0}" 0 255
+            (( exp <= 15 )) || proc_error "ber=${arg[ber]} is out of range 5e-13 - 1e-3"
+            for (( ; exp > 0; exp-- )); do div=$(( div * 10 )); done
+            value=$(( (mant * (1 << 41) + div / 2) / div ))
+            (( value >= 1 && value <= 0xFFFFFFFF )) || proc_error "ber=${arg[ber]} is out of range 5e-13 - 1e-3"
+            SETTING1=$(( SETTING1 | value << 16 | ${arg[burst]:-0} << 8 ))
+            ;;
+
+        socTime)
+            # Flags of cTimeShift << 40 | offset << 8, drift << 32 | step of the random walk
+            local -i flags=0
+            [ "${arg[field]}" ] || proc_error "field is missing"
+            for value in ${arg[field]//,/ }
+            do
+                [ "$value" = net ] || [ "$value" = rel ] || proc_error "unknown field $value"
+                flags=$(( flags | 1 << TIME_FLAG[$value] ))
+            done
+            for key in offset drift
+            do
+                value=${arg[$key]:-0}
+                [[ $value =~ ^-?[0-9]+$ ]] || proc_error "$key=$value isn't a number"
+                (( value >= -(1 << 31) && value < (1 << 31) )) || proc_error "$key=$value is out of range -2^31 - 2^31-1"
+            done
+            if [ "${arg[walk]}" ]; then
+                proc_range walk "${arg[walk]}" 1 $(( (1 << 31) - 1 ))
+                flags=$(( flags | 1 << TIME_FLAG[walk] ))
+            fi
+            SETTING1=$(( SETTING1 | flags << 40 | (${arg[offset]:-0} & 0xFFFFFFFF) << 8 ))
+            SETTING2=$(( (${arg[drift]:-0} & 0xFFFFFFFF) << 32 | ${arg[walk]:-0} ))
+            ;;
+
+        drop|crc|trigger|start)
+            ;;
+
+        *)
+            # Safety tasks
+            proc_range start "${arg[start]}" 1 255
+            proc_range size "${arg[size]}" 1 255
+            proc_range packets "${arg[packets]}" 1 65535
+            if [ "${arg[sn2start]}" ]; then
+                proc_range sn2start "${arg[sn2start]}" 1 255
+            elif [ ${arg[task]} = insertion ]; then
+                proc_error "sn2start is missing"
+            fi
+
+            SETTING1=$(( SETTING1 | arg[start] << 40 | arg[size] << 32 | arg[packets] << 16 | ${arg[sn2start]:-0} << 8 ))
+            paStart=(${arg[start]})
+            paSize=(${arg[size]})
+
+            # Descriptors of further packets: descriptor 1 at Byte 7-9, 2 at 10-12, 3 at 13-15
+            local -i descr descrPos i paStartNew paSizeNew
+            for descr in 1 2 3
+            do
+                value=${arg[packet$(( descr + 1 ))]}
+                [ "$value" ] || continue
+
+                [[ $value =~ ^([a-zA-Z0-9]+):([0-9]+):([0-9]+)$ ]] || proc_error "invalid packet$(( descr + 1 ))=$value"
+                key=${BASH_REMATCH[1]}
+                paStartNew=${BASH_REMATCH[2]}
+                paSizeNew=${BASH_REMATCH[3]}
+                [ "${SAFETY_TASK[$key]}" ] || proc_error "packet$(( descr + 1 )) with $key isn't a safety task"
+                proc_range start $paStartNew 1 255
+                proc_range size $paSizeNew 1 255
+
+                for i in ${!paStart[@]}
+                do
+                    (( paStartNew >= paStart[i] + paSize[i] || paStartNew + paSizeNew <= paStart[i] )) ||
+                        proc_error "packet$(( descr + 1 )) overlaps with packet$(( i + 1 ))"
+                done
+                paStart+=($paStartNew)
+                paSize+=($paSizeNew)
+
+                value=$(( TASK_CODE[$key] << 16 | paStartNew << 8 | paSizeNew ))
+                if [ $descr -eq 1 ]; then
+                    SETTING1=$(( SETTING1 | value >> 16 ))
+                    SETTING2=$(( SETTING2 | (value & 0xFFFF) << 48 ))
+                else
+                    descrPos=$(( 24*(3-descr) ))
+                    SETTING2=$(( SETTING2 | value << descrPos ))
+                fi
+            done
+            ;;
+    esac
+
+    [ "${SAFETY_TASK[${arg[task]}]}" ] && return
+
+    for key in start packets sn2start packet2 packet3 packet4
+    do
+        [ "${arg[$key]}" ] && proc_error "$key is only used by safety tasks"
+    done
+    return 0
+}
+
+# Pack the template frames of TEMPLATE_LIST into the little endian words of WORD_TEMPLATE
+proc_templates() {
+    local entry name value
+    local -i start=0 i
+    local -a bytes=()
+
+    WORD_TEMPLATE=()
+
+    for entry in "${TEMPLATE_LIST[@]}"
+    do
+        ENTRY="template $entry"
+        [[ $entry =~ ^([a-zA-Z][a-zA-Z0-9_]*)=([0-9A-Fa-f]+)$ ]] || proc_error "invalid template, use NAME=HEX"
+        name=${BASH_REMATCH[1]}
+        value=${BASH_REMATCH[2]}
+        ENTRY="template $name"
+        [ "${TEMPLATE_START[$name]}" ] && proc_error "template is defined twice"
+        (( ${#value} % 2 == 0 )) || proc_error "odd number of hex digits"
+        (( ${#value} / 2 >= 14 && ${#value} / 2 <= 1514 )) || proc_error "frame size of $(( ${#value} / 2 )) Byte is out of range 14-1514"
+        (( start + ${#value} / 2 <= TEMPLATE_SIZE )) || proc_error "templates exceed TEMPLATE_SIZE of $TEMPLATE_SIZE Byte"
+
+        TEMPLATE_START[$name]=$start
+        TEMPLATE_LENGTH[$name]=$(( ${#value} / 2 ))
+
+        for (( i=0; i<${#value}; i+=2 ))
+        do
+            bytes+=($(( 16#${value:i:2} )))
+        done
+        start+=${#value}/2
+    done
+
+    for (( i=0; i<${#bytes[@]}; i++ ))
+    do
+        WORD_TEMPLATE[i/8]=$(( ${WORD_TEMPLATE[i/8]:-0} | bytes[i] << (8*(i%8)) ))
+    done
+}
+
+# Encode FORWARD_ALL, FORWARD_VLAN and FORWARD_ETHERTYPES into the subindexes 1-5 of WORD_FORWARD
+proc_forwarding() {
+    local type
+    local -i i=2
+
+    ENTRY="forwarding"
+    WORD_FORWARD=()
+
+    (( ${#FORWARD_ETHERTYPES[@]} <= 4 )) || proc_error "more than 4 FORWARD_ETHERTYPES"
+    [[ ${FORWARD_ALL:-0} =~ ^[01]$ ]] || proc_error "FORWARD_ALL isn't 0 or 1"
+    [[ ${FORWARD_VLAN:-0} =~ ^[01]$ ]] || proc_error "FORWARD_VLAN isn't 0 or 1"
+
+    WORD_FORWARD[1]=$(( ${FORWARD_ALL:-0} | ${FORWARD_VLAN:-0} << 1 ))
+
+    for type in "${FORWARD_ETHERTYPES[@]}"
+    do
+        [[ $type =~ ^[0-9A-Fa-f]{4}$ ]] || proc_error "EtherType $type isn't a 4 digit hex value"
+        (( 16#$type != 0 )) || proc_error "EtherType 0000 is reserved for unused entries"
+        WORD_FORWARD[i]=$(( 16#$type ))
+        i+=1
+    done
+}
+
+# Get the start mode and time of object 0x300C into WORD_START
+# Time of the NetTime in SEC:NS, seconds above the nanoseconds like the IP-core compares it
+proc_start() {
+    local mode=${START_MODE:-edge}
+
+    ENTRY="start"
+    WORD_START=()
+
+    [ "${START_CODE[$mode]}" ] || proc_error "unknown START_MODE $mode"
+    WORD_START[1]=${START_CODE[$mode]}
+    WORD_START[2]=0
+
+    case $mode in
+        netTime)
+            [[ ${START_TIME} =~ ^([0-9]+):([0-9]+)$ ]] || proc_error "START_TIME $START_TIME isn't SEC:NS"
+            local sec=$(( 10#${BASH_REMATCH[1]} )) ns=$(( 10#${BASH_REMATCH[2]} ))
+            proc_range seconds $sec 0 $(( (1 << 32) - 1 ))
+            proc_range nanoseconds $ns 0 999999999
+            WORD_START[2]=$(( sec << 32 | ns ))
+            ;;
+        relTime)
+            proc_range START_TIME "${START_TIME}" 0 $(( (1 << 63) - 1 ))
+            WORD_START[2]=$START_TIME
+            ;;
+        *)
+            [ -z "$START_TIME" ] || proc_error "START_TIME without START_MODE netTime or relTime"
+            ;;
+    esac
+}
+
+# Read the scenario file and encode its tasks into WORD_SETTING1, WORD_SETTING2, WORD_FRAME, WORD_MASK,
+# WORD_WINDOW1 and WORD_WINDOW2, its template frames into WORD_TEMPLATE, its forwarding into WORD_FORWARD
+# and its start into WORD_START
+proc_compile() {
+    if [ ! -f "$SCENARIO_FILE" ]; then
+        echo "ERROR: Scenario file $SCENARIO_FILE not found" >&2
+        exit 1
+    fi
+
+    # Get scenario from *.scenario file
+    source $SCENARIO_FILE
+
+    [[ $SCENARIO_NAME =~ ^[a-zA-Z][a-zA-Z0-9_]*$ ]] || {
+        echo "ERROR: SCENARIO_NAME $SCENARIO_NAME isn't a valid name" >&2
+        exit 1
+    }
+
+    if [ ${#TASK_LIST[@]} -gt $TASK_COUNT ]; then
+        echo "ERROR: ${#TASK_LIST[@]} tasks exceed TASK_COUNT of $TASK_COUNT" >&2
+        exit 1
+    fi
+
+    # Get codes from the package
+    proc_readPkg cTask TASK_CODE
+    proc_readPkg cDelayType DELAY_CODE
+    proc_readPkg cChain CHAIN_FLAG
+    proc_readPkg cStartMode START_CODE
+    proc_readPkg cPhyFault PHY_FLAG
+    proc_readPkg cCyclePhase PHASE_FLAG
+    proc_readPkg cTimeShift TIME_FLAG
+    proc_readSafetyTasks
+    proc_templates
+    proc_forwarding
+    proc_start
+
+    local i
+
+    WORD_SETTING1=()
+    WORD_SETTING2=()
+    WORD_FRAME=()
+    WORD_MASK=()
+    WORD_WINDOW1=()
+    WORD_WINDOW2=()
+    WORD_CHAIN=()
+
+    TASK_NO=1
+    for i in "${TASK_LIST[@]}"
+    do
+        ENTRY="task $TASK_NO"
+        proc_encode "$i"
+        WORD_SETTING1+=($SETTING1)
+        WORD_SETTING2+=($SETTING2)
+        WORD_FRAME+=($FRAME)
+        WORD_MASK+=($MASK)
+        WORD_WINDOW1+=($WINDOW1)
+        WORD_WINDOW2+=($WINDOW2)
+        WORD_CHAIN+=($CHAIN)
+        TASK_NO=$(( TASK_NO + 1 ))
+    done
+
+    # Tasks in standby have to be armed by the chain of another task
+    local -i j armed
+    for i in ${!WORD_CHAIN[@]}
+    do
+        (( WORD_CHAIN[i] >> 56 & 1 << CHAIN_FLAG[standby] )) || continue
+        ENTRY="task $(( i + 1 ))"
+        armed=0
+        for j in ${!WORD_CHAIN[@]}
+        do
+            (( j != i && (WORD_CHAIN[j] >> 40 & 0xFF) == i + 1 )) && armed=1
+        done
+        (( armed )) || proc_error "standby task isn't armed by any other task"
+    done
+
+    # Start tasks are only used by the start mode trigger, which needs at least one
+    local -i starts=0
+    for i in ${!WORD_SETTING1[@]}
+    do
+        (( (WORD_SETTING1[i] >> 48 & 0xFF) != TASK_CODE[start] )) || starts+=1
+    done
+    ENTRY="start"
+    if [ "${START_MODE:-edge}" = trigger ]; then
+        (( starts )) || proc_error "START_MODE trigger without start task"
+    elif (( starts )); then
+        proc_error "start task without START_MODE trigger"
+    fi
+}
@@ -0,0 +1,198 @@
+#!/bin/bash
+# Converts stimulation files of ethPktGen to the binary format of ethPktGenBin and back.
+# Call e.g. ./tools/fm-stimbin.sh to-bin STIM-FILE BIN-FILE [START_NS] [PERIOD_NS]
+#           ./tools/fm-stimbin.sh to-txt BIN-FILE STIM-FILE
+#           ./tools/fm-stimbin.sh stress BIN-FILE SIZE IPG BURST CYCLES [START_NS]
+#
+# Binary format, one record per frame:
+#   8 Byte  Start time of the frame in ns, little endian
+#   2 Byte  Number of Bytes, little endian
+#   N Byte  Frame with preamble and CRC
+#
+# to-bin sets the start times to START_NS + n*PERIOD_NS like the trigger of
+# tbFramemanipulator (default 60000 ns and 10020 ns).
+#
+# stress generates CYCLES POWERLINK cycles of one SoC and BURST-1 PRes of SIZE
+# Byte (without preamble, with CRC), sent back to back with an inter-packet gap
+# of IPG Byte. The cycles are separated by 10 us.
+
+proc_error() {
+    echo "ERROR: $1" >&2
+    exit 1
+}
+
+# Append little endian value: proc_binValue VALUE BYTES
+proc_binValue() {
+    local -i i
+    local byte
+    for (( i=0; i<$2; i++ ))
+    do
+        printf -v byte '\\x%02X' $(( ($1 >> (8 * i)) & 0xFF ))
+        BIN+=($byte)
+    done
+}
+
+# Time of one Byte at 100 MBit/s in ns
+BYTE_TIME=80
+
+# Ethernet CRC of the Bytes in FRAME: proc_crc
+proc_crc() {
+    local -i crc=0xFFFFFFFF
+    local -i byte
+    local -i bit
+
+    for byte in ${FRAME[@]}
+    do
+        crc=$(( crc ^ byte ))
+        for (( bit=0; bit<8; bit++ ))
+        do
+            crc=$(( (crc >> 1) ^ (0xEDB88320 & -(crc & 1)) ))
+        done
+    done
+
+    CRC=$(( ~crc & 0xFFFFFFFF ))
+}
+
+# Frame with preamble and CRC as printf-escapes: proc_plkFrame SIZE MTYPE SOURCE
+proc_plkFrame() {
+    local -i i
+    local byte
+
+    # Destination multicast, source MAC, EtherType, MessageType, destination, source node
+    FRAME=(0x01 0x11 0x1E 0x00 0x00 0x01 0x00 0x60 0x65 0x18 0x5A 0x3E 0x88 0xAB $2 0xFF $3)
+    for (( i=${#FRAME[@]}; i<$1-4; i++ ))
+    do
+        FRAME+=($(( i & 0xFF )))
+    done
+
+    proc_crc
+    FRAME+=($(( CRC & 0xFF )) $(( CRC >> 8 & 0xFF )) $(( CRC >> 16 & 0xFF )) $(( CRC >> 24 )))
+
+    ESC=('\x55' '\x55' '\x55' '\x55' '\x55' '\x55' '\x55' '\xD5')
+    for i in ${FRAME[@]}
+    do
+        printf -v byte '\\x%02X' $i
+        ESC+=($byte)
+    done
+}
+
+proc_stress() {
+    local -i size=$2
+    local -i ipg=$3
+    local -i burst=$4
+    local -i cycles=$5
+    local -i time=${6:-60000}
+    local -i cycle
+    local -i nr
+    local soc=()
+    local pres=()
+
+    [ $size -ge 64 ] && [ $size -le 1518 ] || proc_error "Frame size $size isn't within 64 and 1518"
+    [ $ipg -ge 12 ] || proc_error "Inter-packet gap $ipg is less than 12 Byte"
+    [ $burst -ge 1 ] && [ $cycles -ge 1 ] && [ $cycles -le 255 ] || proc_error "Invalid burst $burst or cycles $cycles"
+
+    proc_plkFrame $size 0x01 0xF0
+    soc=("${ESC[@]}")
+    proc_plkFrame $size 0x04 0x01
+    pres=("${ESC[@]}")
+
+    BIN=()
+    for (( cycle=0; cycle<cycles; cycle++ ))
+    do
+        for (( nr=0; nr<burst; nr++ ))
+        do
+            proc_binValue $time 8
+            proc_binValue $(( size + 8 )) 2
+            if [ $nr -eq 0 ]; then
+                BIN+=("${soc[@]}")
+            else
+                BIN+=("${pres[@]}")
+            fi
+            time=$(( time + (size + 8 + ipg) * BYTE_TIME ))
+        done
+        time=time+10000
+    done
+
+    printf '%b' "${BIN[@]}" > $1
+}
+
+proc_toBin() {
+    local -i start=${3:-60000}
+    local -i period=${4:-10020}
+    local -i count=0
+    local -i time=$start
+    local line
+    local frame=()
+
+    BIN=()
+
+    while read -r line || [ -n "$line" ]
+    do
+        line=${line%%#*}
+        line=${line//[[:space:]]/}
+        [ -z "$line" ] && continue
+
+        if [ $count -eq 0 ]; then
+            count=$line
+            frame=()
+            [ $count -gt 0 ] || proc_error "Invalid frame size $line in $1"
+        else
+            [[ $line =~ ^[0-9A-Fa-f]{1,2}$ ]] || proc_error "Invalid Byte $line in $1"
+            frame+=("\\x$line")
+            count=count-1
+
+            if [ $count -eq 0 ]; then
+                proc_binValue $time 8
+                proc_binValue ${#frame[@]} 2
+                BIN+=("${frame[@]}")
+                time=time+period
+            fi
+        fi
+    done < $1
+
+    [ $count -eq 0 ] || proc_error "Last frame of $1 is incomplete"
+
+    printf '%b' "${BIN[@]}" > $2
+}
+
+proc_toTxt() {
+    local -a data
+    local -i pos=0
+    local -i length
+    local -i nr=0
+    local -i i
+    local txt=()
+    local line
+
+    data=($(od -An -v -tu1 $1))
+
+    while [ $pos -lt ${#data[@]} ]
+    do
+        [ $(( pos + 10 )) -le ${#data[@]} ] || proc_error "Incomplete header in $1"
+
+        length=$(( data[pos + 8] + (data[pos + 9] << 8) ))
+        pos=pos+10
+        nr=nr+1
+
+        [ $(( pos + length )) -le ${#data[@]} ] || proc_error "Frame $nr of $1 is incomplete"
+
+        txt+=("$length # Frame $nr")
+        for (( i=0; i<length; i++ ))
+        do
+            printf -v line '%02X' ${data[pos + i]}
+            txt+=($line)
+        done
+        pos=pos+length
+    done
+
+    printf '%s\n' "${txt[@]}" > $2
+}
+
+case $1 in
+    to-bin) proc_toBin "${@:2}" ;;
+    to-txt) proc_toTxt "${@:2}" ;;
+    stress) proc_stress "${@:2}" ;;
+    *)      proc_error "Unknown command $1, use to-bin, to-txt or stress" ;;
+esac
+
+exit 0
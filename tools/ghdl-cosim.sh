@@ -0,0 +1,119 @@
+#!/bin/bash
+# Runs GHDL to simulate the provided sources together with the firmware in C.
+# Call e.g. ./tools/ghdl-cosim.sh SETTING-FILE [DIR_TOOLS]
+#
+# The firmware is linked via VHPIDIRECT. Libraries of LIB_LIST are compiled from
+# their lib*.settings files, altera_mf is taken from ALTERA_LIB_DIR (precompiled
+# with the vendor scripts of GHDL).
+#
+# Needed parameters of the setting file:
+# SRC_LIST:     VHDL sources
+# C_LIST:       C sources of the firmware
+# C_INCLUDE:    Include paths of the firmware
+# TOP_LEVEL:    Toplevel of the testbench
+# COSIM_LIST:   One run per entry: "SCENARIO-FILE|FMCOSIM_OPERATION|GENERICS[|image]"
+#               With "image" the tasks are uploaded as image of object 0x300A/1
+# Optional:
+# STIM_FILE_BIN: Binary stimulation file, which is converted from STIM_FILE
+
+proc_genList() {
+    export GENLIST=
+
+    for i in $*
+    do
+        GENLIST+="-g$i "
+        shift
+    done
+}
+
+# Get *.settings file
+SETTINGS_FILE=$1
+DIR_TOOLS=${2:-$(dirname $0)}
+
+# Set defaults
+LIB_LIST=
+SRC_LIST=
+C_LIST=
+C_INCLUDE=
+TOP_LEVEL=
+COSIM_LIST=("")
+VHDL_STD="93c"
+ALTERA_LIB_DIR=${ALTERA_LIB_DIR:-/usr/local/lib/ghdl/vendors/altera}
+WORK_DIR=ghdl-work
+
+# Get parameters from *.settings file
+source $SETTINGS_FILE
+
+GHDL_FLAGS="--std=$VHDL_STD --workdir=$WORK_DIR -P$WORK_DIR -P$ALTERA_LIB_DIR -fexplicit -frelaxed-rules --ieee=synopsys"
+
+echo
+echo "#### $TOP_LEVEL (co-simulation) ####"
+
+mkdir -p $WORK_DIR
+
+#compile libraries
+for LIBSET in $LIB_LIST
+do
+    LIB_SRC=
+    LIB_NAME=
+    source $LIBSET
+
+    ghdl -a $GHDL_FLAGS --work=$LIB_NAME $LIB_SRC || exit 1
+done
+
+#compile source files
+ghdl -a $GHDL_FLAGS --work=work $SRC_LIST || exit 1
+
+#compile firmware
+OBJ_LIST=
+for i in $C_LIST
+do
+    OBJ=$WORK_DIR/$(basename ${i%.c}).o
+
+    gcc -c -O1 -fPIC $(printf -- '-I%s ' $C_INCLUDE) -o $OBJ $i || exit 1
+    OBJ_LIST+="-Wl,$OBJ "
+done
+
+#elaborate with firmware
+ghdl -e $GHDL_FLAGS -o $WORK_DIR/$TOP_LEVEL $OBJ_LIST -Wl,-lpthread $TOP_LEVEL || exit 1
+
+#convert stimulation file for ethPktGenBin
+if [ -n "$STIM_FILE_BIN" ]; then
+    $DIR_TOOLS/fm-stimbin.sh to-bin $STIM_FILE $STIM_FILE_BIN || exit 1
+fi
+
+RET=0
+for i in "${COSIM_LIST[@]}"
+do
+    IFS='|' read SCENARIO OPERATION GENERICS UPLOAD <<< "$i"
+
+    proc_genList $GENERICS
+
+    #task configuration of the scenario
+    SCENARIO_NAME=$($DIR_TOOLS/fm-scenario.sh $SCENARIO $WORK_DIR) || exit 1
+
+    export FMCOSIM_TASKS=$WORK_DIR/${SCENARIO_NAME%%:*}.txt
+    export FMCOSIM_OPERATION=$OPERATION
+    export FMCOSIM_IMAGE=
+
+    if [ "$UPLOAD" == "image" ]; then
+        FMCOSIM_IMAGE=$WORK_DIR/${SCENARIO_NAME%%:*}.bin
+    fi
+
+    #simulate design
+    ./$WORK_DIR/$TOP_LEVEL $GENLIST --ieee-asserts=disable-at-0
+
+    #catch simulation return
+    RET=$?
+
+    echo
+    if [ $RET -ne 0 ]; then
+        echo "ERROR"
+        exit $RET
+    else
+        echo "PASS"
+    fi
+done
+
+#exit with simulation return
+exit $RET
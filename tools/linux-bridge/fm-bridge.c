@@ -0,0 +1,1690 @@
+/**
+********************************************************************************
+\file   fm-bridge.c
+
+\brief  Software Framemanipulator between two Linux network interfaces
+
+The bridge forwards the frames between two interfaces via memory mapped
+AF_PACKET rings and executes the tasks of the Framemanipulator on the frames
+from the input to the output interface. The tasks are loaded from an image of
+the task memory with the objects 0x3001-0x3004, like it is generated by
+tools/fm-scenario.sh.
+
+Build:  gcc -O2 -Wall -pthread -o fm-bridge fm-bridge.c
+Call:   fm-bridge -i IN-IF -o OUT-IF -t TASK-IMAGE [-w] [-n] [-a] [-v] [-e ETHERTYPE ...]
+                  [-s trigger|netTime:SEC:NS|relTime:US]
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2014, Bernecker+Rainer Industrie-Elektronik Ges.m.b.H. (B&R)
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+#define FRAMEMAN_TASK_OBJECTS       7       //Objects 0x3001-0x3004, 0x3007-0x3008 and 0x300B within the task image
+#define FRAMEMAN_FILTER_WINDOWS     2       //framemanipulatorPkg.cParam.noOfFilterWindows
+#define FRAMEMAN_MAX_CYCLE          255     //Cycles of the series of test
+#define FRAMEMAN_NO_DEL_FRAMES      255     //framemanipulatorPkg.cParam.noDelFrames
+#define FRAMEMAN_SAFETY_PACKETS     4       //framemanipulatorPkg.cParam.maxSafetyPackets
+#define FRAMEMAN_SAFETY_CONTEXTS    2       //FrameManipulator.gSafetyContexts
+#define FRAMEMAN_PACKET_SLOTS       512     //Stored packets of each safety packet
+#define FRAMEMAN_CUT_MASK           0x7FF   //Width of the frame buffer address for the Cut task
+#define FRAMEMAN_IPG_SIZE           12      //framemanipulatorPkg.cCreateTime.ipgSize in Byte
+#define FRAMEMAN_BYTE_TIME          80      //Time of one Byte at 100 Mbit/s in ns
+
+//Tasks of framemanipulatorPkg.cTask
+#define TASK_DROP                   0x01
+#define TASK_DELAY                  0x02
+#define TASK_MANI                   0x04
+#define TASK_CRC                    0x08
+#define TASK_CUT                    0x10
+#define TASK_IPG                    0x20
+#define TASK_TRIGGER                0x07
+#define TASK_START                  0x09
+#define TASK_REPETITION             0x81
+#define TASK_PALOSS                 0x82
+#define TASK_INSERTION              0x83
+#define TASK_INCSEQ                 0x84
+#define TASK_INCDATA                0x85
+#define TASK_PADELAY                0x86
+#define TASK_MASQUERADE             0x87
+
+//Flags of the task chain framemanipulatorPkg.cChain
+#define CHAIN_STANDBY               0x01
+#define CHAIN_ONCE                  0x02
+#define CHAIN_STOP                  0x04
+
+//Flags of the cycle phase framemanipulatorPkg.cCyclePhase
+#define PHASE_ISOCHRONOUS           0x01
+#define PHASE_ASYNC                 0x02
+
+//Start modes of framemanipulatorPkg.cStartMode
+#define START_EDGE                  0x00
+#define START_TRIGGER               0x01
+#define START_NET_TIME              0x02
+#define START_REL_TIME              0x03
+
+//Delay types of framemanipulatorPkg.cDelayType
+#define DELAY_PASS                  0x01
+#define DELAY_DELETE                0x02
+#define DELAY_PASS_SOC              0x04
+
+//Error flags of the status register 0x3000/2
+#define STATUS_ER_DATA_OV           0x10
+#define STATUS_ER_FRAME_OV          0x20
+#define STATUS_ER_PACKET_OV         0x40
+#define STATUS_ER_TASK_CONF         0x80
+
+//Frame positions, counted from the destination MAC address
+#define FRAME_ETHER_TYPE            12      //framemanipulatorPkg.cEth.startEtherType-1
+#define FRAME_FILTER                14      //framemanipulatorPkg.cEth.startFrameFilter-1
+#define FRAME_WINDOW_END            48      //framemanipulatorPkg.cEth.endWindowFilter without the VLAN tag
+#define FRAME_VLAN_TAG              4       //framemanipulatorPkg.cEth.sizeVlanTag
+#define FRAME_SOC_TIME              20      //Packet_Handler.cSocTimeStart-1
+#define FRAME_SOC_FLAGS             18      //framemanipulatorPkg.cEth.startSocFlags-1
+#define FRAME_SOA_SERVICE           20      //framemanipulatorPkg.cEth.startSoaService-1
+#define FRAME_SOA_TARGET            21      //framemanipulatorPkg.cEth.startSoaTarget-1
+#define SOC_FLAG_MC                 0x80    //framemanipulatorPkg.cEth.socFlagMc
+#define FRAME_PAYLOAD               4       //Packet_Handler.cFirstPayloadByte
+#define FRAME_MAX_SIZE              1536
+
+#define ETHERTYPE_POWERLINK         0x88AB
+#define ETHERTYPE_VLAN              0x8100  //framemanipulatorPkg.cEth.vlanTpid
+#define FORWARD_ETHERTYPES          4       //framemanipulatorPkg.cEth.noCfgEtherType
+
+#define FRAME_DROP                  0       //Frame isn't forwarded
+#define FRAME_TASKS                 1       //Frame is forwarded and manipulated by the tasks
+#define FRAME_BYPASS                2       //Frame is forwarded without tasks
+#define MESSAGETYPE_SOC             0x01
+#define MESSAGETYPE_SOA             0x05
+
+//Ring configuration
+#define RING_FRAME_SIZE             2048
+#define RING_FRAME_NR               4096
+#define RING_BLOCK_SIZE             (RING_FRAME_SIZE * 16)
+#define RING_BATCH                  64      //Frames per send call
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief  Task of the task memory
+
+The setting holds the Bytes of the objects 0x3001 and 0x3002 in the order of
+the hardware, starting with the cycle and the task.
+*/
+typedef struct
+{
+    uint8_t     aSetting[16];   ///< Setting with cycle, task and parameters
+    uint64_t    frame;          ///< Frame filter of object 0x3003
+    uint64_t    mask;           ///< Frame mask of object 0x3004
+    uint64_t    aWindow[FRAMEMAN_FILTER_WINDOWS];   ///< Filter windows of the objects 0x3007-0x3008
+    uint8_t     aChain[8];      ///< Flags, hits, armed and disarmed task, phase, slot, node and service of object 0x300B
+    unsigned    hitCnt;         ///< Selected frames of the series of test
+    int         armed;          ///< Task was armed by a chain
+    int         disarmed;       ///< Task was disarmed by a chain
+} tTask;
+
+/**
+\brief  Packet memory of one safety packet
+*/
+typedef struct
+{
+    uint8_t     aaPacket[FRAMEMAN_PACKET_SLOTS][256];   ///< Stored packets
+    unsigned    head;                                   ///< Oldest packet
+    unsigned    count;                                  ///< Number of stored packets
+    uint8_t     aLast[256];                             ///< Last packet, which was put out
+    uint8_t     aSn2[256];                              ///< Last packet of the second SN
+} tPacketMem;
+
+/**
+\brief  Safety context with its tasks and packet memories
+*/
+typedef struct
+{
+    uint64_t    frame;                                  ///< Frame filter of the context
+    uint64_t    mask;                                   ///< Frame mask of the context
+    int         aTask[256];                             ///< Safety tasks ordered by cycle
+    int         taskCount;                              ///< Number of tasks
+    int         current;                                ///< Current or last task
+    int         active;                                 ///< Manipulation is active
+    int         twisted;                                ///< Packets of Incorrect-Sequence are reversed
+    unsigned    frameCnt;                               ///< Manipulated safety frames
+    tPacketMem  aMem[FRAMEMAN_SAFETY_PACKETS];          ///< Memory of each safety packet
+} tContext;
+
+/**
+\brief  Delayed or queued frame
+*/
+typedef struct
+{
+    uint8_t     aData[FRAME_MAX_SIZE];  ///< Frame data
+    unsigned    len;                    ///< Frame length
+    uint64_t    sendTime;               ///< Earliest send time in ns
+    uint64_t    rxTime;                 ///< Receive time in ns
+    int         distortCrc;             ///< Frame is sent with a wrong CRC
+} tQueueFrame;
+
+/**
+\brief  Interface with its RX and TX ring
+*/
+typedef struct
+{
+    const char*         pName;      ///< Name of the interface
+    int                 fd;         ///< Packet socket
+    uint8_t*            pRing;      ///< Mapped RX ring followed by TX ring
+    unsigned            rxPos;      ///< Next RX frame
+    unsigned            txPos;      ///< Next TX frame
+    unsigned            txPending;  ///< Frames of TX ring, which wait for send
+} tInterface;
+
+/**
+\brief  Statistic of one direction
+*/
+typedef struct
+{
+    uint64_t    rxFrames;           ///< Received frames
+    uint64_t    txFrames;           ///< Sent frames
+    uint64_t    dropFrames;         ///< Dropped frames
+    uint64_t    latencySum;         ///< Sum of the residence times in ns
+    uint64_t    latencyMin;         ///< Minimal residence time in ns
+    uint64_t    latencyMax;         ///< Maximal residence time in ns
+    uint64_t    latencyCnt;         ///< Number of measured residence times
+} tStatistic;
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+static tTask*               pTasks_l;
+static int                  taskCount_l;
+static tContext             aContext_l[FRAMEMAN_SAFETY_CONTEXTS];
+static int                  contextCount_l;
+
+static tQueueFrame          aQueue_l[FRAMEMAN_NO_DEL_FRAMES];
+static unsigned             queueHead_l;
+static unsigned             queueCount_l;
+static uint8_t              delayType_l;
+
+static uint8_t              aSocData_l[256];
+
+//Cycle structure of the Cycle_Tracker
+static uint8_t              phase_l;
+static int                  mc_l = -1;
+static uint8_t              muxSlot_l;
+static uint8_t              invitedNode_l;
+static uint8_t              invitedService_l;
+static int                  soaPending_l;
+static uint8_t              soaNode_l;
+static uint8_t              soaService_l;
+
+static tInterface           ifIn_l;
+static tInterface           ifOut_l;
+static tStatistic           aStat_l[2];
+
+static volatile int         running_l = 1;
+static volatile int         startTest_l;
+static volatile int         stopTest_l;
+static int                  testActive_l;
+static unsigned             cycle_l;
+static volatile uint8_t     status_l;
+static int                  noFcs_l;
+
+//EtherTypes of framemanipulatorPkg.cEth.filterEtherType
+static const uint16_t       aEtherType_l[] = {0x88AB, 0x0800, 0x0806, 0x3E3F};
+
+//Forwarding of object 0x3009
+static int                  forwardAll_l;
+static int                  forwardVlan_l;
+static uint16_t             aCfgEtherType_l[FORWARD_ETHERTYPES];
+static int                  cfgEtherTypeCount_l;
+
+//Start of object 0x300C
+static int                  startMode_l = START_EDGE;
+static uint64_t             startTime_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+static uint64_t getTime(void);
+static uint32_t crc32(const uint8_t* pData_p, unsigned len_p);
+static int      loadTasks(const char* pFile_p);
+static int      openInterface(tInterface* pIf_p, const char* pName_p, int noFcs_p);
+static void     sendFrame(tInterface* pIf_p, tStatistic* pStat_p, const uint8_t* pData_p,
+                          unsigned len_p, int distortCrc_p, uint64_t rxTime_p);
+static void     flushInterface(tInterface* pIf_p);
+static void     setError(uint8_t flag_p);
+static int      processFrame(uint8_t* pData_p, unsigned* pLen_p, int* pDistortCrc_p,
+                             uint64_t rxTime_p);
+static int      classifyFrame(const uint8_t* pData_p, unsigned len_p, unsigned* pTag_p);
+static int      matchWindows(const tTask* pTask_p, const uint8_t* pData_p, unsigned len_p, unsigned tag_p);
+static void     trackCycle(const uint8_t* pData_p, unsigned len_p, unsigned tag_p, int class_p);
+static int      matchPhase(const tTask* pTask_p);
+static void     hitChain(int task_p);
+static void     startSeries(void);
+static uint64_t getSocTime(void);
+static void     processSafety(uint8_t* pData_p, unsigned len_p);
+static void     processQueue(void);
+static void*    forwardThread(void* pArg_p);
+static void     signalHandler(int signal_p);
+
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Main function of the bridge
+
+Loads the tasks, opens both interfaces and starts one busy-polling thread per
+direction. The series of test is started with the first SoC or with the signal
+SIGUSR1, when option -w is used. SIGUSR2 stops the test.
+
+Like object 0x3009, option -a forwards the frames of all EtherTypes without
+tasks, option -v parses VLAN tags and option -e adds up to four EtherTypes,
+which are handled like POWERLINK frames.
+
+Like object 0x300C, option -s arms the test instead of starting it: it starts
+with the first frame of a start task or with the first SoC at or behind the
+NetTime or RelativeTime. Cycle 1 is the cycle behind the start.
+
+\return The function returns 0 or 1 at an error.
+*/
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    const char* pIn = NULL;
+    const char* pOut = NULL;
+    const char* pTaskFile = NULL;
+    int         wait = 0;
+    int         noFcs = 1;
+    int         opt;
+    int         dir;
+    int         usage = 0;
+    char*       pEnd;
+    pthread_t   aThread[2];
+
+    while ((opt = getopt(argc, argv, "i:o:t:wnave:s:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'i':   pIn = optarg;       break;
+            case 'o':   pOut = optarg;      break;
+            case 't':   pTaskFile = optarg; break;
+            case 'w':   wait = 1;           break;
+            case 'n':   noFcs = 0;          break;
+            case 'a':   forwardAll_l = 1;   break;
+            case 'v':   forwardVlan_l = 1;  break;
+            case 'e':
+            {
+                unsigned long type = strtoul(optarg, &pEnd, 16);
+
+                if ((*pEnd != '\0') || (type == 0) || (type > 0xFFFF) ||
+                    (cfgEtherTypeCount_l == FORWARD_ETHERTYPES))
+                {
+                    fprintf(stderr, "Invalid EtherType %s, up to %d non-zero hex values\n",
+                            optarg, FORWARD_ETHERTYPES);
+                    return 1;
+                }
+                aCfgEtherType_l[cfgEtherTypeCount_l++] = type;
+                break;
+            }
+            case 's':
+            {
+                unsigned long long  sec;
+                unsigned long       ns;
+
+                if (strcmp(optarg, "trigger") == 0)
+                {
+                    startMode_l = START_TRIGGER;
+                }
+                else if ((sscanf(optarg, "netTime:%llu:%lu", &sec, &ns) == 2) &&
+                         (sec <= 0xFFFFFFFF) && (ns < 1000000000))
+                {
+                    //Seconds above the nanoseconds like the comparison of the IP-core
+                    startMode_l = START_NET_TIME;
+                    startTime_l = ((uint64_t)sec << 32) | ns;
+                }
+                else if (strncmp(optarg, "relTime:", 8) == 0)
+                {
+                    startMode_l = START_REL_TIME;
+                    startTime_l = strtoull(optarg + 8, &pEnd, 10);
+                    usage = (*pEnd != '\0') || (optarg[8] == '\0');
+                }
+                else
+                {
+                    usage = 1;
+                }
+                break;
+            }
+            default:
+                usage = 1;
+                break;
+        }
+    }
+
+    if (usage || (pIn == NULL) || (pOut == NULL) || (pTaskFile == NULL))
+    {
+        fprintf(stderr, "Usage: %s -i IN-IF -o OUT-IF -t TASK-IMAGE [-w] [-n] [-a] [-v] [-e ETHERTYPE ...]\n"
+                        "       [-s trigger|netTime:SEC:NS|relTime:US]\n", argv[0]);
+        return 1;
+    }
+
+    if (loadTasks(pTaskFile) != 0)
+        return 1;
+
+    //The CRC is only appended by the bridge, when a CRC-Distortion task exists
+    noFcs_l = 0;
+    if (noFcs)
+    {
+        int task;
+        for (task = 0; task < taskCount_l; task++)
+        {
+            if (pTasks_l[task].aSetting[1] == TASK_CRC)
+                noFcs_l = 1;
+        }
+    }
+
+    if ((openInterface(&ifIn_l, pIn, 0) != 0) || (openInterface(&ifOut_l, pOut, noFcs_l) != 0))
+        return 1;
+
+    signal(SIGINT, signalHandler);
+    signal(SIGTERM, signalHandler);
+    signal(SIGUSR1, signalHandler);
+    signal(SIGUSR2, signalHandler);
+
+    startTest_l = !wait;
+
+    for (dir = 0; dir < 2; dir++)
+    {
+        if (pthread_create(&aThread[dir], NULL, forwardThread, (void*)(intptr_t)dir) != 0)
+        {
+            perror("pthread_create");
+            return 1;
+        }
+    }
+
+    for (dir = 0; dir < 2; dir++)
+        pthread_join(aThread[dir], NULL);
+
+    for (dir = 0; dir < 2; dir++)
+    {
+        tStatistic* pStat = &aStat_l[dir];
+
+        printf("%s -> %s: rx %llu tx %llu drop %llu",
+               dir == 0 ? pIn : pOut, dir == 0 ? pOut : pIn,
+               (unsigned long long)pStat->rxFrames, (unsigned long long)pStat->txFrames,
+               (unsigned long long)pStat->dropFrames);
+
+        if (pStat->latencyCnt != 0)
+        {
+            printf(" latency min %llu avg %llu max %llu ns",
+                   (unsigned long long)pStat->latencyMin,
+                   (unsigned long long)(pStat->latencySum / pStat->latencyCnt),
+                   (unsigned long long)pStat->latencyMax);
+        }
+        printf("\n");
+    }
+
+    printf("Status 0x%02X\n", status_l);
+
+    return 0;
+}
+
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Current time of the monotonic clock
+
+\return The function returns the time in ns.
+*/
+//------------------------------------------------------------------------------
+static uint64_t getTime(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Ethernet CRC of a frame
+
+\param  pData_p             Frame data without CRC
+\param  len_p               Frame length
+
+\return The function returns the CRC.
+*/
+//------------------------------------------------------------------------------
+static uint32_t crc32(const uint8_t* pData_p, unsigned len_p)
+{
+    uint32_t    crc = 0xFFFFFFFF;
+    unsigned    i;
+    int         bit;
+
+    for (i = 0; i < len_p; i++)
+    {
+        crc ^= pData_p[i];
+        for (bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+
+    return ~crc;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Load the image of the task memory
+
+The image consists of seven blocks with one little endian 64 bit word per task,
+one block for each object 0x3001-0x3004, 0x3007-0x3008 and 0x300B. The safety tasks are assigned to their
+contexts by their frame filter like in SafetyContextSelection.
+
+\param  pFile_p             Task image
+
+\return The function returns 0 or -1 at an error.
+*/
+//------------------------------------------------------------------------------
+static int loadTasks(const char* pFile_p)
+{
+    FILE*       pFile;
+    long        size;
+    uint8_t*    pImage;
+    int         task;
+    int         obj;
+    int         i;
+
+    pFile = fopen(pFile_p, "rb");
+    if (pFile == NULL)
+    {
+        perror(pFile_p);
+        return -1;
+    }
+
+    fseek(pFile, 0, SEEK_END);
+    size = ftell(pFile);
+    fseek(pFile, 0, SEEK_SET);
+
+    if ((size == 0) || (size % (FRAMEMAN_TASK_OBJECTS * 8) != 0))
+    {
+        fprintf(stderr, "%s isn't an image of the task memory\n", pFile_p);
+        fclose(pFile);
+        return -1;
+    }
+
+    pImage = malloc(size);
+    if ((pImage == NULL) || (fread(pImage, 1, size, pFile) != (size_t)size))
+    {
+        fprintf(stderr, "Reading of %s failed\n", pFile_p);
+        fclose(pFile);
+        return -1;
+    }
+    fclose(pFile);
+
+    taskCount_l = size / (FRAMEMAN_TASK_OBJECTS * 8);
+    pTasks_l = calloc(taskCount_l, sizeof(tTask));
+    if (pTasks_l == NULL)
+        return -1;
+
+    for (task = 0; task < taskCount_l; task++)
+    {
+        uint64_t aWord[FRAMEMAN_TASK_OBJECTS];
+
+        for (obj = 0; obj < FRAMEMAN_TASK_OBJECTS; obj++)
+        {
+            const uint8_t* pWord = &pImage[(obj * taskCount_l + task) * 8];
+
+            aWord[obj] = 0;
+            for (i = 7; i >= 0; i--)
+                aWord[obj] = (aWord[obj] << 8) | pWord[i];
+        }
+
+        for (i = 0; i < 8; i++)
+        {
+            pTasks_l[task].aSetting[i]     = aWord[0] >> (56 - 8 * i);
+            pTasks_l[task].aSetting[i + 8] = aWord[1] >> (56 - 8 * i);
+        }
+        pTasks_l[task].frame = aWord[2];
+        pTasks_l[task].mask  = aWord[3];
+        for (i = 0; i < FRAMEMAN_FILTER_WINDOWS; i++)
+            pTasks_l[task].aWindow[i] = aWord[4 + i];
+        for (i = 0; i < 8; i++)
+            pTasks_l[task].aChain[i] = aWord[4 + FRAMEMAN_FILTER_WINDOWS] >> (56 - 8 * i);
+
+        //Assign safety tasks to their context
+        if (pTasks_l[task].aSetting[1] & 0x80)
+        {
+            tContext* pCtx = NULL;
+
+            for (i = 0; i < contextCount_l; i++)
+            {
+                if ((aContext_l[i].frame == pTasks_l[task].frame) && (aContext_l[i].mask == pTasks_l[task].mask))
+                    pCtx = &aContext_l[i];
+            }
+
+            if (pCtx == NULL)
+            {
+                if (contextCount_l == FRAMEMAN_SAFETY_CONTEXTS)
+                {
+                    fprintf(stderr, "Task %d exceeds the %d safety contexts\n", task + 1, FRAMEMAN_SAFETY_CONTEXTS);
+                    status_l |= STATUS_ER_TASK_CONF;
+                    continue;
+                }
+
+                pCtx = &aContext_l[contextCount_l++];
+                pCtx->frame = pTasks_l[task].frame;
+                pCtx->mask = pTasks_l[task].mask;
+            }
+
+            //Insert ordered by cycle
+            for (i = pCtx->taskCount; (i > 0) && (pTasks_l[pCtx->aTask[i - 1]].aSetting[0] > pTasks_l[task].aSetting[0]); i--)
+                pCtx->aTask[i] = pCtx->aTask[i - 1];
+            pCtx->aTask[i] = task;
+            pCtx->taskCount++;
+        }
+    }
+
+    free(pImage);
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Open interface with memory mapped RX and TX ring
+
+\param  pIf_p               Interface
+\param  pName_p             Name of the interface
+\param  noFcs_p             The CRC is appended by the bridge
+
+\return The function returns 0 or -1 at an error.
+*/
+//------------------------------------------------------------------------------
+static int openInterface(tInterface* pIf_p, const char* pName_p, int noFcs_p)
+{
+    struct tpacket_req  req;
+    struct sockaddr_ll  addr;
+    struct packet_mreq  mreq;
+    int                 version = TPACKET_V2;
+    int                 one = 1;
+
+    memset(pIf_p, 0, sizeof(*pIf_p));
+    pIf_p->pName = pName_p;
+
+    pIf_p->fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+    if (pIf_p->fd < 0)
+    {
+        perror("socket");
+        return -1;
+    }
+
+    if (setsockopt(pIf_p->fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) != 0)
+    {
+        perror("PACKET_VERSION");
+        return -1;
+    }
+
+    //Sent frames of the bridge aren't received again
+    setsockopt(pIf_p->fd, SOL_PACKET, PACKET_IGNORE_OUTGOING, &one, sizeof(one));
+
+    //Frames are sent without a check of the ring
+    setsockopt(pIf_p->fd, SOL_PACKET, PACKET_QDISC_BYPASS, &one, sizeof(one));
+
+    if (noFcs_p && (setsockopt(pIf_p->fd, SOL_SOCKET, SO_NOFCS, &one, sizeof(one)) != 0))
+    {
+        fprintf(stderr, "WARNING: %s doesn't support SO_NOFCS, frames of CRC-Distortion are dropped\n", pName_p);
+        noFcs_l = 0;
+    }
+
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size = RING_BLOCK_SIZE;
+    req.tp_frame_size = RING_FRAME_SIZE;
+    req.tp_frame_nr   = RING_FRAME_NR;
+    req.tp_block_nr   = RING_FRAME_NR * RING_FRAME_SIZE / RING_BLOCK_SIZE;
+
+    if ((setsockopt(pIf_p->fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) != 0) ||
+        (setsockopt(pIf_p->fd, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req)) != 0))
+    {
+        perror("PACKET_RX_RING/PACKET_TX_RING");
+        return -1;
+    }
+
+    pIf_p->pRing = mmap(NULL, 2 * RING_FRAME_NR * RING_FRAME_SIZE, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_LOCKED | MAP_POPULATE, pIf_p->fd, 0);
+    if (pIf_p->pRing == MAP_FAILED)
+    {
+        perror("mmap");
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sll_family   = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_ALL);
+    addr.sll_ifindex  = if_nametoindex(pName_p);
+    if ((addr.sll_ifindex == 0) || (bind(pIf_p->fd, (struct sockaddr*)&addr, sizeof(addr)) != 0))
+    {
+        perror(pName_p);
+        return -1;
+    }
+
+    memset(&mreq, 0, sizeof(mreq));
+    mreq.mr_ifindex = addr.sll_ifindex;
+    mreq.mr_type    = PACKET_MR_PROMISC;
+    setsockopt(pIf_p->fd, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mreq, sizeof(mreq));
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Put frame into the TX ring
+
+The ring is flushed once RING_BATCH frames are pending.
+
+\param  pIf_p               Interface
+\param  pStat_p             Statistic of the direction
+\param  pData_p             Frame data
+\param  len_p               Frame length
+\param  distortCrc_p        Frame is sent with a wrong CRC
+\param  rxTime_p            Receive time for the latency measurement or 0
+*/
+//------------------------------------------------------------------------------
+static void sendFrame(tInterface* pIf_p, tStatistic* pStat_p, const uint8_t* pData_p,
+                      unsigned len_p, int distortCrc_p, uint64_t rxTime_p)
+{
+    struct tpacket2_hdr*    pHdr;
+    uint8_t*                pTx;
+    uint32_t                crc;
+
+    if (distortCrc_p && !noFcs_l)
+    {
+        pStat_p->dropFrames++;
+        return;
+    }
+
+    pHdr = (struct tpacket2_hdr*)(pIf_p->pRing + (RING_FRAME_NR + pIf_p->txPos) * RING_FRAME_SIZE);
+
+    //Wait for a free frame of the ring
+    while (pHdr->tp_status != TP_STATUS_AVAILABLE)
+    {
+        if (pHdr->tp_status & TP_STATUS_WRONG_FORMAT)
+        {
+            pHdr->tp_status = TP_STATUS_AVAILABLE;
+            break;
+        }
+        flushInterface(pIf_p);
+    }
+
+    pTx = (uint8_t*)pHdr + TPACKET2_HDRLEN - sizeof(struct sockaddr_ll);
+    memcpy(pTx, pData_p, len_p);
+
+    if (noFcs_l && (pIf_p == &ifOut_l))
+    {
+        crc = crc32(pData_p, len_p);
+        if (distortCrc_p)
+            crc = ~crc;
+
+        pTx[len_p++] = crc;
+        pTx[len_p++] = crc >> 8;
+        pTx[len_p++] = crc >> 16;
+        pTx[len_p++] = crc >> 24;
+    }
+
+    pHdr->tp_len = len_p;
+    __sync_synchronize();
+    pHdr->tp_status = TP_STATUS_SEND_REQUEST;
+
+    pIf_p->txPos = (pIf_p->txPos + 1) % RING_FRAME_NR;
+    pIf_p->txPending++;
+    pStat_p->txFrames++;
+
+    if (rxTime_p != 0)
+    {
+        uint64_t latency = getTime() - rxTime_p;
+
+        pStat_p->latencySum += latency;
+        pStat_p->latencyCnt++;
+        if ((pStat_p->latencyMin == 0) || (latency < pStat_p->latencyMin))
+            pStat_p->latencyMin = latency;
+        if (latency > pStat_p->latencyMax)
+            pStat_p->latencyMax = latency;
+    }
+
+    if (pIf_p->txPending >= RING_BATCH)
+        flushInterface(pIf_p);
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send the pending frames of the TX ring
+
+\param  pIf_p               Interface
+*/
+//------------------------------------------------------------------------------
+static void flushInterface(tInterface* pIf_p)
+{
+    if (pIf_p->txPending != 0)
+    {
+        send(pIf_p->fd, NULL, 0, MSG_DONTWAIT);
+        pIf_p->txPending = 0;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set an error flag and abort the series of test
+
+\param  flag_p              Error flag of the status register
+*/
+//------------------------------------------------------------------------------
+static void setError(uint8_t flag_p)
+{
+    if (!(status_l & flag_p))
+        fprintf(stderr, "Error 0x%02X in cycle %u\n", flag_p, cycle_l);
+
+    status_l |= flag_p;
+    testActive_l = 0;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Execute the tasks on a frame of the input interface
+
+Implements the Process_Unit: counts the cycles at every SoC, executes the task
+of the current cycle with a matching frame filter and the safety tasks.
+
+\param  pData_p             Frame data
+\param  pLen_p              Frame length, is changed by the Cut task
+\param  pDistortCrc_p       Is set by the CRC-Distortion task
+\param  rxTime_p            Receive time in ns
+
+\return The function returns 1, when the frame is sent directly, or 0, when it
+        is dropped or queued.
+*/
+//------------------------------------------------------------------------------
+static int processFrame(uint8_t* pData_p, unsigned* pLen_p, int* pDistortCrc_p, uint64_t rxTime_p)
+{
+    uint16_t    etherType;
+    uint64_t    header = 0;
+    int         isSoc;
+    int         class;
+    unsigned    tag;
+    unsigned    i;
+    int         task;
+    int         selected;
+
+    *pDistortCrc_p = 0;
+
+    class = classifyFrame(pData_p, *pLen_p, &tag);
+    trackCycle(pData_p, *pLen_p, tag, class);
+    if (class == FRAME_DROP)
+        return 0;
+
+    etherType = (pData_p[FRAME_ETHER_TYPE + tag] << 8) | pData_p[FRAME_ETHER_TYPE + tag + 1];
+    isSoc = (class == FRAME_TASKS) && (etherType == ETHERTYPE_POWERLINK) &&
+            (pData_p[FRAME_FILTER + tag] == MESSAGETYPE_SOC);
+
+    if (isSoc)
+    {
+        memset(aSocData_l, 0, sizeof(aSocData_l));
+        memcpy(aSocData_l, &pData_p[FRAME_SOC_TIME + tag], *pLen_p - FRAME_SOC_TIME - tag);
+
+        if (testActive_l)
+        {
+            cycle_l++;
+            if (cycle_l > FRAMEMAN_MAX_CYCLE)
+                testActive_l = 0;
+        }
+
+        if (startTest_l && !testActive_l && !stopTest_l && (cycle_l == 0))
+        {
+            if (startMode_l == START_EDGE)
+            {
+                startSeries();
+                cycle_l = 1;
+            }
+            else if (((startMode_l == START_NET_TIME) || (startMode_l == START_REL_TIME)) &&
+                     (getSocTime() >= startTime_l))
+            {
+                startSeries();
+            }
+        }
+    }
+
+    if (stopTest_l)
+        testActive_l = 0;
+
+    //Frames behind a delayed frame
+    if (queueCount_l != 0)
+    {
+        if ((delayType_l == DELAY_DELETE) || ((delayType_l == DELAY_PASS_SOC) && !isSoc))
+            return 0;
+
+        if (queueCount_l == FRAMEMAN_NO_DEL_FRAMES)
+        {
+            setError(STATUS_ER_FRAME_OV);
+            return 0;
+        }
+
+        tQueueFrame* pQueue = &aQueue_l[(queueHead_l + queueCount_l) % FRAMEMAN_NO_DEL_FRAMES];
+        memcpy(pQueue->aData, pData_p, *pLen_p);
+        pQueue->len = *pLen_p;
+        pQueue->sendTime = 0;
+        pQueue->rxTime = rxTime_p;
+        pQueue->distortCrc = 0;
+        queueCount_l++;
+        return 0;
+    }
+
+    //Frames of other EtherTypes keep their order, but are never manipulated
+    if (class == FRAME_BYPASS)
+        return 1;
+
+    for (i = 0; i < 8; i++)
+        header = (header << 8) | pData_p[FRAME_FILTER + tag + i];
+
+    //Armed test starts with the first frame of a start task regardless of its cycle
+    if ((startMode_l == START_TRIGGER) && startTest_l && !testActive_l && !stopTest_l && (cycle_l == 0))
+    {
+        for (task = 0; task < taskCount_l; task++)
+        {
+            const tTask* pTask = &pTasks_l[task];
+
+            if ((pTask->aSetting[1] == TASK_START) &&
+                ((header & pTask->mask) == (pTask->frame & pTask->mask)) &&
+                matchWindows(pTask, pData_p, *pLen_p, tag) && matchPhase(pTask))
+            {
+                startSeries();
+                break;
+            }
+        }
+    }
+
+    if (!testActive_l)
+        return 1;
+
+    //All matching tasks are counted for their chains, the first one, which isn't a trigger, is executed
+    selected = -1;
+    for (task = 0; task < taskCount_l; task++)
+    {
+        const tTask*    pTask = &pTasks_l[task];
+        const uint8_t*  pSet = pTask->aSetting;
+
+        if (((pSet[0] != cycle_l) && (pSet[0] != 0xFF)) || (pSet[1] == 0) || (pSet[1] & 0x80) ||
+            (pSet[1] == TASK_START) ||
+            pTask->disarmed || ((pTask->aChain[0] & CHAIN_STANDBY) && !pTask->armed) ||
+            ((header & pTask->mask) != (pTask->frame & pTask->mask)) ||
+            !matchWindows(pTask, pData_p, *pLen_p, tag) || !matchPhase(pTask))
+            continue;
+
+        hitChain(task);
+
+        if ((selected < 0) && (pSet[1] != TASK_TRIGGER))
+            selected = task;
+    }
+
+    if (selected >= 0)
+    {
+        const uint8_t*  pSet = pTasks_l[selected].aSetting;
+
+        switch (pSet[1])
+        {
+            case TASK_DROP:
+                return 0;
+
+            case TASK_DELAY:
+            {
+                uint64_t delay = 0;
+                tQueueFrame* pQueue = &aQueue_l[queueHead_l];
+
+                //Delay in 10 ns steps
+                for (i = 3; i < 8; i++)
+                    delay = (delay << 8) | pSet[i];
+
+                delayType_l = pSet[2];
+                memcpy(pQueue->aData, pData_p, *pLen_p);
+                pQueue->len = *pLen_p;
+                pQueue->sendTime = rxTime_p + delay * 10;
+                pQueue->rxTime = 0;
+                pQueue->distortCrc = 0;
+                queueCount_l = 1;
+                return 0;
+            }
+
+            case TASK_MANI:
+            {
+                //Eight 6 bit offsets in Byte 2-7 and the data in Byte 8-15
+                uint64_t offsets = 0;
+
+                for (i = 2; i < 8; i++)
+                    offsets = (offsets << 8) | pSet[i];
+
+                for (i = 0; i < 8; i++)
+                {
+                    unsigned offset = (offsets >> (6 * i)) & 0x3F;
+
+                    if ((offset != 0) && (offset <= *pLen_p))
+                        pData_p[offset - 1] = pSet[15 - i];
+                }
+                break;
+            }
+
+            case TASK_CRC:
+                *pDistortCrc_p = 1;
+                break;
+
+            case TASK_CUT:
+            {
+                unsigned size = ((pSet[6] << 8) | pSet[7]) & FRAMEMAN_CUT_MASK;
+
+                if (size < *pLen_p)
+                    *pLen_p = size;
+                break;
+            }
+
+            case TASK_IPG:
+            {
+                //The host keeps its own IPG, only a stretched gap is applied by holding the frame
+                unsigned gap = (pSet[6] << 8) | pSet[7];
+                tQueueFrame* pQueue = &aQueue_l[queueHead_l];
+
+                if (gap <= FRAMEMAN_IPG_SIZE)
+                    break;
+
+                delayType_l = DELAY_PASS;
+                memcpy(pQueue->aData, pData_p, *pLen_p);
+                pQueue->len = *pLen_p;
+                pQueue->sendTime = rxTime_p + (uint64_t)(gap - FRAMEMAN_IPG_SIZE) * FRAMEMAN_BYTE_TIME;
+                pQueue->rxTime = 0;
+                pQueue->distortCrc = 0;
+                queueCount_l = 1;
+                return 0;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    return 1;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Classify a frame by its EtherType
+
+Like Frame_Receiver: frames of framemanipulatorPkg.cEth.filterEtherType and of
+the configured EtherTypes are manipulated by the tasks, frames of other
+EtherTypes are only forwarded with option -a. With option -v, the EtherType is
+taken behind a VLAN tag.
+
+\param  pData_p             Frame data
+\param  len_p               Frame length
+\param  pTag_p              Returns the size of the VLAN tag or 0
+
+\return The function returns FRAME_DROP, FRAME_TASKS or FRAME_BYPASS.
+*/
+//------------------------------------------------------------------------------
+static int classifyFrame(const uint8_t* pData_p, unsigned len_p, unsigned* pTag_p)
+{
+    uint16_t    etherType;
+    unsigned    i;
+
+    *pTag_p = 0;
+
+    if (len_p < FRAME_FILTER + 8)
+        return FRAME_DROP;
+
+    etherType = (pData_p[FRAME_ETHER_TYPE] << 8) | pData_p[FRAME_ETHER_TYPE + 1];
+    if (forwardVlan_l && (etherType == ETHERTYPE_VLAN) && (len_p >= FRAME_FILTER + FRAME_VLAN_TAG + 8))
+    {
+        *pTag_p = FRAME_VLAN_TAG;
+        etherType = (pData_p[FRAME_ETHER_TYPE + FRAME_VLAN_TAG] << 8) |
+                    pData_p[FRAME_ETHER_TYPE + FRAME_VLAN_TAG + 1];
+    }
+
+    for (i = 0; i < sizeof(aEtherType_l) / sizeof(aEtherType_l[0]); i++)
+    {
+        if (etherType == aEtherType_l[i])
+            return FRAME_TASKS;
+    }
+
+    for (i = 0; i < (unsigned)cfgEtherTypeCount_l; i++)
+    {
+        if (etherType == aCfgEtherType_l[i])
+            return FRAME_TASKS;
+    }
+
+    return forwardAll_l ? FRAME_BYPASS : FRAME_DROP;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare the filter windows of a task with a frame
+
+Like Manipulation_Manager: a window word holds the offset of its first Byte in
+Byte 0-1, three Bytes of data and three Bytes of mask. Windows with a mask of
+zero are unused. Bytes from the EtherType on are taken behind the VLAN tag.
+
+\param  pTask_p             Task
+\param  pData_p             Frame data
+\param  len_p               Frame length
+\param  tag_p               Size of the VLAN tag or 0
+
+\return The function returns 1, when all used windows fit with the frame.
+*/
+//------------------------------------------------------------------------------
+static int matchWindows(const tTask* pTask_p, const uint8_t* pData_p, unsigned len_p, unsigned tag_p)
+{
+    int         win;
+    unsigned    i;
+
+    for (win = 0; win < FRAMEMAN_FILTER_WINDOWS; win++)
+    {
+        uint64_t    word = pTask_p->aWindow[win];
+        unsigned    offset = word >> 48;
+        uint32_t    data = (word >> 24) & 0xFFFFFF;
+        uint32_t    mask = word & 0xFFFFFF;
+        uint32_t    frame = 0;
+
+        if (mask == 0)
+            continue;
+
+        if ((offset == 0) || (offset + 2 > FRAME_WINDOW_END) || (offset + 2 + tag_p > len_p))
+            return 0;
+
+        for (i = 0; i < 3; i++)
+        {
+            unsigned pos = offset - 1 + i;
+
+            if (pos >= FRAME_ETHER_TYPE)
+                pos += tag_p;
+            frame = (frame << 8) | pData_p[pos];
+        }
+
+        if ((frame & mask) != (data & mask))
+            return 0;
+    }
+
+    return 1;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Follow the phases and multiplexed slots of the POWERLINK cycle
+
+Like the Cycle_Tracker: the SoC starts the isochronous, the SoA the
+asynchronous phase. The multiplexed slot restarts at 1 with the SoC, whose flag
+MC toggled, and stays 0 until the first toggle. The invitation of the SoA is
+taken over with the next frame.
+
+\param  pData_p             Frame data
+\param  len_p               Frame length
+\param  tag_p               Size of the VLAN tag or 0
+\param  class_p             Class of classifyFrame
+*/
+//------------------------------------------------------------------------------
+static void trackCycle(const uint8_t* pData_p, unsigned len_p, unsigned tag_p, int class_p)
+{
+    uint8_t messageType;
+    int     mc;
+
+    if (soaPending_l)
+    {
+        invitedNode_l = soaNode_l;
+        invitedService_l = soaService_l;
+        soaPending_l = 0;
+    }
+
+    if ((class_p != FRAME_TASKS) || (len_p <= FRAME_SOA_TARGET + tag_p))
+        return;
+
+    messageType = pData_p[FRAME_FILTER + tag_p];
+
+    if (messageType == MESSAGETYPE_SOC)
+    {
+        mc = (pData_p[FRAME_SOC_FLAGS + tag_p] & SOC_FLAG_MC) != 0;
+
+        if ((mc_l >= 0) && (mc != mc_l))
+            muxSlot_l = 1;
+        else if ((muxSlot_l != 0) && (muxSlot_l != 0xFF))
+            muxSlot_l++;
+
+        mc_l = mc;
+        phase_l = PHASE_ISOCHRONOUS;
+        invitedNode_l = 0;
+        invitedService_l = 0;
+    }
+    else if (messageType == MESSAGETYPE_SOA)
+    {
+        phase_l = PHASE_ASYNC;
+        invitedNode_l = 0;
+        invitedService_l = 0;
+        soaNode_l = pData_p[FRAME_SOA_TARGET + tag_p];
+        soaService_l = pData_p[FRAME_SOA_SERVICE + tag_p];
+        soaPending_l = 1;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare the cycle phase of a task with the current frame
+
+Like Manipulation_Manager: Byte 4-7 of the chain hold the flags of the phase,
+the multiplexed slot, the invited node and the requested service of the SoA.
+Zero values aren't compared.
+
+\param  pTask_p             Task
+
+\return The function returns 1, when the frame fits with the phase of the task.
+*/
+//------------------------------------------------------------------------------
+static int matchPhase(const tTask* pTask_p)
+{
+    const uint8_t* pChain = pTask_p->aChain;
+
+    return ((pChain[4] == 0) || (pChain[4] & phase_l)) &&
+           ((pChain[5] == 0) || (pChain[5] == muxSlot_l)) &&
+           ((pChain[6] == 0) || (pChain[6] == invitedNode_l)) &&
+           ((pChain[7] == 0) || (pChain[7] == invitedService_l));
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Count a selected frame for the chain of a task
+
+Like the Manipulation_Manager: after the number of hits, the chain arms or
+disarms another task, disarms the task itself or stops the series of test.
+
+\param  task_p              Selected task
+*/
+//------------------------------------------------------------------------------
+static void hitChain(int task_p)
+{
+    tTask*          pTask = &pTasks_l[task_p];
+    const uint8_t*  pChain = pTask->aChain;
+
+    if (pTask->hitCnt < 255)
+        pTask->hitCnt++;
+    else
+        return;
+
+    if (pTask->hitCnt != pChain[1])
+        return;
+
+    if ((pChain[2] != 0) && (pChain[2] <= taskCount_l))
+    {
+        pTasks_l[pChain[2] - 1].armed = 1;
+        pTasks_l[pChain[2] - 1].disarmed = 0;
+    }
+
+    if ((pChain[3] != 0) && (pChain[3] <= taskCount_l))
+        pTasks_l[pChain[3] - 1].disarmed = 1;
+
+    if (pChain[0] & CHAIN_ONCE)
+        pTask->disarmed = 1;
+
+    if (pChain[0] & CHAIN_STOP)
+        testActive_l = 0;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start the series of test
+
+New test => restart counters and chains. The cycle counts from the next SoC.
+*/
+//------------------------------------------------------------------------------
+static void startSeries(void)
+{
+    int task;
+
+    testActive_l = 1;
+
+    for (task = 0; task < taskCount_l; task++)
+    {
+        pTasks_l[task].hitCnt = 0;
+        pTasks_l[task].armed = 0;
+        pTasks_l[task].disarmed = 0;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Time of the last SoC for the start mode
+
+Like the Manipulation_Manager: the NetTime with its seconds above the
+nanoseconds, the RelativeTime as it is. Both are little endian in the SoC.
+
+\return The function returns the NetTime or the RelativeTime.
+*/
+//------------------------------------------------------------------------------
+static uint64_t getSocTime(void)
+{
+    uint64_t    time = 0;
+    int         i;
+
+    if (startMode_l == START_NET_TIME)
+    {
+        for (i = 3; i >= 0; i--)
+            time = (time << 8) | aSocData_l[i];
+        for (i = 7; i >= 4; i--)
+            time = (time << 8) | aSocData_l[i];
+    }
+    else
+    {
+        for (i = 15; i >= 8; i--)
+            time = (time << 8) | aSocData_l[i];
+    }
+
+    return time;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Execute the safety tasks on a frame
+
+Implements the Packet_Buffer: every context, whose frame filter matches the
+frame, exchanges its packets with the behavior of the PacketControl_FSM.
+
+\param  pData_p             Frame data
+\param  len_p               Frame length
+*/
+//------------------------------------------------------------------------------
+static void processSafety(uint8_t* pData_p, unsigned len_p)
+{
+    uint64_t    header = 0;
+    int         ctx;
+    unsigned    tag;
+    unsigned    i;
+
+    if (classifyFrame(pData_p, len_p, &tag) != FRAME_TASKS)
+        return;
+
+    for (i = 0; i < 8; i++)
+        header = (header << 8) | pData_p[FRAME_FILTER + tag + i];
+
+    for (ctx = 0; ctx < contextCount_l; ctx++)
+    {
+        tContext*       pCtx = &aContext_l[ctx];
+        const uint8_t*  pSet;
+        unsigned        packets;
+        int             pa;
+
+        if ((header & pCtx->mask) != (pCtx->frame & pCtx->mask))
+            continue;
+
+        //Skip tasks, whose cycle has passed without a safety frame
+        while (!pCtx->active && (pCtx->current < pCtx->taskCount - 1) && testActive_l &&
+               (pTasks_l[pCtx->aTask[pCtx->current]].aSetting[0] < cycle_l))
+            pCtx->current++;
+
+        pSet = pTasks_l[pCtx->aTask[pCtx->current]].aSetting;
+        packets = (pSet[4] << 8) | pSet[5];
+
+        if (!pCtx->active && testActive_l && (pSet[0] == cycle_l) &&
+            matchWindows(&pTasks_l[pCtx->aTask[pCtx->current]], pData_p, len_p, tag) &&
+            matchPhase(&pTasks_l[pCtx->aTask[pCtx->current]]))
+        {
+            pCtx->active = 1;
+            pCtx->twisted = 0;
+            pCtx->frameCnt = 0;
+        }
+
+        if (!testActive_l)
+            pCtx->active = 0;
+
+        for (pa = 0; pa < FRAMEMAN_SAFETY_PACKETS; pa++)
+        {
+            tPacketMem* pMem = &pCtx->aMem[pa];
+            uint8_t     task;
+            unsigned    start;
+            unsigned    size;
+            uint8_t*    pPacket;
+            uint8_t     aOut[256];
+
+            if (pa == 0)
+            {
+                task = pSet[1];
+                start = pSet[2];
+                size = pSet[3];
+            }
+            else
+            {
+                task = pSet[4 + 3 * pa];
+                start = pSet[5 + 3 * pa];
+                size = pSet[6 + 3 * pa];
+            }
+
+            if ((task == 0) || (start == 0) || (start - 1 + size > len_p))
+                continue;
+
+            pPacket = &pData_p[start - 1];
+            memcpy(aOut, pPacket, size);
+
+            switch (task)
+            {
+                case TASK_PALOSS:
+                    if (pCtx->active)
+                        memset(aOut, 0, size);
+                    break;
+
+                case TASK_INCDATA:
+                    if (pCtx->active && (FRAME_PAYLOAD < size))
+                        aOut[FRAME_PAYLOAD] = ~aOut[FRAME_PAYLOAD];
+                    break;
+
+                case TASK_INSERTION:
+                {
+                    unsigned sn2Start = pSet[6];
+
+                    if ((sn2Start == 0) || (sn2Start - 1 + size > len_p))
+                        break;
+
+                    //Packet of the other SN from this frame, when it's sent first
+                    if (sn2Start < start)
+                        memcpy(pMem->aSn2, &pData_p[sn2Start - 1], size);
+
+                    if (pCtx->active)
+                        memcpy(aOut, pMem->aSn2, size);
+
+                    memcpy(pMem->aSn2, &pData_p[sn2Start - 1], size);
+                    break;
+                }
+
+                case TASK_MASQUERADE:
+                    if (pCtx->active)
+                        memcpy(aOut, aSocData_l, size);
+                    break;
+
+                case TASK_REPETITION:
+                case TASK_PADELAY:
+                case TASK_INCSEQ:
+                {
+                    int store = 1;
+                    int load = 1;
+
+                    if (pCtx->active && (task == TASK_REPETITION))
+                    {
+                        //Clone the last packet
+                        memcpy(aOut, pMem->aLast, size);
+                        load = 0;
+                    }
+                    else if (pCtx->active && (task == TASK_PADELAY))
+                    {
+                        memset(aOut, 0, size);
+                        load = 0;
+                    }
+                    else if ((task == TASK_INCSEQ) && !pCtx->active && (pMem->count < packets))
+                    {
+                        //Build up the lag of the Incorrect-Sequence
+                        memset(aOut, 0, size);
+                        load = 0;
+                    }
+                    else if ((task == TASK_INCSEQ) && pCtx->active && !pCtx->twisted)
+                    {
+                        //Put out the stored packets in the reverse order
+                        for (i = 0; i < pMem->count / 2; i++)
+                        {
+                            uint8_t aTmp[256];
+                            uint8_t* pA = pMem->aaPacket[(pMem->head + i) % FRAMEMAN_PACKET_SLOTS];
+                            uint8_t* pB = pMem->aaPacket[(pMem->head + pMem->count - 1 - i) % FRAMEMAN_PACKET_SLOTS];
+
+                            memcpy(aTmp, pA, size);
+                            memcpy(pA, pB, size);
+                            memcpy(pB, aTmp, size);
+                        }
+                        if (pa == FRAMEMAN_SAFETY_PACKETS - 1)
+                            pCtx->twisted = 1;
+                    }
+
+                    if (store)
+                    {
+                        if (pMem->count == FRAMEMAN_PACKET_SLOTS)
+                        {
+                            setError(STATUS_ER_PACKET_OV);
+                            break;
+                        }
+                        memcpy(pMem->aaPacket[(pMem->head + pMem->count) % FRAMEMAN_PACKET_SLOTS], pPacket, size);
+                        pMem->count++;
+                    }
+
+                    if (load)
+                    {
+                        memcpy(aOut, pMem->aaPacket[pMem->head], size);
+                        pMem->head = (pMem->head + 1) % FRAMEMAN_PACKET_SLOTS;
+                        pMem->count--;
+                    }
+                    break;
+                }
+
+                default:
+                    break;
+            }
+
+            memcpy(pMem->aLast, aOut, size);
+            memcpy(pPacket, aOut, size);
+        }
+
+        if (pCtx->active)
+        {
+            pCtx->twisted = 1;
+            pCtx->frameCnt++;
+            if (pCtx->frameCnt >= packets)
+            {
+                pCtx->active = 0;
+
+                //Load the next task of the context, its packets are removed when the task changes
+                if (pCtx->current < pCtx->taskCount - 1)
+                {
+                    pCtx->current++;
+                    if (pTasks_l[pCtx->aTask[pCtx->current]].aSetting[1] != pSet[1])
+                        memset(pCtx->aMem, 0, sizeof(pCtx->aMem));
+                }
+            }
+        }
+    }
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send the delayed frame and the frames behind it
+
+The queue keeps the order of the frames. A frame is sent, when its send time
+is reached.
+*/
+//------------------------------------------------------------------------------
+static void processQueue(void)
+{
+    uint64_t now;
+
+    if (queueCount_l == 0)
+        return;
+
+    now = getTime();
+    while ((queueCount_l != 0) && (aQueue_l[queueHead_l].sendTime <= now))
+    {
+        tQueueFrame* pQueue = &aQueue_l[queueHead_l];
+
+        processSafety(pQueue->aData, pQueue->len);
+        sendFrame(&ifOut_l, &aStat_l[0], pQueue->aData, pQueue->len, pQueue->distortCrc, pQueue->rxTime);
+
+        queueHead_l = (queueHead_l + 1) % FRAMEMAN_NO_DEL_FRAMES;
+        queueCount_l--;
+    }
+    flushInterface(&ifOut_l);
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Forward the frames of one direction
+
+Busy-polls the RX ring of the receiving interface and sends the frames in
+batches via the TX ring of the other interface. The tasks are only executed
+from the input to the output interface.
+
+\param  pArg_p              Direction: 0 input to output, 1 output to input
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* forwardThread(void* pArg_p)
+{
+    int             dir = (int)(intptr_t)pArg_p;
+    tInterface*     pRx = (dir == 0) ? &ifIn_l : &ifOut_l;
+    tInterface*     pTx = (dir == 0) ? &ifOut_l : &ifIn_l;
+    tStatistic*     pStat = &aStat_l[dir];
+
+    while (running_l)
+    {
+        struct tpacket2_hdr*    pHdr;
+        unsigned                batch = 0;
+
+        pHdr = (struct tpacket2_hdr*)(pRx->pRing + pRx->rxPos * RING_FRAME_SIZE);
+
+        while ((pHdr->tp_status & TP_STATUS_USER) && (batch < RING_BATCH))
+        {
+            uint8_t*    pData = (uint8_t*)pHdr + pHdr->tp_mac;
+            unsigned    len = pHdr->tp_snaplen;
+            int         distortCrc = 0;
+            uint64_t    rxTime = getTime();
+
+            pStat->rxFrames++;
+
+            if (len > FRAME_MAX_SIZE)
+            {
+                pStat->dropFrames++;
+            }
+            else if (dir == 1)
+            {
+                sendFrame(pTx, pStat, pData, len, 0, 0);
+            }
+            else if (processFrame(pData, &len, &distortCrc, rxTime))
+            {
+                processSafety(pData, len);
+                sendFrame(pTx, pStat, pData, len, distortCrc, rxTime);
+            }
+            else if (queueCount_l == 0)
+            {
+                pStat->dropFrames++;
+            }
+
+            pHdr->tp_status = TP_STATUS_KERNEL;
+            pRx->rxPos = (pRx->rxPos + 1) % RING_FRAME_NR;
+            pHdr = (struct tpacket2_hdr*)(pRx->pRing + pRx->rxPos * RING_FRAME_SIZE);
+            batch++;
+        }
+
+        flushInterface(pTx);
+
+        if (dir == 0)
+            processQueue();
+    }
+
+    return NULL;
+}
+
+
+//------------------------------------------------------------------------------
+/**
+\brief  Signal handler to start and stop the test and to exit the bridge
+
+\param  signal_p            Received signal
+*/
+//------------------------------------------------------------------------------
+static void signalHandler(int signal_p)
+{
+    switch (signal_p)
+    {
+        case SIGUSR1:
+            startTest_l = 1;
+            break;
+
+        case SIGUSR2:
+            stopTest_l = 1;
+            break;
+
+        default:
+            running_l = 0;
+            break;
+    }
+}
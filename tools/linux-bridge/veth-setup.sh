@@ -0,0 +1,35 @@
+#!/bin/bash
+# Creates two veth pairs to test fm-bridge without network cards.
+# Call e.g. ./tools/linux-bridge/veth-setup.sh [up|down]
+#
+# The bridge is started with -i fmIn -o fmOut. Test frames are sent to fmInPeer
+# and received from fmOutPeer, e.g. by a traffic generator or tcpdump.
+
+PAIRS="fmIn fmOut"
+
+proc_up() {
+    for if in $PAIRS
+    do
+        ip link add $if type veth peer name ${if}Peer || exit 1
+        ip link set $if up
+        ip link set ${if}Peer up
+        # No IPv6 traffic of the host between the frames of the test
+        sysctl -qw net.ipv6.conf.$if.disable_ipv6=1
+        sysctl -qw net.ipv6.conf.${if}Peer.disable_ipv6=1
+    done
+}
+
+proc_down() {
+    for if in $PAIRS
+    do
+        ip link del $if 2> /dev/null
+    done
+}
+
+case ${1:-up} in
+    up)     proc_up ;;
+    down)   proc_down ;;
+    *)      echo "ERROR: Unknown command $1" >&2; exit 1 ;;
+esac
+
+exit 0
@@ -32,6 +32,16 @@ DOFILE=$DIR_TOOLS/sim.do
 echo
 echo "#### $TOP_LEVEL ####"
 
+#Execute pre script, when defined
+if [ "$PRE_SCRIPT" ]; then
+    chmod +x $PRE_SCRIPT
+    $PRE_SCRIPT $SETTINGS_FILE || {
+        echo "Pre-Script failed"
+        exit 1
+    }
+
+fi
+
 vlib work
 
 #compile source files